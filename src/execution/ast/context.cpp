@@ -21,6 +21,7 @@
 #include "execution/sql/filter_manager.h"
 #include "execution/sql/index_iterator.h"
 #include "execution/sql/join_hash_table.h"
+#include "execution/sql/join_hash_table_batch_probe.h"
 #include "execution/sql/join_hash_table_vector_probe.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/table_vector_iterator.h"
@@ -311,6 +311,29 @@ ast::Expr *CodeGen::AggregateType(parser::ExpressionType agg_type, sql::TypeId r
         throw NOT_IMPLEMENTED_EXCEPTION(
             fmt::format("HISTOGRAM aggregate does not support type {}", TypeIdToString(child_type)));
       }
+    case parser::ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT:
+      if (child_type == sql::TypeId::Boolean) {
+        return BuiltinType(ast::BuiltinType::BooleanApproxCountDistinctAggregate);
+      } else if (IsTypeIntegral(child_type)) {
+        return BuiltinType(ast::BuiltinType::IntegerApproxCountDistinctAggregate);
+      } else if (IsTypeFloatingPoint(child_type)) {
+        return BuiltinType(ast::BuiltinType::RealApproxCountDistinctAggregate);
+      } else if (child_type == sql::TypeId::Varchar || child_type == sql::TypeId::Varbinary) {
+        return BuiltinType(ast::BuiltinType::StringApproxCountDistinctAggregate);
+      } else if (child_type == sql::TypeId::Date) {
+        return BuiltinType(ast::BuiltinType::DateApproxCountDistinctAggregate);
+      } else if (child_type == sql::TypeId::Timestamp) {
+        return BuiltinType(ast::BuiltinType::TimestampApproxCountDistinctAggregate);
+      } else {
+        throw NOT_IMPLEMENTED_EXCEPTION(
+            fmt::format("APPROX_COUNT_DISTINCT aggregate does not support type {}", TypeIdToString(child_type)));
+      }
+    case parser::ExpressionType::AGGREGATE_APPROX_PERCENTILE:
+      if (!IsTypeIntegral(child_type) && !IsTypeFloatingPoint(child_type)) {
+        throw NOT_IMPLEMENTED_EXCEPTION(
+            fmt::format("APPROX_PERCENTILE aggregate does not support type {}", TypeIdToString(child_type)));
+      }
+      return BuiltinType(ast::BuiltinType::ApproxPercentileAggregate);
     default: {
       UNREACHABLE("AggregateType() should only be called with aggregates.");
     }
@@ -521,6 +544,12 @@ ast::Expr *CodeGen::IndexIteratorScan(ast::Expr *iter_ptr, planner::IndexScanTyp
   return CallBuiltin(builtin, args);
 }
 
+ast::Expr *CodeGen::IndexIteratorScanKeyBatch(ast::Expr *iter_ptr, bool sort_keys) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::IndexIteratorScanKeyBatch, {iter_ptr, ConstBool(sort_keys)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::PRGet(ast::Expr *pr, type::TypeId type, bool nullable, uint32_t attr_idx) {
   // @indexIteratorGetTypeNull(&iter, attr_idx)
   ast::Builtin builtin;
@@ -629,6 +658,13 @@ ast::Expr *CodeGen::TableIterGetVPI(ast::Expr *table_iter) {
   return call;
 }
 
+ast::Expr *CodeGen::TableIterAddRangeFilter(ast::Expr *table_iter, uint32_t col_idx, int64_t low, int64_t high) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::TableIterAddRangeFilter, {table_iter, ConstU32(col_idx), Const64(low), Const64(high)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::TableIterClose(ast::Expr *table_iter) {
   ast::Expr *call = CallBuiltin(ast::Builtin::TableIterClose, {table_iter});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -931,12 +967,50 @@ ast::Expr *CodeGen::JoinHashTableBuildParallel(ast::Expr *join_hash_table, ast::
   return call;
 }
 
+ast::Expr *CodeGen::JoinHashTableBuildPartitioned(ast::Expr *join_hash_table, ast::Expr *thread_state_container,
+                                                  ast::Expr *offset) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::JoinHashTableBuildPartitioned, {join_hash_table, thread_state_container, offset});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::JoinHashTableLookup(ast::Expr *join_hash_table, ast::Expr *entry_iter, ast::Expr *hash_val) {
   ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableLookup, {join_hash_table, entry_iter, hash_val});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
   return call;
 }
 
+ast::Expr *CodeGen::JoinHashTableEnableSpilling(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableEnableSpilling, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableIsResident(ast::Expr *join_hash_table, ast::Expr *hash_val) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableIsResident, {join_hash_table, hash_val});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableNextPass(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableNextPass, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableEnableBloomFilter(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableEnableBloomFilter, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableMayContain(ast::Expr *join_hash_table, ast::Expr *hash_val) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableMayContain, {join_hash_table, hash_val});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
 ast::Expr *CodeGen::JoinHashTableFree(ast::Expr *join_hash_table) {
   ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableFree, {join_hash_table});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -1117,6 +1191,12 @@ ast::Expr *CodeGen::AggregatorAdvance(ast::Expr *agg, ast::Expr *val) {
   return call;
 }
 
+ast::Expr *CodeGen::AggregatorAdvance(ast::Expr *agg, ast::Expr *val, ast::Expr *percentile) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::AggAdvance, {agg, val, percentile});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::AggregatorMerge(ast::Expr *agg1, ast::Expr *agg2) {
   ast::Expr *call = CallBuiltin(ast::Builtin::AggMerge, {agg1, agg2});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -1290,6 +1370,10 @@ ast::Expr *CodeGen::StorageInterfaceInit(ast::Expr *storage_interface_ptr, ast::
   return CallBuiltin(ast::Builtin::StorageInterfaceInit, args);
 }
 
+ast::Expr *CodeGen::StorageInterfaceBeginWorker(ast::Expr *storage_interface_ptr) {
+  return CallBuiltin(ast::Builtin::StorageInterfaceBeginWorker, {storage_interface_ptr});
+}
+
 // ---------------------------------------------------------
 // Extras
 // ---------------------------------------------------------
@@ -88,7 +88,9 @@ CompilationContext::CompilationContext(ExecutableQuery *query, catalog::CatalogA
       query_state_type_(codegen_.MakeIdentifier("QueryState")),
       query_state_(query_state_type_, [this](CodeGen *codegen) { return codegen->MakeExpr(query_state_var_); }),
       counters_enabled_(settings.GetIsCountersEnabled()),
-      pipeline_metrics_enabled_(settings.GetIsPipelineMetricsEnabled()) {}
+      pipeline_metrics_enabled_(settings.GetIsPipelineMetricsEnabled()),
+      radix_join_build_enabled_(settings.GetIsRadixJoinBuildEnabled()),
+      index_join_key_sort_enabled_(settings.GetIsIndexJoinKeySortEnabled()) {}
 
 ast::FunctionDecl *CompilationContext::GenerateInitFunction() {
   const auto name = codegen_.MakeIdentifier(GetFunctionPrefix() + "_Init");
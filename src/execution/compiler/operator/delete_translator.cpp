@@ -16,7 +16,6 @@ DeleteTranslator::DeleteTranslator(const planner::DeletePlanNode &plan, Compilat
                                    Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DELETE),
       col_oids_(GetCodeGen()->MakeFreshIdentifier("col_oids")) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
   // Prepare the child.
   compilation_context->Prepare(*plan.GetChild(0), pipeline);
 
@@ -35,6 +34,11 @@ DeleteTranslator::DeleteTranslator(const planner::DeletePlanNode &plan, Compilat
 
 void DeleteTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   DeclareDeleter(function);
+  if (pipeline.IsParallel()) {
+    // @storageInterfaceBeginWorker(&pipelineState.storageInterface)
+    auto *begin_worker = GetCodeGen()->StorageInterfaceBeginWorker(si_deleter_.GetPtr(GetCodeGen()));
+    function->Append(GetCodeGen()->MakeStmt(begin_worker));
+  }
   CounterSet(function, num_deletes_, 0);
 }
 
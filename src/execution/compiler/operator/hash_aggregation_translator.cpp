@@ -187,6 +187,10 @@ void HashAggregationTranslator::MergeOverflowPartitions(FunctionBuilder *functio
         auto rhs = GetAggregateTermPtr(partial_row, term_idx);
         function->Append(codegen->AggregatorMerge(lhs, rhs));
       }
+      // The partial row is dropped with its thread-local table, so release what its aggregates allocated.
+      for (auto agg_term_idx : GetAggPlan().GetMemoryAllocatingAggregatorIndexes()) {
+        function->Append(codegen->AggregatorFree(GetAggregateTermPtr(partial_row, agg_term_idx)));
+      }
     }
     check_found.EndIf();
   }
@@ -563,8 +567,16 @@ void HashAggregationTranslator::AdvanceAggregate(WorkContext *ctx, FunctionBuild
   for (uint32_t term_idx = 0; term_idx < agg_terms.size(); term_idx++) {
     auto agg = GetAggregateTermPtr(agg_payload, term_idx);
     auto val = GetAggregateTermPtr(agg_values, term_idx);
-    auto agg_advance_call = codegen->AggregatorAdvance(agg, val);
     auto agg_term = agg_terms[term_idx];
+    ast::Expr *agg_advance_call;
+    if (agg_term->GetExpressionType() == parser::ExpressionType::AGGREGATE_APPROX_PERCENTILE) {
+      // var percentile = <percentile>
+      auto percentile = codegen->MakeFreshIdentifier("percentile");
+      function->Append(codegen->DeclareVarWithInit(percentile, ctx->DeriveValue(*agg_term->GetChild(1), this)));
+      agg_advance_call = codegen->AggregatorAdvance(agg, val, codegen->AddressOf(percentile));
+    } else {
+      agg_advance_call = codegen->AggregatorAdvance(agg, val);
+    }
     if (agg_term->IsDistinct()) {
       // Distinct Aggregation
       auto agg_val = ctx->DeriveValue(*agg_term->GetChild(0), this);
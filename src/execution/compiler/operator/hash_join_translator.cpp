@@ -5,6 +5,7 @@
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/work_context.h"
 #include "execution/sql/join_hash_table.h"
 #include "planner/plannodes/hash_join_plan_node.h"
@@ -21,6 +22,8 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
     // The ExecutionOperatingUnitType depends on whether it is the build pipeline or probe pipeline.
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY),
       join_consumer_flag_(false),
+      pushed_runtime_filter_(false),
+      batched_probes_(false),
       build_row_var_(GetCodeGen()->MakeFreshIdentifier("buildRow")),
       build_row_type_(GetCodeGen()->MakeFreshIdentifier("BuildRow")),
       build_mark_(GetCodeGen()->MakeFreshIdentifier("buildMark")),
@@ -47,6 +50,9 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
     compilation_context->Prepare(*right_hash_key);
   }
 
+  PushDownRuntimeFilter();
+  PushDownProbeBatching();
+
   // Declare global state.
   auto *codegen = GetCodeGen();
   ast::Expr *join_ht_type = codegen->BuiltinType(ast::BuiltinType::JoinHashTable);
@@ -56,6 +62,11 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
     local_join_ht_ = left_pipeline_.DeclarePipelineStateEntry("joinHashTable", join_ht_type);
   }
 
+  if (batched_probes_) {
+    ast::Expr *probe_batch_type = codegen->BuiltinType(ast::BuiltinType::JoinHashTableBatchProbe);
+    probe_batch_ = pipeline->DeclarePipelineStateEntry("joinProbeBatch", probe_batch_type);
+  }
+
   num_build_rows_ = CounterDeclare("num_build_rows", &left_pipeline_);
   num_probe_rows_ = CounterDeclare("num_probe_rows", pipeline);
   num_match_rows_ = CounterDeclare("num_match_rows", pipeline);
@@ -158,8 +169,81 @@ void HashJoinTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pipel
   }
 }
 
-void HashJoinTranslator::InitializeJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const {
-  function->Append(GetCodeGen()->JoinHashTableInit(jht_ptr, GetExecutionContext(), build_row_type_));
+bool HashJoinTranslator::CanSpill() const {
+  // Every pass over spilled partitions re-runs the probe pipeline. If another
+  // hash join probes in the same pipeline, the passes of both joins would have
+  // to be nested, which is not supported.
+  for (auto iter = GetPipeline()->Begin(), end = GetPipeline()->End(); iter != end; ++iter) {
+    const auto *join = dynamic_cast<const HashJoinTranslator *>(*iter);
+    if (join != nullptr && join != this && join->IsRightPipeline(*GetPipeline())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void HashJoinTranslator::PushDownRuntimeFilter() {
+  // Probe tuples without a join partner produce output in right-anti joins.
+  const auto join_type = GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType();
+  if (join_type != planner::LogicalJoinType::INNER && join_type != planner::LogicalJoinType::LEFT &&
+      join_type != planner::LogicalJoinType::LEFT_SEMI && join_type != planner::LogicalJoinType::RIGHT_SEMI) {
+    return;
+  }
+
+  // The probe keys are evaluated in the scan's loop. This requires the scan to
+  // directly feed the probe.
+  auto *probe_translator = GetCompilationContext()->LookupTranslator(*GetPlan().GetChild(1));
+  auto *probe_scan = dynamic_cast<SeqScanTranslator *>(probe_translator);
+  if (probe_scan == nullptr) {
+    return;
+  }
+
+  probe_scan->AddRuntimeFilter(this);
+  pushed_runtime_filter_ = true;
+}
+
+void HashJoinTranslator::PushDownProbeBatching() {
+  // The probe keys are hashed in the scan's loop. This requires the scan to
+  // directly feed the probe.
+  auto *probe_translator = GetCompilationContext()->LookupTranslator(*GetPlan().GetChild(1));
+  auto *probe_scan = dynamic_cast<SeqScanTranslator *>(probe_translator);
+  if (probe_scan == nullptr) {
+    return;
+  }
+
+  probe_scan->AddHashJoinProbeBatch(this);
+  batched_probes_ = true;
+}
+
+ast::Expr *HashJoinTranslator::GenerateRuntimeFilter(WorkContext *context, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  auto hash_val = HashKeys(context, function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
+  return codegen->JoinHashTableMayContain(global_join_ht_.GetPtr(codegen), hash_val);
+}
+
+void HashJoinTranslator::AddBatchProbe(WorkContext *context, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  // var hashVal = @hash(...)
+  auto hash_val = HashKeys(context, function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
+  // @joinHTBatchProbeAddHash(&pipelineState.joinProbeBatch, hashVal)
+  function->Append(codegen->MakeStmt(
+      codegen->CallBuiltin(ast::Builtin::JoinHashTableBatchProbeAddHash, {probe_batch_.GetPtr(codegen), hash_val})));
+}
+
+void HashJoinTranslator::LookupProbeBatch(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  // @joinHTBatchProbeLookup(&pipelineState.joinProbeBatch, &queryState.joinHashTable)
+  function->Append(codegen->MakeStmt(codegen->CallBuiltin(
+      ast::Builtin::JoinHashTableBatchProbeLookup, {probe_batch_.GetPtr(codegen), global_join_ht_.GetPtr(codegen)})));
+}
+
+void HashJoinTranslator::InitializeJoinHashTable(FunctionBuilder *function,
+                                                 const StateDescriptor::Entry &join_ht) const {
+  auto *codegen = GetCodeGen();
+  function->Append(codegen->JoinHashTableInit(join_ht.GetPtr(codegen), GetExecutionContext(), build_row_type_));
+  if (CanSpill()) {
+    function->Append(codegen->JoinHashTableEnableSpilling(join_ht.GetPtr(codegen)));
+  }
 }
 
 void HashJoinTranslator::TearDownJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const {
@@ -167,8 +251,11 @@ void HashJoinTranslator::TearDownJoinHashTable(FunctionBuilder *function, ast::E
 }
 
 void HashJoinTranslator::InitializeQueryState(FunctionBuilder *function) const {
-  auto *codegen = GetCodeGen();
-  InitializeJoinHashTable(function, global_join_ht_.GetPtr(codegen));
+  InitializeJoinHashTable(function, global_join_ht_);
+  if (pushed_runtime_filter_) {
+    // Only the global table is probed, so only it needs a bloom filter.
+    function->Append(GetCodeGen()->JoinHashTableEnableBloomFilter(global_join_ht_.GetPtr(GetCodeGen())));
+  }
 }
 
 void HashJoinTranslator::TearDownQueryState(FunctionBuilder *function) const {
@@ -177,7 +264,14 @@ void HashJoinTranslator::TearDownQueryState(FunctionBuilder *function) const {
 
 void HashJoinTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   if (IsLeftPipeline(pipeline) && left_pipeline_.IsParallel()) {
-    InitializeJoinHashTable(function, local_join_ht_.GetPtr(GetCodeGen()));
+    InitializeJoinHashTable(function, local_join_ht_);
+  }
+
+  if (IsRightPipeline(pipeline) && batched_probes_) {
+    // @joinHTBatchProbeInit(&pipelineState.joinProbeBatch)
+    auto *codegen = GetCodeGen();
+    function->Append(codegen->MakeStmt(
+        codegen->CallBuiltin(ast::Builtin::JoinHashTableBatchProbeInit, {probe_batch_.GetPtr(codegen)})));
   }
 
   InitializeCounters(pipeline, function);
@@ -187,6 +281,13 @@ void HashJoinTranslator::TearDownPipelineState(const Pipeline &pipeline, Functio
   if (IsLeftPipeline(pipeline) && left_pipeline_.IsParallel()) {
     TearDownJoinHashTable(function, local_join_ht_.GetPtr(GetCodeGen()));
   }
+
+  if (IsRightPipeline(pipeline) && batched_probes_) {
+    // @joinHTBatchProbeFree(&pipelineState.joinProbeBatch)
+    auto *codegen = GetCodeGen();
+    function->Append(codegen->MakeStmt(
+        codegen->CallBuiltin(ast::Builtin::JoinHashTableBatchProbeFree, {probe_batch_.GetPtr(codegen)})));
+  }
 }
 
 void HashJoinTranslator::InitializeCounters(const Pipeline &pipeline, FunctionBuilder *function) const {
@@ -298,13 +399,47 @@ void HashJoinTranslator::ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *f
   auto iter_name = codegen->MakeFreshIdentifier("entryIter");
   function->Append(codegen->DeclareVarWithInit(iter_name, codegen->AddressOf(codegen->MakeExpr(iter_name_base))));
 
-  auto entry_iter = codegen->MakeExpr(iter_name);
-  auto hash_val = HashKeys(ctx, function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
+  // The hash is needed to look up the tuple, unless the scan feeding this join
+  // has already done so, and to check whether its partition is resident.
+  ast::Identifier hash_val_name;
+  if (!batched_probes_ || CanSpill()) {
+    auto hash_val = HashKeys(ctx, function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
+    hash_val_name = hash_val->As<ast::IdentifierExpr>()->Name();
+  }
+
+  ast::Stmt *lookup_call = nullptr;
+  if (batched_probes_) {
+    // The scan feeding this join already looked up this tuple as part of a
+    // batch. The batch is consumed in order, so this happens before the
+    // residency check.
+    // @joinHTBatchProbeNext(&pipelineState.joinProbeBatch, entryIter)
+    function->Append(codegen->MakeStmt(codegen->CallBuiltin(
+        ast::Builtin::JoinHashTableBatchProbeNext, {probe_batch_.GetPtr(codegen), codegen->MakeExpr(iter_name)})));
+  } else {
+    // @joinHTLookup(&queryState.joinHashTable, entryIter, hashVal)
+    lookup_call = codegen->MakeStmt(codegen->JoinHashTableLookup(
+        global_join_ht_.GetPtr(codegen), codegen->MakeExpr(iter_name), codegen->MakeExpr(hash_val_name)));
+  }
+
+  if (CanSpill()) {
+    // Skip probe tuples whose partition of the join hash table is on disk.
+    // They are probed in the pass that loads their partition.
+    If check_resident(function, codegen->JoinHashTableIsResident(global_join_ht_.GetPtr(codegen),
+                                                                  codegen->MakeExpr(hash_val_name)));
+    ProbeJoinHashTableForMatches(ctx, function, iter_name, lookup_call);
+    check_resident.EndIf();
+  } else {
+    ProbeJoinHashTableForMatches(ctx, function, iter_name, lookup_call);
+  }
+}
+
+void HashJoinTranslator::ProbeJoinHashTableForMatches(WorkContext *ctx, FunctionBuilder *function,
+                                                      ast::Identifier entry_iter_name, ast::Stmt *lookup_call) const {
+  auto *codegen = GetCodeGen();
+  auto entry_iter = codegen->MakeExpr(entry_iter_name);
 
   // Probe matches.
   const auto &join_plan = GetPlanAs<planner::HashJoinPlanNode>();
-  auto lookup_call =
-      codegen->MakeStmt(codegen->JoinHashTableLookup(global_join_ht_.GetPtr(codegen), entry_iter, hash_val));
   auto has_next_call = codegen->HTEntryIterHasNext(entry_iter);
 
   CounterAdd(function, num_probe_rows_, 1);
@@ -502,7 +637,11 @@ void HashJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBu
 
       auto *tls = GetThreadStateContainer();
       auto *offset = local_join_ht_.OffsetFromState(codegen);
-      function->Append(codegen->JoinHashTableBuildParallel(jht, tls, offset));
+      if (GetCompilationContext()->IsRadixJoinBuildEnabled()) {
+        function->Append(codegen->JoinHashTableBuildPartitioned(jht, tls, offset));
+      } else {
+        function->Append(codegen->JoinHashTableBuildParallel(jht, tls, offset));
+      }
 
       if (IsPipelineMetricsEnabled()) {
         auto *exec_ctx = GetExecutionContext();
@@ -513,10 +652,25 @@ void HashJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBu
       RecordCounters(pipeline, function);
     }
   } else {
-    if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT) {
+    const bool is_left_outer_join =
+        GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT;
+    if (is_left_outer_join) {
       CollectUnmatchedLeftRows(function);
     }
 
+    if (CanSpill()) {
+      // while (@joinHTNextPass(jht)) { ... }
+      // Re-run the probe pipeline once for every batch of spilled partitions.
+      Loop pass_loop(function, codegen->JoinHashTableNextPass(global_join_ht_.GetPtr(codegen)));
+      {
+        GetPipeline()->LaunchWork(function);
+        if (is_left_outer_join) {
+          CollectUnmatchedLeftRows(function);
+        }
+      }
+      pass_loop.EndLoop();
+    }
+
     if (!pipeline.IsParallel()) {
       RecordCounters(pipeline, function);
     }
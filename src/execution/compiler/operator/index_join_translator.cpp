@@ -9,6 +9,7 @@
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
 #include "execution/compiler/operator/operator_translator.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/work_context.h"
 #include "planner/plannodes/index_join_plan_node.h"
 #include "storage/index/index.h"
@@ -24,13 +25,14 @@ IndexJoinTranslator::IndexJoinTranslator(const planner::IndexJoinPlanNode &plan,
       table_pm_(GetCodeGen()->GetCatalogAccessor()->GetTable(plan.GetTableOid())->ProjectionMapForOids(input_oids_)),
       index_schema_(GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(plan.GetIndexOid())),
       index_pm_(GetCodeGen()->GetCatalogAccessor()->GetIndex(plan.GetIndexOid())->GetKeyOidToOffsetMap()),
-      index_iter_(GetCodeGen()->MakeFreshIdentifier("index_iter")),
       col_oids_(GetCodeGen()->MakeFreshIdentifier("col_oids")),
       lo_index_pr_(GetCodeGen()->MakeFreshIdentifier("lo_index_pr")),
       hi_index_pr_(GetCodeGen()->MakeFreshIdentifier("hi_index_pr")),
       table_pr_(GetCodeGen()->MakeFreshIdentifier("table_pr")),
-      slot_(GetCodeGen()->MakeFreshIdentifier("slot")) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+      slot_(GetCodeGen()->MakeFreshIdentifier("slot")),
+      batched_keys_(false) {
+  // The join does not register itself as the source of the pipeline. Every outer tuple is joined independently, so
+  // the join runs in parallel whenever its outer child does.
   if (plan.GetJoinPredicate() != nullptr) {
     compilation_context->Prepare(*plan.GetJoinPredicate());
   }
@@ -43,48 +45,102 @@ IndexJoinTranslator::IndexJoinTranslator(const planner::IndexJoinPlanNode &plan,
   }
 
   compilation_context->Prepare(*GetPlan().GetChild(0), pipeline);
+  PushDownKeyBatching();
+
+  ast::Expr *index_iter_type = GetCodeGen()->BuiltinType(ast::BuiltinType::IndexIterator);
+  index_iter_ = pipeline->DeclarePipelineStateEntry("indexIterator", index_iter_type);
   index_size_ = CounterDeclare("index_size", pipeline);
   num_scans_index_ = CounterDeclare("num_scans_index", pipeline);
   num_loops_ = CounterDeclare("num_loops", pipeline);
 }
 
+void IndexJoinTranslator::PushDownKeyBatching() {
+  // Only exact key lookups can be batched.
+  if (GetPlanAs<planner::IndexJoinPlanNode>().GetScanType() != planner::IndexScanType::Exact) {
+    return;
+  }
+
+  // The keys are evaluated in the scan's loop. This requires the scan to directly
+  // feed the join.
+  auto *outer_translator = GetCompilationContext()->LookupTranslator(*GetPlan().GetChild(0));
+  auto *outer_scan = dynamic_cast<SeqScanTranslator *>(outer_translator);
+  if (outer_scan == nullptr) {
+    return;
+  }
+
+  outer_scan->AddIndexJoinKeyBatch(this);
+  batched_keys_ = true;
+}
+
 void IndexJoinTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   CounterSet(function, index_size_, 0);
   CounterSet(function, num_scans_index_, 0);
   CounterSet(function, num_loops_, 0);
-}
-
-void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
-  const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
   // var col_oids: [num_cols]uint32
   // col_oids[i] = ...
   SetOids(function);
-  // var index_iter : IndexIterator
-  // @indexIteratorInit(&index_iter, queryState.execCtx, num_attrs, table_oid, index_oid, col_oids)
+  // @indexIteratorInit(&pipelineState.indexIterator, queryState.execCtx, num_attrs, table_oid, index_oid, col_oids)
   DeclareIterator(function);
-  // var lo_index_pr = @indexIteratorGetLoPR(&index_iter)
-  // var hi_index_pr = @indexIteratorGetHiPR(&index_iter)
-  DeclareIndexPR(function);
+}
+
+void IndexJoinTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // @indexIteratorFree(&pipelineState.indexIterator)
+  FreeIterator(function);
+}
+
+void IndexJoinTranslator::AddBatchKey(WorkContext *context, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  // var lo_index_pr = @indexIteratorGetLoPR(&pipelineState.indexIterator)
+  ast::Expr *lo_pr_call = codegen->CallBuiltin(ast::Builtin::IndexIteratorGetLoPR, {index_iter_.GetPtr(codegen)});
+  function->Append(codegen->DeclareVar(lo_index_pr_, nullptr, lo_pr_call));
   // @prSet(lo_index_pr, ...)
-  FillKey(context, function, lo_index_pr_, op.GetLoIndexColumns());
-  // @prSet(hi_index_pr, ...)
-  FillKey(context, function, hi_index_pr_, op.GetHiIndexColumns());
+  FillKey(context, function, lo_index_pr_, GetPlanAs<planner::IndexJoinPlanNode>().GetLoIndexColumns());
+  // @indexIteratorAddBatchKey(&pipelineState.indexIterator)
+  function->Append(
+      codegen->MakeStmt(codegen->CallBuiltin(ast::Builtin::IndexIteratorAddBatchKey, {index_iter_.GetPtr(codegen)})));
+}
+
+void IndexJoinTranslator::ScanKeyBatch(FunctionBuilder *function) const {
+  // @indexIteratorScanKeyBatch(&pipelineState.indexIterator, sort_keys)
+  auto *codegen = GetCodeGen();
+  function->Append(codegen->MakeStmt(codegen->IndexIteratorScanKeyBatch(
+      index_iter_.GetPtr(codegen), GetCompilationContext()->IsIndexJoinKeySortEnabled())));
+}
 
-  // @indexIteratorScanKey(&index_iter)
-  ast::Expr *scan_call = GetCodeGen()->IndexIteratorScan(index_iter_, op.GetScanType(), 0);
-  ast::Stmt *loop_init = GetCodeGen()->MakeStmt(scan_call);
-  // @indexIteratorAdvance(&index_iter)
-  ast::Expr *advance_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {GetCodeGen()->AddressOf(index_iter_)});
+void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
+  const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
+  auto *codegen = GetCodeGen();
+
+  ast::Stmt *loop_init;
+  if (batched_keys_) {
+    // The scan feeding this join already probed the key of this tuple as part of a batch.
+    // @indexIteratorNextBatchKey(&pipelineState.indexIterator)
+    ast::Expr *next_call = codegen->CallBuiltin(ast::Builtin::IndexIteratorNextBatchKey, {index_iter_.GetPtr(codegen)});
+    loop_init = codegen->MakeStmt(next_call);
+  } else {
+    // var lo_index_pr = @indexIteratorGetLoPR(&pipelineState.indexIterator)
+    // var hi_index_pr = @indexIteratorGetHiPR(&pipelineState.indexIterator)
+    DeclareIndexPR(function);
+    // @prSet(lo_index_pr, ...)
+    FillKey(context, function, lo_index_pr_, op.GetLoIndexColumns());
+    // @prSet(hi_index_pr, ...)
+    FillKey(context, function, hi_index_pr_, op.GetHiIndexColumns());
+
+    // @indexIteratorScanKey(&pipelineState.indexIterator)
+    ast::Expr *scan_call = codegen->IndexIteratorScan(index_iter_.GetPtr(codegen), op.GetScanType(), 0);
+    loop_init = codegen->MakeStmt(scan_call);
+  }
+  // @indexIteratorAdvance(&pipelineState.indexIterator)
+  ast::Expr *advance_call = codegen->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {index_iter_.GetPtr(codegen)});
 
   CounterAdd(function, num_loops_, 1);
 
-  // for (@indexIteratorScanKey(&index_iter); @indexIteratorAdvance(&index_iter);)
+  // for (@indexIteratorScanKey(&pipelineState.indexIterator); @indexIteratorAdvance(&pipelineState.indexIterator);)
   Loop loop(function, loop_init, advance_call, nullptr);
   {
-    // var table_pr = @indexIteratorGetTablePR(&index_iter)
+    // var table_pr = @indexIteratorGetTablePR(&pipelineState.indexIterator)
     DeclareTablePR(function);
-    // var slot = @indexIteratorGetSlot(&index_iter)
+    // var slot = @indexIteratorGetSlot(&pipelineState.indexIterator)
     DeclareSlot(function);
 
     bool has_predicate = op.GetJoinPredicate() != nullptr;
@@ -104,9 +160,7 @@ void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuil
   loop.EndLoop();
 
   CounterSetExpr(function, index_size_,
-                 GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSize, {GetCodeGen()->AddressOf(index_iter_)}));
-  // @indexIteratorFree(&index_iter_)
-  FreeIterator(function);
+                 codegen->CallBuiltin(ast::Builtin::IndexIteratorGetSize, {index_iter_.GetPtr(codegen)}));
 }
 
 void IndexJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
@@ -160,41 +214,38 @@ void IndexJoinTranslator::SetOids(FunctionBuilder *builder) const {
 }
 
 void IndexJoinTranslator::DeclareIterator(FunctionBuilder *builder) const {
-  // var index_iter : IndexIterator
-  ast::Expr *iter_type = GetCodeGen()->BuiltinType(ast::BuiltinType::IndexIterator);
-  builder->Append(GetCodeGen()->DeclareVar(index_iter_, iter_type, nullptr));
-  // @indexIteratorInit(&index_iter, queryState.execCtx, num_attrs, table_oid, index_oid, col_oids)
+  // @indexIteratorInit(&pipelineState.indexIterator, queryState.execCtx, num_attrs, table_oid, index_oid, col_oids)
   const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
   uint32_t num_attrs = std::max(op.GetLoIndexColumns().size(), op.GetHiIndexColumns().size());
 
   ast::Expr *init_call = GetCodeGen()->IndexIteratorInit(
-      index_iter_, GetCompilationContext()->GetExecutionContextPtrFromQueryState(), num_attrs,
+      index_iter_.GetPtr(GetCodeGen()), GetCompilationContext()->GetExecutionContextPtrFromQueryState(), num_attrs,
       op.GetTableOid().UnderlyingValue(), op.GetIndexOid().UnderlyingValue(), col_oids_);
   builder->Append(GetCodeGen()->MakeStmt(init_call));
 }
 
 void IndexJoinTranslator::DeclareIndexPR(noisepage::execution::compiler::FunctionBuilder *builder) const {
-  // var lo_pr = @indexIteratorGetLoPR(&index_iter)
-  // var hi_pr = @indexIteratorGetHiPR(&index_iter)
+  // var lo_pr = @indexIteratorGetLoPR(&pipelineState.indexIterator)
+  // var hi_pr = @indexIteratorGetHiPR(&pipelineState.indexIterator)
   ast::Expr *lo_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetLoPR, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetLoPR, {index_iter_.GetPtr(GetCodeGen())});
   ast::Expr *hi_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetHiPR, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetHiPR, {index_iter_.GetPtr(GetCodeGen())});
   builder->Append(GetCodeGen()->DeclareVar(lo_index_pr_, nullptr, lo_pr_call));
   builder->Append(GetCodeGen()->DeclareVar(hi_index_pr_, nullptr, hi_pr_call));
 }
 
 void IndexJoinTranslator::DeclareTablePR(noisepage::execution::compiler::FunctionBuilder *builder) const {
-  // var table_pr = @indexIteratorGetTablePR(&index_iter)
+  // var table_pr = @indexIteratorGetTablePR(&pipelineState.indexIterator)
   ast::Expr *get_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {index_iter_.GetPtr(GetCodeGen())});
   builder->Append(GetCodeGen()->DeclareVar(table_pr_, nullptr, get_pr_call));
 }
 
 void IndexJoinTranslator::DeclareSlot(noisepage::execution::compiler::FunctionBuilder *builder) const {
-  // var slot = @indexIteratorGetSlot(&index_iter)
+  // var slot = @indexIteratorGetSlot(&pipelineState.indexIterator)
   ast::Expr *get_slot_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {index_iter_.GetPtr(GetCodeGen())});
   builder->Append(GetCodeGen()->DeclareVar(slot_, nullptr, get_slot_call));
 }
 
@@ -219,9 +270,9 @@ ast::Expr *IndexJoinTranslator::GetSlotAddress() const {
 }
 
 void IndexJoinTranslator::FreeIterator(FunctionBuilder *builder) const {
-  // @indexIteratorFree(&index_iter_)
+  // @indexIteratorFree(&pipelineState.indexIterator)
   ast::Expr *free_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorFree, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorFree, {index_iter_.GetPtr(GetCodeGen())});
   builder->Append(GetCodeGen()->MakeStmt(free_call));
 }
 
@@ -30,8 +30,6 @@ InsertTranslator::InsertTranslator(const planner::InsertPlanNode &plan, Compilat
                     ->GetCatalogAccessor()
                     ->GetTable(GetPlanAs<planner::InsertPlanNode>().GetTableOid())
                     ->ProjectionMapForOids(all_oids_)) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
-
   switch (plan.GetInsertType()) {
     case parser::InsertType::SELECT: {
       NOISEPAGE_ASSERT(plan.GetChildrenSize() == 1, "INSERT INTO SELECT should have 1 child.");
@@ -39,6 +37,8 @@ InsertTranslator::InsertTranslator(const planner::InsertPlanNode &plan, Compilat
       break;
     }
     case parser::InsertType::VALUES: {
+      // There is no child to drive the pipeline, so the insert drives it serially.
+      pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
       for (uint32_t idx = 0; idx < plan.GetBulkInsertCount(); idx++) {
         const auto &node_vals = GetPlanAs<planner::InsertPlanNode>().GetValues(idx);
         for (const auto &node_val : node_vals) {
@@ -70,6 +70,11 @@ void InsertTranslator::InitializePipelineState(const Pipeline &pipeline, Functio
   // col_oids[i] = ...
   // @storageInterfaceInit(&pipelineState.storageInterface, execCtx, table_oid, col_oids, true)
   DeclareInserter(function);
+  if (pipeline.IsParallel()) {
+    // @storageInterfaceBeginWorker(&pipelineState.storageInterface)
+    auto *begin_worker = GetCodeGen()->StorageInterfaceBeginWorker(si_inserter_.GetPtr(GetCodeGen()));
+    function->Append(GetCodeGen()->MakeStmt(begin_worker));
+  }
   CounterSet(function, num_inserts_, 0);
 }
 
@@ -1,5 +1,7 @@
 #include "execution/compiler/operator/seq_scan_translator.h"
 
+#include <limits>
+
 #include "catalog/catalog_accessor.h"
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
@@ -8,9 +10,12 @@
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
+#include "execution/compiler/operator/hash_join_translator.h"
+#include "execution/compiler/operator/index_join_translator.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/work_context.h"
 #include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
 #include "parser/expression_util.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "storage/sql_table.h"
@@ -229,7 +234,7 @@ void SeqScanTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast
     vpi_loop.EndLoop();
   };
   // TODO(Amadou): What if the predicate doesn't filter out anything?
-  gen_vpi_loop(HasPredicate());
+  gen_vpi_loop(IsVPIFiltered());
 
   // var vpi_num_tuples = @tableIterGetNumTuples(tvi)
   ast::Identifier vpi_num_tuples = codegen->MakeFreshIdentifier("vpi_num_tuples");
@@ -238,8 +243,125 @@ void SeqScanTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast
   CounterAdd(function, num_scans_, vpi_num_tuples);
 }
 
+void SeqScanTranslator::ApplyRuntimeFilters(FunctionBuilder *function, ast::Expr *vpi) const {
+  auto *codegen = GetCodeGen();
+
+  // for (; @vpiHasNextFiltered(vpi); @vpiAdvanceFiltered(vpi))
+  Loop vpi_loop(function, nullptr, codegen->VPIHasNext(vpi, true), codegen->MakeStmt(codegen->VPIAdvance(vpi, true)));
+  {
+    // @vpiMatch(vpi, @joinHTMayContain(...) and ...)
+    WorkContext context(GetCompilationContext(), *GetPipeline());
+    ast::Expr *may_match = nullptr;
+    for (const auto *join : runtime_filters_) {
+      ast::Expr *cond = join->GenerateRuntimeFilter(&context, function);
+      may_match = may_match == nullptr ? cond : codegen->BinaryOp(parsing::Token::Type::AND, may_match, cond);
+    }
+    function->Append(codegen->VPIMatch(vpi, may_match));
+  }
+  vpi_loop.EndLoop();
+
+  // @vpiResetFiltered(vpi)
+  function->Append(codegen->MakeStmt(codegen->CallBuiltin(ast::Builtin::VPIResetFiltered, {vpi})));
+}
+
+void SeqScanTranslator::ProbeJoinBatches(FunctionBuilder *function, ast::Expr *vpi) const {
+  auto *codegen = GetCodeGen();
+  const bool is_filtered = IsVPIFiltered();
+
+  // Visit the tuples in the same order as the scan loop pushing them to the joins.
+  // for (; @vpiHasNext(vpi); @vpiAdvance(vpi))
+  Loop vpi_loop(function, nullptr, codegen->VPIHasNext(vpi, is_filtered),
+                codegen->MakeStmt(codegen->VPIAdvance(vpi, is_filtered)));
+  {
+    // @prSet(lo_index_pr, ...)
+    // @indexIteratorAddBatchKey(&pipelineState.indexIterator)
+    WorkContext context(GetCompilationContext(), *GetPipeline());
+    for (const auto *join : index_join_key_batches_) {
+      join->AddBatchKey(&context, function);
+    }
+    // @joinHTBatchProbeAddHash(&pipelineState.joinProbeBatch, @hash(...))
+    for (const auto *join : hash_join_probe_batches_) {
+      join->AddBatchProbe(&context, function);
+    }
+  }
+  vpi_loop.EndLoop();
+
+  // @vpiReset(vpi)
+  const auto reset = is_filtered ? ast::Builtin::VPIResetFiltered : ast::Builtin::VPIReset;
+  function->Append(codegen->MakeStmt(codegen->CallBuiltin(reset, {vpi})));
+
+  // @indexIteratorScanKeyBatch(&pipelineState.indexIterator, sort_keys)
+  for (const auto *join : index_join_key_batches_) {
+    join->ScanKeyBatch(function);
+  }
+
+  // @joinHTBatchProbeLookup(&pipelineState.joinProbeBatch, &queryState.joinHashTable)
+  for (const auto *join : hash_join_probe_batches_) {
+    join->LookupProbeBatch(function);
+  }
+}
+
+bool SeqScanTranslator::IsVPIFiltered() const { return HasPredicate() || !runtime_filters_.empty(); }
+
+void SeqScanTranslator::AddRangeFilters(FunctionBuilder *function,
+                                        common::ManagedPointer<parser::AbstractExpression> predicate) const {
+  // Every conjunct must hold for a tuple to pass, so each one can restrict the blocks to scan on its own.
+  if (predicate->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
+    for (const auto &child : predicate->GetChildren()) {
+      AddRangeFilters(function, child);
+    }
+    return;
+  }
+
+  // Zone maps only exist for integer columns, so only "int_col <op> int_const" conjuncts qualify.
+  if (!parser::ExpressionUtil::IsColumnCompareWithConst(*predicate)) {
+    return;
+  }
+  const auto is_integer = [](type::TypeId type) {
+    return type == type::TypeId::TINYINT || type == type::TypeId::SMALLINT || type == type::TypeId::INTEGER ||
+           type == type::TypeId::BIGINT;
+  };
+  auto cve = predicate->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
+  auto constant = predicate->GetChild(1).CastManagedPointerTo<parser::ConstantValueExpression>();
+  const auto &schema = GetCodeGen()->GetCatalogAccessor()->GetSchema(GetTableOid());
+  if (!is_integer(schema.GetColumn(cve->GetColumnOid()).Type()) || !is_integer(constant->GetReturnValueType()) ||
+      constant->IsNull()) {
+    return;
+  }
+
+  const auto value = constant->Peek<int64_t>();
+  int64_t low = std::numeric_limits<int64_t>::min(), high = std::numeric_limits<int64_t>::max();
+  switch (predicate->GetExpressionType()) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      low = high = value;
+      break;
+    // Strict comparisons use the inclusive bound, which still covers every matching value.
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      high = value;
+      break;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      low = value;
+      break;
+    default:
+      return;
+  }
+
+  // @tableIterAddRangeFilter(tvi, col_idx, low, high)
+  auto *codegen = GetCodeGen();
+  function->Append(
+      codegen->TableIterAddRangeFilter(codegen->MakeExpr(tvi_var_), GetColOidIndex(cve->GetColumnOid()), low, high));
+}
+
 void SeqScanTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
+
+  // Let the iterator skip blocks whose zone maps rule out the scan predicate.
+  if (HasPredicate()) {
+    AddRangeFilters(function, GetPlanAs<planner::SeqScanPlanNode>().GetScanPredicate());
+  }
+
   // for (@tableIterAdvance(tvi))
   Loop tvi_loop(function, codegen->TableIterAdvance(codegen->MakeExpr(tvi_var_)));
   {
@@ -253,7 +375,16 @@ void SeqScanTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *function) c
       function->Append(codegen->FilterManagerRunFilters(filter_manager, vpi, GetExecutionContext()));
     }
 
+    // Drop tuples that the hash joins this scan feeds cannot match.
+    if (!runtime_filters_.empty()) {
+      ApplyRuntimeFilters(function, vpi);
+    }
+
     if (!ctx->GetPipeline().IsVectorized()) {
+      // Probe the indexes and hash tables of the joins this scan feeds for the whole VPI at once.
+      if (!index_join_key_batches_.empty() || !hash_join_probe_batches_.empty()) {
+        ProbeJoinBatches(function, vpi);
+      }
       ScanVPI(ctx, function, vpi);
     }
   }
@@ -122,6 +122,10 @@ void StaticAggregationTranslator::DefineHelperFunctions(util::RegionVector<ast::
         auto rhs = GetAggregateTermPtr(local_aggs_.Get(codegen), term_idx);
         function.Append(codegen->AggregatorMerge(lhs, rhs));
       }
+      // The thread-local aggregates are not used after the merge, so release what they allocated.
+      for (auto agg_term_idx : GetAggPlan().GetMemoryAllocatingAggregatorIndexes()) {
+        function.Append(codegen->AggregatorFree(GetAggregateTermPtr(local_aggs_.Get(codegen), agg_term_idx)));
+      }
     }
     decls->push_back(function.Finish());
   }
@@ -221,7 +225,15 @@ void StaticAggregationTranslator::UpdateGlobalAggregate(WorkContext *ctx, Functi
     // Prepare for the advance aggregate call
     auto agg_payload_ptr = GetAggregateTermPtr(agg_payload.Get(codegen), term_idx);
     auto agg_val_ptr = GetAggregateTermPtr(codegen->MakeExpr(agg_values), term_idx);
-    auto agg_advance_call = codegen->AggregatorAdvance(agg_payload_ptr, agg_val_ptr);
+    ast::Expr *agg_advance_call;
+    if (agg_term->GetExpressionType() == parser::ExpressionType::AGGREGATE_APPROX_PERCENTILE) {
+      // var percentile = <percentile>
+      auto percentile = codegen->MakeFreshIdentifier("percentile");
+      function->Append(codegen->DeclareVarWithInit(percentile, ctx->DeriveValue(*agg_term->GetChild(1), this)));
+      agg_advance_call = codegen->AggregatorAdvance(agg_payload_ptr, agg_val_ptr, codegen->AddressOf(percentile));
+    } else {
+      agg_advance_call = codegen->AggregatorAdvance(agg_payload_ptr, agg_val_ptr);
+    }
 
     if (agg_term->IsDistinct()) {
       auto &filter = distinct_filters_.at(term_idx);
@@ -22,7 +22,6 @@ UpdateTranslator::UpdateTranslator(const planner::UpdatePlanNode &plan, Compilat
       table_schema_(GetCodeGen()->GetCatalogAccessor()->GetSchema(plan.GetTableOid())),
       all_oids_(CollectOids(table_schema_)),
       table_pm_(GetCodeGen()->GetCatalogAccessor()->GetTable(plan.GetTableOid())->ProjectionMapForOids(all_oids_)) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
   compilation_context->Prepare(*plan.GetChild(0), pipeline);
 
   for (const auto &clause : plan.GetSetClauses()) {
@@ -47,6 +46,11 @@ void UpdateTranslator::InitializePipelineState(const Pipeline &pipeline, Functio
   // col_oids[i] = ...
   // @storageInterfaceInit(&pipelineState.storageInterface, execCtx, table_oid, col_oids, true)
   DeclareUpdater(function);
+  if (pipeline.IsParallel()) {
+    // @storageInterfaceBeginWorker(&pipelineState.storageInterface)
+    auto *begin_worker = GetCodeGen()->StorageInterfaceBeginWorker(si_updater_.GetPtr(GetCodeGen()));
+    function->Append(GetCodeGen()->MakeStmt(begin_worker));
+  }
   CounterSet(function, num_updates_, 0);
 }
 
@@ -308,16 +308,11 @@ ast::FunctionDecl *Pipeline::GenerateRunPipelineFunction() const {
     builder.Append(codegen_->DeclareVarWithInit(state_var_, state));
 
     // Launch pipeline work.
-    if (IsParallel()) {
-      driver_->LaunchWork(&builder, GetWorkFunctionName());
-    } else {
-      // SerialWork(queryState, pipelineState)
+    if (!IsParallel()) {
       InjectStartResourceTracker(&builder, false);
       started_tracker = true;
-
-      builder.Append(
-          codegen_->Call(GetWorkFunctionName(), {builder.GetParameterByPosition(0), codegen_->MakeExpr(state_var_)}));
     }
+    LaunchWork(&builder);
 
     // TODO(abalakum): This shouldn't actually be dependent on order and the loop can be simplified
     // after issue #1154 is fixed
@@ -334,6 +329,16 @@ ast::FunctionDecl *Pipeline::GenerateRunPipelineFunction() const {
   return builder.Finish();
 }
 
+void Pipeline::LaunchWork(FunctionBuilder *function) const {
+  if (IsParallel()) {
+    driver_->LaunchWork(function, GetWorkFunctionName());
+  } else {
+    // SerialWork(queryState, pipelineState)
+    function->Append(
+        codegen_->Call(GetWorkFunctionName(), {function->GetParameterByPosition(0), codegen_->MakeExpr(state_var_)}));
+  }
+}
+
 ast::FunctionDecl *Pipeline::GenerateTearDownPipelineFunction() const {
   auto name = codegen_->MakeIdentifier(CreatePipelineFunctionName("TearDown"));
   FunctionBuilder builder(codegen_, name, compilation_context_->QueryParams(), codegen_->Nil());
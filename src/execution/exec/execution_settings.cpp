@@ -10,6 +10,12 @@ void ExecutionSettings::UpdateFromSettingsManager(common::ManagedPointer<setting
     number_of_parallel_execution_threads_ = settings->GetInt(settings::Param::num_parallel_execution_threads);
     is_counters_enabled_ = settings->GetBool(settings::Param::counters_enable);
     is_pipeline_metrics_enabled_ = settings->GetBool(settings::Param::pipeline_metrics_enable);
+    query_memory_budget_ = settings->GetInt64(settings::Param::query_memory_budget);
+    is_radix_join_build_enabled_ = settings->GetBool(settings::Param::radix_join_build_enable);
+    is_index_join_key_sort_enabled_ = settings->GetBool(settings::Param::index_join_sort_keys_enable);
+    index_join_hash_switch_probes_per_block_ =
+        settings->GetInt(settings::Param::index_join_hash_switch_probes_per_block);
+    index_join_hash_table_max_size_ = settings->GetInt64(settings::Param::index_join_hash_table_max_size);
   }
 }
 
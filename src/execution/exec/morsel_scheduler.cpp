@@ -0,0 +1,340 @@
+#include "execution/exec/morsel_scheduler.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "common/constants.h"
+#include "common/spin_latch.h"
+#include "execution/util/cpu_info.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::exec {
+
+namespace {
+
+// The charge of a morsel of a query with priority 1. Queries with priority p are charged 1/p of it.
+constexpr uint64_t STRIDE = uint64_t{1} << 20;
+
+// The ID of threads that are not workers of a scheduler.
+constexpr uint32_t NO_WORKER = std::numeric_limits<uint32_t>::max();
+
+// The ID of the worker the current thread is, if it is one.
+thread_local uint32_t current_worker_id = NO_WORKER;
+
+// The CPUs of each NUMA node of the machine, empty if the topology cannot be determined.
+std::vector<std::vector<uint32_t>> ReadNumaNodeCpus() {
+  std::vector<std::vector<uint32_t>> nodes;
+#ifdef __linux__
+  for (uint32_t node = 0;; node++) {
+    std::ifstream cpulist(fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+    std::string ranges;
+    if (!std::getline(cpulist, ranges)) {
+      break;
+    }
+    // The list is a comma-separated list of CPUs and CPU ranges, e.g., "0-3,8-11".
+    auto &cpus = nodes.emplace_back();
+    std::istringstream stream(ranges);
+    for (std::string range; std::getline(stream, range, ',');) {
+      const auto dash = range.find('-');
+      const auto first = static_cast<uint32_t>(std::stoul(range.substr(0, dash)));
+      const auto last = dash == std::string::npos ? first : static_cast<uint32_t>(std::stoul(range.substr(dash + 1)));
+      for (uint32_t cpu = first; cpu <= last; cpu++) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  return nodes;
+}
+
+}  // namespace
+
+struct MorselScheduler::Job {
+  // A range of work.
+  struct Morsel {
+    std::size_t begin_;
+    std::size_t end_;
+  };
+
+  // The morsels of one worker. Padded to a cache line so that workers don't contend on neighbours.
+  struct alignas(common::Constants::CACHELINE_SIZE) Queue {
+    common::SpinLatch latch_;
+    std::deque<Morsel> morsels_;
+  };
+
+  Job(const QueryOptions &options, const MorselFn &fn, const uint32_t num_workers)
+      : fn_(fn),
+        stride_(STRIDE / options.priority_),
+        max_parallelism_(options.max_parallelism_),
+        queues_(num_workers) {}
+
+  // The function to execute for each morsel.
+  const MorselFn &fn_;
+  // The charge of each morsel executed by a worker.
+  const uint64_t stride_;
+  // The maximum number of threads working on the job at once, zero for no limit.
+  const uint32_t max_parallelism_;
+  // The morsels not claimed yet, by the worker they are assigned to.
+  std::vector<Queue> queues_;
+  // The number of morsels not claimed yet.
+  std::atomic<std::size_t> unclaimed_{0};
+  // The number of threads working on the job. The submitting thread counts as one until it leaves.
+  std::atomic<uint32_t> active_{1};
+  // The total charge of the job.
+  std::atomic<uint64_t> pass_{0};
+
+  // Protects the error and signals the submitting thread when the last thread left the job.
+  std::mutex done_mutex_;
+  std::condition_variable done_;
+  // Whether a morsel threw, and the first exception thrown.
+  std::atomic<bool> failed_{false};
+  std::exception_ptr error_;
+};
+
+MorselScheduler *MorselScheduler::Instance() {
+  static MorselScheduler scheduler(std::max(CpuInfo::Instance()->GetNumLogicalCores(), 1u));
+  return &scheduler;
+}
+
+MorselScheduler::MorselScheduler(const uint32_t num_workers) {
+  NOISEPAGE_ASSERT(num_workers > 0, "The scheduler needs at least one worker");
+
+  // Spread the workers evenly over the NUMA nodes, numbering them node by node.
+  const auto node_cpus = ReadNumaNodeCpus();
+  num_nodes_ = std::max(static_cast<uint32_t>(node_cpus.size()), 1u);
+  worker_nodes_.resize(num_workers);
+  for (uint32_t worker = 0; worker < num_workers; worker++) {
+    worker_nodes_[worker] = static_cast<uint64_t>(worker) * num_nodes_ / num_workers;
+  }
+
+  // Workers steal from the workers of their own node first, then from the remote ones.
+  steal_orders_.resize(num_workers);
+  for (uint32_t worker = 0; worker < num_workers; worker++) {
+    auto &order = steal_orders_[worker];
+    for (const bool local : {true, false}) {
+      for (uint32_t i = 1; i < num_workers; i++) {
+        const uint32_t victim = (worker + i) % num_workers;
+        if ((worker_nodes_[victim] == worker_nodes_[worker]) == local) {
+          order.push_back(victim);
+        }
+      }
+    }
+  }
+
+  workers_.reserve(num_workers);
+  for (uint32_t worker = 0; worker < num_workers; worker++) {
+    workers_.emplace_back([this, worker] { WorkerLoop(worker); });
+#ifdef __linux__
+    // Keep each worker on the CPUs of its node so that the morsels assigned to it stay local.
+    if (num_nodes_ > 1) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      for (const uint32_t cpu : node_cpus[worker_nodes_[worker]]) {
+        CPU_SET(cpu, &cpu_set);
+      }
+      pthread_setaffinity_np(workers_.back().native_handle(), sizeof(cpu_set), &cpu_set);
+    }
+#endif
+  }
+}
+
+MorselScheduler::~MorselScheduler() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    NOISEPAGE_ASSERT(jobs_.empty(), "Scheduler destroyed while jobs are running");
+    shutdown_ = true;
+  }
+  work_available_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void MorselScheduler::ParallelFor(const QueryOptions &options, const std::size_t begin, const std::size_t end,
+                                  const std::size_t grain_size, const MorselFn &fn) {
+  NOISEPAGE_ASSERT(grain_size > 0, "Morsels must not be empty");
+  NOISEPAGE_ASSERT(options.priority_ > 0, "Query priorities must be positive");
+
+  if (begin >= end) {
+    return;
+  }
+
+  // A single morsel isn't worth waking up any workers for.
+  const std::size_t num_morsels = (end - begin + grain_size - 1) / grain_size;
+  if (num_morsels == 1) {
+    fn(begin, end);
+    return;
+  }
+
+  // Assign consecutive morsels to the same worker, so each worker, and each node, starts out with a
+  // contiguous part of the range.
+  const uint32_t num_workers = GetNumWorkers();
+  Job job(options, fn, num_workers);
+  for (std::size_t idx = 0; idx < num_morsels; idx++) {
+    const std::size_t morsel_begin = begin + idx * grain_size;
+    job.queues_[idx * num_workers / num_morsels].morsels_.push_back(
+        {morsel_begin, std::min(end, morsel_begin + grain_size)});
+  }
+  job.unclaimed_ = num_morsels;
+
+  job.pass_ = virtual_time_.load();
+  {
+    common::SharedLatch::ScopedExclusiveLatch guard(&jobs_latch_);
+    jobs_.push_back(&job);
+  }
+  // Sleeping workers check for jobs while holding the mutex, so taking it here makes sure that none of
+  // them misses the wakeup.
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+  }
+  if (num_morsels >= num_workers) {
+    work_available_.notify_all();
+  } else {
+    for (std::size_t i = 0; i < num_morsels; i++) {
+      work_available_.notify_one();
+    }
+  }
+
+  // Help out until every morsel has been claimed. Once the job is no longer listed no worker can join
+  // it, so only the workers that are still executing its morsels have to be waited for.
+  while (RunMorsel(&job, current_worker_id)) {
+  }
+  {
+    common::SharedLatch::ScopedExclusiveLatch guard(&jobs_latch_);
+    jobs_.remove(&job);
+  }
+  LeaveJob(&job);
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(job.done_mutex_);
+    job.done_.wait(lock, [&] { return job.active_ == 0; });
+    error = job.error_;
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+void MorselScheduler::WorkerLoop(const uint32_t worker_id) {
+  current_worker_id = worker_id;
+  while (true) {
+    // Only go to sleep, and take the mutex, once there is nothing left to do.
+    Job *job = PickJob();
+    if (job == nullptr) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_available_.wait(lock, [&] { return shutdown_ || (job = PickJob()) != nullptr; });
+      if (job == nullptr) {
+        return;
+      }
+    }
+    // Run a single morsel before picking again so that every morsel goes to the job due next.
+    RunMorsel(job, worker_id);
+    LeaveJob(job);
+  }
+}
+
+MorselScheduler::Job *MorselScheduler::PickJob() {
+  common::SharedLatch::ScopedSharedLatch guard(&jobs_latch_);
+  while (true) {
+    Job *next = nullptr;
+    uint64_t next_pass = 0;
+    for (Job *job : jobs_) {
+      if (job->unclaimed_ == 0 || (job->max_parallelism_ != 0 && job->active_ >= job->max_parallelism_)) {
+        continue;
+      }
+      const uint64_t pass = job->pass_.load(std::memory_order_relaxed);
+      if (next == nullptr || pass < next_pass) {
+        next = job;
+        next_pass = pass;
+      }
+    }
+    if (next == nullptr) {
+      return nullptr;
+    }
+
+    // Other workers may have joined the job in the meantime, so only join it while it's below its
+    // limit. Look for the next best job otherwise.
+    uint32_t active = next->active_.load();
+    bool joined = false;
+    while (!joined && (next->max_parallelism_ == 0 || active < next->max_parallelism_)) {
+      joined = next->active_.compare_exchange_weak(active, active + 1);
+    }
+    if (!joined) {
+      continue;
+    }
+
+    virtual_time_.store(next->pass_.fetch_add(next->stride_, std::memory_order_relaxed), std::memory_order_relaxed);
+    return next;
+  }
+}
+
+bool MorselScheduler::RunMorsel(Job *const job, const uint32_t worker_id) {
+  Job::Morsel morsel{};
+  const auto try_claim = [&](Job::Queue *queue, const bool front) {
+    common::SpinLatch::ScopedSpinLatch guard(&queue->latch_);
+    if (queue->morsels_.empty()) {
+      return false;
+    }
+    if (front) {
+      morsel = queue->morsels_.front();
+      queue->morsels_.pop_front();
+    } else {
+      morsel = queue->morsels_.back();
+      queue->morsels_.pop_back();
+    }
+    return true;
+  };
+
+  // Take the next morsel of our own queue, or steal the last morsel of another one. Threads that are
+  // not workers of this scheduler have no queue and can only steal.
+  bool claimed = false;
+  if (worker_id < job->queues_.size()) {
+    claimed = try_claim(&job->queues_[worker_id], true);
+    for (auto iter = steal_orders_[worker_id].begin(); !claimed && iter != steal_orders_[worker_id].end(); ++iter) {
+      claimed = try_claim(&job->queues_[*iter], false);
+    }
+  } else {
+    for (auto iter = job->queues_.rbegin(); !claimed && iter != job->queues_.rend(); ++iter) {
+      claimed = try_claim(&*iter, false);
+    }
+  }
+  if (!claimed) {
+    return false;
+  }
+  job->unclaimed_--;
+
+  // Once a morsel failed, the remaining ones are only drained.
+  if (!job->failed_) {
+    try {
+      job->fn_(morsel.begin_, morsel.end_);
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(job->done_mutex_);
+      if (!job->failed_.exchange(true)) {
+        job->error_ = std::current_exception();
+      }
+    }
+  }
+  return true;
+}
+
+void MorselScheduler::LeaveJob(Job *const job) {
+  std::lock_guard<std::mutex> guard(job->done_mutex_);
+  if (--job->active_ == 0) {
+    job->done_.notify_all();
+  }
+}
+
+}  // namespace noisepage::execution::exec
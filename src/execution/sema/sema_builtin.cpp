@@ -568,7 +568,7 @@ void Sema::CheckBuiltinAggregatorCall(ast::CallExpr *call, ast::Builtin builtin)
       break;
     }
     case ast::Builtin::AggAdvance: {
-      if (!CheckArgCount(call, 2)) {
+      if (!CheckArgCountBetween(call, 2, 3)) {
         return;
       }
       // First argument to @aggAdvance() must be a SQL aggregator, second must be a SQL value
@@ -580,6 +580,16 @@ void Sema::CheckBuiltinAggregatorCall(ast::CallExpr *call, ast::Builtin builtin)
         GetErrorReporter()->Report(call->Position(), ErrorMessages::kNotASQLAggregate, args[1]->GetType());
         return;
       }
+      // Approximate percentiles, and only those, take the percentile to compute as a third argument
+      const auto percentile_agg_kind = ast::BuiltinType::ApproxPercentileAggregate;
+      const bool is_percentile_agg = IsPointerToSpecificBuiltin(args[0]->GetType(), percentile_agg_kind);
+      if (!CheckArgCount(call, is_percentile_agg ? 3 : 2)) {
+        return;
+      }
+      if (is_percentile_agg && !IsPointerToSpecificBuiltin(args[2]->GetType(), ast::BuiltinType::Real)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Real)->PointerTo());
+        return;
+      }
       // Advance returns nil
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
@@ -634,12 +644,20 @@ void Sema::CheckBuiltinAggregatorCall(ast::CallExpr *call, ast::Builtin builtin)
         case ast::BuiltinType::Kind::IntegerMaxAggregate:
         case ast::BuiltinType::Kind::IntegerMinAggregate:
         case ast::BuiltinType::Kind::IntegerSumAggregate:
+        case ast::BuiltinType::Kind::BooleanApproxCountDistinctAggregate:
+        case ast::BuiltinType::Kind::IntegerApproxCountDistinctAggregate:
+        case ast::BuiltinType::Kind::RealApproxCountDistinctAggregate:
+        case ast::BuiltinType::Kind::DecimalApproxCountDistinctAggregate:
+        case ast::BuiltinType::Kind::StringApproxCountDistinctAggregate:
+        case ast::BuiltinType::Kind::DateApproxCountDistinctAggregate:
+        case ast::BuiltinType::Kind::TimestampApproxCountDistinctAggregate:
           call->SetType(GetBuiltinType(ast::BuiltinType::Integer));
           break;
         case ast::BuiltinType::Kind::RealMaxAggregate:
         case ast::BuiltinType::Kind::RealMinAggregate:
         case ast::BuiltinType::Kind::RealSumAggregate:
         case ast::BuiltinType::Kind::AvgAggregate:
+        case ast::BuiltinType::Kind::ApproxPercentileAggregate:
           call->SetType(GetBuiltinType(ast::BuiltinType::Real));
           break;
         case ast::BuiltinType::Kind::StringMaxAggregate:
@@ -763,7 +781,8 @@ void Sema::CheckBuiltinJoinHashTableBuild(ast::CallExpr *call, ast::Builtin buil
     case ast::Builtin::JoinHashTableBuild: {
       break;
     }
-    case ast::Builtin::JoinHashTableBuildParallel: {
+    case ast::Builtin::JoinHashTableBuildParallel:
+    case ast::Builtin::JoinHashTableBuildPartitioned: {
       if (!CheckArgCount(call, 3)) {
         return;
       }
@@ -820,6 +839,93 @@ void Sema::CheckBuiltinJoinHashTableLookup(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::HashTableEntryIterator));
 }
 
+void Sema::CheckBuiltinJoinHashTableSpillCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+
+  // The first argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableEnableSpilling: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableIsResident: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a 64-bit unsigned hash value
+      if (!call_args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextPass: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table spill call");
+    }
+  }
+}
+
+void Sema::CheckBuiltinJoinHashTableBloomFilterCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+
+  // The first argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableEnableBloomFilter: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableMayContain: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a 64-bit unsigned hash value
+      if (!call_args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table bloom filter call");
+    }
+  }
+}
+
 void Sema::CheckBuiltinJoinHashTableFree(ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -865,6 +971,72 @@ void Sema::CheckBuiltinHashTableEntryIterCall(ast::CallExpr *call, ast::Builtin
   }
 }
 
+void Sema::CheckBuiltinJoinHashTableBatchProbeCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first argument must be a pointer to a JoinHashTableBatchProbe
+  const auto probe_kind = ast::BuiltinType::JoinHashTableBatchProbe;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), probe_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(probe_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableBatchProbeInit:
+    case ast::Builtin::JoinHashTableBatchProbeFree: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      break;
+    }
+    case ast::Builtin::JoinHashTableBatchProbeAddHash: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a 64-bit unsigned hash value
+      if (!args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      break;
+    }
+    case ast::Builtin::JoinHashTableBatchProbeLookup: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a pointer to the JoinHashTable to probe
+      const auto jht_kind = ast::BuiltinType::JoinHashTable;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), jht_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(jht_kind)->PointerTo());
+        return;
+      }
+      break;
+    }
+    case ast::Builtin::JoinHashTableBatchProbeNext: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a pointer to the HashTableEntryIterator to position
+      const auto iter_kind = ast::BuiltinType::HashTableEntryIterator;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), iter_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(iter_kind)->PointerTo());
+        return;
+      }
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table batch probe call");
+    }
+  }
+
+  // None of the calls return anything
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckBuiltinJoinHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin) {
   if (!CheckArgCountAtLeast(call, 1)) {
     return;
@@ -1318,6 +1490,27 @@ void Sema::CheckBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin)
       call->SetType(GetBuiltinType(vpi_kind)->PointerTo());
       break;
     }
+    case ast::Builtin::TableIterAddRangeFilter: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // The second argument is the column index, the third and fourth are the bounds of the range
+      ast::Type *uint_type = GetBuiltinType(ast::BuiltinType::Uint32);
+      ast::Type *int64_type = GetBuiltinType(ast::BuiltinType::Int64);
+      for (uint32_t arg_idx = 1; arg_idx < 4; arg_idx++) {
+        ast::Type *expected_type = arg_idx == 1 ? uint_type : int64_type;
+        if (!call_args[arg_idx]->GetType()->IsIntegerType()) {
+          ReportIncorrectCallArg(call, arg_idx, expected_type);
+          return;
+        }
+        if (call_args[arg_idx]->GetType() != expected_type) {
+          auto *cast = ImplCastExprToType(call_args[arg_idx], expected_type, ast::CastKind::IntegralCast);
+          call->SetArgument(arg_idx, cast);
+        }
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::TableIterClose: {
       // A single-arg builtin returning void
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
@@ -2421,10 +2614,21 @@ void Sema::CheckBuiltinIndexIteratorScan(execution::ast::CallExpr *call, ast::Bu
 
   switch (builtin) {
     case ast::Builtin::IndexIteratorScanKey:
-    case ast::Builtin::IndexIteratorScanDescending: {
+    case ast::Builtin::IndexIteratorScanDescending:
+    case ast::Builtin::IndexIteratorAddBatchKey:
+    case ast::Builtin::IndexIteratorNextBatchKey: {
       if (!CheckArgCount(call, 1)) return;
       break;
     }
+    case ast::Builtin::IndexIteratorScanKeyBatch: {
+      if (!CheckArgCount(call, 2)) return;
+      // Second argument is a boolean
+      if (!call->Arguments()[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Bool)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Bool));
+        return;
+      }
+      break;
+    }
     case ast::Builtin::IndexIteratorScanAscending: {
       if (!CheckArgCount(call, 3)) return;
       break;
@@ -2809,6 +3013,7 @@ void Sema::CheckBuiltinStorageInterfaceCall(ast::CallExpr *call, ast::Builtin bu
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::StorageInterfaceBeginWorker:
     case ast::Builtin::StorageInterfaceFree: {
       if (!CheckArgCount(call, 1)) {
         return;
@@ -3338,6 +3543,7 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterGetVPINumTuples:
     case ast::Builtin::TableIterGetVPI:
+    case ast::Builtin::TableIterAddRangeFilter:
     case ast::Builtin::TableIterClose: {
       CheckBuiltinTableIterCall(call, builtin);
       break;
@@ -3478,7 +3684,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       break;
     }
     case ast::Builtin::JoinHashTableBuild:
-    case ast::Builtin::JoinHashTableBuildParallel: {
+    case ast::Builtin::JoinHashTableBuildParallel:
+    case ast::Builtin::JoinHashTableBuildPartitioned: {
       CheckBuiltinJoinHashTableBuild(call, builtin);
       break;
     }
@@ -3486,6 +3693,17 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinJoinHashTableLookup(call);
       break;
     }
+    case ast::Builtin::JoinHashTableEnableSpilling:
+    case ast::Builtin::JoinHashTableIsResident:
+    case ast::Builtin::JoinHashTableNextPass: {
+      CheckBuiltinJoinHashTableSpillCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::JoinHashTableEnableBloomFilter:
+    case ast::Builtin::JoinHashTableMayContain: {
+      CheckBuiltinJoinHashTableBloomFilterCall(call, builtin);
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       CheckBuiltinJoinHashTableFree(call);
       break;
@@ -3495,6 +3713,14 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinHashTableEntryIterCall(call, builtin);
       break;
     }
+    case ast::Builtin::JoinHashTableBatchProbeInit:
+    case ast::Builtin::JoinHashTableBatchProbeAddHash:
+    case ast::Builtin::JoinHashTableBatchProbeLookup:
+    case ast::Builtin::JoinHashTableBatchProbeNext:
+    case ast::Builtin::JoinHashTableBatchProbeFree: {
+      CheckBuiltinJoinHashTableBatchProbeCall(call, builtin);
+      break;
+    }
     case ast::Builtin::JoinHashTableIterInit:
     case ast::Builtin::JoinHashTableIterHasNext:
     case ast::Builtin::JoinHashTableIterNext:
@@ -3554,7 +3780,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorScanKey:
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
-    case ast::Builtin::IndexIteratorScanLimitDescending: {
+    case ast::Builtin::IndexIteratorScanLimitDescending:
+    case ast::Builtin::IndexIteratorAddBatchKey:
+    case ast::Builtin::IndexIteratorScanKeyBatch:
+    case ast::Builtin::IndexIteratorNextBatchKey: {
       CheckBuiltinIndexIteratorScan(call, builtin);
       break;
     }
@@ -3628,6 +3857,7 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       break;
     }
     case ast::Builtin::StorageInterfaceInit:
+    case ast::Builtin::StorageInterfaceBeginWorker:
     case ast::Builtin::GetTablePR:
     case ast::Builtin::StorageInterfaceGetIndexHeapSize:
     case ast::Builtin::TableInsert:
@@ -1,11 +1,9 @@
 #include "execution/sql/aggregation_hash_table.h"
 
-#include <tbb/parallel_for_each.h>
-#include <tbb/task_scheduler_init.h>
-
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <memory>
-#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -13,8 +11,11 @@
 #include "common/math_util.h"
 #include "count/hll.h"
 #include "execution/exec/execution_context.h"
+#include "execution/exec/morsel_scheduler.h"
 #include "execution/sql/constant_vector.h"
 #include "execution/sql/generic_value.h"
+#include "execution/sql/memory_tracker.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql/vector_operations/unary_operation_executor.h"
 #include "execution/sql/vector_operations/vector_operations.h"
@@ -167,7 +168,11 @@ AggregationHashTable::AggregationHashTable(const exec::ExecutionSettings &exec_s
       partition_tails_(nullptr),
       partition_estimates_(nullptr),
       partition_tables_(nullptr),
-      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)) {
+      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)),
+      spill_pending_(false),
+      preagg_bypass_(false),
+      preagg_num_input_(0),
+      preagg_num_bypassed_(0) {
   hash_table_.SetSize(initial_size, memory_->GetTracker());
   max_fill_ = std::llround(hash_table_.GetCapacity() * hash_table_.GetLoadFactor());
 
@@ -285,23 +290,163 @@ void AggregationHashTable::FlushToOverflowPartitions() {
   // hash values using a bijective hash scrambling before feeding them to the
   // estimator.
 
-  hash_table_.FlushEntries([this](HashTableEntry *entry) {
-    const uint64_t partition_idx = (entry->hash_ >> partition_shift_bits_);
-    entry->next_ = partition_heads_[partition_idx];
-    partition_heads_[partition_idx] = entry;
-    if (UNLIKELY(partition_tails_[partition_idx] == nullptr)) {
-      partition_tails_[partition_idx] = entry;
-    }
-    partition_estimates_[partition_idx]->Update(common::HashUtil::ScrambleHash(entry->hash_));
-  });
+  hash_table_.FlushEntries([this](HashTableEntry *entry) { AddToOverflowPartition(entry); });
+  preagg_num_input_ = 0;
 
   // Update stats
   stats_.num_flushes_++;
+
+  // If the query is over its memory budget, the partitions we just filled are
+  // the coldest data we have. Request that they be spilled.
+  auto tracker = memory_->GetTracker();
+  spill_pending_ = owned_entries_.empty() && tracker != nullptr && tracker->IsOverBudget();
+}
+
+void AggregationHashTable::AddToOverflowPartition(HashTableEntry *entry) {
+  const uint64_t partition_idx = (entry->hash_ >> partition_shift_bits_);
+  entry->next_ = partition_heads_[partition_idx];
+  partition_heads_[partition_idx] = entry;
+  if (UNLIKELY(partition_tails_[partition_idx] == nullptr)) {
+    partition_tails_[partition_idx] = entry;
+  }
+  partition_estimates_[partition_idx]->Update(common::HashUtil::ScrambleHash(entry->hash_));
+}
+
+void AggregationHashTable::UpdatePreAggregationBypass() {
+  // Every input tuple either found its group or created one. When nearly every
+  // tuple creates a group, probing the main table only delays the inevitable
+  // merge of the partitions. The partitions absorb the groups directly instead.
+  const auto num_groups = static_cast<float>(GetTupleCount());
+  if (num_groups > static_cast<float>(preagg_num_input_) * (1.0f - PREAGG_MIN_HIT_RATE)) {
+    preagg_bypass_ = true;
+    preagg_num_bypassed_ = 0;
+  }
+}
+
+HashTableEntry *AggregationHashTable::AllocateEntryBypassed(const hash_t hash) {
+  auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
+  entry->hash_ = hash;
+  AddToOverflowPartition(entry);
+  stats_.num_bypassed_++;
+
+  // Without flushes, the memory budget and the hit rate are checked whenever
+  // a flush threshold worth of groups has been inserted.
+  if (++preagg_num_bypassed_ % flush_threshold_ == 0) {
+    auto tracker = memory_->GetTracker();
+    spill_pending_ = owned_entries_.empty() && tracker != nullptr && tracker->IsOverBudget();
+    if (preagg_num_bypassed_ >= flush_threshold_ * PREAGG_BYPASS_RESAMPLE_INTERVAL) {
+      preagg_bypass_ = false;
+      preagg_num_input_ = 0;
+    }
+  }
+
+  return entry;
+}
+
+void AggregationHashTable::SpillOverflowPartitions() {
+  NOISEPAGE_ASSERT(owned_entries_.empty(), "Only tables owning all their entries can spill");
+
+  spill_pending_ = false;
+
+  // Drain the main hash table so that every entry lives in an overflow
+  // partition. After this, the memory in 'entries_' is referenced only by the
+  // overflow partition chains.
+  if (GetTupleCount() > 0) {
+    FlushToOverflowPartitions();
+    spill_pending_ = false;
+  }
+
+  if (spill_files_.empty()) {
+    spill_files_.emplace_back(std::make_unique<SpillFile>());
+    partition_spills_.resize(DEFAULT_NUM_PARTITIONS);
+  }
+
+  // Write each partition's chain as a single contiguous run.
+  SpillFile *file = spill_files_.front().get();
+  const std::size_t entry_size = entries_.ElementSize();
+  std::vector<byte> buffer;
+  for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+    if (partition_heads_[part_idx] == nullptr) {
+      continue;
+    }
+    buffer.clear();
+    uint64_t num_entries = 0;
+    for (const HashTableEntry *entry = partition_heads_[part_idx]; entry != nullptr; entry = entry->next_) {
+      const auto *raw_entry = reinterpret_cast<const byte *>(entry);
+      buffer.insert(buffer.end(), raw_entry, raw_entry + entry_size);
+      num_entries++;
+    }
+    const std::size_t offset = file->Append(buffer.data(), buffer.size());
+    partition_spills_[part_idx].push_back(SpilledRun{file, offset, num_entries});
+    partition_heads_[part_idx] = partition_tails_[part_idx] = nullptr;
+    stats_.num_spilled_entries_ += num_entries;
+  }
+
+  // Every entry is on disk now. Recycle the entry memory for new insertions;
+  // the chunks are retained, so the table's footprint stops growing.
+  entries_.clear();
+
+  // Update stats
+  stats_.num_spills_++;
+
+  EXECUTION_LOG_TRACE("Spilled overflow partitions: spills = {}, total entries spilled = {}, spill file size = {}",
+                      stats_.num_spills_, stats_.num_spilled_entries_, file->GetSize());
+}
+
+void AggregationHashTable::MergeSpilledPartition(const uint32_t part_idx, AggregationHashTable *target,
+                                                 void *query_state, const MergePartitionFn merge_func) const {
+  // Read back spilled entries in batches of roughly one vector's worth. The
+  // merging function is allowed to link entries directly into the target, so
+  // entries are copied into memory owned by the target table.
+  constexpr uint64_t batch_size = common::Constants::K_DEFAULT_VECTOR_SIZE;
+  const std::size_t entry_size = entries_.ElementSize();
+  std::vector<byte> buffer(batch_size * entry_size);
+  auto &target_entries = target->owned_entries_.emplace_back(entry_size, MemoryPoolAllocator<byte>(target->memory_));
+
+  for (const SpilledRun &run : partition_spills_[part_idx]) {
+    for (uint64_t read = 0; read < run.num_entries_;) {
+      const uint64_t num_entries = std::min(batch_size, run.num_entries_ - read);
+      run.file_->Read(run.offset_ + read * entry_size, buffer.data(), num_entries * entry_size);
+
+      // Materialize and chain the batch.
+      HashTableEntry *head = nullptr;
+      for (uint64_t i = 0; i < num_entries; i++) {
+        auto *entry = reinterpret_cast<HashTableEntry *>(target_entries.Append());
+        std::memcpy(reinterpret_cast<byte *>(entry), buffer.data() + i * entry_size, entry_size);
+        entry->next_ = head;
+        head = entry;
+      }
+
+      // Merge.
+      AHTOverflowPartitionIterator iter(&head, &head + 1);
+      merge_func(query_state, target, &iter);
+
+      read += num_entries;
+    }
+  }
+}
+
+void AggregationHashTable::ReleaseTableOverPartition(const uint32_t part_idx) {
+  if (partition_tables_[part_idx] != nullptr) {
+    partition_tables_[part_idx]->~AggregationHashTable();
+    memory_->Deallocate(partition_tables_[part_idx], sizeof(AggregationHashTable));
+    partition_tables_[part_idx] = nullptr;
+  }
 }
 
 byte *AggregationHashTable::AllocInputTuplePartitioned(hash_t hash) {
+  // Spill before allocating, so that the returned payload stays resident
+  // until the caller has written it.
+  if (UNLIKELY(spill_pending_)) {
+    SpillOverflowPartitions();
+  }
+  if (preagg_bypass_) {
+    stats_.num_inserts_++;
+    return AllocateEntryBypassed(hash)->payload_;
+  }
   byte *ret = AllocInputTuple(hash);
   if (NeedsToFlushToOverflowPartitions()) {
+    UpdatePreAggregationBypass();
     FlushToOverflowPartitions();
   }
   return ret;
@@ -444,7 +589,8 @@ void FixGrouping(AggregationHashTable::HashToGroupIdMap *groups, const Vector &h
 
 void AggregationHashTable::CreateMissingGroups(VectorProjectionIterator *input_batch,
                                                const std::vector<uint32_t> &key_indexes,
-                                               const AggregationHashTable::VectorInitAggFn init_agg_fn) {
+                                               const AggregationHashTable::VectorInitAggFn init_agg_fn,
+                                               const bool bypass_preagg) {
   // The groups-found list contains all tuples that found a matching group in
   // the aggregation hash table. Thus, the list of tuples that did not find a
   // match is the complement of the groups-found list.
@@ -465,7 +611,9 @@ void AggregationHashTable::CreateMissingGroups(VectorProjectionIterator *input_b
                 *batch_state_->Entries(),        // Entries
                 *key_vector,                     // Keys
                 batch_state_->KeyEqual(),        // The running list of tuples that found a match
-                [this](const hash_t hash) { return AllocateEntryInternal(hash); });
+                [this, bypass_preagg](const hash_t hash) {
+                  return bypass_preagg ? AllocateEntryBypassed(hash) : AllocateEntryInternal(hash);
+                });
   }
 
   // The key-not-equal list contains the list of all TIDs that did not find a
@@ -514,16 +662,22 @@ void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, c
   // Compute the hashes.
   ComputeHash(input_batch, key_indexes);
 
-  // Find groups.
-  FindGroups(input_batch, key_indexes);
+  // Find groups. If pre-aggregation is bypassed, the main hash table is empty
+  // and every tuple gets a new group, shared only within this batch.
+  const bool bypass_preagg = partitioned_aggregation && preagg_bypass_;
+  if (!bypass_preagg) {
+    preagg_num_input_ += input_batch->GetSelectedTupleCount();
+    FindGroups(input_batch, key_indexes);
+  }
 
   // Creating missing groups.
-  CreateMissingGroups(input_batch, key_indexes, init_agg_fn);
+  CreateMissingGroups(input_batch, key_indexes, init_agg_fn, bypass_preagg);
 
   // If the caller requested a partitioned aggregation, drain the main hash
   // table out to the overflow partitions, but only if needed.
   if (partitioned_aggregation) {
     if (NeedsToFlushToOverflowPartitions()) {
+      UpdatePreAggregationBypass();
       FlushToOverflowPartitions();
     }
   } else {
@@ -534,6 +688,12 @@ void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, c
 
   // Advance the aggregates for all tuples that found a match.
   AdvanceGroups(input_batch, advance_agg_fn);
+
+  // All aggregates in this batch have been updated. If the last flush pushed
+  // the query over its memory budget, it is now safe to spill.
+  if (partitioned_aggregation && spill_pending_) {
+    SpillOverflowPartitions();
+  }
 }
 
 void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thread_states, std::size_t agg_ht_offset,
@@ -587,6 +747,22 @@ void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thr
         partition_estimates_[part_idx]->Merge(table->partition_estimates_[part_idx]);
       }
     }
+
+    // Finally, take over the partition runs the table spilled to disk
+    if (!table->partition_spills_.empty()) {
+      if (partition_spills_.empty()) {
+        partition_spills_.resize(DEFAULT_NUM_PARTITIONS);
+      }
+      for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+        auto &runs = table->partition_spills_[part_idx];
+        partition_spills_[part_idx].insert(partition_spills_[part_idx].end(), runs.begin(), runs.end());
+      }
+      for (auto &file : table->spill_files_) {
+        spill_files_.emplace_back(std::move(file));
+      }
+      table->partition_spills_.clear();
+      table->spill_files_.clear();
+    }
   }
 
   exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(tl_agg_ht.size()));
@@ -595,8 +771,7 @@ void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thr
 AggregationHashTable *AggregationHashTable::GetOrBuildTableOverPartition(void *query_state,
                                                                          const uint32_t partition_idx) {
   NOISEPAGE_ASSERT(partition_idx < DEFAULT_NUM_PARTITIONS, "Out-of-bounds partition access");
-  NOISEPAGE_ASSERT(partition_heads_[partition_idx] != nullptr,
-                   "Should not build aggregation table over empty partition!");
+  NOISEPAGE_ASSERT(IsPartitionNonEmpty(partition_idx), "Should not build aggregation table over empty partition!");
   NOISEPAGE_ASSERT(merge_partition_fn_ != nullptr,
                    "Merging function was not provided! Did you forget to call TransferMemoryAndPartitions()?");
 
@@ -616,6 +791,9 @@ AggregationHashTable *AggregationHashTable::GetOrBuildTableOverPartition(void *q
   // Build it
   AHTOverflowPartitionIterator iter(partition_heads_ + partition_idx, partition_heads_ + partition_idx + 1);
   merge_partition_fn_(query_state, agg_table, &iter);
+  if (IsPartitionSpilled(partition_idx)) {
+    MergeSpilledPartition(partition_idx, agg_table, query_state, merge_partition_fn_);
+  }
 
   timer.Stop();
   EXECUTION_LOG_DEBUG("Overflow Partition {}: estimated size = {}, actual size = {}, build time = {:2f} ms",
@@ -635,11 +813,16 @@ void AggregationHashTable::ExecutePartitionedScan(void *query_state, Aggregation
 
   // Determine the non-empty overflow partitions.
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (IsPartitionNonEmpty(part_idx)) {
       // Get or build the table on the partition.
       auto agg_table_partition = GetOrBuildTableOverPartition(query_state, part_idx);
       // Scan the partition.
       scan_fn(query_state, nullptr, agg_table_partition);
+      // Partitions read back from disk are released immediately so that only
+      // one of them is resident at a time.
+      if (IsPartitionSpilled(part_idx)) {
+        ReleaseTableOverPartition(part_idx);
+      }
     }
   }
 }
@@ -662,7 +845,7 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t i = 0; i < DEFAULT_NUM_PARTITIONS; i++) {
-    if (partition_heads_[i] != nullptr) {
+    if (IsPartitionNonEmpty(i)) {
       nonempty_parts.push_back(i);
     }
   }
@@ -670,12 +853,14 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
   util::Timer<std::milli> timer;
   timer.Start();
 
-  size_t num_threads = tbb::task_scheduler_init::default_num_threads();
+  auto *scheduler = exec::MorselScheduler::Instance();
+  size_t num_threads = scheduler->GetNumWorkers();
   size_t num_tasks = nonempty_parts.size();
   size_t concurrent_estimate = std::min(num_threads, num_tasks);
   exec_ctx_->SetNumConcurrentEstimate(concurrent_estimate);
 
-  tbb::parallel_for_each(nonempty_parts, [&](const uint32_t part_idx) {
+  std::atomic<uint64_t> tuple_count{0};
+  scheduler->ParallelForEach(exec_ctx_->GetSchedulingOptions(), nonempty_parts, [&](const uint32_t part_idx) {
     // TODO(wz2): Resource trackers are started and stopped within scan_fn. It might be more correct
     // to start the trackers here manually -- or have TransferMemoryAndPartitions build all the tables
     // over each partition (but that would require storing the agg table pointers).
@@ -688,18 +873,20 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
 
     // Scan the partition
     scan_fn(query_state, thread_state, agg_table_partition);
+    tuple_count += agg_table_partition->GetTupleCount();
+
+    // Partitions read back from disk are released as soon as they're scanned
+    if (IsPartitionSpilled(part_idx)) {
+      ReleaseTableOverPartition(part_idx);
+    }
   });
 
   exec_ctx_->SetNumConcurrentEstimate(0);
   timer.Stop();
 
-  const uint64_t tuple_count =
-      std::accumulate(nonempty_parts.begin(), nonempty_parts.end(), uint64_t{0},
-                      [&](const auto curr, const auto idx) { return curr + partition_tables_[idx]->GetTupleCount(); });
-
-  UNUSED_ATTRIBUTE double tps = (tuple_count / timer.GetElapsed()) / 1000.0;
+  UNUSED_ATTRIBUTE double tps = (tuple_count.load() / timer.GetElapsed()) / 1000.0;
   EXECUTION_LOG_TRACE("Built and scanned {} tables totalling {} tuples in {:.2f} ms ({:.2f} mtps)",
-                      nonempty_parts.size(), tuple_count, timer.GetElapsed(), tps);
+                      nonempty_parts.size(), tuple_count.load(), timer.GetElapsed(), tps);
 }
 
 void AggregationHashTable::BuildAllPartitions(void *query_state) {
@@ -710,14 +897,15 @@ void AggregationHashTable::BuildAllPartitions(void *query_state) {
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (IsPartitionNonEmpty(part_idx)) {
       nonempty_parts.push_back(part_idx);
     }
   }
 
   // For each valid partition, build a hash table over its contents.
-  tbb::parallel_for_each(nonempty_parts,
-                         [&](const uint32_t part_idx) { GetOrBuildTableOverPartition(query_state, part_idx); });
+  exec::MorselScheduler::Instance()->ParallelForEach(
+      exec_ctx_->GetSchedulingOptions(), nonempty_parts,
+      [&](const uint32_t part_idx) { GetOrBuildTableOverPartition(query_state, part_idx); });
 }
 
 void AggregationHashTable::Repartition() {
@@ -731,7 +919,8 @@ void AggregationHashTable::Repartition() {
   }
 
   // First, flush all hash table partitions to their own overflow buckets.
-  tbb::parallel_for_each(nonempty_tables, [&](auto table) { table->FlushToOverflowPartitions(); });
+  exec::MorselScheduler::Instance()->ParallelForEach(exec_ctx_->GetSchedulingOptions(), nonempty_tables,
+                                                     [&](auto table) { table->FlushToOverflowPartitions(); });
 
   // Now, transfer each hash table partition's overflow buckets to us.
   for (auto *table : nonempty_tables) {
@@ -760,20 +949,24 @@ void AggregationHashTable::MergePartitions(AggregationHashTable *target, void *q
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (IsPartitionNonEmpty(part_idx)) {
       nonempty_parts.push_back(part_idx);
     }
   }
 
   // Merge overflow data into the appropriate partitioned table in the target.
-  tbb::parallel_for_each(nonempty_parts, [&](const uint32_t part_idx) {
-    // Get the partitioned hash table from the target.
-    auto agg_table_partition = target->GetOrBuildTableOverPartition(query_state, part_idx);
-
-    // Merge our overflow partition into target table.
-    AHTOverflowPartitionIterator iter(partition_heads_ + part_idx, partition_heads_ + part_idx + 1);
-    merge_func(query_state, agg_table_partition, &iter);
-  });
+  exec::MorselScheduler::Instance()->ParallelForEach(
+      exec_ctx_->GetSchedulingOptions(), nonempty_parts, [&](const uint32_t part_idx) {
+        // Get the partitioned hash table from the target.
+        auto agg_table_partition = target->GetOrBuildTableOverPartition(query_state, part_idx);
+
+        // Merge our overflow partition into target table.
+        AHTOverflowPartitionIterator iter(partition_heads_ + part_idx, partition_heads_ + part_idx + 1);
+        merge_func(query_state, agg_table_partition, &iter);
+        if (IsPartitionSpilled(part_idx)) {
+          MergeSpilledPartition(part_idx, agg_table_partition, query_state, merge_func);
+        }
+      });
 
   // Move our memory to the target.
   target->owned_entries_.emplace_back(std::move(entries_));
@@ -1,5 +1,6 @@
 #include "execution/sql/bloom_filter.h"
 
+#include <algorithm>
 #include <limits>
 #include <string>
 #include <vector>
@@ -24,11 +25,17 @@ BloomFilter::~BloomFilter() {
 }
 
 void BloomFilter::Init(MemoryPool *memory, uint32_t expected_num_elems) {
+  // Release the blocks of a previous initialization
+  if (blocks_ != nullptr) {
+    memory_->Deallocate(blocks_, GetNumBlocks() * sizeof(Block));
+  }
+
   memory_ = memory;
   lazily_added_hashes_ = MemPoolVector<hash_t>(memory_);
 
   uint64_t num_bits = common::MathUtil::PowerOf2Ceil(BITS_PER_ELEMENT * expected_num_elems);
-  uint64_t num_blocks = common::MathUtil::DivRoundUp(num_bits, sizeof(Block) * common::Constants::K_BITS_PER_BYTE);
+  uint64_t num_blocks = std::max(
+      uint64_t{1}, common::MathUtil::DivRoundUp(num_bits, sizeof(Block) * common::Constants::K_BITS_PER_BYTE));
   uint64_t num_bytes = num_blocks * sizeof(Block);
   blocks_ = reinterpret_cast<Block *>(memory->AllocateAligned(num_bytes, common::Constants::CACHELINE_SIZE, true));
 
@@ -23,6 +23,8 @@ void ConciseHashTable::SetSize(const uint32_t new_size, common::ManagedPointer<M
   slot_mask_ = capacity - 1;
   num_groups_ = capacity >> LOG_SLOTS_PER_GROUP;
   slot_groups_ = util::Memory::TrackMallocHugeArray<SlotGroup>(tracker, num_groups_, true);
+  num_overflow_ = 0;
+  built_ = false;
 }
 
 void ConciseHashTable::Build() {
@@ -1,7 +1,17 @@
 #include "execution/sql/index_iterator.h"
 
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <utility>
+
 #include "catalog/catalog_accessor.h"
+#include "common/hash_util.h"
+#include "common/math_util.h"
+#include "execution/sql/hash_table_entry.h"
+#include "execution/sql/join_hash_table.h"
 #include "execution/sql/value.h"
+#include "parser/expression/column_value_expression.h"
 #include "storage/sql_table.h"
 
 namespace noisepage::execution::sql {
@@ -11,8 +21,13 @@ IndexIterator::IndexIterator(exec::ExecutionContext *exec_ctx, uint32_t num_attr
     : exec_ctx_(exec_ctx),
       num_attrs_(num_attrs),
       col_oids_(col_oids, col_oids + num_oids),
-      index_(exec_ctx_->GetAccessor()->GetIndex(catalog::index_oid_t(index_oid))),
-      table_(exec_ctx_->GetAccessor()->GetTable(catalog::table_oid_t(table_oid))) {}
+      index_oid_(index_oid),
+      index_(exec_ctx_->GetAccessor()->GetIndex(index_oid_)),
+      table_(exec_ctx_->GetAccessor()->GetTable(catalog::table_oid_t(table_oid))) {
+  // The key columns are only resolved if the iterator ever switches to the hash table, see BuildHashTable().
+  const uint32_t probes_per_block = exec_ctx_->GetExecutionSettings().GetIndexJoinHashSwitchProbesPerBlock();
+  hash_switch_threshold_ = static_cast<uint64_t>(probes_per_block) * std::max(table_->GetNumBlocks(), 1u);
+}
 
 void IndexIterator::Init() {
   // Initialize projected rows for the index and the table
@@ -35,6 +50,11 @@ void IndexIterator::ScanKey() {
   // Scan the index
   tuples_.clear();
   curr_index_ = 0;
+  CountKeyLookups(1);
+  if (hash_table_ != nullptr) {
+    LookupHashTable(*index_pr_, &tuples_);
+    return;
+  }
   index_->ScanKey(*exec_ctx_->GetTxn(), *index_pr_, &tuples_);
 }
 
@@ -59,6 +79,42 @@ void IndexIterator::ScanLimitDescending(uint32_t limit) {
   index_->ScanLimitDescending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_, limit);
 }
 
+void IndexIterator::AddBatchKey() {
+  if (num_batch_keys_ == batch_keys_.size()) {
+    auto &index_pri = index_->GetProjectedRowInitializer();
+    void *buffer = exec_ctx_->GetMemoryPool()->AllocateAligned(index_pri.ProjectedRowSize(), alignof(uint64_t), false);
+    batch_keys_.push_back(index_pri.InitializeRow(buffer));
+  }
+  // Projected rows only hold offsets relative to themselves, so a plain copy is a valid row.
+  std::memcpy(batch_keys_[num_batch_keys_++], index_pr_, index_pr_->Size());
+}
+
+void IndexIterator::ScanKeyBatch(bool sort_keys) {
+  batch_tuples_.clear();
+  batch_key_ends_.clear();
+  next_batch_key_ = 0;
+  CountKeyLookups(num_batch_keys_);
+  if (hash_table_ != nullptr) {
+    for (uint32_t i = 0; i < num_batch_keys_; i++) {
+      LookupHashTable(*batch_keys_[i], &batch_tuples_);
+      batch_key_ends_.push_back(static_cast<uint32_t>(batch_tuples_.size()));
+    }
+    num_batch_keys_ = 0;
+    return;
+  }
+  index_->ScanKeyBatch(*exec_ctx_->GetTxn(), batch_keys_.data(), num_batch_keys_, sort_keys, &batch_tuples_,
+                       &batch_key_ends_);
+  num_batch_keys_ = 0;
+}
+
+void IndexIterator::NextBatchKey() {
+  NOISEPAGE_ASSERT(next_batch_key_ < batch_key_ends_.size(), "No more keys in the batch.");
+  const uint32_t begin = next_batch_key_ == 0 ? 0 : batch_key_ends_[next_batch_key_ - 1];
+  const uint32_t end = batch_key_ends_[next_batch_key_++];
+  tuples_.assign(batch_tuples_.begin() + begin, batch_tuples_.begin() + end);
+  curr_index_ = 0;
+}
+
 bool IndexIterator::Advance() {
   if (curr_index_ < tuples_.size()) {
     ++curr_index_;
@@ -67,6 +123,132 @@ bool IndexIterator::Advance() {
   return false;
 }
 
+void IndexIterator::CountKeyLookups(const uint32_t num_keys) {
+  if (hash_switch_threshold_ == 0 || hash_table_ != nullptr) {
+    return;
+  }
+  num_key_lookups_ += num_keys;
+  if (num_key_lookups_ > hash_switch_threshold_) {
+    // Whether or not the hash table can be built, the iterator only tries once.
+    hash_switch_threshold_ = 0;
+    BuildHashTable();
+  }
+}
+
+bool IndexIterator::ResolveKeyAttrs() {
+  // Exact-key lookups can only be answered from the table if every key column is a plain table column.
+  const auto &key_cols = exec_ctx_->GetAccessor()->GetIndexSchema(index_oid_).GetColumns();
+  std::vector<catalog::col_oid_t> key_col_oids;
+  for (const auto &col : key_cols) {
+    if (col.StoredExpression()->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+      return false;
+    }
+    key_col_oids.push_back(
+        col.StoredExpression().CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid());
+  }
+  if (std::set<catalog::col_oid_t>(key_col_oids.begin(), key_col_oids.end()).size() != key_col_oids.size()) {
+    return false;
+  }
+  const auto table_offsets = table_->ProjectionMapForOids(key_col_oids);
+  const auto &key_offsets = index_->GetKeyOidToOffsetMap();
+  for (uint32_t i = 0; i < key_cols.size(); i++) {
+    key_attrs_.push_back({key_offsets.at(key_cols[i].Oid()), table_offsets.at(key_col_oids[i]),
+                          storage::AttrSizeBytes(key_cols[i].AttributeLength()),
+                          key_cols[i].AttributeLength() == storage::VARLEN_COLUMN});
+  }
+  key_col_oids_ = std::move(key_col_oids);
+  return true;
+}
+
+void IndexIterator::BuildHashTable() {
+  if (!ResolveKeyAttrs()) {
+    return;
+  }
+
+  auto *memory_pool = exec_ctx_->GetMemoryPool();
+  auto table_pri = table_->InitializerForProjectedRow(key_col_oids_);
+  void *table_buffer = memory_pool->AllocateAligned(table_pri.ProjectedRowSize(), alignof(uint64_t), false);
+  auto *table_key = table_pri.InitializeRow(table_buffer);
+  auto &index_pri = index_->GetProjectedRowInitializer();
+  void *key_buffer = memory_pool->AllocateAligned(index_pri.ProjectedRowSize(), alignof(uint64_t), false);
+  auto *key = index_pri.InitializeRow(key_buffer);
+
+  // Entries hold the slot of the tuple followed by its key, laid out as an index key.
+  const auto key_size = index_pri.ProjectedRowSize();
+  const auto payload_size = common::MathUtil::AlignTo(sizeof(storage::TupleSlot) + key_size, alignof(uint64_t));
+  hash_table_ = std::make_unique<JoinHashTable>(exec_ctx_->GetExecutionSettings(), exec_ctx_,
+                                                static_cast<uint32_t>(payload_size));
+  // Every thread builds its own table, so give up and keep probing the index once it grows past the limit.
+  const uint64_t max_size = exec_ctx_->GetExecutionSettings().GetIndexJoinHashTableMaxSize();
+  uint64_t size = 0;
+  for (auto iter = table_->begin(); iter != table_->end(); iter++) {
+    const storage::TupleSlot slot = *iter;
+    if (!table_->Select(exec_ctx_->GetTxn(), slot, table_key)) {
+      continue;
+    }
+    size += sizeof(HashTableEntry) + payload_size;
+    if (max_size != 0 && size > max_size) {
+      hash_table_.reset();
+      break;
+    }
+    for (const auto &attr : key_attrs_) {
+      const byte *value = table_key->AccessWithNullCheck(attr.table_offset_);
+      if (value == nullptr) {
+        key->SetNull(attr.key_offset_);
+      } else {
+        std::memcpy(key->AccessForceNotNull(attr.key_offset_), value, attr.size_);
+      }
+    }
+    byte *payload = hash_table_->AllocInputTuple(HashKey(*key));
+    *reinterpret_cast<storage::TupleSlot *>(payload) = slot;
+    std::memcpy(payload + sizeof(storage::TupleSlot), key, key_size);
+  }
+  if (hash_table_ != nullptr) {
+    hash_table_->Build();
+  }
+
+  memory_pool->Deallocate(table_buffer, table_key->Size());
+  memory_pool->Deallocate(key_buffer, key->Size());
+}
+
+hash_t IndexIterator::HashKey(const storage::ProjectedRow &key) const {
+  hash_t hash = 0;
+  for (const auto &attr : key_attrs_) {
+    const byte *value = key.AccessWithNullCheck(attr.key_offset_);
+    hash_t value_hash = 0;
+    if (value != nullptr) {
+      value_hash = attr.varlen_ ? reinterpret_cast<const storage::VarlenEntry *>(value)->Hash()
+                                : common::HashUtil::HashBytes(value, attr.size_);
+    }
+    hash = common::HashUtil::CombineHashes(hash, value_hash);
+  }
+  return hash;
+}
+
+void IndexIterator::LookupHashTable(const storage::ProjectedRow &key, std::vector<storage::TupleSlot> *results) const {
+  // Keys compare like they do in the index: NULLs equal each other, and varlens compare by content.
+  const auto keys_equal = [&](const storage::ProjectedRow &other) {
+    return std::all_of(key_attrs_.begin(), key_attrs_.end(), [&](const KeyAttr &attr) {
+      const byte *lhs = key.AccessWithNullCheck(attr.key_offset_);
+      const byte *rhs = other.AccessWithNullCheck(attr.key_offset_);
+      if (lhs == nullptr || rhs == nullptr) {
+        return lhs == rhs;
+      }
+      if (attr.varlen_) {
+        return *reinterpret_cast<const storage::VarlenEntry *>(lhs) ==
+               *reinterpret_cast<const storage::VarlenEntry *>(rhs);
+      }
+      return std::memcmp(lhs, rhs, attr.size_) == 0;
+    });
+  };
+  for (auto iter = hash_table_->Lookup<false>(HashKey(key)); iter.HasNext();) {
+    const byte *payload = iter.GetMatchPayload();
+    if (keys_equal(*reinterpret_cast<const storage::ProjectedRow *>(payload + sizeof(storage::TupleSlot)))) {
+      results->push_back(*reinterpret_cast<const storage::TupleSlot *>(payload));
+    }
+  }
+}
+
 storage::ProjectedRow *IndexIterator::TablePR() {
   table_->Select(exec_ctx_->GetTxn(), tuples_[curr_index_ - 1], table_pr_);
   return table_pr_;
@@ -77,5 +259,8 @@ IndexIterator::~IndexIterator() {
   exec_ctx_->GetMemoryPool()->Deallocate(table_buffer_, table_pr_->Size());
   exec_ctx_->GetMemoryPool()->Deallocate(index_buffer_, index_pr_->Size());
   exec_ctx_->GetMemoryPool()->Deallocate(hi_index_buffer_, hi_index_pr_->Size());
+  for (auto *key : batch_keys_) {
+    exec_ctx_->GetMemoryPool()->Deallocate(key, key->Size());
+  }
 }
 }  // namespace noisepage::execution::sql
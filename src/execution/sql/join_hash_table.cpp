@@ -1,20 +1,25 @@
 #include "execution/sql/join_hash_table.h"
 
 #include <llvm/ADT/STLExtras.h>
-#include <tbb/parallel_for_each.h>
-#include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <cstring>
 #include <limits>
+#include <memory>
 #include <utility>
 #include <vector>
 
+#include "common/constants.h"
+#include "common/math_util.h"
 #include "count/hll.h"
 #include "execution/exec/execution_context.h"
+#include "execution/exec/morsel_scheduler.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_operations/unary_operation_executor.h"
+#include "execution/util/bit_util.h"
 #include "execution/util/cpu_info.h"
 #include "execution/util/memory.h"
 #include "execution/util/timer.h"
@@ -32,15 +37,44 @@ JoinHashTable::JoinHashTable(const exec::ExecutionSettings &exec_settings, exec:
       hll_estimator_(libcount::HLL::Create(DEFAULT_HLL_PRECISION)),
       built_(false),
       use_concise_ht_(use_concise_ht),
-      tracker_(exec_ctx->GetMemoryPool()->GetTracker()) {}
+      bloom_filter_enabled_(false),
+      tracker_(exec_ctx->GetMemoryPool()->GetTracker()),
+      spill_enabled_(false),
+      num_entries_at_spill_(0),
+      spilled_partitions_(0),
+      resident_partitions_(~uint64_t{0}),
+      pending_partitions_(0) {}
 
 // Needed because we forward-declared HLL from libcount
 JoinHashTable::~JoinHashTable() = default;
 
+void JoinHashTable::EnableSpilling() {
+  NOISEPAGE_ASSERT(entries_.empty(), "Spilling must be enabled before any insertion");
+  spill_enabled_ = tracker_ != nullptr;
+}
+
 byte *JoinHashTable::AllocInputTuple(const hash_t hash) {
   // Add to unique_count estimation
   hll_estimator_->Update(hash);
 
+  if (spill_enabled_) {
+    // The tuple returned by the previous call has been materialized by now, so
+    // entries can be moved to disk. Only spill again after the resident part
+    // of the table has regrown to its size at the last spill, otherwise memory
+    // held by other operators would make us spill everything at once.
+    if (UNLIKELY(tracker_->IsOverBudget()) && ~spilled_partitions_ != 0 &&
+        entries_.size() >= num_entries_at_spill_) {
+      SpillPartitions(ChooseSpillVictims());
+    }
+
+    if (!IsResident(hash)) {
+      auto *entry = AllocSpilledEntry(SpillPartitionOf(hash));
+      entry->hash_ = hash;
+      entry->next_ = nullptr;
+      return entry->payload_;
+    }
+  }
+
   // Allocate space for a new tuple
   auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
   entry->hash_ = hash;
@@ -48,6 +82,127 @@ byte *JoinHashTable::AllocInputTuple(const hash_t hash) {
   return entry->payload_;
 }
 
+uint64_t JoinHashTable::ChooseSpillVictims() const {
+  // Spill the upper half of the resident partitions. Picking deterministically
+  // from the top makes thread-local tables likely to agree on what they spill,
+  // which keeps the work needed to reconcile them in MergeParallel() small.
+  const uint64_t resident = ~spilled_partitions_;
+  const uint32_t num_victims = (util::BitUtil::CountPopulation(resident) + 1) / 2;
+  uint64_t victims = 0;
+  for (uint32_t part_idx = NUM_SPILL_PARTITIONS, n = 0; part_idx-- > 0 && n < num_victims;) {
+    const uint64_t part_bit = uint64_t{1} << part_idx;
+    if ((resident & part_bit) != 0) {
+      victims |= part_bit;
+      n++;
+    }
+  }
+  return victims;
+}
+
+void JoinHashTable::SpillPartitions(const uint64_t partitions) {
+  NOISEPAGE_ASSERT(owned_.empty(), "Only tables owning all their entries can spill");
+
+  if (spill_files_.empty()) {
+    spill_files_.emplace_back(std::make_unique<SpillFile>());
+    partition_spills_.resize(NUM_SPILL_PARTITIONS);
+    spill_buffers_.resize(NUM_SPILL_PARTITIONS);
+  }
+
+  spilled_partitions_ |= partitions;
+  resident_partitions_ = ~spilled_partitions_;
+
+  // Move the entries of the victim partitions into their write buffers and
+  // compact the remaining ones into a fresh vector, releasing the old memory.
+  const std::size_t entry_size = entries_.ElementSize();
+  const uint64_t num_entries = entries_.size();
+  decltype(entries_) resident(entry_size, MemoryPoolAllocator<byte>(exec_ctx_->GetMemoryPool()));
+  for (const byte *raw_entry : entries_) {
+    const hash_t hash = reinterpret_cast<const HashTableEntry *>(raw_entry)->hash_;
+    byte *dest =
+        IsResident(hash) ? resident.Append() : reinterpret_cast<byte *>(AllocSpilledEntry(SpillPartitionOf(hash)));
+    std::memcpy(dest, raw_entry, entry_size);
+  }
+  entries_ = std::move(resident);
+  num_entries_at_spill_ = num_entries;
+
+  EXECUTION_LOG_TRACE("JHT: spilled partitions {:#x}, {} of {} entries remain resident", spilled_partitions_,
+                      entries_.size(), num_entries);
+}
+
+HashTableEntry *JoinHashTable::AllocSpilledEntry(const uint32_t part_idx) {
+  auto &buffer = spill_buffers_[part_idx];
+  const std::size_t entry_size = entries_.ElementSize();
+  if (buffer.size() + entry_size > SPILL_BUFFER_SIZE) {
+    FlushSpillBuffer(part_idx);
+  }
+  if (buffer.empty()) {
+    buffer.reserve(std::max<std::size_t>(SPILL_BUFFER_SIZE, entry_size));
+  }
+  buffer.resize(buffer.size() + entry_size);
+  return reinterpret_cast<HashTableEntry *>(buffer.data() + buffer.size() - entry_size);
+}
+
+void JoinHashTable::FlushSpillBuffer(const uint32_t part_idx) {
+  auto &buffer = spill_buffers_[part_idx];
+  if (buffer.empty()) {
+    return;
+  }
+  SpillFile *file = spill_files_.front().get();
+  const std::size_t offset = file->Append(buffer.data(), buffer.size());
+  partition_spills_[part_idx].push_back(SpilledRun{file, offset, buffer.size() / entries_.ElementSize()});
+  buffer.clear();
+}
+
+void JoinHashTable::LoadSpilledPartition(const uint32_t part_idx) {
+  // Read back spilled entries in batches of roughly one vector's worth.
+  constexpr uint64_t batch_size = common::Constants::K_DEFAULT_VECTOR_SIZE;
+  const std::size_t entry_size = entries_.ElementSize();
+  std::vector<byte> buffer(batch_size * entry_size);
+
+  for (const SpilledRun &run : partition_spills_[part_idx]) {
+    for (uint64_t read = 0; read < run.num_entries_;) {
+      const uint64_t num_entries = std::min(batch_size, run.num_entries_ - read);
+      run.file_->Read(run.offset_ + read * entry_size, buffer.data(), num_entries * entry_size);
+      for (uint64_t i = 0; i < num_entries; i++) {
+        std::memcpy(entries_.Append(), buffer.data() + i * entry_size, entry_size);
+      }
+      read += num_entries;
+    }
+  }
+}
+
+bool JoinHashTable::NextPass() {
+  NOISEPAGE_ASSERT(IsBuilt(), "Table must be built before advancing to the next pass");
+
+  if (pending_partitions_ == 0) {
+    return false;
+  }
+
+  // Release the partitions processed in the previous pass.
+  entries_ = decltype(entries_)(entries_.ElementSize(), MemoryPoolAllocator<byte>(exec_ctx_->GetMemoryPool()));
+  {
+    common::SpinLatch::ScopedSpinLatch latch(&owned_latch_);
+    owned_.clear();
+  }
+
+  // Load as many pending partitions as the budget allows, but at least one.
+  resident_partitions_ = 0;
+  while (pending_partitions_ != 0 && (resident_partitions_ == 0 || !tracker_->IsOverBudget())) {
+    const auto part_idx = static_cast<uint32_t>(util::BitUtil::CountTrailingZeros(pending_partitions_));
+    LoadSpilledPartition(part_idx);
+    resident_partitions_ |= uint64_t{1} << part_idx;
+    pending_partitions_ &= ~(uint64_t{1} << part_idx);
+  }
+
+  EXECUTION_LOG_TRACE("JHT: next pass over partitions {:#x} with {} entries, {:#x} pending", resident_partitions_,
+                      entries_.size(), pending_partitions_);
+
+  // Rebuild the index over the newly loaded entries.
+  built_ = false;
+  Build();
+  return true;
+}
+
 void JoinHashTable::BuildChainingHashTable() {
   // Perfectly size the generic hash table in preparation for bulk-load.
   chaining_hash_table_.SetSize(GetTupleCount(), tracker_);
@@ -490,11 +645,39 @@ void JoinHashTable::BuildConciseHashTable() {
   }
 }
 
+void JoinHashTable::BuildBloomFilter() {
+  // Only resident entries are added. Probe tuples of partitions that are on
+  // disk are skipped in the current pass anyway.
+  const uint64_t num_entries = GetTupleCount();
+  bloom_filter_.Init(exec_ctx_->GetMemoryPool(),
+                     static_cast<uint32_t>(std::min<uint64_t>(num_entries, std::numeric_limits<uint32_t>::max())));
+
+  const auto add_entries = [this](const auto &entries) {
+    for (const byte *entry : entries) {
+      bloom_filter_.Add(reinterpret_cast<const HashTableEntry *>(entry)->hash_);
+    }
+  };
+  add_entries(entries_);
+  for (const auto &entries : owned_) {
+    add_entries(entries);
+  }
+}
+
 void JoinHashTable::Build() {
   if (IsBuilt()) {
     return;
   }
 
+  // Write out the remaining buffered entries of spilled partitions. These
+  // partitions are processed in later passes.
+  if (!spill_buffers_.empty()) {
+    for (uint32_t part_idx = 0; part_idx < NUM_SPILL_PARTITIONS; part_idx++) {
+      FlushSpillBuffer(part_idx);
+    }
+    spill_buffers_.clear();
+    pending_partitions_ = spilled_partitions_;
+  }
+
   EXECUTION_LOG_DEBUG("Unique estimate: {}", hll_estimator_->Estimate());
 
   util::Timer<> timer;
@@ -507,6 +690,10 @@ void JoinHashTable::Build() {
     BuildChainingHashTable();
   }
 
+  if (bloom_filter_enabled_) {
+    BuildBloomFilter();
+  }
+
   timer.Stop();
   UNUSED_ATTRIBUTE double tps = (GetTupleCount() / timer.GetElapsed()) / 1000.0;
   EXECUTION_LOG_DEBUG("JHT: built {} tuples in {} ms ({:.2f} tps)", GetTupleCount(), timer.GetElapsed(), tps);
@@ -515,9 +702,16 @@ void JoinHashTable::Build() {
 }
 
 // TODO(pmenon): Vectorized bloom filter pre-filtering.
-// TODO(pmenon): Implement prefetching.
 
 void JoinHashTable::LookupBatchInChainingHashTable(const Vector &hashes, Vector *results) const {
+  // Once the directory outgrows the cache, nearly every lookup misses. Prefetching the bucket heads
+  // of the whole batch first lets these misses overlap rather than stall each lookup in turn.
+  if (chaining_hash_table_.GetTotalMemoryUsage() > CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE)) {
+    auto *RESTRICT raw_hashes = reinterpret_cast<const hash_t *>(hashes.GetData());
+    VectorOps::Exec(hashes, [&](const uint64_t i, const uint64_t k) {
+      chaining_hash_table_.PrefetchChainHead<true>(raw_hashes[i]);
+    });
+  }
   UnaryOperationExecutor::Execute<hash_t, const HashTableEntry *>(
       exec_settings_, hashes,
       results, [&](const hash_t hash_val) noexcept { return chaining_hash_table_.FindChainHead(hash_val); });
@@ -553,18 +747,54 @@ void JoinHashTable::MergeIncomplete(JoinHashTable *source) {
   owned_.emplace_back(std::move(source->entries_));
 }
 
+uint64_t JoinHashTable::PrepareMerge(const std::vector<JoinHashTable *> &tl_join_tables) {
+  // Combine HLL counts to get a global estimate
+  for (auto *jht : tl_join_tables) {
+    hll_estimator_->Merge(jht->hll_estimator_.get());
+  }
+
+  uint64_t num_elem_estimate = hll_estimator_->Estimate();
+
+  // If any thread-local table spilled, all tables must agree on the set of
+  // spilled partitions before their resident entries are merged. Take over
+  // the spilled runs; the resident tuple count is then known exactly.
+  uint64_t spilled_partitions = 0;
+  for (auto *jht : tl_join_tables) {
+    spilled_partitions |= jht->spilled_partitions_;
+  }
+  if (spilled_partitions != 0) {
+    partition_spills_.resize(NUM_SPILL_PARTITIONS);
+    num_elem_estimate = 0;
+    for (auto *jht : tl_join_tables) {
+      jht->SpillPartitions(spilled_partitions);
+      for (uint32_t part_idx = 0; part_idx < NUM_SPILL_PARTITIONS; part_idx++) {
+        jht->FlushSpillBuffer(part_idx);
+        auto &runs = jht->partition_spills_[part_idx];
+        partition_spills_[part_idx].insert(partition_spills_[part_idx].end(), runs.begin(), runs.end());
+      }
+      for (auto &file : jht->spill_files_) {
+        spill_files_.emplace_back(std::move(file));
+      }
+      jht->partition_spills_.clear();
+      jht->spill_files_.clear();
+      jht->spill_buffers_.clear();
+      num_elem_estimate += jht->entries_.size();
+    }
+    spilled_partitions_ = pending_partitions_ = spilled_partitions;
+    resident_partitions_ = ~spilled_partitions;
+  }
+
+  return num_elem_estimate;
+}
+
 void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container, const std::size_t jht_offset) {
   // Collect thread-local hash tables
   std::vector<JoinHashTable *> tl_join_tables;
   thread_state_container->CollectThreadLocalStateElementsAs(&tl_join_tables, jht_offset);
 
-  // Combine HLL counts to get a global estimate
-  for (auto *jht : tl_join_tables) {
-    hll_estimator_->Merge(jht->hll_estimator_.get());
-  }
+  const uint64_t num_elem_estimate = PrepareMerge(tl_join_tables);
 
   // Size the global hash table
-  uint64_t num_elem_estimate = hll_estimator_->Estimate();
   chaining_hash_table_.SetSize(num_elem_estimate, tracker_);
 
   // Resize the owned entries vector now to avoid resizing concurrently during
@@ -593,20 +823,22 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
     EXECUTION_LOG_TRACE("JHT: Estimated {} elements >= {} element parallel threshold. Using parallel merge.",
                         num_elem_estimate, DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE);
 
-    size_t num_threads = tbb::task_scheduler_init::default_num_threads();
+    auto *scheduler = exec::MorselScheduler::Instance();
+    size_t num_threads = scheduler->GetNumWorkers();
     size_t num_tasks = tl_join_tables.size();
     auto estimate = std::min(num_threads, num_tasks);
     exec_ctx_->SetNumConcurrentEstimate(estimate);
-    tbb::parallel_for_each(tl_join_tables, [this, thread_state_container](auto source) {
-      auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
-      auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
-      auto *tls = thread_state_container->AccessCurrentThreadState();
-      exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
-
-      size_t size = source->entries_.size();
-      MergeIncomplete<true>(source);
-      exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(size));
-    });
+    scheduler->ParallelForEach(exec_ctx_->GetSchedulingOptions(), tl_join_tables,
+                               [this, thread_state_container](auto source) {
+                                 auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
+                                 auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
+                                 auto *tls = thread_state_container->AccessCurrentThreadState();
+                                 exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+                                 size_t size = source->entries_.size();
+                                 MergeIncomplete<true>(source);
+                                 exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(size));
+                               });
     exec_ctx_->SetNumConcurrentEstimate(0);
   }
 
@@ -617,6 +849,155 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
                       use_serial_build ? "Serial" : "Parallel", tl_join_tables.size(), num_elem_estimate,
                       chaining_hash_table_.GetElementCount(), timer.GetElapsed(), tps);
 
+  if (bloom_filter_enabled_) {
+    BuildBloomFilter();
+  }
+
+  built_ = true;
+}
+
+uint64_t JoinHashTable::ComputeRadixBuildPartitions(const uint64_t num_entries) const {
+  // Choose enough partitions that the tuples of one partition and the slice of
+  // the bucket directory they are inserted into fit in the L2 cache. Never
+  // hand out less than a cache line of buckets per partition so that builds of
+  // different partitions don't write to the same lines.
+  const uint64_t l2_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE);
+  const uint64_t build_size = num_entries * entries_.ElementSize() + chaining_hash_table_.GetTotalMemoryUsage();
+  const uint64_t max_partitions = std::max(
+      uint64_t{1}, chaining_hash_table_.GetCapacity() / (common::Constants::CACHELINE_SIZE / sizeof(HashTableEntry *)));
+  const uint64_t num_partitions = common::MathUtil::PowerOf2Ceil(std::max(uint64_t{1}, build_size / l2_size));
+  return std::min({num_partitions, max_partitions, uint64_t{MAX_RADIX_BUILD_PARTITIONS}});
+}
+
+void JoinHashTable::MergeParallelPartitioned(ThreadStateContainer *thread_state_container,
+                                             const std::size_t jht_offset) {
+  NOISEPAGE_ASSERT(owned_.empty(), "Partitioned merge must be the first merge into the table");
+
+  // Collect thread-local hash tables
+  std::vector<JoinHashTable *> tl_join_tables;
+  thread_state_container->CollectThreadLocalStateElementsAs(&tl_join_tables, jht_offset);
+
+  PrepareMerge(tl_join_tables);
+
+  // Unlike the HLL estimate, the number of buffered entries is exact.
+  uint64_t num_entries = 0;
+  for (auto *jht : tl_join_tables) {
+    num_entries += jht->entries_.size();
+  }
+
+  // Size the global hash table
+  chaining_hash_table_.SetSize(num_entries, tracker_);
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  const uint64_t num_partitions = ComputeRadixBuildPartitions(num_entries);
+  if (num_partitions == 1) {
+    // The whole build fits in cache. Scattering would only copy the input.
+    EXECUTION_LOG_TRACE("JHT: {} elements fit in a single partition. Using serial merge.", num_entries);
+
+    auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
+    auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
+    auto *tls = thread_state_container->AccessCurrentThreadState();
+    exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+    owned_.reserve(tl_join_tables.size());
+    llvm::for_each(tl_join_tables, [this](auto *source) { MergeIncomplete<false>(source); });
+
+    exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(num_entries));
+  } else {
+    // Partitions are ranges of the bucket directory: the radix bits are the
+    // topmost bits of the bucket position. Partitions can therefore be built
+    // independently and without atomics.
+    const uint64_t bucket_mask = chaining_hash_table_.GetCapacity() - 1;
+    const uint64_t shift = util::BitUtil::CountTrailingZeros(chaining_hash_table_.GetCapacity()) -
+                           util::BitUtil::CountTrailingZeros(num_partitions);
+    const auto partition_of = [=](const byte *entry) {
+      return (reinterpret_cast<const HashTableEntry *>(entry)->hash_ & bucket_mask) >> shift;
+    };
+
+    const std::size_t num_tables = tl_join_tables.size();
+    const std::size_t entry_size = entries_.ElementSize();
+
+    auto *scheduler = exec::MorselScheduler::Instance();
+    const auto options = exec_ctx_->GetSchedulingOptions();
+    size_t num_threads = scheduler->GetNumWorkers();
+    exec_ctx_->SetNumConcurrentEstimate(std::min(num_threads, std::max(num_tables, num_partitions)));
+
+    // Build a histogram of partition sizes for each thread-local table.
+    std::vector<std::vector<uint64_t>> write_offsets(num_tables, std::vector<uint64_t>(num_partitions, 0));
+    scheduler->ParallelFor(options, 0, num_tables, 1, [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t table_idx = begin; table_idx < end; table_idx++) {
+        auto &histogram = write_offsets[table_idx];
+        for (const byte *entry : tl_join_tables[table_idx]->entries_) {
+          histogram[partition_of(entry)]++;
+        }
+      }
+    });
+
+    // Turn the histograms into the position each thread-local table starts
+    // writing at in each partition.
+    std::vector<uint64_t> partition_sizes(num_partitions, 0);
+    for (uint64_t part_idx = 0; part_idx < num_partitions; part_idx++) {
+      for (auto &offsets : write_offsets) {
+        const uint64_t count = offsets[part_idx];
+        offsets[part_idx] = partition_sizes[part_idx];
+        partition_sizes[part_idx] += count;
+      }
+    }
+
+    // Each partition becomes one of the entry vectors this table owns.
+    owned_.reserve(num_partitions);
+    for (uint64_t part_idx = 0; part_idx < num_partitions; part_idx++) {
+      owned_.emplace_back(entry_size, MemoryPoolAllocator<byte>(exec_ctx_->GetMemoryPool()));
+    }
+    scheduler->ParallelFor(options, 0, num_partitions, 1, [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t part_idx = begin; part_idx < end; part_idx++) {
+        owned_[part_idx].resize(partition_sizes[part_idx]);
+      }
+    });
+
+    // Scatter the entries of every thread-local table into their partitions,
+    // releasing thread-local memory as soon as the table has been processed.
+    scheduler->ParallelFor(options, 0, num_tables, 1, [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t table_idx = begin; table_idx < end; table_idx++) {
+        auto *source = tl_join_tables[table_idx];
+        auto &offsets = write_offsets[table_idx];
+        for (const byte *entry : source->entries_) {
+          const uint64_t part_idx = partition_of(entry);
+          std::memcpy(owned_[part_idx][offsets[part_idx]++], entry, entry_size);
+        }
+        decltype(entries_) released(std::move(source->entries_));
+      }
+    });
+
+    // Build each partition's slice of the directory.
+    scheduler->ParallelFor(options, 0, num_partitions, 1, [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t part_idx = begin; part_idx < end; part_idx++) {
+        auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
+        auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
+        auto *tls = thread_state_container->AccessCurrentThreadState();
+        exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+        chaining_hash_table_.InsertBatch<false>(&owned_[part_idx]);
+
+        exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(partition_sizes[part_idx]));
+      }
+    });
+
+    exec_ctx_->SetNumConcurrentEstimate(0);
+  }
+
+  timer.Stop();
+
+  UNUSED_ATTRIBUTE const double tps = (chaining_hash_table_.GetElementCount() / timer.GetElapsed()) / 1000.0;
+  EXECUTION_LOG_TRACE("JHT: Partitioned merge of {} JHTs into {} partitions. Time: {:.2f} ms ({:.2f} mtps)",
+                      tl_join_tables.size(), num_partitions, timer.GetElapsed(), tps);
+
+  if (bloom_filter_enabled_) {
+    BuildBloomFilter();
+  }
+
   built_ = true;
 }
 
@@ -0,0 +1,58 @@
+#include "execution/sql/join_hash_table_batch_probe.h"
+
+#include "common/constants.h"
+#include "execution/sql/join_hash_table.h"
+#include "execution/util/memory.h"
+
+namespace noisepage::execution::sql {
+
+JoinHashTableBatchProbe::JoinHashTableBatchProbe()
+    : hashes_(TypeId::Hash, true, false),
+      entries_(TypeId::Pointer, true, false),
+      num_added_(0),
+      num_probes_(0),
+      next_(0) {}
+
+void JoinHashTableBatchProbe::AddHash(const hash_t hash) {
+  NOISEPAGE_ASSERT(num_added_ < common::Constants::K_DEFAULT_VECTOR_SIZE, "Batch probe exceeds vector size");
+  // The hashes of the previous batch are not needed any more once the new batch is being filled.
+  reinterpret_cast<hash_t *>(hashes_.GetData())[num_added_++] = hash;
+}
+
+void JoinHashTableBatchProbe::Lookup(const JoinHashTable &table) {
+  NOISEPAGE_ASSERT(!table.UsingConciseHashTable(), "Batch probes follow bucket chains, concise tables have none");
+  num_probes_ = num_added_;
+  num_added_ = 0;
+  next_ = 0;
+
+  // Find the heads of the bucket chains of all probes.
+  hashes_.Resize(num_probes_);
+  hashes_.GetMutableNullMask()->Reset();
+  table.LookupBatch(hashes_, &entries_);
+
+  // Move each probe to the first entry in its chain with a matching hash. The entries of the probes
+  // a fixed distance ahead are prefetched, which also brings the start of their payloads into the
+  // cache for when the probes are consumed.
+  auto *RESTRICT hashes = reinterpret_cast<const hash_t *>(hashes_.GetData());
+  auto *RESTRICT entries = reinterpret_cast<const HashTableEntry **>(entries_.GetData());
+  for (uint32_t idx = 0, prefetch_idx = common::Constants::K_PREFETCH_DISTANCE; idx < num_probes_;
+       idx++, prefetch_idx++) {
+    if (LIKELY(prefetch_idx < num_probes_) && entries[prefetch_idx] != nullptr) {
+      util::Memory::Prefetch<true, Locality::Low>(entries[prefetch_idx]);
+    }
+    const HashTableEntry *entry = entries[idx];
+    while (entry != nullptr && entry->hash_ != hashes[idx]) {
+      entry = entry->next_;
+    }
+    entries[idx] = entry;
+  }
+}
+
+HashTableEntryIterator JoinHashTableBatchProbe::Next() {
+  NOISEPAGE_ASSERT(next_ < num_probes_, "Retrieving more probes than were looked up");
+  const uint32_t idx = next_++;
+  return HashTableEntryIterator(reinterpret_cast<const HashTableEntry **>(entries_.GetData())[idx],
+                                reinterpret_cast<const hash_t *>(hashes_.GetData())[idx]);
+}
+
+}  // namespace noisepage::execution::sql
@@ -1,6 +1,10 @@
 #include "execution/sql/operators/like_operators.h"
 
+#include <cstring>
+#include <utility>
+
 #include "common/macros.h"
+#include "execution/util/simd.h"
 
 namespace noisepage::execution::sql {
 
@@ -48,14 +52,7 @@ bool Like::Impl(const char *str, size_t str_len, const char *pattern, size_t pat
         return true;
       }
 
-      if (*p == escape) {
-        NextByte(p, plen);
-        NOISEPAGE_ASSERT(*p != 0, "LIKE pattern must not end with an escape character");
-        if (plen == 0) {
-          return false;
-        }
-      }
-
+      // The rest of the pattern, including a leading escape, is matched against every suffix of the input.
       while (slen > 0) {
         if (Like::Impl(s, slen, p, plen, escape)) {
           return true;
@@ -81,4 +78,66 @@ bool Like::Impl(const char *str, size_t str_len, const char *pattern, size_t pat
   return slen == 0 && plen == 0;
 }
 
+LikePattern::LikePattern(const char *pattern, std::size_t pattern_len, char escape)
+    : kind_(Kind::General), literal_(pattern, pattern_len), escape_(escape) {
+  if (escape == '%' || escape == '_') {
+    return;
+  }
+
+  // Strip a leading run of '%' and unescape the rest of the pattern. Patterns with any other wildcard than a leading
+  // or a trailing run of '%', or ending in a dangling escape, are left to the general matcher.
+  std::size_t pos = 0;
+  while (pos < pattern_len && pattern[pos] == '%') {
+    pos++;
+  }
+  const bool leading_wildcard = pos > 0;
+  bool trailing_wildcard = false;
+  std::string literal;
+  for (; pos < pattern_len; pos++) {
+    if (pattern[pos] == escape) {
+      if (++pos == pattern_len) {
+        return;
+      }
+      literal.push_back(pattern[pos]);
+    } else if (pattern[pos] == '_') {
+      return;
+    } else if (pattern[pos] == '%') {
+      while (pos < pattern_len && pattern[pos] == '%') {
+        pos++;
+      }
+      if (pos != pattern_len) {
+        return;
+      }
+      trailing_wildcard = true;
+    } else {
+      literal.push_back(pattern[pos]);
+    }
+  }
+
+  if (leading_wildcard) {
+    kind_ = trailing_wildcard ? Kind::Contains : Kind::Suffix;
+  } else {
+    kind_ = trailing_wildcard ? Kind::Prefix : Kind::Exact;
+  }
+  literal_ = std::move(literal);
+}
+
+bool LikePattern::Matches(const char *str, std::size_t str_len) const {
+  NOISEPAGE_ASSERT(str != nullptr, "Input string cannot be NULL");
+  const std::size_t len = literal_.size();
+  switch (kind_) {
+    case Kind::Exact:
+      return str_len == len && std::memcmp(str, literal_.data(), len) == 0;
+    case Kind::Prefix:
+      return str_len >= len && std::memcmp(str, literal_.data(), len) == 0;
+    case Kind::Suffix:
+      return str_len >= len && std::memcmp(str + str_len - len, literal_.data(), len) == 0;
+    case Kind::Contains:
+      return util::simd::FindSubstring(str, str_len, literal_.data(), len) != nullptr;
+    case Kind::General:
+      return Like::Impl(str, str_len, literal_.data(), len, escape_);
+  }
+  UNREACHABLE("Impossible LIKE pattern kind.");
+}
+
 }  // namespace noisepage::execution::sql
@@ -1,15 +1,18 @@
 #include "execution/sql/sorter.h"
 
 #include <llvm/ADT/STLExtras.h>
-#include <tbb/parallel_for_each.h>
-#include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <cstring>
+#include <memory>
 #include <queue>
 #include <utility>
 #include <vector>
 
 #include "execution/exec/execution_context.h"
+#include "execution/exec/morsel_scheduler.h"
+#include "execution/sql/memory_tracker.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/stage_timer.h"
 #include "ips4o/ips4o.hpp"
@@ -32,17 +35,29 @@ Sorter::Sorter(exec::ExecutionContext *exec_ctx, ComparisonFunction cmp_fn, uint
       owned_tuples_(exec_ctx->GetMemoryPool()),
       cmp_fn_(cmp_fn),
       tuples_(exec_ctx->GetMemoryPool()),
-      sorted_(false) {}
+      sorted_(false),
+      tracker_(exec_ctx->GetMemoryPool()->GetTracker()),
+      min_run_size_(MIN_RUN_SIZE),
+      num_spilled_tuples_(0) {}
 
 Sorter::~Sorter() = default;
 
-byte *Sorter::AllocInputTuple() {
+byte *Sorter::AppendTuple() {
   byte *ret = tuple_storage_.Append();
   tuples_.push_back(ret);
   return ret;
 }
 
-byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AllocInputTuple(); }
+byte *Sorter::AllocInputTuple() {
+  // The tuple returned by the previous call has been written by now, so the
+  // buffered tuples can be cut into a run.
+  if (tracker_ != nullptr && UNLIKELY(tracker_->IsOverBudget()) && tuples_.size() >= min_run_size_) {
+    SpillSortedRun();
+  }
+  return AppendTuple();
+}
+
+byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AppendTuple(); }
 
 void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
   // If the number of buffered tuples is less than top_k, we're done.
@@ -107,12 +122,136 @@ void Sorter::HeapSiftDown() {
   tuples_[idx] = top;
 }
 
+namespace {
+
+// Buffers tuples and appends them to a spill file as one contiguous run.
+class RunWriter {
+ public:
+  RunWriter(SpillFile *file, const std::size_t tuple_size)
+      : file_(file), tuple_size_(tuple_size), offset_(0), num_flushed_(0), num_tuples_(0) {
+    buffer_.reserve(std::max<std::size_t>(Sorter::RUN_BUFFER_SIZE, tuple_size));
+  }
+
+  void Append(const byte *tuple) {
+    if (buffer_.size() + tuple_size_ > buffer_.capacity()) {
+      Flush();
+    }
+    buffer_.insert(buffer_.end(), tuple, tuple + tuple_size_);
+    num_tuples_++;
+  }
+
+  // Write out the remaining buffered tuples. Returns the file offset of the
+  // run and its number of tuples.
+  std::pair<std::size_t, uint64_t> Finish() {
+    Flush();
+    return {offset_, num_tuples_};
+  }
+
+ private:
+  void Flush() {
+    if (buffer_.empty()) {
+      return;
+    }
+    // This writer is the only one appending to the file, so consecutive
+    // appends are contiguous.
+    const std::size_t offset = file_->Append(buffer_.data(), buffer_.size());
+    if (num_flushed_ == 0) {
+      offset_ = offset;
+    }
+    num_flushed_ += buffer_.size();
+    buffer_.clear();
+  }
+
+ private:
+  SpillFile *file_;
+  std::size_t tuple_size_;
+  std::vector<byte> buffer_;
+  std::size_t offset_;
+  std::size_t num_flushed_;
+  uint64_t num_tuples_;
+};
+
+}  // namespace
+
+void Sorter::SpillSortedRun() {
+  NOISEPAGE_ASSERT(owned_tuples_.empty(), "Only sorters owning all their tuples can spill");
+
+  if (spill_files_.empty()) {
+    spill_files_.emplace_back(std::make_unique<SpillFile>());
+  }
+
+  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+  ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+
+  RunWriter writer(spill_files_.front().get(), tuple_storage_.ElementSize());
+  for (const byte *tuple : tuples_) {
+    writer.Append(tuple);
+  }
+  const auto [offset, num_tuples] = writer.Finish();
+  runs_.push_back(SortedRun{spill_files_.front().get(), offset, num_tuples});
+  num_spilled_tuples_ += num_tuples;
+
+  EXECUTION_LOG_TRACE("Sorter: spilled run #{} of {} tuples", runs_.size(), num_tuples);
+
+  // Release the memory of the spilled tuples. Only cut the next run after as
+  // many tuples have been buffered again, so that memory held elsewhere in the
+  // query doesn't make us write many tiny runs.
+  min_run_size_ = std::max(min_run_size_, tuples_.size());
+  tuples_.clear();
+  tuple_storage_ = decltype(tuple_storage_)(tuple_storage_.ElementSize(), MemoryPoolAllocator<byte>(memory_));
+}
+
+void Sorter::ReduceRuns() {
+  while (runs_.size() > MAX_MERGE_FAN_IN) {
+    EXECUTION_LOG_DEBUG("Sorter: merging {} runs with fan-in {}", runs_.size(), MAX_MERGE_FAN_IN);
+
+    std::vector<SortedRun> merged_runs;
+    for (std::size_t first_run = 0; first_run < runs_.size(); first_run += MAX_MERGE_FAN_IN) {
+      const std::size_t num_runs = std::min<std::size_t>(MAX_MERGE_FAN_IN, runs_.size() - first_run);
+      if (num_runs == 1) {
+        merged_runs.push_back(runs_[first_run]);
+        continue;
+      }
+
+      RunWriter writer(spill_files_.front().get(), tuple_storage_.ElementSize());
+      for (SorterRunMerger merger(*this, first_run, num_runs); merger.HasNext(); merger.Next()) {
+        writer.Append(merger.GetRow());
+      }
+      const auto [offset, num_tuples] = writer.Finish();
+      merged_runs.push_back(SortedRun{spill_files_.front().get(), offset, num_tuples});
+    }
+    runs_ = std::move(merged_runs);
+  }
+}
+
+void Sorter::TakeRuns(Sorter *other) {
+  runs_.insert(runs_.end(), other->runs_.begin(), other->runs_.end());
+  num_spilled_tuples_ += other->num_spilled_tuples_;
+  for (auto &file : other->spill_files_) {
+    spill_files_.emplace_back(std::move(file));
+  }
+  other->runs_.clear();
+  other->spill_files_.clear();
+  other->num_spilled_tuples_ = 0;
+}
+
 void Sorter::Sort() {
   // Exit if the input tuples have already been sorted
   if (IsSorted()) {
     return;
   }
 
+  // If runs were spilled, the remaining tuples become the last run. The runs
+  // are merged while iterating.
+  if (HasSpilled()) {
+    if (!tuples_.empty()) {
+      SpillSortedRun();
+    }
+    ReduceRuns();
+    sorted_ = true;
+    return;
+  }
+
   // Exit if there are no input tuples
   if (tuples_.empty()) {
     return;
@@ -167,6 +306,34 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
     return;
   }
 
+  // If any thread-local sorter spilled, the input doesn't fit in memory. All
+  // thread-local sorters write their remaining tuples out as a final sorted
+  // run in parallel, and this sorter takes ownership of all runs.
+  if (llvm::any_of(tl_sorters, [](const Sorter *sorter) { return sorter->HasSpilled(); })) {
+    EXECUTION_LOG_DEBUG("Thread-local sorters spilled. Using external merge sort.");
+
+    exec::MorselScheduler::Instance()->ParallelForEach(
+        exec_ctx_->GetSchedulingOptions(), tl_sorters, [thread_state_container, this](Sorter *sorter) {
+          auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLSortHook);
+          auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLSortHook);
+          auto *tls = thread_state_container->AccessCurrentThreadState();
+          exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+          if (!sorter->tuples_.empty()) {
+            sorter->SpillSortedRun();
+          }
+
+          exec_ctx_->InvokeHook(post_hook, tls, nullptr);
+        });
+
+    for (auto *tl_sorter : tl_sorters) {
+      TakeRuns(tl_sorter);
+    }
+    ReduceRuns();
+    sorted_ = true;
+    return;
+  }
+
   const uint64_t num_tuples =
       std::accumulate(tl_sorters.begin(), tl_sorters.end(), uint64_t(0),
                       [](const auto partial, const auto *sorter) { return partial + sorter->GetTupleCount(); });
@@ -212,7 +379,7 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
   // 1. If placed around all code that follows, the metrics would then end up depending
   // on the time it takes to do per-task sorting and per-task merging.
   //
-  // 2. tbb::parallel_for() could actually end up using the "main" thread.
+  // 2. The parallel loops below could actually end up using the "main" thread.
 
 #ifndef NDEBUG
   std::string msg = "Issuing parallel sort. Sorter sizes: ";
@@ -234,15 +401,16 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
   util::StageTimer<std::milli> timer;
   timer.EnterStage("Parallel Sort Thread-Local Instances");
 
-  tbb::task_scheduler_init sched;
+  auto *scheduler = exec::MorselScheduler::Instance();
+  const auto options = exec_ctx_->GetSchedulingOptions();
   {
-    size_t num_threads = tbb::task_scheduler_init::default_num_threads();
+    size_t num_threads = scheduler->GetNumWorkers();
     size_t num_tasks = tl_sorters.size();
     size_t num_concurrent = std::min(num_threads, num_tasks);
     exec_ctx_->SetNumConcurrentEstimate(num_concurrent);
   }
 
-  tbb::parallel_for_each(tl_sorters, [thread_state_container, this](Sorter *sorter) {
+  scheduler->ParallelForEach(options, tl_sorters, [thread_state_container, this](Sorter *sorter) {
     auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLSortHook);
     auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLSortHook);
     auto *tls = thread_state_container->AccessCurrentThreadState();
@@ -360,13 +528,13 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
   };
 
   {
-    size_t num_threads = tbb::task_scheduler_init::default_num_threads();
+    size_t num_threads = scheduler->GetNumWorkers();
     size_t num_tasks = merge_work.size();
     size_t concurrent = std::min(num_threads, num_tasks);
     exec_ctx_->SetNumConcurrentEstimate(concurrent);
   }
 
-  tbb::parallel_for_each(merge_work, [&heap_cmp, thread_state_container, this](const MergeWork<SeqTypeIter> &work) {
+  scheduler->ParallelForEach(options, merge_work, [&heap_cmp, thread_state_container, this](const MergeWorkType &work) {
     auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLMergeHook);
     auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLMergeHook);
     auto *tls = thread_state_container->AccessCurrentThreadState();
@@ -431,17 +599,120 @@ void Sorter::SortTopKParallel(ThreadStateContainer *thread_state_container, uint
   }
 }
 
+//===----------------------------------------------------------------------===//
+//
+// Sorter Run Merger
+//
+//===----------------------------------------------------------------------===//
+
+SorterRunMerger::SorterRunMerger(const Sorter &sorter) : SorterRunMerger(sorter, 0, sorter.runs_.size()) {}
+
+SorterRunMerger::SorterRunMerger(const Sorter &sorter, const std::size_t first_run, const std::size_t num_runs)
+    : cmp_fn_(sorter.cmp_fn_), tuple_size_(sorter.tuple_storage_.ElementSize()), num_remaining_(0) {
+  NOISEPAGE_ASSERT(num_runs > 0, "Merger requires at least one run");
+  NOISEPAGE_ASSERT(first_run + num_runs <= sorter.runs_.size(), "Run range out of bounds");
+
+  cursors_.resize(num_runs);
+  for (std::size_t i = 0; i < num_runs; i++) {
+    const auto &run = sorter.runs_[first_run + i];
+    Cursor &cursor = cursors_[i];
+    cursor.file_ = run.file_;
+    cursor.next_offset_ = run.offset_;
+    cursor.num_unread_ = run.num_tuples_;
+    cursor.num_buffered_ = cursor.pos_ = 0;
+    Refill(&cursor);
+    num_remaining_ += run.num_tuples_;
+  }
+
+  InitTree();
+}
+
+void SorterRunMerger::Refill(Cursor *cursor) {
+  const uint64_t buffer_capacity = std::max<uint64_t>(1, Sorter::RUN_BUFFER_SIZE / tuple_size_);
+  const uint64_t num_tuples = std::min(buffer_capacity, cursor->num_unread_);
+  cursor->buffer_.resize(num_tuples * tuple_size_);
+  if (num_tuples > 0) {
+    cursor->file_->Read(cursor->next_offset_, cursor->buffer_.data(), num_tuples * tuple_size_);
+  }
+  cursor->next_offset_ += num_tuples * tuple_size_;
+  cursor->num_unread_ -= num_tuples;
+  cursor->num_buffered_ = num_tuples;
+  cursor->pos_ = 0;
+}
+
+bool SorterRunMerger::Beats(const uint32_t a, const uint32_t b) const {
+  // Exhausted runs lose every match.
+  if (cursors_[a].IsExhausted()) {
+    return false;
+  }
+  if (cursors_[b].IsExhausted()) {
+    return true;
+  }
+  // Ties go to the earlier run.
+  const int32_t result = cmp_fn_(cursors_[a].Current(tuple_size_), cursors_[b].Current(tuple_size_));
+  return result < 0 || (result == 0 && a < b);
+}
+
+void SorterRunMerger::InitTree() {
+  // Play all matches bottom-up. The leaves, i.e., the runs, are at positions
+  // [k, 2k) of an implicit binary tree whose inner nodes are [1, k).
+  const auto k = static_cast<uint32_t>(cursors_.size());
+  std::vector<uint32_t> winners(2 * k);
+  for (uint32_t i = 0; i < k; i++) {
+    winners[k + i] = i;
+  }
+  tree_.resize(k);
+  for (uint32_t node = k - 1; node >= 1; node--) {
+    const uint32_t left = winners[2 * node], right = winners[2 * node + 1];
+    const bool left_wins = Beats(left, right);
+    winners[node] = left_wins ? left : right;
+    tree_[node] = left_wins ? right : left;
+  }
+  tree_[0] = winners[1];
+}
+
+void SorterRunMerger::Next() {
+  NOISEPAGE_ASSERT(HasNext(), "Merger is exhausted");
+  num_remaining_--;
+
+  // Advance the winning run.
+  uint32_t winner = tree_[0];
+  Cursor &cursor = cursors_[winner];
+  if (++cursor.pos_ == cursor.num_buffered_ && cursor.num_unread_ > 0) {
+    Refill(&cursor);
+  }
+
+  // Replay the matches on the path from the winner's leaf to the root.
+  const auto k = static_cast<uint32_t>(cursors_.size());
+  for (uint32_t node = (winner + k) / 2; node >= 1; node /= 2) {
+    if (Beats(tree_[node], winner)) {
+      std::swap(tree_[node], winner);
+    }
+  }
+  tree_[0] = winner;
+}
+
 //===----------------------------------------------------------------------===//
 //
 // Sorter Iterator
 //
 //===----------------------------------------------------------------------===//
 
-SorterIterator::SorterIterator(const Sorter &sorter) : iter_(sorter.tuples_.begin()), end_(sorter.tuples_.end()) {}
+SorterIterator::SorterIterator(const Sorter &sorter)
+    : iter_(sorter.tuples_.begin()),
+      end_(sorter.tuples_.end()),
+      merger_(sorter.HasSpilled() ? std::make_unique<SorterRunMerger>(sorter) : nullptr) {
+  NOISEPAGE_ASSERT(!sorter.HasSpilled() || sorter.tuples_.empty(), "Spilled sorter must be sorted before iteration");
+}
 
 void SorterIterator::AdvanceBy(uint64_t n) {
   if (n > NumRemaining()) {
-    iter_ = end_;
+    n = NumRemaining();
+  }
+  if (merger_ != nullptr) {
+    for (; n > 0; n--) {
+      merger_->Next();
+    }
     return;
   }
   iter_ += n;
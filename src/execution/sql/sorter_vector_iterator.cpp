@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -14,6 +16,8 @@ SorterVectorIterator::SorterVectorIterator(const Sorter &sorter,
     : memory_(sorter.memory_),
       iter_(sorter),
       temp_rows_(memory_->AllocateArray<const byte *>(common::Constants::K_DEFAULT_VECTOR_SIZE, false)),
+      tuple_size_(sorter.tuple_storage_.ElementSize()),
+      staged_rows_(nullptr),
       vector_projection_(std::make_unique<VectorProjection>()),
       vector_projection_iterator_(std::make_unique<VectorProjectionIterator>()) {
   // First, initialize the vector projection
@@ -24,6 +28,12 @@ SorterVectorIterator::SorterVectorIterator(const Sorter &sorter,
   }
   vector_projection_->Initialize(col_types);
 
+  // Rows streamed from a spilled sorter have to be staged to remain valid
+  if (sorter.HasSpilled()) {
+    const std::size_t staged_size = common::Constants::K_DEFAULT_VECTOR_SIZE * tuple_size_;
+    staged_rows_ = memory_->AllocateArray<byte>(staged_size, alignof(std::max_align_t), false);
+  }
+
   // Now, move the iterator to the next valid position
   Next(transpose_fn);
 }
@@ -34,6 +44,9 @@ SorterVectorIterator::SorterVectorIterator(const Sorter &sorter, const catalog::
 
 SorterVectorIterator::~SorterVectorIterator() {
   memory_->DeallocateArray(temp_rows_, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  if (staged_rows_ != nullptr) {
+    memory_->DeallocateArray(staged_rows_, common::Constants::K_DEFAULT_VECTOR_SIZE * tuple_size_);
+  }
 }
 
 bool SorterVectorIterator::HasNext() const { return vector_projection_->GetSelectedTupleCount() > 0; }
@@ -43,6 +56,12 @@ void SorterVectorIterator::Next(const SorterVectorIterator::TransposeFn transpos
   uint32_t size = std::min(iter_.NumRemaining(), static_cast<uint64_t>(common::Constants::K_DEFAULT_VECTOR_SIZE));
   for (uint32_t i = 0; i < size; ++i, ++iter_) {
     temp_rows_[i] = iter_.GetRow();
+    if (staged_rows_ != nullptr) {
+      // Rows streamed from disk are invalidated as the iterator advances.
+      byte *staged_row = staged_rows_ + i * tuple_size_;
+      std::memcpy(staged_row, temp_rows_[i], tuple_size_);
+      temp_rows_[i] = staged_row;
+    }
   }
 
   // Setup vector projection
@@ -0,0 +1,54 @@
+#include "execution/sql/spill_file.h"
+
+#include <algorithm>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::sql {
+
+namespace {
+// The largest single positional I/O request we issue. util::File reports byte counts as 32-bit
+// integers, so larger transfers are broken up.
+constexpr std::size_t MAX_IO_SIZE = std::size_t{1} << 30;
+}  // namespace
+
+SpillFile::SpillFile() {
+  file_.CreateTemp(true);
+  if (file_.HasError()) {
+    throw EXECUTION_EXCEPTION(
+        fmt::format("Unable to create spill file: {}.", util::File::ErrorToString(file_.GetErrorIndicator())),
+        common::ErrorCode::ERRCODE_IO_ERROR);
+  }
+}
+
+std::size_t SpillFile::Append(const byte *data, const std::size_t len) {
+  // Reserve the range first so that concurrent appenders never overlap.
+  const std::size_t offset = size_.fetch_add(len, std::memory_order_relaxed);
+  for (std::size_t done = 0; done < len;) {
+    const std::size_t chunk = std::min(len - done, MAX_IO_SIZE);
+    const int32_t written = file_.WriteFullAtPosition(offset + done, data + done, chunk);
+    if (written < 0 || static_cast<std::size_t>(written) != chunk) {
+      throw EXECUTION_EXCEPTION(fmt::format("Failed writing {} bytes at offset {} to spill file.", len, offset),
+                                common::ErrorCode::ERRCODE_DISK_FULL);
+    }
+    done += chunk;
+  }
+  return offset;
+}
+
+void SpillFile::Read(const std::size_t offset, byte *data, const std::size_t len) const {
+  NOISEPAGE_ASSERT(offset + len <= GetSize(), "Out-of-bounds read from spill file");
+  for (std::size_t done = 0; done < len;) {
+    const std::size_t chunk = std::min(len - done, MAX_IO_SIZE);
+    const int32_t read = file_.ReadFullFromPosition(offset + done, data + done, chunk);
+    if (read < 0 || static_cast<std::size_t>(read) != chunk) {
+      throw EXECUTION_EXCEPTION(fmt::format("Failed reading {} bytes at offset {} from spill file.", len, offset),
+                                common::ErrorCode::ERRCODE_IO_ERROR);
+    }
+    done += chunk;
+  }
+}
+
+}  // namespace noisepage::execution::sql
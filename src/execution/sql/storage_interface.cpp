@@ -1,6 +1,7 @@
 #include "execution/sql/storage_interface.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
@@ -8,6 +9,7 @@
 #include "execution/util/execution_common.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
+#include "transaction/transaction_context.h"
 
 namespace noisepage::execution::sql {
 
@@ -35,10 +37,21 @@ StorageInterface::StorageInterface(exec::ExecutionContext *exec_ctx, catalog::ta
 
 StorageInterface::~StorageInterface() {
   if (need_indexes_) exec_ctx_->GetMemoryPool()->Deallocate(index_pr_buffer_, max_pr_size_);
+  if (worker_txn_ != nullptr) exec_ctx_->GetTxn()->MergeWorker(std::move(worker_txn_));
+}
+
+void StorageInterface::BeginWorker() {
+  NOISEPAGE_ASSERT(worker_txn_ == nullptr, "Storage interface already writes through a worker");
+  worker_txn_ = exec_ctx_->GetTxn()->BeginWorker();
+}
+
+common::ManagedPointer<transaction::TransactionContext> StorageInterface::GetTxn() {
+  return worker_txn_ != nullptr ? common::ManagedPointer<transaction::TransactionContext>(worker_txn_)
+                               : exec_ctx_->GetTxn();
 }
 
 storage::ProjectedRow *StorageInterface::GetTablePR() {
-  auto txn = exec_ctx_->GetTxn();
+  auto txn = GetTxn();
   table_redo_ = txn->StageWrite(exec_ctx_->DBOid(), table_oid_, pri_);
   return table_redo_->Delta();
 }
@@ -55,7 +68,7 @@ storage::ProjectedRow *StorageInterface::GetIndexPR(catalog::index_oid_t index_o
   return index_pr_;
 }
 
-storage::TupleSlot StorageInterface::TableInsert() { return table_->Insert(exec_ctx_->GetTxn(), table_redo_); }
+storage::TupleSlot StorageInterface::TableInsert() { return table_->Insert(GetTxn(), table_redo_); }
 
 uint32_t StorageInterface::GetIndexHeapSize() {
   NOISEPAGE_ASSERT(curr_index_ != nullptr, "Index must have been loaded");
@@ -63,39 +76,39 @@ uint32_t StorageInterface::GetIndexHeapSize() {
 }
 
 bool StorageInterface::TableDelete(storage::TupleSlot table_tuple_slot) {
-  auto txn = exec_ctx_->GetTxn();
+  auto txn = GetTxn();
   txn->StageDelete(exec_ctx_->DBOid(), table_oid_, table_tuple_slot);
-  return table_->Delete(exec_ctx_->GetTxn(), table_tuple_slot);
+  return table_->Delete(txn, table_tuple_slot);
 }
 
 bool StorageInterface::TableUpdate(storage::TupleSlot table_tuple_slot) {
   table_redo_->SetTupleSlot(table_tuple_slot);
-  return table_->Update(exec_ctx_->GetTxn(), table_redo_);
+  return table_->Update(GetTxn(), table_redo_);
 }
 
 uint64_t StorageInterface::IndexGetSize() const { return curr_index_->GetSize(); }
 
 bool StorageInterface::IndexInsert() {
   NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
-  return curr_index_->Insert(exec_ctx_->GetTxn(), *index_pr_, table_redo_->GetTupleSlot());
+  return curr_index_->Insert(GetTxn(), *index_pr_, table_redo_->GetTupleSlot());
 }
 
 bool StorageInterface::IndexInsertUnique() {
   NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
-  return curr_index_->InsertUnique(exec_ctx_->GetTxn(), *index_pr_, table_redo_->GetTupleSlot());
+  return curr_index_->InsertUnique(GetTxn(), *index_pr_, table_redo_->GetTupleSlot());
 }
 
 void StorageInterface::IndexDelete(storage::TupleSlot table_tuple_slot) {
   NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
-  curr_index_->Delete(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
+  curr_index_->Delete(GetTxn(), *index_pr_, table_tuple_slot);
 }
 
 bool StorageInterface::IndexInsertWithTuple(storage::TupleSlot table_tuple_slot, bool unique) {
   NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
   if (unique) {
-    return curr_index_->InsertUnique(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
+    return curr_index_->InsertUnique(GetTxn(), *index_pr_, table_tuple_slot);
   }
-  return curr_index_->Insert(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
+  return curr_index_->Insert(GetTxn(), *index_pr_, table_tuple_slot);
 }
 
 }  // namespace noisepage::execution::sql
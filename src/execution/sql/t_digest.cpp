@@ -0,0 +1,135 @@
+#include "execution/sql/t_digest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "common/macros.h"
+
+namespace noisepage::execution::sql {
+
+namespace {
+
+// Buffered values are merged into the centroids once there are this many times the compression
+// factor of them.
+constexpr double BUFFER_FACTOR = 5.0;
+
+}  // namespace
+
+TDigest::TDigest(const double compression)
+    : compression_(compression),
+      count_(0),
+      min_(std::numeric_limits<double>::max()),
+      max_(std::numeric_limits<double>::lowest()) {
+  NOISEPAGE_ASSERT(compression_ > 0.0, "Compression factor must be positive");
+}
+
+void TDigest::Add(const double value) {
+  buffer_.push_back(Centroid{value, 1.0});
+  count_++;
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+  if (static_cast<double>(buffer_.size()) >= BUFFER_FACTOR * compression_) {
+    Compress();
+  }
+}
+
+void TDigest::Merge(const TDigest &that) {
+  if (that.IsEmpty()) {
+    return;
+  }
+  buffer_.insert(buffer_.end(), that.centroids_.begin(), that.centroids_.end());
+  buffer_.insert(buffer_.end(), that.buffer_.begin(), that.buffer_.end());
+  count_ += that.count_;
+  min_ = std::min(min_, that.min_);
+  max_ = std::max(max_, that.max_);
+  Compress();
+}
+
+void TDigest::Clear() {
+  centroids_.clear();
+  buffer_.clear();
+  count_ = 0;
+  min_ = std::numeric_limits<double>::max();
+  max_ = std::numeric_limits<double>::lowest();
+}
+
+double TDigest::Scale(const double q) const { return compression_ / (2.0 * M_PI) * std::asin(2.0 * q - 1.0); }
+
+double TDigest::InverseScale(const double k) const {
+  if (k >= compression_ / 4.0) {
+    return 1.0;
+  }
+  return (std::sin(k * 2.0 * M_PI / compression_) + 1.0) / 2.0;
+}
+
+void TDigest::Compress() {
+  if (buffer_.empty()) {
+    return;
+  }
+
+  // Merge the buffered values and the existing centroids in a single pass over all of them in
+  // sorted order. A centroid absorbs its successor as long as its weight stays within the limit
+  // that the scale function sets at its quantile.
+  buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+  std::sort(buffer_.begin(), buffer_.end(), [](const auto &a, const auto &b) { return a.mean_ < b.mean_; });
+  centroids_.clear();
+
+  const auto total = static_cast<double>(count_);
+  double weight_so_far = 0.0;
+  double weight_limit = total * InverseScale(Scale(0.0) + 1.0);
+  Centroid current = buffer_[0];
+  for (std::size_t i = 1; i < buffer_.size(); i++) {
+    const Centroid &next = buffer_[i];
+    if (weight_so_far + current.weight_ + next.weight_ <= weight_limit) {
+      current.weight_ += next.weight_;
+      current.mean_ += (next.mean_ - current.mean_) * next.weight_ / current.weight_;
+    } else {
+      weight_so_far += current.weight_;
+      weight_limit = total * InverseScale(Scale(weight_so_far / total) + 1.0);
+      centroids_.push_back(current);
+      current = next;
+    }
+  }
+  centroids_.push_back(current);
+  buffer_.clear();
+}
+
+double TDigest::Quantile(const double q) const {
+  NOISEPAGE_ASSERT(!IsEmpty(), "Quantile of an empty digest");
+
+  if (!buffer_.empty()) {
+    TDigest compressed(*this);
+    compressed.Compress();
+    return compressed.Quantile(q);
+  }
+
+  // Every centroid stands for the values around its mean, so its mean is placed at the center of
+  // its weight. Values in between are interpolated linearly between the neighbouring centroids,
+  // and values before the first or after the last centroid between that centroid and the extrema.
+  const double index = std::clamp(q, 0.0, 1.0) * static_cast<double>(count_);
+
+  const Centroid &first = centroids_.front();
+  if (index < first.weight_ / 2.0) {
+    return min_ + (first.mean_ - min_) * index / (first.weight_ / 2.0);
+  }
+
+  double center = first.weight_ / 2.0;
+  for (std::size_t i = 0; i + 1 < centroids_.size(); i++) {
+    const Centroid &left = centroids_[i], &right = centroids_[i + 1];
+    const double gap = (left.weight_ + right.weight_) / 2.0;
+    if (index < center + gap) {
+      return left.mean_ + (right.mean_ - left.mean_) * (index - center) / gap;
+    }
+    center += gap;
+  }
+
+  const Centroid &last = centroids_.back();
+  const double rest = static_cast<double>(count_) - center;
+  if (rest <= 0.0) {
+    return max_;
+  }
+  return last.mean_ + (max_ - last.mean_) * std::min(1.0, (index - center) / rest);
+}
+
+}  // namespace noisepage::execution::sql
@@ -1,9 +1,6 @@
 #include "execution/sql/table_vector_iterator.h"
 
-#include <tbb/parallel_for.h>
-#include <tbb/task_arena.h>
-#include <tbb/task_scheduler_init.h>
-
+#include <algorithm>
 #include <limits>
 #include <numeric>
 #include <utility>
@@ -12,6 +9,7 @@
 #include "catalog/catalog_accessor.h"
 #include "execution/exec/execution_context.h"
 #include "execution/exec/execution_settings.h"
+#include "execution/exec/morsel_scheduler.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/timer.h"
 #include "loggers/execution_logger.h"
@@ -36,6 +34,8 @@ bool TableVectorIterator::Init(uint32_t block_start, uint32_t block_end) {
   // Set up the table and the iterator.
   table_ = exec_ctx_->GetAccessor()->GetTable(table_oid_);
   NOISEPAGE_ASSERT(table_ != nullptr, "Table must exist!!");
+  block_start_ = block_start;
+  block_end_ = std::min(block_end, table_->table_.data_table_->GetNumBlocks());
   if (block_start == 0 && block_end == storage::DataTable::GetMaxBlocks()) {
     iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->begin());
   } else {
@@ -53,6 +53,9 @@ bool TableVectorIterator::Init(uint32_t block_start, uint32_t block_end) {
 
     col_ids.emplace_back(storage_col_id);
     col_types[idx] = col_type;
+    if (col_type == TypeId::Varchar) {
+      dictionary_cols_.emplace_back(idx, storage_col_id);
+    }
   }
 
   // Create an owning vector.
@@ -65,19 +68,80 @@ bool TableVectorIterator::Init(uint32_t block_start, uint32_t block_end) {
   return true;
 }
 
+void TableVectorIterator::AddRangeFilter(const uint32_t col_idx, const int64_t low, const int64_t high) {
+  NOISEPAGE_ASSERT(IsInitialized(), "Range filters can only be added to an initialized iterator");
+  NOISEPAGE_ASSERT(col_idx < col_oids_.size(), "Column index out of range");
+  const auto col_id = table_->GetColumnMap().at(col_oids_[col_idx]).col_id_;
+  if (range_filters_.empty()) {
+    // Switch to block-at-a-time iteration, starting at the first block of the range.
+    next_block_ = block_start_;
+    iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->end());
+  }
+  range_filters_.push_back(RangeFilter{col_id, low, high});
+}
+
+bool TableVectorIterator::AdvanceToNextMatchingBlock() {
+  const auto *data_table = table_->table_.data_table_;
+  while (next_block_ < block_end_) {
+    const uint32_t block_idx = next_block_++;
+    const bool may_match = std::all_of(range_filters_.begin(), range_filters_.end(), [&](const RangeFilter &filter) {
+      return data_table->BlockMayContainRange(block_idx, filter.col_id_, filter.low_, filter.high_);
+    });
+    if (may_match) {
+      iter_ = std::make_unique<storage::DataTable::SlotIterator>(
+          table_->GetBlockedSlotIterator(block_idx, block_idx + 1));
+      return true;
+    }
+  }
+  return false;
+}
+
+void TableVectorIterator::AttachDictionaries(storage::RawBlock *const block) {
+  // Only attach when every scanned tuple came from the block and the block stayed frozen throughout the scan. A writer
+  // that thaws the block afterwards leaves versions behind that cannot be pruned while this transaction is running, so
+  // the block cannot be compacted and frozen again, and its dictionaries stay valid, until the scan is over.
+  const uint64_t num_tuples = vector_projection_.GetTotalTupleCount();
+  if (num_tuples == 0 || vector_projection_.GetTupleSlot(0).GetBlock() != block ||
+      vector_projection_.GetTupleSlot(num_tuples - 1).GetBlock() != block) {
+    return;
+  }
+  const auto *data_table = table_->table_.data_table_;
+  for (const auto &[col_idx, col_id] : dictionary_cols_) {
+    const storage::ArrowColumnInfo *col_info = data_table->GetFrozenDictionary(block, col_id);
+    if (col_info == nullptr) continue;
+    const uint64_t *indices = col_info->Indices();
+    uint32_t *codes = vector_projection_.SetColumnDictionary(col_idx, &col_info->VarlenColumn());
+    for (uint64_t i = 0; i < num_tuples; i++) {
+      codes[i] = static_cast<uint32_t>(indices[vector_projection_.GetTupleSlot(i).GetOffset()]);
+    }
+  }
+}
+
 bool TableVectorIterator::Advance() {
   // Cannot advance if not initialized.
   if (!IsInitialized()) {
     return false;
   }
 
-  // If the iterator is out of data, then we are done.
-  if (*iter_ == table_->end() || (**iter_).GetBlock() == nullptr) {
-    return false;
+  // If the iterator is out of data, then we are done, unless there are more blocks to visit.
+  while (*iter_ == table_->end() || (**iter_).GetBlock() == nullptr) {
+    if (range_filters_.empty() || !AdvanceToNextMatchingBlock()) {
+      return false;
+    }
+  }
+
+  // Note the block the scan starts in if it is frozen, since its string columns may then be dictionary-compressed.
+  storage::RawBlock *frozen_block = nullptr;
+  if (!dictionary_cols_.empty()) {
+    storage::RawBlock *block = (**iter_).GetBlock();
+    if (block->controller_.GetBlockState()->load() == storage::BlockState::FROZEN) frozen_block = block;
   }
 
   // Otherwise, scan the table to set the vector projection.
   table_->Scan(exec_ctx_->GetTxn(), iter_.get(), &vector_projection_);
+  if (frozen_block != nullptr) {
+    AttachDictionaries(frozen_block);
+  }
   vector_projection_iterator_.SetVectorProjection(&vector_projection_);
 
   return true;
@@ -97,12 +161,12 @@ class ScanTask {
         thread_state_container_(exec_ctx->GetThreadStateContainer()),
         scanner_(scanner) {}
 
-  void operator()(const tbb::blocked_range<uint32_t> &block_range) const {
+  void operator()(const std::size_t block_start, const std::size_t block_end) const {
     // Create the iterator over the specified block range
     TableVectorIterator iter{exec_ctx_, table_oid_, col_oids_, num_oids_};
 
     // Initialize it
-    if (!iter.Init(block_range.begin(), block_range.end())) {
+    if (!iter.Init(block_start, block_end)) {
       return;
     }
 
@@ -138,21 +202,21 @@ bool TableVectorIterator::ParallelScan(uint32_t table_oid, uint32_t *col_oids, u
   timer.Start();
 
   // Execute parallel scan
-  size_t num_threads = std::max(exec_ctx->GetExecutionSettings().GetNumberOfParallelExecutionThreads(), 0);
-  size_t num_tasks = std::ceil(table->table_.data_table_->GetNumBlocks() * 1.0 / min_grain_size);
+  auto *scheduler = exec::MorselScheduler::Instance();
+  const auto options = exec_ctx->GetScanSchedulingOptions();
+  const uint32_t num_blocks = table->table_.data_table_->GetNumBlocks();
+  size_t num_threads = options.max_parallelism_ == 0 ? scheduler->GetNumWorkers() : options.max_parallelism_;
+  size_t num_tasks = std::ceil(num_blocks * 1.0 / min_grain_size);
   size_t concurrent = std::min(num_threads, num_tasks);
   exec_ctx->SetNumConcurrentEstimate(concurrent);
 
-  tbb::task_arena limited_arena(num_threads);
-  tbb::blocked_range<uint32_t> block_range(0, table->table_.data_table_->GetNumBlocks(), min_grain_size);
-  const bool is_static_partitioned = exec_ctx->GetExecutionSettings().GetIsStaticPartitionerEnabled();
-  limited_arena.execute(
-      [&block_range, &table_oid, &col_oids, &num_oids, &query_state, &exec_ctx, &scan_fn, is_static_partitioned] {
-        is_static_partitioned
-            ? tbb::parallel_for(block_range, ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn),
-                                tbb::static_partitioner())
-            : tbb::parallel_for(block_range, ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn));
-      });
+  // With static partitioning, every thread scans one contiguous range of blocks.
+  size_t grain_size = min_grain_size;
+  if (exec_ctx->GetExecutionSettings().GetIsStaticPartitionerEnabled()) {
+    grain_size = std::max(grain_size, (num_blocks + num_threads - 1) / num_threads);
+  }
+  scheduler->ParallelFor(options, 0, num_blocks, grain_size,
+                         ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn));
 
   exec_ctx->SetNumConcurrentEstimate(0);
   timer.Stop();
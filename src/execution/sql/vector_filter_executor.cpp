@@ -0,0 +1,141 @@
+#include "execution/sql/vector_filter_executor.h"
+
+#include <cstring>
+
+#include "execution/sql/operators/like_operators.h"
+#include "storage/arrow_block_metadata.h"
+
+namespace noisepage::execution::sql {
+
+namespace {
+
+// A view over the sorted words of an Arrow dictionary.
+class SortedDictionary {
+ public:
+  explicit SortedDictionary(const storage::ArrowVarlenColumn &dictionary)
+      : dictionary_(dictionary), num_words_(dictionary.OffsetsLength() - 1) {}
+
+  uint32_t NumWords() const { return num_words_; }
+
+  storage::VarlenEntry Word(const uint32_t code) const {
+    const auto *offsets = dictionary_.Offsets();
+    return storage::VarlenEntry::Create(dictionary_.Values() + offsets[code],
+                                        static_cast<uint32_t>(offsets[code + 1] - offsets[code]), false);
+  }
+
+  // The first code in [begin, NumWords()) for which pred() is false, assuming pred() is true for a prefix of codes.
+  template <typename P>
+  uint32_t PartitionPoint(uint32_t begin, P pred) const {
+    uint32_t end = num_words_;
+    while (begin < end) {
+      const uint32_t mid = begin + (end - begin) / 2;
+      if (pred(Word(mid))) {
+        begin = mid + 1;
+      } else {
+        end = mid;
+      }
+    }
+    return begin;
+  }
+
+  // The first code whose word is not smaller than the given value.
+  uint32_t LowerBound(const storage::VarlenEntry &val) const {
+    return PartitionPoint(0, [&](const auto &word) { return storage::VarlenEntry::Compare(word, val) < 0; });
+  }
+
+  // The first code whose word is larger than the given value.
+  uint32_t UpperBound(const storage::VarlenEntry &val) const {
+    return PartitionPoint(0, [&](const auto &word) { return storage::VarlenEntry::Compare(word, val) <= 0; });
+  }
+
+ private:
+  const storage::ArrowVarlenColumn &dictionary_;
+  const uint32_t num_words_;
+};
+
+// If the LIKE pattern is a plain prefix followed only by '%' wildcards (e.g., 'abc%'), store the prefix in the
+// output argument and return true.
+bool IsPrefixPattern(const storage::VarlenEntry &pattern, storage::VarlenEntry *prefix) {
+  const auto *chars = reinterpret_cast<const char *>(pattern.Content());
+  uint32_t prefix_len = 0;
+  while (prefix_len < pattern.Size() && chars[prefix_len] != '%') {
+    if (chars[prefix_len] == '_' || chars[prefix_len] == DEFAULT_ESCAPE) return false;
+    prefix_len++;
+  }
+  if (prefix_len == pattern.Size()) return false;  // No wildcard at all, not a prefix pattern.
+  for (uint32_t i = prefix_len; i < pattern.Size(); i++) {
+    if (chars[i] != '%') return false;
+  }
+  *prefix = storage::VarlenEntry::Create(pattern.Content(), prefix_len, false);
+  return true;
+}
+
+}  // namespace
+
+bool VectorFilterExecutor::SelectOnDictionary(const DictionaryComparison cmp, VectorProjection *vector_projection,
+                                              const uint32_t col_idx, const GenericValue &val,
+                                              TupleIdList *tid_list) {
+  const storage::ArrowVarlenColumn *dictionary = vector_projection->GetColumnDictionary(col_idx);
+  if (dictionary == nullptr || val.GetTypeId() != TypeId::Varchar) {
+    return false;
+  }
+
+  // Comparisons with NULL are never true.
+  if (val.IsNull()) {
+    tid_list->Clear();
+    return true;
+  }
+
+  const ConstantVector constant_vector(val);
+  const auto &constant = *reinterpret_cast<const storage::VarlenEntry *>(constant_vector.GetData());
+  const SortedDictionary words(*dictionary);
+
+  // Since the dictionary is sorted, every comparison selects a contiguous range of codes [low, high), or its
+  // complement when negated.
+  uint32_t low = 0, high = words.NumWords();
+  bool negate = false;
+  switch (cmp) {
+    case DictionaryComparison::SelectNotEqual:
+      negate = true;
+      // fall through
+    case DictionaryComparison::SelectEqual:
+      low = words.LowerBound(constant);
+      high = words.UpperBound(constant);
+      break;
+    case DictionaryComparison::SelectGreaterThan:
+      low = words.UpperBound(constant);
+      break;
+    case DictionaryComparison::SelectGreaterThanEqual:
+      low = words.LowerBound(constant);
+      break;
+    case DictionaryComparison::SelectLessThan:
+      high = words.LowerBound(constant);
+      break;
+    case DictionaryComparison::SelectLessThanEqual:
+      high = words.UpperBound(constant);
+      break;
+    case DictionaryComparison::SelectNotLike:
+      negate = true;
+      // fall through
+    case DictionaryComparison::SelectLike: {
+      storage::VarlenEntry prefix;
+      if (!IsPrefixPattern(constant, &prefix)) {
+        return false;
+      }
+      // Words that start with the prefix follow right after the words that are smaller than the prefix.
+      low = words.LowerBound(prefix);
+      high = words.PartitionPoint(low, [&](const storage::VarlenEntry &word) {
+        return word.Size() >= prefix.Size() && std::memcmp(word.Content(), prefix.Content(), prefix.Size()) == 0;
+      });
+      break;
+    }
+  }
+
+  // Remove NULLs, then filter on the codes.
+  const uint32_t *codes = vector_projection->GetDictionaryCodes(col_idx);
+  tid_list->GetMutableBits()->Difference(vector_projection->GetColumn(col_idx)->GetNullMask());
+  tid_list->Filter([&](const uint64_t i) { return (low <= codes[i] && codes[i] < high) != negate; });
+  return true;
+}
+
+}  // namespace noisepage::execution::sql
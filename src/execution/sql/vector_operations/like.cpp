@@ -23,8 +23,11 @@ void TemplatedLikeOperationVectorConstant(const Vector &a, const Vector &b, Tupl
   // Remove NULL entries from the left input
   tid_list->GetMutableBits()->Difference(a.GetNullMask());
 
+  // Compile the pattern once for the whole vector
+  const LikePattern pattern(b_data[0]);
+
   // Lift-off
-  tid_list->Filter([&](const uint64_t i) { return Op{}(a_data[i], b_data[0]); });
+  tid_list->Filter([&](const uint64_t i) { return Op{}(a_data[i], pattern); });
 }
 
 template <typename Op>
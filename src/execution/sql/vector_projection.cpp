@@ -116,6 +116,8 @@ void VectorProjection::Reset(uint64_t num_tuples) {
   }
 
   tuple_slots_.resize(num_tuples);
+
+  ClearDictionaries();
 }
 
 void VectorProjection::Pack() {
@@ -130,6 +132,29 @@ void VectorProjection::Pack() {
   for (auto &col : columns_) {
     col->Pack();
   }
+
+  // The codes are not packed along with the data.
+  ClearDictionaries();
+}
+
+uint32_t *VectorProjection::SetColumnDictionary(const uint32_t col_idx, const storage::ArrowVarlenColumn *dictionary) {
+  NOISEPAGE_ASSERT(col_idx < GetColumnCount(), "Out-of-bounds column access");
+  NOISEPAGE_ASSERT(GetColumnType(col_idx) == TypeId::Varchar, "Only string columns can be dictionary-encoded");
+  if (dictionaries_.size() != columns_.size()) {
+    dictionaries_.resize(columns_.size());
+  }
+  ColumnDictionary &col_dictionary = dictionaries_[col_idx];
+  if (col_dictionary.codes_ == nullptr) {
+    col_dictionary.codes_ = std::make_unique<uint32_t[]>(common::Constants::K_DEFAULT_VECTOR_SIZE);
+  }
+  col_dictionary.dictionary_ = dictionary;
+  return col_dictionary.codes_.get();
+}
+
+void VectorProjection::ClearDictionaries() {
+  for (auto &col_dictionary : dictionaries_) {
+    col_dictionary.dictionary_ = nullptr;
+  }
 }
 
 void VectorProjection::ProjectColumns(const std::vector<uint32_t> &cols, VectorProjection *result) const {
@@ -90,6 +90,7 @@ void BytecodeEmitter::Bind(BytecodeLabel *label) {
   }
 
   label->BindTo(curr_offset);
+  last_bound_pos_ = curr_offset;
 }
 
 void BytecodeEmitter::EmitJump(BytecodeLabel *label) {
@@ -125,10 +126,36 @@ void BytecodeEmitter::EmitJump(Bytecode bytecode, BytecodeLabel *label) {
 
 void BytecodeEmitter::EmitConditionalJump(Bytecode bytecode, LocalVar cond, BytecodeLabel *label) {
   NOISEPAGE_ASSERT(Bytecodes::IsJump(bytecode), "Provided bytecode is not a jump");
-  EmitAll(bytecode, cond);
+  if (bytecode != Bytecode::JumpIfFalse || !FuseJumpIfFalse(cond)) {
+    EmitAll(bytecode, cond);
+  }
   EmitJump(label);
 }
 
+bool BytecodeEmitter::FuseJumpIfFalse(LocalVar cond) {
+  // Nothing may jump to the conditional jump itself, since it no longer exists on its own once fused.
+  if (last_bytecode_pos_ >= GetPosition() || last_bound_pos_ == GetPosition()) {
+    return false;
+  }
+
+  using BytecodeType = std::underlying_type_t<Bytecode>;
+  uint8_t *const last = &(*bytecode_)[last_bytecode_pos_];
+  const Bytecode condition = Bytecodes::FromByte(*reinterpret_cast<const BytecodeType *>(last));
+  const Bytecode fused = Bytecodes::GetFusedJumpIfFalse(condition);
+  if (fused == Bytecode::JumpIfFalse) {
+    return false;
+  }
+
+  // The last bytecode must compute the condition. The jump offset is appended to its operands.
+  const uint32_t dest_offset = Bytecodes::GetNthOperandOffset(condition, 0);
+  const LocalVar dest = LocalVar::Decode(*reinterpret_cast<const uint32_t *>(last + dest_offset));
+  if (dest.GetAddressMode() != LocalVar::AddressMode::Address || !(dest.ValueOf() == cond)) {
+    return false;
+  }
+  *reinterpret_cast<BytecodeType *>(last) = Bytecodes::ToByte(fused);
+  return true;
+}
+
 void BytecodeEmitter::Emit(Bytecode bytecode, LocalVar operand_1) {
   NOISEPAGE_ASSERT(Bytecodes::NumOperands(bytecode) == 1, "Incorrect operand count for bytecode");
   NOISEPAGE_ASSERT(Bytecodes::GetNthOperandType(bytecode, 0) == OperandType::Local,
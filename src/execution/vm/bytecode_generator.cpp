@@ -688,6 +688,13 @@ void BytecodeGenerator::VisitBuiltinTableIterCall(ast::CallExpr *call, ast::Buil
       GetExecutionResult()->SetDestination(vpi.ValueOf());
       break;
     }
+    case ast::Builtin::TableIterAddRangeFilter: {
+      LocalVar col_idx = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar low = VisitExpressionForRValue(call->Arguments()[2]);
+      LocalVar high = VisitExpressionForRValue(call->Arguments()[3]);
+      GetEmitter()->Emit(Bytecode::TableVectorIteratorAddRangeFilter, iter, col_idx, low, high);
+      break;
+    }
     case ast::Builtin::TableIterClose: {
       GetEmitter()->Emit(Bytecode::TableVectorIteratorFree, iter);
       break;
@@ -1265,7 +1272,44 @@ namespace {
   /* HISTOGRAM(timestamp_col) */                                                                                       \
   F(TimestampHistogramAggregate, TimestampHistogramAggregateInit, TimestampHistogramAggregateAdvance,                  \
     TimestampHistogramAggregateGetResult, TimestampHistogramAggregateMerge, TimestampHistogramAggregateReset,          \
-    TimestampHistogramAggregateFree)
+    TimestampHistogramAggregateFree)                                                                                   \
+  /* APPROX_COUNT_DISTINCT(bool_col) */                                                                                \
+  F(BooleanApproxCountDistinctAggregate, BooleanApproxCountDistinctAggregateInit,                                      \
+    BooleanApproxCountDistinctAggregateAdvance, BooleanApproxCountDistinctAggregateGetResult,                          \
+    BooleanApproxCountDistinctAggregateMerge, BooleanApproxCountDistinctAggregateReset,                                \
+    BooleanApproxCountDistinctAggregateFree)                                                                           \
+  /* APPROX_COUNT_DISTINCT(int_col) */                                                                                 \
+  F(IntegerApproxCountDistinctAggregate, IntegerApproxCountDistinctAggregateInit,                                      \
+    IntegerApproxCountDistinctAggregateAdvance, IntegerApproxCountDistinctAggregateGetResult,                          \
+    IntegerApproxCountDistinctAggregateMerge, IntegerApproxCountDistinctAggregateReset,                                \
+    IntegerApproxCountDistinctAggregateFree)                                                                           \
+  /* APPROX_COUNT_DISTINCT(real_col) */                                                                                \
+  F(RealApproxCountDistinctAggregate, RealApproxCountDistinctAggregateInit, RealApproxCountDistinctAggregateAdvance,   \
+    RealApproxCountDistinctAggregateGetResult, RealApproxCountDistinctAggregateMerge,                                  \
+    RealApproxCountDistinctAggregateReset, RealApproxCountDistinctAggregateFree)                                       \
+  /* APPROX_COUNT_DISTINCT(decimal_col) */                                                                             \
+  F(DecimalApproxCountDistinctAggregate, DecimalApproxCountDistinctAggregateInit,                                      \
+    DecimalApproxCountDistinctAggregateAdvance, DecimalApproxCountDistinctAggregateGetResult,                          \
+    DecimalApproxCountDistinctAggregateMerge, DecimalApproxCountDistinctAggregateReset,                                \
+    DecimalApproxCountDistinctAggregateFree)                                                                           \
+  /* APPROX_COUNT_DISTINCT(string_col) */                                                                              \
+  F(StringApproxCountDistinctAggregate, StringApproxCountDistinctAggregateInit,                                        \
+    StringApproxCountDistinctAggregateAdvance, StringApproxCountDistinctAggregateGetResult,                            \
+    StringApproxCountDistinctAggregateMerge, StringApproxCountDistinctAggregateReset,                                  \
+    StringApproxCountDistinctAggregateFree)                                                                            \
+  /* APPROX_COUNT_DISTINCT(date_col) */                                                                                \
+  F(DateApproxCountDistinctAggregate, DateApproxCountDistinctAggregateInit, DateApproxCountDistinctAggregateAdvance,   \
+    DateApproxCountDistinctAggregateGetResult, DateApproxCountDistinctAggregateMerge,                                  \
+    DateApproxCountDistinctAggregateReset, DateApproxCountDistinctAggregateFree)                                       \
+  /* APPROX_COUNT_DISTINCT(timestamp_col) */                                                                           \
+  F(TimestampApproxCountDistinctAggregate, TimestampApproxCountDistinctAggregateInit,                                  \
+    TimestampApproxCountDistinctAggregateAdvance, TimestampApproxCountDistinctAggregateGetResult,                      \
+    TimestampApproxCountDistinctAggregateMerge, TimestampApproxCountDistinctAggregateReset,                            \
+    TimestampApproxCountDistinctAggregateFree)                                                                         \
+  /* APPROX_PERCENTILE(col, percentile) */                                                                             \
+  F(ApproxPercentileAggregate, ApproxPercentileAggregateInit, ApproxPercentileAggregateAdvanceInteger,                 \
+    ApproxPercentileAggregateGetResult, ApproxPercentileAggregateMerge, ApproxPercentileAggregateReset,                \
+    ApproxPercentileAggregateFree)
 
 enum class AggOpKind : uint8_t { Init = 0, Advance = 1, GetResult = 2, Merge = 3, Reset = 4, Free = 5 };
 
@@ -1394,6 +1438,16 @@ void BytecodeGenerator::VisitBuiltinAggregatorCall(ast::CallExpr *call, ast::Bui
         bytecode = Bytecode::AvgAggregateAdvanceReal;
       }
 
+      // Approximate percentiles take the percentile to compute as an additional input.
+      if (agg_kind == ast::BuiltinType::ApproxPercentileAggregate) {
+        if (args[1]->GetType()->GetPointeeType()->IsSpecificBuiltin(ast::BuiltinType::Real)) {
+          bytecode = Bytecode::ApproxPercentileAggregateAdvanceReal;
+        }
+        LocalVar percentile = VisitExpressionForRValue(args[2]);
+        GetEmitter()->Emit(bytecode, agg, input, percentile);
+        break;
+      }
+
       GetEmitter()->Emit(bytecode, agg, input);
       break;
     }
@@ -1463,12 +1517,46 @@ void BytecodeGenerator::VisitBuiltinJoinHashTableCall(ast::CallExpr *call, ast::
       GetEmitter()->Emit(Bytecode::JoinHashTableBuildParallel, join_hash_table, tls, jht_offset);
       break;
     }
+    case ast::Builtin::JoinHashTableBuildPartitioned: {
+      LocalVar tls = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar jht_offset = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableBuildPartitioned, join_hash_table, tls, jht_offset);
+      break;
+    }
     case ast::Builtin::JoinHashTableLookup: {
       LocalVar ht_entry_iter = VisitExpressionForRValue(call->Arguments()[1]);
       LocalVar hash = VisitExpressionForRValue(call->Arguments()[2]);
       GetEmitter()->Emit(Bytecode::JoinHashTableLookup, join_hash_table, ht_entry_iter, hash);
       break;
     }
+    case ast::Builtin::JoinHashTableEnableSpilling: {
+      GetEmitter()->Emit(Bytecode::JoinHashTableEnableSpilling, join_hash_table);
+      break;
+    }
+    case ast::Builtin::JoinHashTableIsResident: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableIsResident, dest, join_hash_table, hash);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextPass: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::JoinHashTableNextPass, dest, join_hash_table);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableEnableBloomFilter: {
+      GetEmitter()->Emit(Bytecode::JoinHashTableEnableBloomFilter, join_hash_table);
+      break;
+    }
+    case ast::Builtin::JoinHashTableMayContain: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableMayContain, dest, join_hash_table, hash);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       GetEmitter()->Emit(Bytecode::JoinHashTableFree, join_hash_table);
       break;
@@ -1501,6 +1589,40 @@ void BytecodeGenerator::VisitBuiltinHashTableEntryIteratorCall(ast::CallExpr *ca
   }
 }
 
+void BytecodeGenerator::VisitBuiltinJoinHashTableBatchProbeCall(ast::CallExpr *call, ast::Builtin builtin) {
+  // The batch probe is always the first argument to all calls
+  LocalVar probe = VisitExpressionForRValue(call->Arguments()[0]);
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableBatchProbeInit: {
+      GetEmitter()->Emit(Bytecode::JoinHashTableBatchProbeInit, probe);
+      break;
+    }
+    case ast::Builtin::JoinHashTableBatchProbeAddHash: {
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableBatchProbeAddHash, probe, hash);
+      break;
+    }
+    case ast::Builtin::JoinHashTableBatchProbeLookup: {
+      LocalVar join_hash_table = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableBatchProbeLookup, probe, join_hash_table);
+      break;
+    }
+    case ast::Builtin::JoinHashTableBatchProbeNext: {
+      LocalVar ht_entry_iter = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableBatchProbeNext, probe, ht_entry_iter);
+      break;
+    }
+    case ast::Builtin::JoinHashTableBatchProbeFree: {
+      GetEmitter()->Emit(Bytecode::JoinHashTableBatchProbeFree, probe);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table batch probe call");
+    }
+  }
+}
+
 void BytecodeGenerator::VisitBuiltinJoinHashTableIteratorCall(ast::CallExpr *call, ast::Builtin builtin) {
   switch (builtin) {
     case ast::Builtin::JoinHashTableIterInit: {
@@ -2346,6 +2468,10 @@ void BytecodeGenerator::VisitBuiltinStorageInterfaceCall(ast::CallExpr *call, as
                                              col_oids, num_oids, is_index_key_update);
       break;
     }
+    case ast::Builtin::StorageInterfaceBeginWorker: {
+      GetEmitter()->Emit(Bytecode::StorageInterfaceBeginWorker, storage_interface);
+      break;
+    }
     case ast::Builtin::GetTablePR: {
       LocalVar pr = GetExecutionResult()->GetOrCreateDestination(call->GetType());
       GetEmitter()->Emit(Bytecode::StorageInterfaceGetTablePR, pr, storage_interface);
@@ -2749,6 +2875,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterGetVPINumTuples:
     case ast::Builtin::TableIterGetVPI:
+    case ast::Builtin::TableIterAddRangeFilter:
     case ast::Builtin::TableIterClose: {
       VisitBuiltinTableIterCall(call, builtin);
       break;
@@ -2881,7 +3008,13 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::JoinHashTableGetTupleCount:
     case ast::Builtin::JoinHashTableBuild:
     case ast::Builtin::JoinHashTableBuildParallel:
+    case ast::Builtin::JoinHashTableBuildPartitioned:
     case ast::Builtin::JoinHashTableLookup:
+    case ast::Builtin::JoinHashTableEnableSpilling:
+    case ast::Builtin::JoinHashTableIsResident:
+    case ast::Builtin::JoinHashTableNextPass:
+    case ast::Builtin::JoinHashTableEnableBloomFilter:
+    case ast::Builtin::JoinHashTableMayContain:
     case ast::Builtin::JoinHashTableFree: {
       VisitBuiltinJoinHashTableCall(call, builtin);
       break;
@@ -2891,6 +3024,14 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinHashTableEntryIteratorCall(call, builtin);
       break;
     }
+    case ast::Builtin::JoinHashTableBatchProbeInit:
+    case ast::Builtin::JoinHashTableBatchProbeAddHash:
+    case ast::Builtin::JoinHashTableBatchProbeLookup:
+    case ast::Builtin::JoinHashTableBatchProbeNext:
+    case ast::Builtin::JoinHashTableBatchProbeFree: {
+      VisitBuiltinJoinHashTableBatchProbeCall(call, builtin);
+      break;
+    }
     case ast::Builtin::JoinHashTableIterInit:
     case ast::Builtin::JoinHashTableIterHasNext:
     case ast::Builtin::JoinHashTableIterNext:
@@ -2943,6 +3084,9 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
     case ast::Builtin::IndexIteratorScanLimitDescending:
+    case ast::Builtin::IndexIteratorAddBatchKey:
+    case ast::Builtin::IndexIteratorScanKeyBatch:
+    case ast::Builtin::IndexIteratorNextBatchKey:
     case ast::Builtin::IndexIteratorAdvance:
     case ast::Builtin::IndexIteratorFree:
     case ast::Builtin::IndexIteratorGetPR:
@@ -3036,6 +3180,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       break;
     }
     case ast::Builtin::StorageInterfaceInit:
+    case ast::Builtin::StorageInterfaceBeginWorker:
     case ast::Builtin::GetTablePR:
     case ast::Builtin::TableInsert:
     case ast::Builtin::TableDelete:
@@ -3197,6 +3342,19 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       GetEmitter()->Emit(Bytecode::IndexIteratorScanLimitDescending, iterator, limit);
       break;
     }
+    case ast::Builtin::IndexIteratorAddBatchKey: {
+      GetEmitter()->Emit(Bytecode::IndexIteratorAddBatchKey, iterator);
+      break;
+    }
+    case ast::Builtin::IndexIteratorScanKeyBatch: {
+      auto sort_keys = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::IndexIteratorScanKeyBatch, iterator, sort_keys);
+      break;
+    }
+    case ast::Builtin::IndexIteratorNextBatchKey: {
+      GetEmitter()->Emit(Bytecode::IndexIteratorNextBatchKey, iterator);
+      break;
+    }
     case ast::Builtin::IndexIteratorAdvance: {
       LocalVar cond = GetExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
       GetEmitter()->Emit(Bytecode::IndexIteratorAdvance, cond, iterator);
@@ -87,10 +87,36 @@ void OpJoinHashTableBuildParallel(noisepage::execution::sql::JoinHashTable *join
   join_hash_table->MergeParallel(thread_state_container, jht_offset);
 }
 
+void OpJoinHashTableBuildPartitioned(noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                     noisepage::execution::sql::ThreadStateContainer *thread_state_container,
+                                     uint32_t jht_offset) {
+  join_hash_table->MergeParallelPartitioned(thread_state_container, jht_offset);
+}
+
+void OpJoinHashTableEnableSpilling(noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  join_hash_table->EnableSpilling();
+}
+
+void OpJoinHashTableNextPass(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  *result = join_hash_table->NextPass();
+}
+
+void OpJoinHashTableEnableBloomFilter(noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  join_hash_table->EnableBloomFilter();
+}
+
 void OpJoinHashTableFree(noisepage::execution::sql::JoinHashTable *join_hash_table) {
   join_hash_table->~JoinHashTable();
 }
 
+void OpJoinHashTableBatchProbeInit(noisepage::execution::sql::JoinHashTableBatchProbe *probe) {
+  new (probe) noisepage::execution::sql::JoinHashTableBatchProbe();
+}
+
+void OpJoinHashTableBatchProbeFree(noisepage::execution::sql::JoinHashTableBatchProbe *probe) {
+  probe->~JoinHashTableBatchProbe();
+}
+
 void OpJoinHashTableIteratorInit(noisepage::execution::sql::JoinHashTableIterator *iter,
                                  noisepage::execution::sql::JoinHashTable *join_hash_table) {
   NOISEPAGE_ASSERT(join_hash_table != nullptr, "Null hash table");
@@ -207,6 +233,10 @@ void OpStorageInterfaceInit(noisepage::execution::sql::StorageInterface *storage
       exec_ctx, noisepage::catalog::table_oid_t(table_oid), col_oids, num_oids, need_indexes);
 }
 
+void OpStorageInterfaceBeginWorker(noisepage::execution::sql::StorageInterface *storage_interface) {
+  storage_interface->BeginWorker();
+}
+
 void OpStorageInterfaceGetTablePR(noisepage::storage::ProjectedRow **pr_result,
                                   noisepage::execution::sql::StorageInterface *storage_interface) {
   *pr_result = storage_interface->GetTablePR();
@@ -51,6 +51,18 @@ uint32_t Bytecodes::MaxBytecodeNameLength() {
   return max_inst_name_length;
 }
 
+Bytecode Bytecodes::GetFusedJumpIfFalse(Bytecode condition) {
+  switch (condition) {
+#define ENTRY(G, op, ...) \
+  case Bytecode::op:      \
+    return Bytecode::op##_JumpIfFalse;
+    FUSABLE_CONDITION_LIST(ENTRY, _)
+#undef ENTRY
+    default:
+      return Bytecode::JumpIfFalse;
+  }
+}
+
 uint32_t Bytecodes::GetNthOperandOffset(Bytecode bytecode, uint32_t operand_index) {
   NOISEPAGE_ASSERT(operand_index < NumOperands(bytecode), "Invalid operand index");
   uint32_t offset = sizeof(std::underlying_type_t<Bytecode>);
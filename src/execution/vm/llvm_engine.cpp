@@ -12,6 +12,8 @@
 #include <llvm/IR/Verifier.h>
 #include <llvm/MC/MCContext.h>
 #include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/SmallVectorMemoryBuffer.h>
 #include <llvm/Support/TargetRegistry.h>
@@ -28,10 +30,12 @@
 #include <utility>
 #include <vector>
 
+#include "common/hash_util.h"
 #include "execution/ast/type.h"
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/bytecode_traits.h"
 #include "loggers/execution_logger.h"
+#include "spdlog/fmt/fmt.h"
 
 extern void *__dso_handle __attribute__((__visibility__("hidden")));  // NOLINT
 
@@ -358,7 +362,8 @@ llvm::Value *LLVMEngine::FunctionLocalsMap::GetArgumentById(LocalVar var) {
 /** A builder for compiled modules. We need this because compiled modules are immutable after creation. */
 class LLVMEngine::CompiledModuleBuilder {
  public:
-  CompiledModuleBuilder(const CompilerOptions &options, const BytecodeModule &tpl_module);
+  CompiledModuleBuilder(const CompilerOptions &options, const BytecodeModule &tpl_module,
+                        const std::vector<FunctionId> &functions);
 
   // No copying or moving this class
   DISALLOW_COPY_AND_MOVE(CompiledModuleBuilder);
@@ -369,9 +374,9 @@ class LLVMEngine::CompiledModuleBuilder {
   // Generate function declarations for each function in the TPL bytecode module
   void DeclareFunctions();
 
-  // Generate an LLVM function implementation for each function defined in the
-  // TPL bytecode module. DeclareFunctions() must be called to generate function
-  // declarations before they can be defined.
+  // Generate an LLVM function implementation for each function of the TPL
+  // bytecode module that is to be compiled. DeclareFunctions() must be called to
+  // generate function declarations before they can be defined.
   void DefineFunctions();
 
   // Verify that all generated code is good
@@ -383,8 +388,9 @@ class LLVMEngine::CompiledModuleBuilder {
   // Optimize the generate code
   void Optimize();
 
-  // Perform finalization logic and create a compiled module
-  std::unique_ptr<CompiledModule> Finalize();
+  // Perform finalization logic and create a compiled module. If an object
+  // cache file name is given, the object code is also written to that file.
+  std::unique_ptr<CompiledModule> Finalize(const std::string &object_cache_file);
 
   // Print the contents of the module to a string and return it
   std::string DumpModuleIR();
@@ -409,9 +415,13 @@ class LLVMEngine::CompiledModuleBuilder {
   // Write the given object to the file system
   void PersistObjectToFile(const llvm::MemoryBuffer &obj_buffer);
 
+  // Write the given object to the object cache
+  void PersistObjectToCache(const llvm::MemoryBuffer &obj_buffer, const std::string &object_cache_file);
+
  private:
   const CompilerOptions &options_;
   const BytecodeModule &tpl_module_;
+  const std::vector<FunctionId> &functions_;
   std::unique_ptr<llvm::TargetMachine> target_machine_;
   std::unique_ptr<llvm::LLVMContext> context_;
   std::unique_ptr<llvm::Module> llvm_module_;
@@ -424,9 +434,11 @@ class LLVMEngine::CompiledModuleBuilder {
 // ---------------------------------------------------------
 
 LLVMEngine::CompiledModuleBuilder::CompiledModuleBuilder(const CompilerOptions &options,
-                                                         const BytecodeModule &tpl_module)
+                                                         const BytecodeModule &tpl_module,
+                                                         const std::vector<FunctionId> &functions)
     : options_(options),
       tpl_module_(tpl_module),
+      functions_(functions),
       target_machine_(nullptr),
       context_(std::make_unique<llvm::LLVMContext>()),
       llvm_module_(nullptr),
@@ -606,8 +618,9 @@ void LLVMEngine::CompiledModuleBuilder::BuildSimpleCFG(const FunctionInfo &func_
           (*blocks)[fallthrough_pos] = nullptr;
         }
 
-        std::size_t branch_target_pos =
-            iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, 1) + iter.GetJumpOffsetOperand(1);
+        const uint32_t offset_index = Bytecodes::GetJumpOffsetOperandIndex(bytecode);
+        std::size_t branch_target_pos = iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, offset_index) +
+                                        iter.GetJumpOffsetOperand(offset_index);
 
         if (blocks->find(branch_target_pos) == blocks->end()) {
           bb_begin_positions.push_back(branch_target_pos);
@@ -900,7 +913,23 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
       default: {
         // In the default case, each bytecode makes a function call into its bytecode handler
         llvm::Function *handler = LookupBytecodeHandler(bytecode);
-        issue_call(handler, args);
+        llvm::Value *ret = issue_call(handler, args);
+
+        // The handler of a superinstruction ending in a conditional jump returns whether the jump is taken
+        if (Bytecodes::IsFusedConditionalJump(bytecode)) {
+          const uint32_t offset_index = Bytecodes::GetJumpOffsetOperandIndex(bytecode);
+          std::size_t fallthrough_bb_pos = iter.GetPosition() + iter.CurrentBytecodeSize();
+          std::size_t branch_target_bb_pos = iter.GetPosition() +
+                                             Bytecodes::GetNthOperandOffset(bytecode, offset_index) +
+                                             iter.GetJumpOffsetOperand(offset_index);
+          NOISEPAGE_ASSERT(blocks[fallthrough_bb_pos] != nullptr,
+                           "Branch fallthrough does not point to valid basic block");
+          NOISEPAGE_ASSERT(blocks[branch_target_bb_pos] != nullptr,
+                           "Branch target does not point to valid basic block");
+
+          llvm::Value *taken = ir_builder->CreateICmpNE(ret, llvm::ConstantInt::get(ret->getType(), 0, false));
+          ir_builder->CreateCondBr(taken, blocks[branch_target_bb_pos], blocks[fallthrough_bb_pos]);
+        }
         break;
       }
     }
@@ -922,8 +951,8 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
 
 void LLVMEngine::CompiledModuleBuilder::DefineFunctions() {
   llvm::IRBuilder<> ir_builder(*context_);
-  for (const auto &func_info : tpl_module_.GetFunctionsInfo()) {
-    DefineFunction(func_info, &ir_builder);
+  for (const FunctionId func_id : functions_) {
+    DefineFunction(*tpl_module_.GetFuncInfoById(func_id), &ir_builder);
   }
 }
 
@@ -948,6 +977,11 @@ void LLVMEngine::CompiledModuleBuilder::Simplify() {
 }
 
 void LLVMEngine::CompiledModuleBuilder::Optimize() {
+  const uint32_t opt_level = options_.GetOptimizationLevel();
+  if (opt_level == 0) {
+    return;
+  }
+
   llvm::legacy::PassManager module_passes;
   llvm::legacy::FunctionPassManager function_passes(llvm_module_.get());
 
@@ -959,8 +993,8 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
 
   // Build up optimization pipeline
   llvm::PassManagerBuilder pm_builder;
-  pm_builder.OptLevel = 3;
-  pm_builder.Inliner = llvm::createFunctionInliningPass(3, 0, false);
+  pm_builder.OptLevel = opt_level;
+  pm_builder.Inliner = llvm::createFunctionInliningPass(opt_level, 0, false);
   pm_builder.populateFunctionPassManager(function_passes);
   pm_builder.populateModulePassManager(module_passes);
 
@@ -973,13 +1007,18 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
   module_passes.run(*llvm_module_);
 }
 
-std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::CompiledModuleBuilder::Finalize() {
+std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::CompiledModuleBuilder::Finalize(
+    const std::string &object_cache_file) {
   std::unique_ptr<llvm::MemoryBuffer> obj = EmitObject();
 
   if (options_.ShouldPersistObjectFile()) {
     PersistObjectToFile(*obj);
   }
 
+  if (!object_cache_file.empty()) {
+    PersistObjectToCache(*obj, object_cache_file);
+  }
+
   return std::make_unique<CompiledModule>(std::move(obj));
 }
 
@@ -1022,6 +1061,35 @@ void LLVMEngine::CompiledModuleBuilder::PersistObjectToFile(const llvm::MemoryBu
   dest.close();
 }
 
+void LLVMEngine::CompiledModuleBuilder::PersistObjectToCache(const llvm::MemoryBuffer &obj_buffer,
+                                                             const std::string &object_cache_file) {
+  // Other processes sharing the cache may load the file at any time, so write it under a unique name and then
+  // atomically rename it into place. If several compile the same module, the last rename wins with identical contents.
+  int fd;
+  llvm::SmallString<128> temp_file;
+  if (std::error_code error = llvm::sys::fs::createUniqueFile(object_cache_file + "-%%%%%%.tmp", fd, temp_file)) {
+    EXECUTION_LOG_ERROR("LLVMEngine: Could not create object cache file: {}", error.message());
+    return;
+  }
+
+  {
+    llvm::raw_fd_ostream dest(fd, true);
+    dest.write(obj_buffer.getBufferStart(), obj_buffer.getBufferSize());
+    dest.close();
+    if (dest.has_error()) {
+      EXECUTION_LOG_ERROR("LLVMEngine: Could not write object cache file: {}", dest.error().message());
+      dest.clear_error();
+      llvm::sys::fs::remove(temp_file);
+      return;
+    }
+  }
+
+  if (std::error_code error = llvm::sys::fs::rename(temp_file, object_cache_file)) {
+    EXECUTION_LOG_ERROR("LLVMEngine: Could not rename object cache file: {}", error.message());
+    llvm::sys::fs::remove(temp_file);
+  }
+}
+
 std::string LLVMEngine::CompiledModuleBuilder::DumpModuleIR() {
   std::string result;
   llvm::raw_string_ostream ostream(result);
@@ -1066,7 +1134,7 @@ void *LLVMEngine::CompiledModule::GetFunctionPointer(const std::string &name) co
   return nullptr;
 }
 
-void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
+void LLVMEngine::CompiledModule::Load(const BytecodeModule &module, const std::vector<FunctionId> &functions) {
   // If already loaded, do nothing
   if (IsLoaded()) {
     return;
@@ -1121,7 +1189,7 @@ void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
   // all module functions into a handy cache.
   //
 
-  for (const auto &func : module.GetFunctionsInfo()) {
+  const auto load_function = [&](const FunctionInfo &func) {
     auto symbol = loader.getSymbol(func.GetName());
     if (symbol.getAddress() == 0) {
       // for Mac portability
@@ -1129,6 +1197,15 @@ void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
     }
     functions_[func.GetName()] = reinterpret_cast<void *>(symbol.getAddress());
     NOISEPAGE_ASSERT(symbol.getAddress() != 0, "symbol came out to be badly defined or missing");
+  };
+  if (functions.empty()) {
+    for (const auto &func : module.GetFunctionsInfo()) {
+      load_function(func);
+    }
+  } else {
+    for (const FunctionId func_id : functions) {
+      load_function(*module.GetFuncInfoById(func_id));
+    }
   }
 
   // Done
@@ -1149,16 +1226,52 @@ void LLVMEngine::Initialize(std::unique_ptr<const Settings> &&settings) {
   llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
 
   engine_settings = std::move(settings);
+
+  // The object cache is keyed by the bytecode handlers and the machine we generate code for, which together with the
+  // contents of a module determine the object code we generate for it.
+  engine_build_id = 0;
+  const std::string &object_cache_path = engine_settings->GetObjectCachePath();
+  if (!object_cache_path.empty()) {
+    auto handlers = llvm::MemoryBuffer::getFile(engine_settings->GetBytecodeHandlersBcPath());
+    if (std::error_code error = handlers.getError()) {
+      EXECUTION_LOG_ERROR("LLVMEngine: Object cache disabled, error reading bytecode handlers '{}'", error.message());
+    } else if (std::error_code error = llvm::sys::fs::create_directories(object_cache_path)) {
+      EXECUTION_LOG_ERROR("LLVMEngine: Object cache disabled, error creating '{}': {}", object_cache_path,
+                          error.message());
+    } else {
+      const auto &bitcode = *handlers.get();
+      engine_build_id = common::HashUtil::Hash(reinterpret_cast<const uint8_t *>(bitcode.getBufferStart()),
+                                               bitcode.getBufferSize());
+      engine_build_id = common::HashUtil::CombineHashes(engine_build_id,
+                                                        common::HashUtil::Hash(llvm::sys::getProcessTriple()));
+      engine_build_id = common::HashUtil::CombineHashes(engine_build_id,
+                                                        common::HashUtil::Hash(llvm::sys::getHostCPUName().str()));
+    }
+  }
 }
 
 void LLVMEngine::Shutdown() {
   engine_settings.reset();
+  engine_build_id = 0;
   llvm::llvm_shutdown();
 }
 
 std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeModule &module,
                                                                 const CompilerOptions &options) {
-  CompiledModuleBuilder builder(options, module);
+  const std::vector<FunctionId> functions = FunctionsToCompile(module, options);
+  const std::string object_cache_file = ObjectCacheFile(module, options);
+  if (!object_cache_file.empty()) {
+    if (auto object_code = llvm::MemoryBuffer::getFile(object_cache_file)) {
+      auto compiled_module = std::make_unique<CompiledModule>(std::move(object_code.get()));
+      compiled_module->Load(module, functions);
+      if (compiled_module->IsLoaded()) {
+        return compiled_module;
+      }
+      // The file is unusable, so compile the module again and overwrite it
+    }
+  }
+
+  CompiledModuleBuilder builder(options, module, functions);
 
   builder.DeclareStaticLocals();
 
@@ -1172,13 +1285,84 @@ std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeMo
 
   builder.Optimize();
 
-  auto compiled_module = builder.Finalize();
+  auto compiled_module = builder.Finalize(object_cache_file);
 
-  compiled_module->Load(module);
+  compiled_module->Load(module, functions);
 
   return compiled_module;
 }
 
+std::vector<FunctionId> LLVMEngine::FunctionsToCompile(const BytecodeModule &module, const CompilerOptions &options) {
+  std::vector<FunctionId> functions;
+  if (options.GetFunctions().empty()) {
+    for (const auto &func : module.GetFunctionsInfo()) {
+      functions.push_back(func.GetId());
+    }
+    return functions;
+  }
+
+  // Collect every function reachable from the requested ones, whether through calls or as function pointer operands
+  std::vector<bool> visited(module.GetFunctionCount(), false);
+  std::vector<FunctionId> stack = options.GetFunctions();
+  while (!stack.empty()) {
+    const FunctionId func_id = stack.back();
+    stack.pop_back();
+    if (visited[func_id]) {
+      continue;
+    }
+    visited[func_id] = true;
+    functions.push_back(func_id);
+
+    for (auto iter = module.GetBytecodeForFunction(*module.GetFuncInfoById(func_id)); !iter.Done(); iter.Advance()) {
+      const Bytecode bytecode = iter.CurrentBytecode();
+      for (uint32_t i = 0; i < Bytecodes::NumOperands(bytecode); i++) {
+        if (Bytecodes::GetNthOperandType(bytecode, i) == OperandType::FunctionId) {
+          stack.push_back(iter.GetFunctionIdOperand(i));
+        }
+      }
+    }
+  }
+  return functions;
+}
+
+std::string LLVMEngine::ObjectCacheFile(const BytecodeModule &module, const CompilerOptions &options) {
+  if (engine_build_id == 0) {
+    return "";
+  }
+
+  // The file name is a 128-bit hash of everything in the module that code generation depends on. The module's name,
+  // which differs across otherwise identical queries, is left out.
+  std::string contents = fmt::format("O{};", options.GetOptimizationLevel());
+  for (const FunctionId func_id : options.GetFunctions()) {
+    contents += fmt::format("{},", func_id);
+  }
+  const auto append_local = [&contents](const LocalInfo &local) {
+    contents += fmt::format("{}:{}:{}:{};", local.GetName(), local.GetOffset(), local.GetSize(),
+                            ast::Type::ToString(local.GetType()));
+  };
+  for (const auto &local : module.GetStaticLocalsInfo()) {
+    append_local(local);
+    contents.append(reinterpret_cast<const char *>(module.AccessStaticLocalDataRaw(local.GetOffset())),
+                    local.GetSize());
+  }
+  for (const auto &func : module.GetFunctionsInfo()) {
+    const auto [start, end] = func.GetBytecodeRange();
+    contents += fmt::format("{}:{}:{}:{}:{};", func.GetName(), ast::Type::ToString(func.GetFuncType()),
+                            func.GetFrameSize(), func.GetParamsStartPos(), func.GetParamsSize());
+    for (const auto &local : func.GetLocals()) {
+      append_local(local);
+    }
+    contents.append(reinterpret_cast<const char *>(module.AccessBytecodeForFunctionRaw(func)), end - start);
+  }
+
+  const auto *data = reinterpret_cast<const uint8_t *>(contents.data());
+  const auto seed = engine_build_id;
+  llvm::SmallString<128> path(GetEngineSettings()->GetObjectCachePath());
+  llvm::sys::path::append(path, fmt::format("{:016x}{:016x}.to", common::HashUtil::Hash(data, contents.size(), seed),
+                                            common::HashUtil::Hash(data, contents.size(), ~seed)));
+  return path.str().str();
+}
+
 const LLVMEngine::Settings *LLVMEngine::GetEngineSettings() {
   NOISEPAGE_ASSERT(static_cast<bool>(engine_settings), "LLVMEngine must be initialized before use");
   return engine_settings.get();
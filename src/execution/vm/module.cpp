@@ -18,22 +18,25 @@ namespace noisepage::execution::vm {
 // Async Compile Task
 // ---------------------------------------------------------
 
-// This class encapsulates the ability to asynchronously JIT compile a module.
+// This class encapsulates the ability to asynchronously JIT compile a function of a module.
 class Module::AsyncCompileTask : public tbb::task {
  public:
-  // Construct an asynchronous compilation task to compile the the module
-  explicit AsyncCompileTask(Module *module) : module_(module) {}
+  // Construct an asynchronous compilation task to compile the function of the module for the tier
+  AsyncCompileTask(const Module *module, FunctionId func_id, uint32_t tier)
+      : module_(module), func_id_(func_id), tier_(tier) {}
 
   // Execute
   tbb::task *execute() override {
-    // This simply invokes Module::CompileToMachineCode() asynchronously.
-    module_->CompileToMachineCode();
+    // This simply invokes Module::CompileFunction() asynchronously.
+    module_->CompileFunction(func_id_, tier_);
     // Done. There's no next task, so return null.
     return nullptr;
   }
 
  private:
-  Module *module_;
+  const Module *module_;
+  FunctionId func_id_;
+  uint32_t tier_;
 };
 
 // ---------------------------------------------------------
@@ -46,7 +49,9 @@ Module::Module(std::unique_ptr<BytecodeModule> bytecode_module, std::unique_ptr<
     : bytecode_module_(std::move(bytecode_module)),
       jit_module_(std::move(llvm_module)),
       functions_(std::make_unique<std::atomic<void *>[]>(bytecode_module_->GetFunctionCount())),
-      bytecode_trampolines_(std::make_unique<Trampoline[]>(bytecode_module_->GetFunctionCount())) {
+      bytecode_trampolines_(std::make_unique<Trampoline[]>(bytecode_module_->GetFunctionCount())),
+      profiles_(std::make_unique<FunctionProfile[]>(bytecode_module_->GetFunctionCount())),
+      fully_compiled_(jit_module_ != nullptr) {
   // Create the trampolines for all bytecode functions
   for (const auto &func : bytecode_module_->GetFunctionsInfo()) {
     CreateFunctionTrampoline(func.GetId());
@@ -68,6 +73,12 @@ Module::Module(std::unique_ptr<BytecodeModule> bytecode_module, std::unique_ptr<
   }
 }
 
+Module::~Module() {
+  // Background compilations reference this module, so they must finish first.
+  std::unique_lock<std::mutex> lock(tiering_mutex_);
+  compiles_done_.wait(lock, [this] { return pending_compiles_ == 0; });
+}
+
 namespace {
 
 // TODO(pmenon): Implement generator for non x86_64 machines
@@ -276,18 +287,89 @@ void Module::CompileToMachineCode() {
 
     // JIT completed successfully. For each function in the module, pull out its
     // compiled implementation into the function cache, atomically replacing any
-    // previous implementation.
+    // previous implementation, tiered ones included.
+    std::lock_guard<std::mutex> lock(tiering_mutex_);
     for (const auto &func_info : bytecode_module_->GetFunctionsInfo()) {
       auto *jit_function = jit_module_->GetFunctionPointer(func_info.GetName());
       NOISEPAGE_ASSERT(jit_function != nullptr, "Missing function in compiled module!");
       functions_[func_info.GetId()].store(jit_function, std::memory_order_relaxed);
     }
+    fully_compiled_ = true;
   });
 }
 
-void Module::CompileToMachineCodeAsync() {
-  auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this);
-  tbb::task::enqueue(*compile_task);
+void Module::RecordInvocation(const FunctionId func_id, const bool interpreted, const uint64_t loop_iterations) const {
+  if (!tiering_enabled_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  FunctionProfile &profile = profiles_[func_id];
+  uint64_t interpreted_invocations = profile.interpreted_invocations_.load(std::memory_order_relaxed);
+  uint64_t compiled_invocations = profile.compiled_invocations_.load(std::memory_order_relaxed);
+  uint64_t iterations = profile.loop_iterations_.load(std::memory_order_relaxed);
+  if (interpreted) {
+    interpreted_invocations = profile.interpreted_invocations_.fetch_add(1, std::memory_order_relaxed) + 1;
+    iterations = profile.loop_iterations_.fetch_add(loop_iterations, std::memory_order_relaxed) + loop_iterations;
+  } else {
+    compiled_invocations = profile.compiled_invocations_.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  // Compiled code does not count its loop iterations, so extrapolate them from the interpreted invocations.
+  const uint64_t invocations = interpreted_invocations + compiled_invocations;
+  if (interpreted_invocations > 0) {
+    iterations = iterations / interpreted_invocations * invocations;
+  }
+
+  // The highest tier the function is hot enough for
+  uint32_t tier = NUM_TIERS - 1;
+  while (tier > 0 && invocations < TIER_INVOCATIONS[tier] && iterations < TIER_LOOP_ITERATIONS[tier]) {
+    tier--;
+  }
+
+  // Only the thread that raises the requested tier triggers the compilation
+  uint32_t requested_tier = profile.requested_tier_.load(std::memory_order_relaxed);
+  while (requested_tier < tier) {
+    if (profile.requested_tier_.compare_exchange_weak(requested_tier, tier)) {
+      {
+        std::lock_guard<std::mutex> lock(tiering_mutex_);
+        if (fully_compiled_) {
+          return;
+        }
+        pending_compiles_++;
+      }
+      EXECUTION_LOG_DEBUG("Promoting function {} to tier {} after {} invocations", func_id, tier, invocations);
+      auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this, func_id, tier);
+      tbb::task::enqueue(*compile_task);
+      return;
+    }
+  }
+}
+
+void Module::CompileFunction(const FunctionId func_id, const uint32_t tier) const {
+  // JIT the function, and the functions it references.
+  LLVMEngine::CompilerOptions options;
+  options.SetOptimizationLevel(TIER_OPT_LEVELS[tier]).SetFunctions({func_id});
+  std::unique_ptr<LLVMEngine::CompiledModule> compiled_module;
+  try {
+    compiled_module = LLVMEngine::Compile(*bytecode_module_, options);
+  } catch (const std::exception &e) {
+    // The function stays on its current tier, but the compilation still has to count as done for ~Module().
+    EXECUTION_LOG_ERROR("Failed to promote function {} to tier {}: {}", func_id, tier, e.what());
+  }
+
+  std::lock_guard<std::mutex> lock(tiering_mutex_);
+  FunctionProfile &profile = profiles_[func_id];
+  if (compiled_module != nullptr && !fully_compiled_ && tier > profile.installed_tier_) {
+    auto *jit_function = compiled_module->GetFunctionPointer(GetFuncInfoById(func_id)->GetName());
+    NOISEPAGE_ASSERT(jit_function != nullptr, "Missing function in compiled module!");
+    functions_[func_id].store(jit_function, std::memory_order_relaxed);
+    profile.installed_tier_ = tier;
+    // Invocations that loaded the previous implementation may still be running it, so it is kept as well.
+    tiered_modules_.emplace_back(std::move(compiled_module));
+  }
+
+  pending_compiles_--;
+  compiles_done_.notify_all();
 }
 
 }  // namespace noisepage::execution::vm
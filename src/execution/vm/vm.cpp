@@ -1,7 +1,11 @@
 #include "execution/vm/vm.h"
 
+#include <algorithm>
+#include <atomic>
 #include <numeric>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "execution/sql/value.h"
 #include "execution/util/memory.h"
@@ -111,6 +115,9 @@ void VM::InvokeFunction(const Module *module, const FunctionId func_id, const ui
   Frame frame(raw_frame, frame_size);
   vm.Interpret(module->GetBytecodeModule()->AccessBytecodeForFunctionRaw(*func_info), &frame);
 
+  // Profile the invocation for tiered compilation
+  module->RecordInvocation(func_id, true, vm.loop_iterations_);
+
   // Done. Now, let's cleanup.
   if (used_heap) {
     std::free(raw_frame);
@@ -137,8 +144,38 @@ inline ALWAYS_INLINE T Peek(const uint8_t **ip) {
   return *reinterpret_cast<const T *>(*ip);
 }
 
+#ifdef NOISEPAGE_PROFILE_BYTECODES
+// The number of times each pair of bytecodes was interpreted back to back, the first one of the pair being the row
+std::atomic<uint64_t> bytecode_pair_counts[Bytecodes::NumBytecodes() * Bytecodes::NumBytecodes()];
+#endif
+
 }  // namespace
 
+std::vector<std::pair<std::pair<Bytecode, Bytecode>, uint64_t>> VM::GetHotBytecodePairs(const std::size_t n) {
+  std::vector<std::pair<std::pair<Bytecode, Bytecode>, uint64_t>> pairs;
+#ifdef NOISEPAGE_PROFILE_BYTECODES
+  for (uint32_t first = 0; first < Bytecodes::NumBytecodes(); first++) {
+    for (uint32_t second = 0; second < Bytecodes::NumBytecodes(); second++) {
+      const auto count = bytecode_pair_counts[first * Bytecodes::NumBytecodes() + second].load();
+      if (count > 0) {
+        pairs.push_back({{Bytecodes::FromByte(first), Bytecodes::FromByte(second)}, count});
+      }
+    }
+  }
+  std::sort(pairs.begin(), pairs.end(), [](const auto &a, const auto &b) { return a.second > b.second; });
+  pairs.resize(std::min(n, pairs.size()));
+#endif
+  return pairs;
+}
+
+void VM::ResetBytecodeProfile() {
+#ifdef NOISEPAGE_PROFILE_BYTECODES
+  for (auto &count : bytecode_pair_counts) {
+    count.store(0);
+  }
+#endif
+}
+
 void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   static void *kDispatchTable[] = {
 #define ENTRY(name, ...) &&op_##name,
@@ -155,6 +192,19 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   } while (false)
 #else
 #define DEBUG_TRACE_INSTRUCTIONS(op) (void)op
+#endif
+
+#ifdef NOISEPAGE_PROFILE_BYTECODES
+  uint32_t prev_op = Bytecodes::NumBytecodes();
+#define PROFILE_BYTECODES(op)                                                                                 \
+  do {                                                                                                        \
+    if (prev_op < Bytecodes::NumBytecodes()) {                                                                \
+      bytecode_pair_counts[prev_op * Bytecodes::NumBytecodes() + op].fetch_add(1, std::memory_order_relaxed); \
+    }                                                                                                         \
+    prev_op = op;                                                                                             \
+  } while (false)
+#else
+#define PROFILE_BYTECODES(op) (void)op
 #endif
 
   // TODO(pmenon): Should these READ/PEEK macros take in a vm::OperandType so
@@ -180,6 +230,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   do {                            \
     auto op = READ_OP();          \
     DEBUG_TRACE_INSTRUCTIONS(op); \
+    PROFILE_BYTECODES(op);        \
     goto *kDispatchTable[op];     \
   } while (false)
 
@@ -329,6 +380,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   OP(Jump) : {
     auto skip = PEEK_JMP_OFFSET();
     if (LIKELY(OpJump())) {
+      loop_iterations_ += static_cast<uint64_t>(skip < 0);
       ip += skip;
     }
     DISPATCH_NEXT();
@@ -356,6 +408,62 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  // -------------------------------------------------------
+  // Superinstructions, i.e., conditions fused with jumps
+  // -------------------------------------------------------
+
+#define DO_GEN_FUSED_COMPARISON(op, type)                 \
+  OP(op##_##type##_JumpIfFalse) : {                       \
+    auto *dest = frame->LocalAt<bool *>(READ_LOCAL_ID()); \
+    auto lhs = frame->LocalAt<type>(READ_LOCAL_ID());     \
+    auto rhs = frame->LocalAt<type>(READ_LOCAL_ID());     \
+    auto skip = PEEK_JMP_OFFSET();                        \
+    if (Op##op##_##type##_JumpIfFalse(dest, lhs, rhs)) {  \
+      ip += skip;                                         \
+    } else {                                              \
+      READ_JMP_OFFSET();                                  \
+    }                                                     \
+    DISPATCH_NEXT();                                      \
+  }
+#define GEN_FUSED_COMPARISON_TYPES(type)          \
+  DO_GEN_FUSED_COMPARISON(GreaterThan, type)      \
+  DO_GEN_FUSED_COMPARISON(GreaterThanEqual, type) \
+  DO_GEN_FUSED_COMPARISON(Equal, type)            \
+  DO_GEN_FUSED_COMPARISON(LessThan, type)         \
+  DO_GEN_FUSED_COMPARISON(LessThanEqual, type)    \
+  DO_GEN_FUSED_COMPARISON(NotEqual, type)
+
+  GEN_FUSED_COMPARISON_TYPES(int32_t)
+  GEN_FUSED_COMPARISON_TYPES(int64_t)
+  GEN_FUSED_COMPARISON_TYPES(uint32_t)
+  GEN_FUSED_COMPARISON_TYPES(uint64_t)
+#undef GEN_FUSED_COMPARISON_TYPES
+#undef DO_GEN_FUSED_COMPARISON
+
+#define GEN_FUSED_CONDITION(op, type)                      \
+  OP(op##_JumpIfFalse) : {                                 \
+    auto *dest = frame->LocalAt<bool *>(READ_LOCAL_ID());  \
+    auto *input = frame->LocalAt<type *>(READ_LOCAL_ID()); \
+    auto skip = PEEK_JMP_OFFSET();                         \
+    if (Op##op##_JumpIfFalse(dest, input)) {               \
+      ip += skip;                                          \
+    } else {                                               \
+      READ_JMP_OFFSET();                                   \
+    }                                                      \
+    DISPATCH_NEXT();                                       \
+  }
+
+  GEN_FUSED_CONDITION(ForceBoolTruth, sql::BoolVal)
+  GEN_FUSED_CONDITION(TableVectorIteratorNext, sql::TableVectorIterator)
+  GEN_FUSED_CONDITION(VPIHasNext, sql::VectorProjectionIterator)
+  GEN_FUSED_CONDITION(VPIHasNextFiltered, sql::VectorProjectionIterator)
+  GEN_FUSED_CONDITION(AggregationHashTableIteratorHasNext, sql::AHTIterator)
+  GEN_FUSED_CONDITION(HashTableEntryIteratorHasNext, sql::HashTableEntryIterator)
+  GEN_FUSED_CONDITION(JoinHashTableIteratorHasNext, sql::JoinHashTableIterator)
+  GEN_FUSED_CONDITION(SorterIteratorHasNext, sql::SorterIterator)
+  GEN_FUSED_CONDITION(IndexIteratorAdvance, sql::IndexIterator)
+#undef GEN_FUSED_CONDITION
+
   // -------------------------------------------------------
   // Low-level memory operations
   // -------------------------------------------------------
@@ -678,6 +786,15 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(TableVectorIteratorAddRangeFilter) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto low = frame->LocalAt<int64_t>(READ_LOCAL_ID());
+    auto high = frame->LocalAt<int64_t>(READ_LOCAL_ID());
+    OpTableVectorIteratorAddRangeFilter(iter, col_idx, low, high);
+    DISPATCH_NEXT();
+  }
+
   OP(ParallelScanTable) : {
     auto table_oid = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
     auto col_oids = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
@@ -1598,6 +1715,99 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
 
 #undef GEN_BINARY_AGGREGATE
 
+#define GEN_APPROX_COUNT_DISTINCT_AGGREGATE(SQL_TYPE, AGG_TYPE)     \
+  OP(AGG_TYPE##Init) : {                                            \
+    auto *agg = frame->LocalAt<sql::AGG_TYPE *>(READ_LOCAL_ID());   \
+    Op##AGG_TYPE##Init(agg);                                        \
+    DISPATCH_NEXT();                                                \
+  }                                                                 \
+  OP(AGG_TYPE##Advance) : {                                         \
+    auto *agg = frame->LocalAt<sql::AGG_TYPE *>(READ_LOCAL_ID());   \
+    auto *val = frame->LocalAt<sql::SQL_TYPE *>(READ_LOCAL_ID());   \
+    Op##AGG_TYPE##Advance(agg, val);                                \
+    DISPATCH_NEXT();                                                \
+  }                                                                 \
+  OP(AGG_TYPE##Merge) : {                                           \
+    auto *agg_1 = frame->LocalAt<sql::AGG_TYPE *>(READ_LOCAL_ID()); \
+    auto *agg_2 = frame->LocalAt<sql::AGG_TYPE *>(READ_LOCAL_ID()); \
+    Op##AGG_TYPE##Merge(agg_1, agg_2);                              \
+    DISPATCH_NEXT();                                                \
+  }                                                                 \
+  OP(AGG_TYPE##Reset) : {                                           \
+    auto *agg = frame->LocalAt<sql::AGG_TYPE *>(READ_LOCAL_ID());   \
+    Op##AGG_TYPE##Reset(agg);                                       \
+    DISPATCH_NEXT();                                                \
+  }                                                                 \
+  OP(AGG_TYPE##GetResult) : {                                       \
+    auto *result = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID()); \
+    auto *agg = frame->LocalAt<sql::AGG_TYPE *>(READ_LOCAL_ID());   \
+    Op##AGG_TYPE##GetResult(result, agg);                           \
+    DISPATCH_NEXT();                                                \
+  }                                                                 \
+  OP(AGG_TYPE##Free) : {                                            \
+    auto *agg = frame->LocalAt<sql::AGG_TYPE *>(READ_LOCAL_ID());   \
+    Op##AGG_TYPE##Free(agg);                                        \
+    DISPATCH_NEXT();                                                \
+  }
+
+  GEN_APPROX_COUNT_DISTINCT_AGGREGATE(BoolVal, BooleanApproxCountDistinctAggregate);
+  GEN_APPROX_COUNT_DISTINCT_AGGREGATE(Integer, IntegerApproxCountDistinctAggregate);
+  GEN_APPROX_COUNT_DISTINCT_AGGREGATE(Real, RealApproxCountDistinctAggregate);
+  GEN_APPROX_COUNT_DISTINCT_AGGREGATE(DecimalVal, DecimalApproxCountDistinctAggregate);
+  GEN_APPROX_COUNT_DISTINCT_AGGREGATE(StringVal, StringApproxCountDistinctAggregate);
+  GEN_APPROX_COUNT_DISTINCT_AGGREGATE(DateVal, DateApproxCountDistinctAggregate);
+  GEN_APPROX_COUNT_DISTINCT_AGGREGATE(TimestampVal, TimestampApproxCountDistinctAggregate);
+
+#undef GEN_APPROX_COUNT_DISTINCT_AGGREGATE
+
+  OP(ApproxPercentileAggregateInit) : {
+    auto *agg = frame->LocalAt<sql::ApproxPercentileAggregate *>(READ_LOCAL_ID());
+    OpApproxPercentileAggregateInit(agg);
+    DISPATCH_NEXT();
+  }
+
+  OP(ApproxPercentileAggregateAdvanceInteger) : {
+    auto *agg = frame->LocalAt<sql::ApproxPercentileAggregate *>(READ_LOCAL_ID());
+    auto *val = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID());
+    auto *percentile = frame->LocalAt<sql::Real *>(READ_LOCAL_ID());
+    OpApproxPercentileAggregateAdvanceInteger(agg, val, percentile);
+    DISPATCH_NEXT();
+  }
+
+  OP(ApproxPercentileAggregateAdvanceReal) : {
+    auto *agg = frame->LocalAt<sql::ApproxPercentileAggregate *>(READ_LOCAL_ID());
+    auto *val = frame->LocalAt<sql::Real *>(READ_LOCAL_ID());
+    auto *percentile = frame->LocalAt<sql::Real *>(READ_LOCAL_ID());
+    OpApproxPercentileAggregateAdvanceReal(agg, val, percentile);
+    DISPATCH_NEXT();
+  }
+
+  OP(ApproxPercentileAggregateMerge) : {
+    auto *agg_1 = frame->LocalAt<sql::ApproxPercentileAggregate *>(READ_LOCAL_ID());
+    auto *agg_2 = frame->LocalAt<sql::ApproxPercentileAggregate *>(READ_LOCAL_ID());
+    OpApproxPercentileAggregateMerge(agg_1, agg_2);
+    DISPATCH_NEXT();
+  }
+
+  OP(ApproxPercentileAggregateReset) : {
+    auto *agg = frame->LocalAt<sql::ApproxPercentileAggregate *>(READ_LOCAL_ID());
+    OpApproxPercentileAggregateReset(agg);
+    DISPATCH_NEXT();
+  }
+
+  OP(ApproxPercentileAggregateGetResult) : {
+    auto *result = frame->LocalAt<sql::Real *>(READ_LOCAL_ID());
+    auto *agg = frame->LocalAt<sql::ApproxPercentileAggregate *>(READ_LOCAL_ID());
+    OpApproxPercentileAggregateGetResult(result, agg);
+    DISPATCH_NEXT();
+  }
+
+  OP(ApproxPercentileAggregateFree) : {
+    auto *agg = frame->LocalAt<sql::ApproxPercentileAggregate *>(READ_LOCAL_ID());
+    OpApproxPercentileAggregateFree(agg);
+    DISPATCH_NEXT();
+  }
+
   // -------------------------------------------------------
   // Hash Joins
   // -------------------------------------------------------
@@ -1639,6 +1849,14 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableBuildPartitioned) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto *thread_state_container = frame->LocalAt<sql::ThreadStateContainer *>(READ_LOCAL_ID());
+    auto jht_offset = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpJoinHashTableBuildPartitioned(join_hash_table, thread_state_container, jht_offset);
+    DISPATCH_NEXT();
+  }
+
   OP(JoinHashTableLookup) : {
     auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
     auto *ht_entry_iter = frame->LocalAt<sql::HashTableEntryIterator *>(READ_LOCAL_ID());
@@ -1647,12 +1865,80 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableEnableSpilling) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableEnableSpilling(join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableIsResident) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash_val = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    OpJoinHashTableIsResident(result, join_hash_table, hash_val);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableNextPass) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableNextPass(result, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableEnableBloomFilter) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableEnableBloomFilter(join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableMayContain) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash_val = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    OpJoinHashTableMayContain(result, join_hash_table, hash_val);
+    DISPATCH_NEXT();
+  }
+
   OP(JoinHashTableFree) : {
     auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
     OpJoinHashTableFree(join_hash_table);
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableBatchProbeInit) : {
+    auto *probe = frame->LocalAt<sql::JoinHashTableBatchProbe *>(READ_LOCAL_ID());
+    OpJoinHashTableBatchProbeInit(probe);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableBatchProbeAddHash) : {
+    auto *probe = frame->LocalAt<sql::JoinHashTableBatchProbe *>(READ_LOCAL_ID());
+    auto hash_val = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    OpJoinHashTableBatchProbeAddHash(probe, hash_val);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableBatchProbeLookup) : {
+    auto *probe = frame->LocalAt<sql::JoinHashTableBatchProbe *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableBatchProbeLookup(probe, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableBatchProbeNext) : {
+    auto *probe = frame->LocalAt<sql::JoinHashTableBatchProbe *>(READ_LOCAL_ID());
+    auto *ht_entry_iter = frame->LocalAt<sql::HashTableEntryIterator *>(READ_LOCAL_ID());
+    OpJoinHashTableBatchProbeNext(probe, ht_entry_iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableBatchProbeFree) : {
+    auto *probe = frame->LocalAt<sql::JoinHashTableBatchProbe *>(READ_LOCAL_ID());
+    OpJoinHashTableBatchProbeFree(probe);
+    DISPATCH_NEXT();
+  }
+
   OP(HashTableEntryIteratorHasNext) : {
     auto *has_next = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *ht_entry_iter = frame->LocalAt<sql::HashTableEntryIterator *>(READ_LOCAL_ID());
@@ -1945,6 +2231,25 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorAddBatchKey) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorAddBatchKey(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorScanKeyBatch) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    auto sort_keys = frame->LocalAt<bool>(READ_LOCAL_ID());
+    OpIndexIteratorScanKeyBatch(iter, sort_keys);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorNextBatchKey) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorNextBatchKey(iter);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorFree) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     OpIndexIteratorFree(iter);
@@ -2090,6 +2395,12 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(StorageInterfaceBeginWorker) : {
+    auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
+    OpStorageInterfaceBeginWorker(storage_interface);
+    DISPATCH_NEXT();
+  }
+
   OP(StorageInterfaceGetTablePR) : {
     auto *pr_result = frame->LocalAt<storage::ProjectedRow **>(READ_LOCAL_ID());
     auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
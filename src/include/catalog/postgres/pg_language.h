@@ -6,6 +6,7 @@
 #include "catalog/catalog_defs.h"
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 }  // namespace noisepage::storage
 
@@ -17,6 +18,7 @@ class PgProcImpl;
 /** The OIDs used by the NoisePage version of pg_language. */
 class PgLanguage {
  private:
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
 
   friend class Builder;
@@ -14,6 +14,7 @@ class CatalogAccessor;
 }  // namespace noisepage::catalog
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 }  // namespace noisepage::storage
 
@@ -33,6 +34,7 @@ class PgNamespace {
 
  private:
   friend class catalog::CatalogAccessor;
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
   friend class Builder;
   friend class PgConstraintImpl;
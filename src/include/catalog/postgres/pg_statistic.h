@@ -7,6 +7,7 @@
 #include "parser/expression_defs.h"
 
 namespace noisepage::storage {
+class CheckpointManager;
 class RecoveryManager;
 }  // namespace noisepage::storage
 
@@ -22,6 +23,7 @@ class PgStatisticImpl;
 class PgStatistic {
  private:
   friend class execution::compiler::AnalyzeTranslator;
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
   friend class Builder;
   friend class PgStatisticImpl;
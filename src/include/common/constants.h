@@ -126,5 +126,38 @@ struct Constants {
    * Flag indicating if static partitioner is used
    */
   static constexpr const bool IS_STATIC_PARTITIONER_ENABLED = false;
+
+  /**
+   * Flag indicating if parallel hash join builds use a radix-partitioned merge of the thread-local tables.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const bool IS_RADIX_JOIN_BUILD_ENABLED = true;
+
+  /**
+   * Flag indicating if index nested-loop joins sort each batch of outer keys before probing the index.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const bool IS_INDEX_JOIN_KEY_SORT_ENABLED = true;
+
+  /**
+   * The number of outer tuples per block of the inner table after which an index nested-loop join stops probing the
+   * index and probes a hash table built over the inner table instead. Zero disables the switch.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint32_t INDEX_JOIN_HASH_SWITCH_PROBES_PER_BLOCK = 1000;
+
+  /**
+   * The maximum number of bytes the hash table an index nested-loop join switches to may take up per thread. If the
+   * inner table needs more, the join keeps probing the index. Zero means unlimited.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint64_t INDEX_JOIN_HASH_TABLE_MAX_SIZE = 64 * 1024 * 1024;
+
+  /**
+   * The maximum number of bytes a single query may keep in memory before operators that support it (e.g., the
+   * partitioned aggregation hash table) start spilling to disk. Zero means unlimited.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint64_t QUERY_MEMORY_BUDGET = 0;
 };
 }  // namespace noisepage::common
@@ -56,6 +56,7 @@ namespace noisepage::execution::ast {
   F(TableIterAdvance, tableIterAdvance)                                 \
   F(TableIterGetVPINumTuples, tableIterGetVPINumTuples)                 \
   F(TableIterGetVPI, tableIterGetVPI)                                   \
+  F(TableIterAddRangeFilter, tableIterAddRangeFilter)                   \
   F(TableIterClose, tableIterClose)                                     \
   F(TableIterParallel, iterateTableParallel)                            \
   F(TableIterCreateIndexParallel, iterateTableCreateIndexParallel)      \
@@ -169,14 +170,27 @@ namespace noisepage::execution::ast {
   F(JoinHashTableInsert, joinHTInsert)                                  \
   F(JoinHashTableBuild, joinHTBuild)                                    \
   F(JoinHashTableBuildParallel, joinHTBuildParallel)                    \
+  F(JoinHashTableBuildPartitioned, joinHTBuildPartitioned)              \
   F(JoinHashTableGetTupleCount, joinHTGetTupleCount)                    \
   F(JoinHashTableLookup, joinHTLookup)                                  \
+  F(JoinHashTableEnableSpilling, joinHTEnableSpilling)                  \
+  F(JoinHashTableIsResident, joinHTIsResident)                          \
+  F(JoinHashTableNextPass, joinHTNextPass)                              \
+  F(JoinHashTableEnableBloomFilter, joinHTEnableBloomFilter)            \
+  F(JoinHashTableMayContain, joinHTMayContain)                          \
   F(JoinHashTableFree, joinHTFree)                                      \
                                                                         \
   /* Hash Table Entry Iterator (for hash joins) */                      \
   F(HashTableEntryIterHasNext, htEntryIterHasNext)                      \
   F(HashTableEntryIterGetRow, htEntryIterGetRow)                        \
                                                                         \
+  /* Batch Probes (for hash joins) */                                    \
+  F(JoinHashTableBatchProbeInit, joinHTBatchProbeInit)                  \
+  F(JoinHashTableBatchProbeAddHash, joinHTBatchProbeAddHash)            \
+  F(JoinHashTableBatchProbeLookup, joinHTBatchProbeLookup)              \
+  F(JoinHashTableBatchProbeNext, joinHTBatchProbeNext)                  \
+  F(JoinHashTableBatchProbeFree, joinHTBatchProbeFree)                  \
+                                                                        \
   F(JoinHashTableIterInit, joinHTIterInit)                              \
   F(JoinHashTableIterHasNext, joinHTIterHasNext)                        \
   F(JoinHashTableIterNext, joinHTIterNext)                              \
@@ -213,6 +227,9 @@ namespace noisepage::execution::ast {
   F(IndexIteratorScanAscending, indexIteratorScanAscending)             \
   F(IndexIteratorScanDescending, indexIteratorScanDescending)           \
   F(IndexIteratorScanLimitDescending, indexIteratorScanLimitDescending) \
+  F(IndexIteratorAddBatchKey, indexIteratorAddBatchKey)                 \
+  F(IndexIteratorScanKeyBatch, indexIteratorScanKeyBatch)               \
+  F(IndexIteratorNextBatchKey, indexIteratorNextBatchKey)               \
   F(IndexIteratorAdvance, indexIteratorAdvance)                         \
   F(IndexIteratorGetPR, indexIteratorGetPR)                             \
   F(IndexIteratorGetLoPR, indexIteratorGetLoPR)                         \
@@ -271,6 +288,7 @@ namespace noisepage::execution::ast {
                                                                         \
   /* SQL Table Calls */                                                 \
   F(StorageInterfaceInit, storageInterfaceInit)                         \
+  F(StorageInterfaceBeginWorker, storageInterfaceBeginWorker)           \
   F(StorageInterfaceGetIndexHeapSize, storageInterfaceGetIndexHeapSize) \
   F(GetTablePR, getTablePR)                                             \
   F(TableInsert, tableInsert)                                           \
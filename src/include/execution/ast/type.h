@@ -37,88 +37,97 @@ class Context;
 //           implementations, but can also be created and manipulated from TPL
 //           code. We specialize these because we also want to add SQL-level
 //           type information to these builtins.
-#define BUILTIN_TYPE_LIST(PRIM, NON_PRIM, SQL)                                                    \
-  /* Primitive types */                                                                           \
-  PRIM(Nil, uint8_t, "nil")                                                                       \
-  PRIM(Bool, bool, "bool")                                                                        \
-  PRIM(Int8, int8_t, "int8")                                                                      \
-  PRIM(Int16, int16_t, "int16")                                                                   \
-  PRIM(Int32, int32_t, "int32")                                                                   \
-  PRIM(Int64, int64_t, "int64")                                                                   \
-  PRIM(Uint8, uint8_t, "uint8")                                                                   \
-  PRIM(Uint16, uint16_t, "uint16")                                                                \
-  PRIM(Uint32, uint32_t, "uint32")                                                                \
-  PRIM(Uint64, uint64_t, "uint64")                                                                \
-  PRIM(Int128, int128_t, "int128")                                                                \
-  PRIM(Uint128, uint128_t, "uint128")                                                             \
-  PRIM(Float32, float, "float32")                                                                 \
-  PRIM(Float64, double, "float64")                                                                \
-                                                                                                  \
-  /* Non-primitive builtins */                                                                    \
-  NON_PRIM(AggregationHashTable, noisepage::execution::sql::AggregationHashTable)                 \
-  NON_PRIM(AHTIterator, noisepage::execution::sql::AHTIterator)                                   \
-  NON_PRIM(AHTVectorIterator, noisepage::execution::sql::AHTVectorIterator)                       \
-  NON_PRIM(AHTOverflowPartitionIterator, noisepage::execution::sql::AHTOverflowPartitionIterator) \
-  /* NON_PRIM(CSVReader, noisepage::execution::util::CSVReader)                                */ \
-  NON_PRIM(OutputBuffer, noisepage::execution::exec::OutputBuffer)                                \
-  NON_PRIM(ExecutionContext, noisepage::execution::exec::ExecutionContext)                        \
-  NON_PRIM(ExecOUFeatureVector, noisepage::selfdriving::ExecOUFeatureVector)                      \
-  NON_PRIM(FilterManager, noisepage::execution::sql::FilterManager)                               \
-  NON_PRIM(HashTableEntry, noisepage::execution::sql::HashTableEntry)                             \
-  NON_PRIM(HashTableEntryIterator, noisepage::execution::sql::HashTableEntryIterator)             \
-  NON_PRIM(JoinHashTableIterator, noisepage::execution::sql::JoinHashTableIterator)               \
-  NON_PRIM(JoinHashTable, noisepage::execution::sql::JoinHashTable)                               \
-  NON_PRIM(MemoryPool, noisepage::execution::sql::MemoryPool)                                     \
-  NON_PRIM(Sorter, noisepage::execution::sql::Sorter)                                             \
-  NON_PRIM(SorterIterator, noisepage::execution::sql::SorterIterator)                             \
-  NON_PRIM(TableVectorIterator, noisepage::execution::sql::TableVectorIterator)                   \
-  NON_PRIM(ThreadStateContainer, noisepage::execution::sql::ThreadStateContainer)                 \
-  NON_PRIM(TupleIdList, noisepage::execution::sql::TupleIdList)                                   \
-  NON_PRIM(VectorProjection, noisepage::execution::sql::VectorProjection)                         \
-  NON_PRIM(VectorProjectionIterator, noisepage::execution::sql::VectorProjectionIterator)         \
-  NON_PRIM(IndexIterator, noisepage::execution::sql::IndexIterator)                               \
-                                                                                                  \
-  /* SQL Aggregate types (if you add, remember to update BuiltinType) */                          \
-  NON_PRIM(CountAggregate, noisepage::execution::sql::CountAggregate)                             \
-  NON_PRIM(CountStarAggregate, noisepage::execution::sql::CountStarAggregate)                     \
-  NON_PRIM(AvgAggregate, noisepage::execution::sql::AvgAggregate)                                 \
-  NON_PRIM(IntegerMaxAggregate, noisepage::execution::sql::IntegerMaxAggregate)                   \
-  NON_PRIM(IntegerMinAggregate, noisepage::execution::sql::IntegerMinAggregate)                   \
-  NON_PRIM(IntegerSumAggregate, noisepage::execution::sql::IntegerSumAggregate)                   \
-  NON_PRIM(RealMaxAggregate, noisepage::execution::sql::RealMaxAggregate)                         \
-  NON_PRIM(RealMinAggregate, noisepage::execution::sql::RealMinAggregate)                         \
-  NON_PRIM(RealSumAggregate, noisepage::execution::sql::RealSumAggregate)                         \
-  NON_PRIM(DateMinAggregate, noisepage::execution::sql::DateMinAggregate)                         \
-  NON_PRIM(DateMaxAggregate, noisepage::execution::sql::DateMaxAggregate)                         \
-  NON_PRIM(StringMinAggregate, noisepage::execution::sql::StringMinAggregate)                     \
-  NON_PRIM(StringMaxAggregate, noisepage::execution::sql::StringMaxAggregate)                     \
-  NON_PRIM(BooleanTopKAggregate, noisepage::execution::sql::BooleanTopKAggregate)                 \
-  NON_PRIM(IntegerTopKAggregate, noisepage::execution::sql::IntegerTopKAggregate)                 \
-  NON_PRIM(RealTopKAggregate, noisepage::execution::sql::RealTopKAggregate)                       \
-  NON_PRIM(DecimalTopKAggregate, noisepage::execution::sql::DecimalTopKAggregate)                 \
-  NON_PRIM(StringTopKAggregate, noisepage::execution::sql::StringTopKAggregate)                   \
-  NON_PRIM(DateTopKAggregate, noisepage::execution::sql::DateTopKAggregate)                       \
-  NON_PRIM(TimestampTopKAggregate, noisepage::execution::sql::TimestampTopKAggregate)             \
-  NON_PRIM(BooleanHistogramAggregate, noisepage::execution::sql::BooleanHistogramAggregate)       \
-  NON_PRIM(IntegerHistogramAggregate, noisepage::execution::sql::IntegerHistogramAggregate)       \
-  NON_PRIM(RealHistogramAggregate, noisepage::execution::sql::RealHistogramAggregate)             \
-  NON_PRIM(DecimalHistogramAggregate, noisepage::execution::sql::DecimalHistogramAggregate)       \
-  NON_PRIM(StringHistogramAggregate, noisepage::execution::sql::StringHistogramAggregate)         \
-  NON_PRIM(DateHistogramAggregate, noisepage::execution::sql::DateHistogramAggregate)             \
-  NON_PRIM(TimestampHistogramAggregate, noisepage::execution::sql::TimestampHistogramAggregate)   \
-                                                                                                  \
-  /* SQL Table operations */                                                                      \
-  NON_PRIM(ProjectedRow, noisepage::storage::ProjectedRow)                                        \
-  NON_PRIM(TupleSlot, noisepage::storage::TupleSlot)                                              \
-  NON_PRIM(StorageInterface, noisepage::execution::sql::StorageInterface)                         \
-                                                                                                  \
-  /* Non-primitive SQL Runtime Values */                                                          \
-  SQL(Boolean, noisepage::execution::sql::BoolVal)                                                \
-  SQL(Integer, noisepage::execution::sql::Integer)                                                \
-  SQL(Real, noisepage::execution::sql::Real)                                                      \
-  SQL(Decimal, noisepage::execution::sql::DecimalVal)                                             \
-  SQL(StringVal, noisepage::execution::sql::StringVal)                                            \
-  SQL(Date, noisepage::execution::sql::DateVal)                                                   \
+#define BUILTIN_TYPE_LIST(PRIM, NON_PRIM, SQL)                                                                      \
+  /* Primitive types */                                                                                             \
+  PRIM(Nil, uint8_t, "nil")                                                                                         \
+  PRIM(Bool, bool, "bool")                                                                                          \
+  PRIM(Int8, int8_t, "int8")                                                                                        \
+  PRIM(Int16, int16_t, "int16")                                                                                     \
+  PRIM(Int32, int32_t, "int32")                                                                                     \
+  PRIM(Int64, int64_t, "int64")                                                                                     \
+  PRIM(Uint8, uint8_t, "uint8")                                                                                     \
+  PRIM(Uint16, uint16_t, "uint16")                                                                                  \
+  PRIM(Uint32, uint32_t, "uint32")                                                                                  \
+  PRIM(Uint64, uint64_t, "uint64")                                                                                  \
+  PRIM(Int128, int128_t, "int128")                                                                                  \
+  PRIM(Uint128, uint128_t, "uint128")                                                                               \
+  PRIM(Float32, float, "float32")                                                                                   \
+  PRIM(Float64, double, "float64")                                                                                  \
+                                                                                                                    \
+  /* Non-primitive builtins */                                                                                      \
+  NON_PRIM(AggregationHashTable, noisepage::execution::sql::AggregationHashTable)                                   \
+  NON_PRIM(AHTIterator, noisepage::execution::sql::AHTIterator)                                                     \
+  NON_PRIM(AHTVectorIterator, noisepage::execution::sql::AHTVectorIterator)                                         \
+  NON_PRIM(AHTOverflowPartitionIterator, noisepage::execution::sql::AHTOverflowPartitionIterator)                   \
+  /* NON_PRIM(CSVReader, noisepage::execution::util::CSVReader)                                */                   \
+  NON_PRIM(OutputBuffer, noisepage::execution::exec::OutputBuffer)                                                  \
+  NON_PRIM(ExecutionContext, noisepage::execution::exec::ExecutionContext)                                          \
+  NON_PRIM(ExecOUFeatureVector, noisepage::selfdriving::ExecOUFeatureVector)                                        \
+  NON_PRIM(FilterManager, noisepage::execution::sql::FilterManager)                                                 \
+  NON_PRIM(HashTableEntry, noisepage::execution::sql::HashTableEntry)                                               \
+  NON_PRIM(HashTableEntryIterator, noisepage::execution::sql::HashTableEntryIterator)                               \
+  NON_PRIM(JoinHashTableIterator, noisepage::execution::sql::JoinHashTableIterator)                                 \
+  NON_PRIM(JoinHashTable, noisepage::execution::sql::JoinHashTable)                                                 \
+  NON_PRIM(JoinHashTableBatchProbe, noisepage::execution::sql::JoinHashTableBatchProbe)                             \
+  NON_PRIM(MemoryPool, noisepage::execution::sql::MemoryPool)                                                       \
+  NON_PRIM(Sorter, noisepage::execution::sql::Sorter)                                                               \
+  NON_PRIM(SorterIterator, noisepage::execution::sql::SorterIterator)                                               \
+  NON_PRIM(TableVectorIterator, noisepage::execution::sql::TableVectorIterator)                                     \
+  NON_PRIM(ThreadStateContainer, noisepage::execution::sql::ThreadStateContainer)                                   \
+  NON_PRIM(TupleIdList, noisepage::execution::sql::TupleIdList)                                                     \
+  NON_PRIM(VectorProjection, noisepage::execution::sql::VectorProjection)                                           \
+  NON_PRIM(VectorProjectionIterator, noisepage::execution::sql::VectorProjectionIterator)                           \
+  NON_PRIM(IndexIterator, noisepage::execution::sql::IndexIterator)                                                 \
+                                                                                                                    \
+  /* SQL Aggregate types (if you add, remember to update BuiltinType) */                                            \
+  NON_PRIM(CountAggregate, noisepage::execution::sql::CountAggregate)                                               \
+  NON_PRIM(CountStarAggregate, noisepage::execution::sql::CountStarAggregate)                                       \
+  NON_PRIM(AvgAggregate, noisepage::execution::sql::AvgAggregate)                                                   \
+  NON_PRIM(IntegerMaxAggregate, noisepage::execution::sql::IntegerMaxAggregate)                                     \
+  NON_PRIM(IntegerMinAggregate, noisepage::execution::sql::IntegerMinAggregate)                                     \
+  NON_PRIM(IntegerSumAggregate, noisepage::execution::sql::IntegerSumAggregate)                                     \
+  NON_PRIM(RealMaxAggregate, noisepage::execution::sql::RealMaxAggregate)                                           \
+  NON_PRIM(RealMinAggregate, noisepage::execution::sql::RealMinAggregate)                                           \
+  NON_PRIM(RealSumAggregate, noisepage::execution::sql::RealSumAggregate)                                           \
+  NON_PRIM(DateMinAggregate, noisepage::execution::sql::DateMinAggregate)                                           \
+  NON_PRIM(DateMaxAggregate, noisepage::execution::sql::DateMaxAggregate)                                           \
+  NON_PRIM(StringMinAggregate, noisepage::execution::sql::StringMinAggregate)                                       \
+  NON_PRIM(StringMaxAggregate, noisepage::execution::sql::StringMaxAggregate)                                       \
+  NON_PRIM(BooleanTopKAggregate, noisepage::execution::sql::BooleanTopKAggregate)                                   \
+  NON_PRIM(IntegerTopKAggregate, noisepage::execution::sql::IntegerTopKAggregate)                                   \
+  NON_PRIM(RealTopKAggregate, noisepage::execution::sql::RealTopKAggregate)                                         \
+  NON_PRIM(DecimalTopKAggregate, noisepage::execution::sql::DecimalTopKAggregate)                                   \
+  NON_PRIM(StringTopKAggregate, noisepage::execution::sql::StringTopKAggregate)                                     \
+  NON_PRIM(DateTopKAggregate, noisepage::execution::sql::DateTopKAggregate)                                         \
+  NON_PRIM(TimestampTopKAggregate, noisepage::execution::sql::TimestampTopKAggregate)                               \
+  NON_PRIM(BooleanHistogramAggregate, noisepage::execution::sql::BooleanHistogramAggregate)                         \
+  NON_PRIM(IntegerHistogramAggregate, noisepage::execution::sql::IntegerHistogramAggregate)                         \
+  NON_PRIM(RealHistogramAggregate, noisepage::execution::sql::RealHistogramAggregate)                               \
+  NON_PRIM(DecimalHistogramAggregate, noisepage::execution::sql::DecimalHistogramAggregate)                         \
+  NON_PRIM(StringHistogramAggregate, noisepage::execution::sql::StringHistogramAggregate)                           \
+  NON_PRIM(DateHistogramAggregate, noisepage::execution::sql::DateHistogramAggregate)                               \
+  NON_PRIM(TimestampHistogramAggregate, noisepage::execution::sql::TimestampHistogramAggregate)                     \
+  NON_PRIM(BooleanApproxCountDistinctAggregate, noisepage::execution::sql::BooleanApproxCountDistinctAggregate)     \
+  NON_PRIM(IntegerApproxCountDistinctAggregate, noisepage::execution::sql::IntegerApproxCountDistinctAggregate)     \
+  NON_PRIM(RealApproxCountDistinctAggregate, noisepage::execution::sql::RealApproxCountDistinctAggregate)           \
+  NON_PRIM(DecimalApproxCountDistinctAggregate, noisepage::execution::sql::DecimalApproxCountDistinctAggregate)     \
+  NON_PRIM(StringApproxCountDistinctAggregate, noisepage::execution::sql::StringApproxCountDistinctAggregate)       \
+  NON_PRIM(DateApproxCountDistinctAggregate, noisepage::execution::sql::DateApproxCountDistinctAggregate)           \
+  NON_PRIM(TimestampApproxCountDistinctAggregate, noisepage::execution::sql::TimestampApproxCountDistinctAggregate) \
+  NON_PRIM(ApproxPercentileAggregate, noisepage::execution::sql::ApproxPercentileAggregate)                         \
+                                                                                                                    \
+  /* SQL Table operations */                                                                                        \
+  NON_PRIM(ProjectedRow, noisepage::storage::ProjectedRow)                                                          \
+  NON_PRIM(TupleSlot, noisepage::storage::TupleSlot)                                                                \
+  NON_PRIM(StorageInterface, noisepage::execution::sql::StorageInterface)                                           \
+                                                                                                                    \
+  /* Non-primitive SQL Runtime Values */                                                                            \
+  SQL(Boolean, noisepage::execution::sql::BoolVal)                                                                  \
+  SQL(Integer, noisepage::execution::sql::Integer)                                                                  \
+  SQL(Real, noisepage::execution::sql::Real)                                                                        \
+  SQL(Decimal, noisepage::execution::sql::DecimalVal)                                                               \
+  SQL(StringVal, noisepage::execution::sql::StringVal)                                                              \
+  SQL(Date, noisepage::execution::sql::DateVal)                                                                     \
   SQL(Timestamp, noisepage::execution::sql::TimestampVal)
 
 // Ignore a builtin
@@ -405,7 +414,7 @@ class BuiltinType : public Type {
    *         CountAggregate, etc.); false otherwise.
    */
   bool IsSqlAggregateType() const {
-    return Kind::CountAggregate <= GetKind() && GetKind() <= Kind::TimestampHistogramAggregate;
+    return Kind::CountAggregate <= GetKind() && GetKind() <= Kind::ApproxPercentileAggregate;
   }
 
   /**
@@ -578,6 +578,17 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *TableIterGetVPI(ast::Expr *table_iter);
 
+  /**
+   * Call \@tableIterAddRangeFilter(). Let the table vector iterator skip blocks whose zone maps show
+   * that no value of the column falls in the range [low, high].
+   * @param table_iter The table vector iterator.
+   * @param col_idx The index of the column in the scanned column OIDs.
+   * @param low The smallest value of the range (inclusive).
+   * @param high The largest value of the range (inclusive).
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *TableIterAddRangeFilter(ast::Expr *table_iter, uint32_t col_idx, int64_t low, int64_t high);
+
   /**
    * Call \@tableIterClose(). Close and destroy a table vector iterator.
    * @param table_iter The table vector iterator.
@@ -651,6 +662,14 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *IndexIteratorScan(ast::Expr *iter_ptr, planner::IndexScanType scan_type, uint32_t limit);
 
+  /**
+   * Call \@indexIteratorScanKeyBatch(iter_ptr, sort_keys)
+   * @param iter_ptr Pointer to the index iterator.
+   * @param sort_keys Whether the batched keys should be probed in key order.
+   * @return The expression corresponding to the builtin call.
+   */
+  [[nodiscard]] ast::Expr *IndexIteratorScanKeyBatch(ast::Expr *iter_ptr, bool sort_keys);
+
   // -------------------------------------------------------
   //
   // VPI stuff
@@ -942,6 +961,17 @@ class CodeGen {
   [[nodiscard]] ast::Expr *JoinHashTableBuildParallel(ast::Expr *join_hash_table, ast::Expr *thread_state_container,
                                                       ast::Expr *offset);
 
+  /**
+   * Call \@joinHTBuildPartitioned(). Like JoinHashTableBuildParallel(), but merges the
+   * thread-local tables through a radix-partitioned build.
+   * @param join_hash_table The global join hash table.
+   * @param thread_state_container The thread state container.
+   * @param offset The offset in the thread state container where thread-local tables are.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableBuildPartitioned(ast::Expr *join_hash_table, ast::Expr *thread_state_container,
+                                                         ast::Expr *offset);
+
   /**
    * Call \@joinHTLookup(). Performs a single lookup into the hash table with a tuple with the
    * provided hash value. The provided iterator will provide tuples in the hash table that match the
@@ -954,6 +984,47 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *JoinHashTableLookup(ast::Expr *join_hash_table, ast::Expr *entry_iter, ast::Expr *hash_val);
 
+  /**
+   * Call \@joinHTEnableSpilling(). Allow the provided join hash table to spill partitions to disk
+   * when the query exceeds its memory budget.
+   * @param join_hash_table The join hash table.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableEnableSpilling(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTIsResident(). Determine if the partition of the provided hash value is in memory
+   * in the current pass over the join hash table.
+   * @param join_hash_table The join hash table.
+   * @param hash_val The hash value of the probe key.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableIsResident(ast::Expr *join_hash_table, ast::Expr *hash_val);
+
+  /**
+   * Call \@joinHTNextPass(). Load the next batch of spilled partitions into the join hash table.
+   * @param join_hash_table The join hash table.
+   * @return The call. Evaluates to true if the probe input must be processed again.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableNextPass(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTEnableBloomFilter(). Have the provided join hash table build a bloom filter over its
+   * build input when it is built.
+   * @param join_hash_table The join hash table.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableEnableBloomFilter(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTMayContain(). Check the bloom filter of the provided join hash table for the given
+   * hash value.
+   * @param join_hash_table The join hash table.
+   * @param hash_val The hash value of the probe key.
+   * @return The call. Evaluates to false if no build tuple can match the probe key.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableMayContain(ast::Expr *join_hash_table, ast::Expr *hash_val);
+
   /**
    * Call \@joinHTFree(). Cleanup and destroy the provided join hash table instance.
    * @param join_hash_table The join hash table.
@@ -1189,6 +1260,15 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *AggregatorAdvance(ast::Expr *agg, ast::Expr *val);
 
+  /**
+   * Call \@aggAdvance(). Advance an approximate percentile aggregator with the provided input value.
+   * @param agg A pointer to the aggregator.
+   * @param val The input value.
+   * @param percentile A pointer to the percentile to compute.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *AggregatorAdvance(ast::Expr *agg, ast::Expr *val, ast::Expr *percentile);
+
   /**
    * Call \@aggMerge(). Merges two aggregators storing the result in the first argument.
    * @param agg1 A pointer to the aggregator.
@@ -1406,6 +1486,13 @@ class CodeGen {
   ast::Expr *StorageInterfaceInit(ast::Expr *storage_interface_ptr, ast::Expr *exec_ctx, uint32_t table_oid,
                                   ast::Identifier col_oids, bool need_indexes);
 
+  /**
+   * Call \@storageInterfaceBeginWorker(si_ptr)
+   * @param storage_interface_ptr A pointer to the storage interface used by a worker of a parallel pipeline.
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *StorageInterfaceBeginWorker(ast::Expr *storage_interface_ptr);
+
   // ---------------------------------------------------------------------------
   //
   // Identifiers
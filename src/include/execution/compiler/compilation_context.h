@@ -123,6 +123,12 @@ class CompilationContext {
   /** @return True if we should record pipeline metrics */
   bool IsPipelineMetricsEnabled() const { return pipeline_metrics_enabled_; }
 
+  /** @return True if parallel hash join builds should use a radix-partitioned merge. */
+  bool IsRadixJoinBuildEnabled() const { return radix_join_build_enabled_; }
+
+  /** @return True if index nested-loop joins should sort each batch of outer keys before probing the index. */
+  bool IsIndexJoinKeySortEnabled() const { return index_join_key_sort_enabled_; }
+
   /** @return Query Id associated with the query */
   query_id_t GetQueryId() const { return query_id_t{unique_id_}; }
 
@@ -176,6 +182,12 @@ class CompilationContext {
 
   // Whether pipeline metrics are enabled.
   bool pipeline_metrics_enabled_;
+
+  // Whether parallel hash join builds are radix-partitioned.
+  bool radix_join_build_enabled_;
+
+  // Whether index nested-loop joins sort their batches of outer keys.
+  bool index_join_key_sort_enabled_;
 };
 
 }  // namespace noisepage::execution::compiler
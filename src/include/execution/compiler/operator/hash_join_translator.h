@@ -97,7 +97,9 @@ class HashJoinTranslator : public OperatorTranslator {
 
   /**
    * If the pipeline context represents the left pipeline and the left pipeline is parallel, we'll
-   * issue a parallel join hash table construction at this point.
+   * issue a parallel join hash table construction at this point. If the pipeline context
+   * represents the right pipeline, we'll re-run it once for every batch of partitions the join
+   * hash table has spilled to disk.
    * @param pipeline The current pipeline.
    * @param function The pipeline generating function.
    */
@@ -109,6 +111,31 @@ class HashJoinTranslator : public OperatorTranslator {
    */
   ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
 
+  /**
+   * Generate the runtime filter this join pushes down into its probe-side scan. The probe keys of
+   * the tuple the scan is positioned at are hashed and checked against the bloom filter over the
+   * build input.
+   * @param context The context of the work.
+   * @param function The function being built.
+   * @return A boolean expression that is false if the current probe tuple cannot find a partner.
+   */
+  ast::Expr *GenerateRuntimeFilter(WorkContext *context, FunctionBuilder *function) const;
+
+  /**
+   * Add the hash of the probe keys of the tuple the probe-side scan is positioned at to the batch
+   * of probes. Called by the scan feeding this join.
+   * @param context The context of the work.
+   * @param function The pipeline generating function.
+   */
+  void AddBatchProbe(WorkContext *context, FunctionBuilder *function) const;
+
+  /**
+   * Look up the batch of probes added since the last lookup in the join hash table. Called by the
+   * scan feeding this join.
+   * @param function The pipeline generating function.
+   */
+  void LookupProbeBatch(FunctionBuilder *function) const;
+
   /**
    * Hash-joins do not produce columns from base tables.
    */
@@ -129,8 +156,20 @@ class HashJoinTranslator : public OperatorTranslator {
   // Is the given pipeline this join's right pipeline?
   bool IsRightPipeline(const Pipeline &pipeline) const { return GetPipeline() == &pipeline; }
 
-  // Initialize the given join hash table instance, provided as a *JHT.
-  void InitializeJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const;
+  // Can the join hash table spill partitions to disk? Spilled partitions are
+  // joined in additional passes that each re-run the probe pipeline.
+  bool CanSpill() const;
+
+  // Push a bloom filter over the build keys down into the probe-side scan,
+  // if there is one and the join type allows probe tuples without a join
+  // partner to be dropped.
+  void PushDownRuntimeFilter();
+
+  // Let the probe-side scan batch the lookups of its tuples, if possible.
+  void PushDownProbeBatching();
+
+  // Initialize the given join hash table instance stored in the given state slot.
+  void InitializeJoinHashTable(FunctionBuilder *function, const StateDescriptor::Entry &join_ht) const;
 
   // Clean up and destroy the given join hash table instance, provided as a *JHT.
   void TearDownJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const;
@@ -155,6 +194,12 @@ class HashJoinTranslator : public OperatorTranslator {
   // Probe the join hash table with the input tuple(s).
   void ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *function) const;
 
+  // Find the matches of the input tuple(s) with the provided entry iterator,
+  // positioned by the provided lookup (if any), and process them according to
+  // the join type.
+  void ProbeJoinHashTableForMatches(WorkContext *ctx, FunctionBuilder *function, ast::Identifier entry_iter_name,
+                                    ast::Stmt *lookup_call) const;
+
   // Check the right mark.
   void CheckRightMark(WorkContext *ctx, FunctionBuilder *function, ast::Identifier right_mark) const;
 
@@ -177,6 +222,12 @@ class HashJoinTranslator : public OperatorTranslator {
   // Flag to indicate whether or not we are in the joinConsumer function
   bool join_consumer_flag_;
 
+  // Has a runtime filter been pushed down into the probe-side scan?
+  bool pushed_runtime_filter_;
+
+  // Are the lookups of the probe tuples batched by the probe-side scan?
+  bool batched_probes_;
+
   // The name of the materialized row when inserting into join hash table.
   ast::Identifier build_row_var_;
   ast::Identifier build_row_type_;
@@ -198,6 +249,9 @@ class HashJoinTranslator : public OperatorTranslator {
   StateDescriptor::Entry global_join_ht_;
   StateDescriptor::Entry local_join_ht_;
 
+  // The slot in the probe pipeline's state where the batch of probes is stored.
+  StateDescriptor::Entry probe_batch_;
+
   // The number of rows that are inserted into the hash table.
   StateDescriptor::Entry num_build_rows_;
   // The number of probes that are performed.
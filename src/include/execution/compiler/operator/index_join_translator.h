@@ -22,7 +22,12 @@ class IndexJoinPlanNode;
 namespace noisepage::execution::compiler {
 
 /**
- * Index join translator.
+ * Index join translator. The join runs in the pipeline of its outer child, and probes the index once per outer tuple
+ * using a pipeline-local index iterator. When the outer child is a sequential scan and the join looks up exact keys,
+ * the scan gathers the keys of each vector projection into a batch that is probed as a whole before the join consumes
+ * the results tuple by tuple. Exact-key lookups switch from the index to a hash table over the inner table once the
+ * outer side has produced more keys than the configured number of probes per block of the inner table (see
+ * IndexIterator).
  */
 class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
  public:
@@ -41,7 +46,20 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
 
   void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
-  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *func) const override {}
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * Add the key of the current outer tuple to the batch of keys to probe. Called by the scan feeding this join.
+   * @param context The context of the work.
+   * @param function The pipeline generating function.
+   */
+  void AddBatchKey(WorkContext *context, FunctionBuilder *function) const;
+
+  /**
+   * Probe the index with the batch of keys added since the last probe. Called by the scan feeding this join.
+   * @param function The pipeline generating function.
+   */
+  void ScanKeyBatch(FunctionBuilder *function) const;
 
   /**
    * @return The value (or value vector) of the column with the provided column OID in the table
@@ -51,12 +69,14 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
 
   ast::Expr *GetSlotAddress() const override;
 
-  /** @return Throw an error, this is serial for now. */
-  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("Index join is serial."); };
+  /** @return Throw an error, the index join never drives its pipeline. */
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override {
+    UNREACHABLE("Index join does not drive its pipeline.");
+  };
 
-  /** @return Throw an error, this is serial for now. */
+  /** @return Throw an error, the index join never drives its pipeline. */
   void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
-    UNREACHABLE("Index join is serial.");
+    UNREACHABLE("Index join does not drive its pipeline.");
   };
 
  private:
@@ -68,6 +88,8 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   void DeclareIndexPR(FunctionBuilder *builder) const;
   void DeclareTablePR(FunctionBuilder *builder) const;
   void DeclareSlot(FunctionBuilder *builder) const;
+  // Let the outer scan batch the keys of this join, if possible.
+  void PushDownKeyBatching();
 
  private:
   std::vector<catalog::col_oid_t> input_oids_;
@@ -76,8 +98,9 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   const catalog::IndexSchema &index_schema_;
   const std::unordered_map<catalog::indexkeycol_oid_t, uint16_t> &index_pm_;
 
+  // The index iterator, declared in the pipeline state.
+  StateDescriptor::Entry index_iter_;
   // Structs and local variables
-  ast::Identifier index_iter_;
   ast::Identifier col_oids_;
   ast::Identifier lo_index_pr_;
   ast::Identifier hi_index_pr_;
@@ -90,5 +113,8 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   StateDescriptor::Entry num_scans_index_;
   // The number of outer loop iterations.
   StateDescriptor::Entry num_loops_;
+
+  // Whether the keys are batched and probed by the outer scan.
+  bool batched_keys_;
 };
 }  // namespace noisepage::execution::compiler
@@ -22,6 +22,8 @@ class SeqScanPlanNode;
 namespace noisepage::execution::compiler {
 
 class FunctionBuilder;
+class HashJoinTranslator;
+class IndexJoinTranslator;
 
 /**
  * A translator for sequential table scans.
@@ -41,6 +43,30 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
    */
   DISALLOW_COPY_AND_MOVE(SeqScanTranslator);
 
+  /**
+   * Register a hash join whose probe input is produced by this scan. Scanned tuples that cannot
+   * find a partner in the join's build input are dropped right after the scan predicate is
+   * evaluated, using the bloom filter of the join's hash table.
+   * @param join The hash join.
+   */
+  void AddRuntimeFilter(const HashJoinTranslator *join) { runtime_filters_.push_back(join); }
+
+  /**
+   * Register an index join whose outer input is produced by this scan. The keys of all tuples of
+   * a vector projection are added to the join's batch and probed together before the tuples are
+   * pushed to the join one by one.
+   * @param join The index join.
+   */
+  void AddIndexJoinKeyBatch(const IndexJoinTranslator *join) { index_join_key_batches_.push_back(join); }
+
+  /**
+   * Register a hash join whose probe input is produced by this scan. The probe hashes of all
+   * tuples of a vector projection are added to the join's batch and looked up together before the
+   * tuples are pushed to the join one by one.
+   * @param join The hash join.
+   */
+  void AddHashJoinProbeBatch(const HashJoinTranslator *join) { hash_join_probe_batches_.push_back(join); }
+
   /**
    * If the scan has a predicate, this function will define all clause functions.
    * @param decls The top-level declarations.
@@ -111,12 +137,24 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
                                      common::ManagedPointer<parser::AbstractExpression> predicate,
                                      std::vector<ast::Identifier> *curr_clause, bool seen_conjunction);
 
+  // Register the integer range conjuncts of the predicate with the table vector iterator for block skipping.
+  void AddRangeFilters(FunctionBuilder *function, common::ManagedPointer<parser::AbstractExpression> predicate) const;
+
   // Perform a table scan using the provided table vector iterator pointer.
   void ScanTable(WorkContext *ctx, FunctionBuilder *function) const;
 
   // Generate a scan over the VPI.
   void ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast::Expr *vpi) const;
 
+  // Filter the VPI with the runtime filters of all registered hash joins.
+  void ApplyRuntimeFilters(FunctionBuilder *function, ast::Expr *vpi) const;
+
+  // Batch and probe the keys of the VPI for all registered index and hash joins.
+  void ProbeJoinBatches(FunctionBuilder *function, ast::Expr *vpi) const;
+
+  // Is the VPI that is pushed to the rest of the pipeline filtered?
+  bool IsVPIFiltered() const;
+
  private:
   // When the plan's oid list is empty (like in "SELECT COUNT(*)"), then we just read the first column of the table.
   // Otherwise we just read the plan's oid list.
@@ -144,6 +182,18 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
   // definition, but only if there's a predicate.
   std::vector<std::vector<ast::Identifier>> filters_;
 
+  // The hash joins probed with the output of this scan whose bloom filters
+  // are applied to the scanned tuples.
+  std::vector<const HashJoinTranslator *> runtime_filters_;
+
+  // The index joins probed with the output of this scan whose keys are
+  // batched per vector projection.
+  std::vector<const IndexJoinTranslator *> index_join_key_batches_;
+
+  // The hash joins probed with the output of this scan whose lookups are
+  // batched per vector projection.
+  std::vector<const HashJoinTranslator *> hash_join_probe_batches_;
+
   // The version of col_oids that we use for translation. See MakeInputOids for justification.
   std::vector<catalog::col_oid_t> col_oids_;
 
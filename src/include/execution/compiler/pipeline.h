@@ -135,6 +135,13 @@ class Pipeline {
    */
   void GeneratePipeline(ExecutableQueryFragmentBuilder *builder) const;
 
+  /**
+   * Launch the work of this pipeline from within its run function. Operators that make multiple
+   * passes over the pipeline's input use this to run the pipeline again.
+   * @param function The pipeline's run function.
+   */
+  void LaunchWork(FunctionBuilder *function) const;
+
   /**
    * @return True if the pipeline is parallel; false otherwise.
    */
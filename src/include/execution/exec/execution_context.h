@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "common/managed_pointer.h"
 #include "execution/exec/execution_settings.h"
+#include "execution/exec/morsel_scheduler.h"
 #include "execution/exec/output.h"
 #include "execution/exec_defs.h"
 #include "execution/sql/memory_tracker.h"
@@ -97,7 +100,7 @@ class EXPORT ExecutionContext {
       : exec_settings_(exec_settings),
         db_oid_(db_oid),
         txn_(txn),
-        mem_tracker_(std::make_unique<sql::MemoryTracker>()),
+        mem_tracker_(std::make_unique<sql::MemoryTracker>(exec_settings.GetQueryMemoryBudget())),
         mem_pool_(std::make_unique<sql::MemoryPool>(common::ManagedPointer<sql::MemoryTracker>(mem_tracker_))),
         schema_(schema),
         callback_(callback),
@@ -238,8 +241,8 @@ class EXPORT ExecutionContext {
   /** @return The number of rows affected by the current execution, e.g., INSERT/DELETE/UPDATE. */
   uint32_t GetRowsAffected() const { return rows_affected_; }
 
-  /** Increment or decrement the number of rows affected. */
-  void AddRowsAffected(int64_t num_rows) { rows_affected_ += num_rows; }
+  /** Increment or decrement the number of rows affected. Thread-safe, as workers of parallel DML all add to it. */
+  void AddRowsAffected(int64_t num_rows) { rows_affected_ += static_cast<uint32_t>(num_rows); }
 
   /**
    * @return    On the primary, returns the ID of the last txn sent.
@@ -309,6 +312,26 @@ class EXPORT ExecutionContext {
    */
   void SetNumConcurrentEstimate(uint32_t estimate) { num_concurrent_estimate_ = estimate; }
 
+  /**
+   * @return The parameters the parallel operations of this query are scheduled with. These may use all workers of the
+   *         scheduler, only table scans are limited to the configured number of threads.
+   */
+  MorselScheduler::QueryOptions GetSchedulingOptions() const { return {query_priority_, 0}; }
+
+  /**
+   * @return The parameters the parallel table scans of this query are scheduled with. Scans run on at most the
+   *         configured number of parallel execution threads, or on all workers if that number is not positive.
+   */
+  MorselScheduler::QueryOptions GetScanSchedulingOptions() const {
+    return {query_priority_, static_cast<uint32_t>(std::max(exec_settings_.GetNumberOfParallelExecutionThreads(), 0))};
+  }
+
+  /**
+   * Sets the priority of this query's parallel work relative to concurrently running queries
+   * @param priority The share of the scheduler's workers the query receives. Must be positive.
+   */
+  void SetQueryPriority(uint32_t priority) { query_priority_ = priority; }
+
   /**
    * Invoke a hook function if a hook function is available
    * @param hook_index Index of hook function to invoke
@@ -356,7 +379,7 @@ class EXPORT ExecutionContext {
   common::ManagedPointer<metrics::MetricsManager> metrics_manager_;
   common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> params_;
   uint8_t execution_mode_;
-  uint32_t rows_affected_ = 0;
+  std::atomic<uint32_t> rows_affected_ = 0;
 
   common::ManagedPointer<replication::ReplicationManager> replication_manager_;
   common::ManagedPointer<storage::RecoveryManager> recovery_manager_;
@@ -364,6 +387,7 @@ class EXPORT ExecutionContext {
   bool memory_use_override_ = false;
   uint32_t memory_use_override_value_ = 0;
   uint32_t num_concurrent_estimate_ = 0;
+  uint32_t query_priority_ = MorselScheduler::DEFAULT_PRIORITY;
   std::vector<HookFn> hooks_{};
   void *query_state_;
 };
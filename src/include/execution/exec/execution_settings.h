@@ -23,6 +23,7 @@ class IdxJoinTest_MultiPredicateJoinWithExtra_Test;
 class IdxJoinTest_FooOnlyScan_Test;
 class IdxJoinTest_BarOnlyScan_Test;
 class IdxJoinTest_IndexToIndexJoin_Test;
+class IdxJoinTest_AdaptiveHashJoin_Test;
 }  // namespace noisepage::optimizer
 
 namespace noisepage::tpch {
@@ -73,6 +74,27 @@ class EXPORT ExecutionSettings {
   /** @return True if static partitioner is enabled. */
   constexpr bool GetIsStaticPartitionerEnabled() const { return is_static_partitioner_enabled_; }
 
+  /** @return The per-query memory budget in bytes past which operators spill to disk. Zero means unlimited. */
+  uint64_t GetQueryMemoryBudget() const { return query_memory_budget_; }
+
+  /** @return True if parallel hash join builds should use a radix-partitioned merge. */
+  bool GetIsRadixJoinBuildEnabled() const { return is_radix_join_build_enabled_; }
+
+  /** @return True if index nested-loop joins should sort each batch of outer keys before probing the index. */
+  bool GetIsIndexJoinKeySortEnabled() const { return is_index_join_key_sort_enabled_; }
+
+  /**
+   * @return The number of outer tuples per block of the inner table after which index nested-loop joins switch to
+   *         probing a hash table over the inner table. Zero means never.
+   */
+  uint32_t GetIndexJoinHashSwitchProbesPerBlock() const { return index_join_hash_switch_probes_per_block_; }
+
+  /**
+   * @return The maximum number of bytes per thread of the hash table an index nested-loop join switches to. Joins
+   *         whose inner table needs more keep probing the index. Zero means unlimited.
+   */
+  uint64_t GetIndexJoinHashTableMaxSize() const { return index_join_hash_table_max_size_; }
+
  private:
   double select_opt_threshold_{common::Constants::SELECT_OPT_THRESHOLD};
   double arithmetic_full_compute_opt_threshold_{common::Constants::ARITHMETIC_FULL_COMPUTE_THRESHOLD};
@@ -83,6 +105,11 @@ class EXPORT ExecutionSettings {
   bool is_pipeline_metrics_enabled_{common::Constants::IS_PIPELINE_METRICS_ENABLED};
   int number_of_parallel_execution_threads_{common::Constants::NUM_PARALLEL_EXECUTION_THREADS};
   bool is_static_partitioner_enabled_{common::Constants::IS_STATIC_PARTITIONER_ENABLED};
+  uint64_t query_memory_budget_{common::Constants::QUERY_MEMORY_BUDGET};
+  bool is_radix_join_build_enabled_{common::Constants::IS_RADIX_JOIN_BUILD_ENABLED};
+  bool is_index_join_key_sort_enabled_{common::Constants::IS_INDEX_JOIN_KEY_SORT_ENABLED};
+  uint32_t index_join_hash_switch_probes_per_block_{common::Constants::INDEX_JOIN_HASH_SWITCH_PROBES_PER_BLOCK};
+  uint64_t index_join_hash_table_max_size_{common::Constants::INDEX_JOIN_HASH_TABLE_MAX_SIZE};
 
   // MiniRunners needs to set query_identifier and pipeline_operating_units_.
   friend class noisepage::runner::ExecutionRunners;
@@ -94,5 +121,6 @@ class EXPORT ExecutionSettings {
   friend class noisepage::optimizer::IdxJoinTest_FooOnlyScan_Test;
   friend class noisepage::optimizer::IdxJoinTest_BarOnlyScan_Test;
   friend class noisepage::optimizer::IdxJoinTest_IndexToIndexJoin_Test;
+  friend class noisepage::optimizer::IdxJoinTest_AdaptiveHashJoin_Test;
 };
 }  // namespace noisepage::execution::exec
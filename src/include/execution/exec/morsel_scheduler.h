@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/macros.h"
+#include "common/shared_latch.h"
+
+namespace noisepage::execution::exec {
+
+/**
+ * An engine-wide scheduler for the parallel work of all queries. Parallel operations, e.g., table
+ * scans, aggregation hash table merges, join hash table builds and sorts, split their input into
+ * morsels, i.e., small ranges of work, and submit them to the scheduler as one job. A fixed pool of
+ * workers, one per core, executes the morsels of all jobs of all concurrent queries, so concurrent
+ * queries share the cores instead of each bringing its own threads.
+ *
+ * Each job keeps one deque of morsels per worker. Consecutive morsels are handed to the same worker
+ * and workers are numbered by NUMA node, so neighbouring blocks of a table are scanned on the same
+ * node. A worker takes the morsels of its own deque from the front and, once it is empty, steals
+ * from the back of the deques of other workers, preferring workers on its own node.
+ *
+ * Workers pick the job to take their next morsel from by stride scheduling: every morsel charges its
+ * job an amount inversely proportional to the priority of the submitting query, and workers take
+ * from the job charged the least. Concurrent queries therefore receive a share of the workers that
+ * is proportional to their priority, and a short query submitted while long ones are running is
+ * served right away rather than after them.
+ *
+ * The thread that submits a job works on it as well, and only on it, until all its morsels have been
+ * claimed, and then waits for the workers to finish theirs. A job thus always completes, even when
+ * all workers are busy, and morsels may submit nested jobs.
+ */
+class MorselScheduler {
+ public:
+  /** The function executed for each morsel, given the range [begin, end) of the morsel. */
+  using MorselFn = std::function<void(std::size_t, std::size_t)>;
+
+  /** The priority of queries that do not set one. */
+  static constexpr uint32_t DEFAULT_PRIORITY = 1;
+
+  /**
+   * The scheduling parameters of the query submitting a job.
+   */
+  struct QueryOptions {
+    /** The relative share of the workers the query receives. Must be positive. */
+    uint32_t priority_{DEFAULT_PRIORITY};
+    /** The maximum number of threads working on a job of the query at once, zero for no limit. */
+    uint32_t max_parallelism_{0};
+  };
+
+  /**
+   * @return The scheduler shared by all queries, with one worker per logical core.
+   */
+  static MorselScheduler *Instance();
+
+  /**
+   * Create a scheduler and start its workers.
+   * @param num_workers The number of worker threads. Must be positive.
+   */
+  explicit MorselScheduler(uint32_t num_workers);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(MorselScheduler);
+
+  /**
+   * Stop all workers. No jobs may be running.
+   */
+  ~MorselScheduler();
+
+  /**
+   * Execute the given function over the range [begin, end), split into morsels of the given size,
+   * and return once all morsels have executed. If a morsel throws, the morsels that have not started
+   * yet are skipped and the first exception is rethrown to the caller.
+   * @param options The scheduling parameters of the submitting query.
+   * @param begin The start of the range.
+   * @param end The end of the range.
+   * @param grain_size The number of elements per morsel. Must be positive.
+   * @param fn The function to execute for each morsel.
+   */
+  void ParallelFor(const QueryOptions &options, std::size_t begin, std::size_t end, std::size_t grain_size,
+                   const MorselFn &fn);
+
+  /**
+   * Execute the given function for each element of the given random-access container, one element
+   * per morsel, and return once all elements have been processed.
+   * @tparam Container The type of the container.
+   * @tparam F The type of the function, invocable with an element of the container.
+   * @param options The scheduling parameters of the submitting query.
+   * @param container The container to process.
+   * @param fn The function to execute for each element.
+   */
+  template <typename Container, typename F>
+  void ParallelForEach(const QueryOptions &options, Container &container, const F &fn) {
+    auto first = std::begin(container);
+    ParallelFor(options, 0, std::size(container), 1, [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        fn(first[i]);
+      }
+    });
+  }
+
+  /**
+   * @return The number of worker threads.
+   */
+  uint32_t GetNumWorkers() const { return static_cast<uint32_t>(workers_.size()); }
+
+  /**
+   * @return The number of NUMA nodes the workers are spread over.
+   */
+  uint32_t GetNumNodes() const { return num_nodes_; }
+
+ private:
+  struct Job;
+
+  // The main loop of the worker with the given ID.
+  void WorkerLoop(uint32_t worker_id);
+
+  // Choose the job the calling worker executes a morsel of next and register the worker with it.
+  // Returns null if there is no job with unclaimed morsels the worker may join.
+  Job *PickJob();
+
+  // Claim the next morsel of the given job for the given worker and execute it. Returns false if all
+  // morsels of the job have been claimed.
+  bool RunMorsel(Job *job, uint32_t worker_id);
+
+  // Unregister a thread from the given job once it stopped working on it.
+  void LeaveJob(Job *job);
+
+ private:
+  // The NUMA node of each worker.
+  std::vector<uint32_t> worker_nodes_;
+  // For each worker, the order in which it steals from the deques of the other workers.
+  std::vector<std::vector<uint32_t>> steal_orders_;
+  // The number of NUMA nodes.
+  uint32_t num_nodes_;
+
+  // Protects the list of running jobs. Workers only take it shared to pick their next morsel, so
+  // dispatching morsels doesn't serialize on a single mutex.
+  common::SharedLatch jobs_latch_;
+  // The running jobs.
+  std::list<Job *> jobs_;
+  // The charge of the job most recently picked. New jobs start out with this charge.
+  std::atomic<uint64_t> virtual_time_{0};
+
+  // Protects the shutdown flag. Idle workers sleep on it until a job is submitted.
+  std::mutex mutex_;
+  // Signaled when a job is submitted or the scheduler shuts down.
+  std::condition_variable work_available_;
+  // Whether the workers should exit.
+  bool shutdown_{false};
+
+  // The worker threads.
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace noisepage::execution::exec
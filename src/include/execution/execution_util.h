@@ -17,10 +17,13 @@ class ExecutionUtil {
 
   /**
    * Initialize all TPL subsystems
+   * @param bytecode_handlers_path path to the bytecode handlers bitcode file
+   * @param jit_object_cache_path directory to cache compiled object code in, empty to disable the cache
    */
-  static void InitTPL(std::string_view bytecode_handlers_path) {
+  static void InitTPL(std::string_view bytecode_handlers_path, std::string_view jit_object_cache_path = "") {
     execution::CpuInfo::Instance();
-    auto settings = std::make_unique<const typename vm::LLVMEngine::Settings>(bytecode_handlers_path);
+    auto settings =
+        std::make_unique<const typename vm::LLVMEngine::Settings>(bytecode_handlers_path, jit_object_cache_path);
     execution::vm::LLVMEngine::Initialize(std::move(settings));
   }
 
@@ -127,9 +127,12 @@ class Sema : public ast::AstVisitor<Sema> {
   void CheckBuiltinJoinHashTableInsert(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableGetTupleCount(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableBuild(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinJoinHashTableSpillCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinJoinHashTableBloomFilterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinJoinHashTableLookup(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableFree(ast::CallExpr *call);
   void CheckBuiltinHashTableEntryIterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinJoinHashTableBatchProbeCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinJoinHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSorterInit(ast::CallExpr *call);
   void CheckBuiltinSorterGetTupleCount(ast::CallExpr *call);
@@ -25,6 +25,7 @@ class ExecutionContext;
 
 namespace noisepage::execution::sql {
 
+class SpillFile;
 class ThreadStateContainer;
 class VectorProjectionIterator;
 
@@ -64,6 +65,18 @@ class EXPORT AggregationHashTable {
   /** The default precision used to configure the HyperLogLog instances. Set to optimize accuracy and space manually. */
   static constexpr uint32_t DEFAULT_HLL_PRECISION = 10;
 
+  /**
+   * In partitioned mode, pre-aggregation is bypassed once fewer than this fraction of the input
+   * tuples since the last flush found an existing group in the main hash table.
+   */
+  static constexpr const float PREAGG_MIN_HIT_RATE = 0.1f;
+
+  /**
+   * The number of flush thresholds worth of groups inserted while pre-aggregation is bypassed,
+   * after which pre-aggregation is tried again to re-sample its hit rate.
+   */
+  static constexpr uint32_t PREAGG_BYPASS_RESAMPLE_INTERVAL = 16;
+
   // -------------------------------------------------------
   // Callback functions to customize aggregations
   // -------------------------------------------------------
@@ -114,6 +127,12 @@ class EXPORT AggregationHashTable {
     uint64_t num_flushes_ = 0;
     /** Number of times that the hash table has been inserted into. */
     uint64_t num_inserts_ = 0;
+    /** Number of times that the overflow partitions have been spilled to disk. */
+    uint64_t num_spills_ = 0;
+    /** Number of entries that have been spilled to disk. */
+    uint64_t num_spilled_entries_ = 0;
+    /** Number of groups inserted directly into the overflow partitions, bypassing pre-aggregation. */
+    uint64_t num_bypassed_ = 0;
   };
 
   // -------------------------------------------------------
@@ -161,6 +180,15 @@ class EXPORT AggregationHashTable {
 
   /**
    * Insert a new element with hash value @em hash into this partitioned aggregation hash table.
+   *
+   * If the query has exceeded its memory budget, the overflow partitions are spilled to disk before
+   * the new element is allocated. Pointers to previously inserted elements are invalidated by this
+   * call; only the returned pointer is guaranteed to be valid.
+   *
+   * If pre-aggregating in the main hash table does not reduce the input, the new element bypasses
+   * the main hash table and goes straight into its overflow partition, where it is merged with the
+   * other partial aggregates of its group later on.
+   *
    * @param hash The hash value of the element to insert.
    * @return A pointer to a memory area where the input element can be written.
    */
@@ -306,6 +334,41 @@ class EXPORT AggregationHashTable {
   // partitions.
   void FlushToOverflowPartitions();
 
+  // Link the given entry into its overflow partition.
+  void AddToOverflowPartition(HashTableEntry *entry);
+
+  // Decide whether to bypass pre-aggregation, based on the hit rate in the main
+  // hash table since the last flush. Called right before flushing.
+  void UpdatePreAggregationBypass();
+
+  // Allocate an entry and link it directly into its overflow partition,
+  // bypassing the main hash table.
+  HashTableEntry *AllocateEntryBypassed(hash_t hash);
+
+  // Write all overflow partitions to disk and recycle the entry memory. Only
+  // thread-local tables that own all of their entries can spill.
+  void SpillOverflowPartitions();
+
+  // Does the given overflow partition have any entries, in memory or on disk?
+  bool IsPartitionNonEmpty(uint32_t part_idx) const {
+    return partition_heads_[part_idx] != nullptr ||
+           (!partition_spills_.empty() && !partition_spills_[part_idx].empty());
+  }
+
+  // Does the given overflow partition have entries on disk?
+  bool IsPartitionSpilled(uint32_t part_idx) const {
+    return !partition_spills_.empty() && !partition_spills_[part_idx].empty();
+  }
+
+  // Read back all spilled entries in the given overflow partition, and merge
+  // them into the target table using the provided merging function. The
+  // entries are read in batches into memory owned by the target table.
+  void MergeSpilledPartition(uint32_t part_idx, AggregationHashTable *target, void *query_state,
+                             MergePartitionFn merge_func) const;
+
+  // Destroy the table built over the given partition to release its memory.
+  void ReleaseTableOverPartition(uint32_t part_idx);
+
   // Allocate all overflow partition information if unallocated
   void AllocateOverflowPartitions();
 
@@ -326,9 +389,10 @@ class EXPORT AggregationHashTable {
   void FollowNext();
 
   // Called from ProcessBatch() to create and initialize new aggregates for
-  // tuples that did not find a matching group.
+  // tuples that did not find a matching group. If pre-aggregation is bypassed,
+  // the new aggregates go straight into the overflow partitions.
   void CreateMissingGroups(VectorProjectionIterator *input_batch, const std::vector<uint32_t> &key_indexes,
-                           VectorInitAggFn init_agg_fn);
+                           VectorInitAggFn init_agg_fn, bool bypass_preagg);
 
   // Called from ProcessBatch() to update aggregates with tuples from batch that
   // found matching group.
@@ -428,6 +492,42 @@ class EXPORT AggregationHashTable {
   // partition an entry is linked into.
   uint64_t partition_shift_bits_;
 
+  // -------------------------------------------------------
+  // Spilled overflow partitions
+  // -------------------------------------------------------
+
+  // A contiguous run of overflow entries belonging to one partition, written
+  // to a spill file.
+  struct SpilledRun {
+    // The file the run lives in.
+    const SpillFile *file_;
+    // The byte offset of the run in the file.
+    std::size_t offset_;
+    // The number of entries in the run.
+    uint64_t num_entries_;
+  };
+  // The spill files owned by this table. Thread-local tables create at most
+  // one file. The main table takes ownership of all thread-local files.
+  std::vector<std::unique_ptr<SpillFile>> spill_files_;
+  // The spilled runs of each overflow partition. Empty if nothing spilled.
+  std::vector<std::vector<SpilledRun>> partition_spills_;
+  // Set when the query exceeded its memory budget at the last flush. The
+  // partitions are spilled at the next point where no payload pointers into
+  // the table are outstanding.
+  bool spill_pending_;
+
+  // -------------------------------------------------------
+  // Adaptive pre-aggregation
+  // -------------------------------------------------------
+
+  // Are new groups inserted directly into the overflow partitions?
+  bool preagg_bypass_;
+  // The number of input tuples looked up in the main hash table since the last
+  // flush.
+  uint64_t preagg_num_input_;
+  // The number of groups inserted since pre-aggregation was bypassed.
+  uint64_t preagg_num_bypassed_;
+
   // Runtime stats.
   Stats stats_;
 
@@ -453,6 +553,7 @@ inline HashTableEntry *AggregationHashTable::LookupEntryInternal(hash_t hash, Ag
 
 inline byte *AggregationHashTable::Lookup(hash_t hash, AggregationHashTable::KeyEqFn key_eq_fn,
                                           const void *probe_tuple) {
+  preagg_num_input_++;
   auto *entry = LookupEntryInternal(hash, key_eq_fn, probe_tuple);
   return (entry == nullptr ? nullptr : entry->payload_);
 }
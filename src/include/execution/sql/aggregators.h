@@ -5,8 +5,10 @@
 
 #include "common/macros.h"
 #include "execution/exec/execution_context.h"
+#include "execution/sql/t_digest.h"
 #include "execution/sql/value.h"
 #include "optimizer/statistics/histogram.h"
+#include "optimizer/statistics/hyperloglog.h"
 #include "optimizer/statistics/top_k_elements.h"
 
 namespace noisepage::execution::sql {
@@ -553,4 +555,135 @@ class DateHistogramAggregate : public HistogramAggregate<DateVal> {};
 /** Timestamp Histogram Aggregate */
 class TimestampHistogramAggregate : public HistogramAggregate<TimestampVal> {};
 
+/** Approximate count of distinct values. */
+template <typename T>
+class ApproxCountDistinctAggregate {
+  static_assert(std::is_base_of_v<Val, T>, "Template type must subclass value");
+  using CppType = decltype(T::val_);
+
+ public:
+  /**
+   * The precision of the HyperLogLog sketch. A precision of 12 uses 4KB of registers per aggregate
+   * for a relative error of about 1.6%.
+   */
+  static constexpr int PRECISION = 12;
+
+  /**
+   * Constructor.
+   */
+  ApproxCountDistinctAggregate() : hll_(PRECISION) {}
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(ApproxCountDistinctAggregate);
+
+  /**
+   * Advance the aggregate by the input value @em val.
+   * @param val The value to count.
+   */
+  void Advance(const T &val) {
+    if (val.is_null_) {
+      return;
+    }
+    if constexpr (std::is_same_v<T, StringVal>) {
+      hll_.Update(val.val_.Content(), val.val_.Size());
+    } else {
+      hll_.Update(val.val_);
+    }
+  }
+
+  /**
+   * Merge a partial approximate count into this aggregate.
+   * @param that The aggregate to merge.
+   */
+  void Merge(const ApproxCountDistinctAggregate &that) { hll_.Merge(that.hll_); }
+
+  /**
+   * Reset the aggregate.
+   */
+  void Reset() { hll_.Clear(); }
+
+  /**
+   * Return the estimated number of distinct values.
+   */
+  Integer GetResult() const { return Integer(static_cast<int64_t>(hll_.EstimateCardinality())); }
+
+ private:
+  optimizer::HyperLogLog<CppType> hll_;
+};
+
+/** Boolean Approximate Count Distinct Aggregate */
+class BooleanApproxCountDistinctAggregate : public ApproxCountDistinctAggregate<BoolVal> {};
+/** Integer Approximate Count Distinct Aggregate */
+class IntegerApproxCountDistinctAggregate : public ApproxCountDistinctAggregate<Integer> {};
+/** Real Approximate Count Distinct Aggregate */
+class RealApproxCountDistinctAggregate : public ApproxCountDistinctAggregate<Real> {};
+/** Decimal Approximate Count Distinct Aggregate */
+class DecimalApproxCountDistinctAggregate : public ApproxCountDistinctAggregate<DecimalVal> {};
+/** String Approximate Count Distinct Aggregate */
+class StringApproxCountDistinctAggregate : public ApproxCountDistinctAggregate<StringVal> {};
+/** Date Approximate Count Distinct Aggregate */
+class DateApproxCountDistinctAggregate : public ApproxCountDistinctAggregate<DateVal> {};
+/** Timestamp Approximate Count Distinct Aggregate */
+class TimestampApproxCountDistinctAggregate : public ApproxCountDistinctAggregate<TimestampVal> {};
+
+/** Approximate percentile aggregate. */
+class ApproxPercentileAggregate {
+ public:
+  /**
+   * Constructor.
+   */
+  ApproxPercentileAggregate() = default;
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(ApproxPercentileAggregate);
+
+  /**
+   * Advance the aggregate by the input value @em val.
+   * @param val The input value.
+   * @param percentile The percentile to compute, in the range [0, 1]. It is the same for all inputs.
+   */
+  template <typename T>
+  void Advance(const T &val, const Real &percentile) {
+    if (val.is_null_) {
+      return;
+    }
+    percentile_ = percentile.is_null_ ? 0.5 : percentile.val_;
+    digest_.Add(static_cast<double>(val.val_));
+  }
+
+  /**
+   * Merge a partial percentile aggregate into this aggregate.
+   */
+  void Merge(const ApproxPercentileAggregate &that) {
+    if (that.digest_.IsEmpty()) {
+      return;
+    }
+    percentile_ = that.percentile_;
+    digest_.Merge(that.digest_);
+  }
+
+  /**
+   * Reset the aggregate.
+   */
+  void Reset() { digest_.Clear(); }
+
+  /**
+   * Return the estimated value at the percentile.
+   */
+  Real GetResult() const {
+    if (digest_.IsEmpty()) {
+      return Real::Null();
+    }
+    return Real(digest_.Quantile(percentile_));
+  }
+
+ private:
+  TDigest digest_;
+  double percentile_{0.5};
+};
+
 }  // namespace noisepage::execution::sql
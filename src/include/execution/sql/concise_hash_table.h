@@ -71,6 +71,7 @@ class ConciseHashTable {
   /**
    * Set the size of the hash table to support at least @em num_elems entries. The table will
    * optimize itself in expectation of seeing at most @em num_elems elements without resizing.
+   * Any previously inserted elements are discarded, and the table must be built again.
    * @param new_size The expected number of elements.
    * @param tracker MemoryTracker
    */
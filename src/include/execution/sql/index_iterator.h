@@ -13,8 +13,16 @@ class SqlTable;
 }  // namespace noisepage::storage
 
 namespace noisepage::execution::sql {
+class JoinHashTable;
+
 /**
  * Allows iteration for indices from TPL.
+ *
+ * Exact-key lookups (ScanKey() and ScanKeyBatch()) on indexes whose keys are plain table columns are
+ * adaptive: once the number of keys looked up exceeds the configured number of probes per block of
+ * the table, the iterator builds a hash table over the keys of all visible tuples of the table and
+ * answers all further lookups from it instead of the index. If the hash table would grow past the
+ * configured size limit, the iterator keeps probing the index.
  */
 class EXPORT IndexIterator {
  public:
@@ -62,6 +70,23 @@ class EXPORT IndexIterator {
    */
   void ScanLimitDescending(uint32_t limit);
 
+  /**
+   * Append the current contents of the lower bound PR to the batch of keys to be probed by ScanKeyBatch().
+   */
+  void AddBatchKey();
+
+  /**
+   * Look up all keys added with AddBatchKey() since the last batch scan, and clear the batch.
+   * @param sort_keys whether the index should probe the keys in key order
+   */
+  void ScanKeyBatch(bool sort_keys);
+
+  /**
+   * Position the iterator on the results of the next key of the last batch scan, in the order the keys were added.
+   * Advance() then iterates over that key's results just as after ScanKey().
+   */
+  void NextBatchKey();
+
   /**
    * Advances the iterator. Return true if successful
    * @return whether the iterator was advanced or not.
@@ -100,10 +125,40 @@ class EXPORT IndexIterator {
    */
   uint32_t GetIndexSize() const { return index_->GetSize(); }
 
+  /**
+   * @return True if exact-key lookups are answered from a hash table over the table instead of the index.
+   */
+  bool IsUsingHashTable() const { return hash_table_ != nullptr; }
+
  private:
+  // A column of the index key, located in the key PR of the index and in the PR of the table.
+  struct KeyAttr {
+    uint16_t key_offset_;
+    uint16_t table_offset_;
+    uint16_t size_;
+    bool varlen_;
+  };
+
+  // Count the given number of exact-key lookups, and switch to the hash table once there were enough of them.
+  void CountKeyLookups(uint32_t num_keys);
+
+  // Locate the key columns of the index in the table. Returns false if they are not all plain table columns.
+  bool ResolveKeyAttrs();
+
+  // Build the hash table over the keys and slots of all visible tuples of the table, unless the keys cannot be
+  // resolved or the table would outgrow the size limit.
+  void BuildHashTable();
+
+  // Hash the given index key.
+  hash_t HashKey(const storage::ProjectedRow &key) const;
+
+  // Append the slots of all tuples of the hash table whose key equals the given index key.
+  void LookupHashTable(const storage::ProjectedRow &key, std::vector<storage::TupleSlot> *results) const;
+
   exec::ExecutionContext *exec_ctx_;
   uint32_t num_attrs_;
   std::vector<catalog::col_oid_t> col_oids_;
+  catalog::index_oid_t index_oid_;
   common::ManagedPointer<storage::index::Index> index_;
   common::ManagedPointer<storage::SqlTable> table_;
 
@@ -115,6 +170,24 @@ class EXPORT IndexIterator {
   storage::ProjectedRow *hi_index_pr_;
   storage::ProjectedRow *table_pr_;
   std::vector<storage::TupleSlot> tuples_{};
+
+  // Key buffers of the current batch. Buffers are reused across batches and only freed with the iterator.
+  std::vector<storage::ProjectedRow *> batch_keys_{};
+  uint32_t num_batch_keys_ = 0;
+  // Results of the last batch scan, grouped by key, and the key whose results the iterator is positioned on next.
+  std::vector<storage::TupleSlot> batch_tuples_{};
+  std::vector<uint32_t> batch_key_ends_{};
+  uint32_t next_batch_key_ = 0;
+
+  // The key columns of the index, only resolved when the iterator switches to the hash table.
+  std::vector<catalog::col_oid_t> key_col_oids_{};
+  std::vector<KeyAttr> key_attrs_{};
+  // The number of exact-key lookups so far, and the number after which the iterator switches to the hash table. The
+  // threshold is zero if the switch is disabled or was already attempted.
+  uint64_t num_key_lookups_ = 0;
+  uint64_t hash_switch_threshold_ = 0;
+  // The hash table over the table, null until the switch. Each entry holds a tuple slot followed by the index key.
+  std::unique_ptr<JoinHashTable> hash_table_;
 };
 
 }  // namespace noisepage::execution::sql
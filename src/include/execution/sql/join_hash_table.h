@@ -23,6 +23,7 @@ class ExecutionContext;
 
 namespace noisepage::execution::sql {
 
+class SpillFile;
 class ThreadStateContainer;
 class Vector;
 
@@ -44,8 +45,27 @@ class Vector;
  * @endcode
  *
  * In parallel mode, thread-local join hash tables are lazily built and merged in parallel into a
- * global join hash table through a call to JoinHashTable::MergeParallel(). After this call, the
+ * global join hash table through a call to JoinHashTable::MergeParallel() (or its radix-partitioned
+ * counterpart JoinHashTable::MergeParallelPartitioned()). After this call, the
  * global table takes ownership of all thread-local allocated memory and hash index.
+ *
+ * Tables with spilling enabled (see JoinHashTable::EnableSpilling()) radix-partition their build
+ * input on the high bits of the hash value. If the query exceeds its memory budget while the table
+ * is being loaded, a subset of the partitions is written out to a temporary file and all further
+ * build tuples belonging to those partitions go straight to disk. The built table then only
+ * contains the resident partitions. Probes must skip tuples whose partition is not resident (see
+ * JoinHashTable::IsResident()) and re-run over the probe input after every call to
+ * JoinHashTable::NextPass(), which replaces the resident partitions with the next batch of spilled
+ * partitions read back from disk:
+ *
+ * @code
+ * jht.Build();
+ * do {
+ *   for (tuple in probe_input) {
+ *     if (jht.IsResident(hash)) { ... probe ... }
+ *   }
+ * } while (jht.NextPass());
+ * @endcode
  */
 class EXPORT JoinHashTable {
  public:
@@ -63,6 +83,18 @@ class EXPORT JoinHashTable {
   /** Minimum number of expected elements to merge before triggering a parallel merge. */
   static constexpr uint32_t DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE = 1024;
 
+  /** The number of bits of the hash value used to select a spill partition. */
+  static constexpr uint32_t SPILL_PARTITION_BITS = 6;
+
+  /** The number of spill partitions. Partition membership is tracked as a bit set in a 64-bit word. */
+  static constexpr uint32_t NUM_SPILL_PARTITIONS = 1u << SPILL_PARTITION_BITS;
+
+  /** The size of the per-partition buffer that tuples of spilled partitions are collected in. */
+  static constexpr uint32_t SPILL_BUFFER_SIZE = 64 * 1024;
+
+  /** The maximum number of partitions a radix-partitioned parallel merge scatters its input into. */
+  static constexpr uint32_t MAX_RADIX_BUILD_PARTITIONS = 4096;
+
   /**
    * Construct a join hash table. All memory allocations are sourced from the injected @em memory,
    * and thus, are ephemeral.
@@ -94,6 +126,12 @@ class EXPORT JoinHashTable {
    */
   byte *AllocInputTuple(hash_t hash);
 
+  /**
+   * Allow this table to spill partitions of its build input to disk when the query exceeds its
+   * memory budget. Must be called before any tuple is inserted.
+   */
+  void EnableSpilling();
+
   /**
    * Build and finalize the join hash table. After finalization, no new insertions are allowed and
    * the table becomes read-only. Nothing is done if the join hash table has already been finalized.
@@ -126,6 +164,55 @@ class EXPORT JoinHashTable {
    */
   void MergeParallel(ThreadStateContainer *thread_state_container, std::size_t jht_offset);
 
+  /**
+   * Merge all thread-local hash tables stored in the state container into this table using a
+   * radix-partitioned build. Buffered tuples of all thread-local tables are scattered into
+   * cache-sized partitions, each covering a disjoint range of the bucket directory, and then every
+   * partition is inserted into the table in parallel without atomic operations. Compared to
+   * MergeParallel(), this scales with the number of cores and builds the directory in cache.
+   * @param thread_state_container The container for all thread-local tables.
+   * @param jht_offset The offset in the state where the hash table is.
+   */
+  void MergeParallelPartitioned(ThreadStateContainer *thread_state_container, std::size_t jht_offset);
+
+  /**
+   * @return True if tuples with hash value @em hash belong to a partition that is resident in the
+   *         current pass; false if the partition is on disk and will be loaded in a later pass.
+   */
+  bool IsResident(const hash_t hash) const noexcept {
+    return (resident_partitions_ & (uint64_t{1} << SpillPartitionOf(hash))) != 0;
+  }
+
+  /**
+   * Advance to the next pass over a table that has spilled partitions to disk. The partitions
+   * resident in the previous pass are released, and as many spilled partitions as fit in the
+   * query's memory budget (at least one) are read back and built into the table.
+   * @pre The table must have been built.
+   * @return True if a new pass was started and the probe input must be processed again; false if
+   *         all partitions have been processed.
+   */
+  bool NextPass();
+
+  /**
+   * @return True if any partition of this table has been spilled to disk; false otherwise.
+   */
+  bool HasSpilled() const noexcept { return spilled_partitions_ != 0; }
+
+  /**
+   * Build a bloom filter over the hash values of the build tuples whenever the table is built, so
+   * that probe inputs can drop tuples without a join partner early (see MayContain()). Must be
+   * called before the table is built.
+   */
+  void EnableBloomFilter() { bloom_filter_enabled_ = true; }
+
+  /**
+   * @return False if no build tuple resident in the current pass has the hash value @em hash; true
+   *         if one may have it. Always true if the table does not build a bloom filter.
+   */
+  bool MayContain(const hash_t hash) const noexcept {
+    return !bloom_filter_enabled_ || bloom_filter_.Contains(hash);
+  }
+
   /**
    * @return The total number of bytes used to materialize tuples. This excludes space required for
    *         the join index.
@@ -194,6 +281,28 @@ class EXPORT JoinHashTable {
   FRIEND_TEST(JoinHashTableTest, LazyInsertionTest);
   FRIEND_TEST(JoinHashTableTest, PerfTest);
 
+  // The spill partition of the given hash value.
+  static uint32_t SpillPartitionOf(const hash_t hash) noexcept {
+    return static_cast<uint32_t>(hash >> (sizeof(hash_t) * 8 - SPILL_PARTITION_BITS));
+  }
+
+  // Write all buffered entries, and all resident entries belonging to the
+  // given partitions, to disk. Subsequent insertions into these partitions
+  // are buffered and written out, too.
+  void SpillPartitions(uint64_t partitions);
+
+  // Select resident partitions to spill when the query is over budget.
+  uint64_t ChooseSpillVictims() const;
+
+  // Allocate an entry in the write buffer of a spilled partition.
+  HashTableEntry *AllocSpilledEntry(uint32_t part_idx);
+
+  // Write the buffered entries of the given partition to the spill file.
+  void FlushSpillBuffer(uint32_t part_idx);
+
+  // Load all spilled runs of the given partition into this table's entries.
+  void LoadSpilledPartition(uint32_t part_idx);
+
   // Access a stored entry by index
   HashTableEntry *EntryAt(const uint64_t idx) { return reinterpret_cast<HashTableEntry *>(entries_[idx]); }
 
@@ -205,6 +314,9 @@ class EXPORT JoinHashTable {
   void BuildChainingHashTable();
   void BuildConciseHashTable();
 
+  // Fill the bloom filter with the hash values of all entries in the table.
+  void BuildBloomFilter();
+
   // Dispatched from BuildConciseHashTable() to construct the concise hash table
   // and to reorder buffered build tuples in place according to the CHT.
   template <bool PrefetchCHT, bool PrefetchEntries>
@@ -225,6 +337,14 @@ class EXPORT JoinHashTable {
   template <bool Concurrent>
   void MergeIncomplete(JoinHashTable *source);
 
+  // Merge HLL estimates and reconcile spilled partitions of the thread-local
+  // tables before they are merged. Returns the estimated number of elements.
+  uint64_t PrepareMerge(const std::vector<JoinHashTable *> &tl_join_tables);
+
+  // The number of partitions to scatter 'num_entries' entries into during a
+  // partitioned merge. The table directory must already be sized.
+  uint64_t ComputeRadixBuildPartitions(uint64_t num_entries) const;
+
  private:
   // The execution context to run with.
   const exec::ExecutionSettings &exec_settings_;
@@ -259,8 +379,42 @@ class EXPORT JoinHashTable {
   // Should we use a concise hash table?
   bool use_concise_ht_;
 
+  // Should the bloom filter be built along with the table?
+  bool bloom_filter_enabled_;
+
   // MemoryTracker
   common::ManagedPointer<MemoryTracker> tracker_;
+
+  // Is this table allowed to spill partitions to disk?
+  bool spill_enabled_;
+
+  // The number of buffered entries when partitions were last spilled.
+  uint64_t num_entries_at_spill_;
+
+  // A contiguous run of entries belonging to one partition, written to a
+  // spill file.
+  struct SpilledRun {
+    // The file the run lives in.
+    const SpillFile *file_;
+    // The byte offset of the run in the file.
+    std::size_t offset_;
+    // The number of entries in the run.
+    uint64_t num_entries_;
+  };
+  // Bit set of the partitions whose build tuples were (also) written to disk.
+  uint64_t spilled_partitions_;
+  // Bit set of the partitions that are in memory in the current pass.
+  uint64_t resident_partitions_;
+  // Bit set of the spilled partitions not processed in any pass yet.
+  uint64_t pending_partitions_;
+  // The spill files owned by this table. Thread-local tables create at most
+  // one file. The main table takes ownership of all thread-local files.
+  std::vector<std::unique_ptr<SpillFile>> spill_files_;
+  // The spilled runs of each partition. Empty if nothing spilled.
+  std::vector<std::vector<SpilledRun>> partition_spills_;
+  // Per-partition buffers collecting entries of spilled partitions until a
+  // full buffer can be written out at once.
+  std::vector<std::vector<byte>> spill_buffers_;
 };
 
 // ---------------------------------------------------------
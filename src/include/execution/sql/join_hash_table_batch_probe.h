@@ -0,0 +1,77 @@
+#pragma once
+
+#include "common/macros.h"
+#include "execution/sql/hash_table_entry.h"
+#include "execution/sql/vector.h"
+
+namespace noisepage::execution::sql {
+
+class JoinHashTable;
+
+/**
+ * Probes a join hash table for a batch of probe tuples at once, while the matches of each tuple are
+ * still processed one tuple at a time. The hash values of all tuples in a batch are added through
+ * AddHash(), looked up together through Lookup(), and the matches of each tuple are then retrieved
+ * through Next() in the order the hashes were added:
+ *
+ * @code
+ * JoinHashTableBatchProbe probe;
+ * for (const auto &tuple : batch) {
+ *   probe.AddHash(Hash(tuple));
+ * }
+ * probe.Lookup(jht);
+ * for (const auto &tuple : batch) {
+ *   for (auto iter = probe.Next(); iter.HasNext();) {
+ *     // Check keys
+ *   }
+ * }
+ * @endcode
+ *
+ * Looking up the whole batch at once lets the lookup prefetch the bucket chains and entries of the
+ * upcoming probes, so the cache misses of a batch overlap instead of stalling every probe in turn.
+ * A batch holds at most common::Constants::K_DEFAULT_VECTOR_SIZE probes, i.e., one vector projection.
+ */
+class JoinHashTableBatchProbe {
+ public:
+  /**
+   * Create an empty batch probe.
+   */
+  JoinHashTableBatchProbe();
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(JoinHashTableBatchProbe);
+
+  /**
+   * Add the hash of the next probe tuple to the batch.
+   * @param hash The hash value of the probe tuple.
+   */
+  void AddHash(hash_t hash);
+
+  /**
+   * Look up all hashes added since the last lookup in the given table, starting a new batch.
+   * @param table The join hash table to probe. It must have been built.
+   */
+  void Lookup(const JoinHashTable &table);
+
+  /**
+   * @return An iterator over the potential matches of the next probe tuple of the batch, in the order
+   *         the hashes were added.
+   */
+  HashTableEntryIterator Next();
+
+ private:
+  // The hashes of the batch.
+  Vector hashes_;
+  // The first entry with a matching hash for each hash of the batch, if any.
+  Vector entries_;
+  // The number of hashes added to the batch that is looked up next.
+  uint32_t num_added_;
+  // The number of hashes of the batch looked up last.
+  uint32_t num_probes_;
+  // The index of the next probe to retrieve.
+  uint32_t next_;
+};
+
+}  // namespace noisepage::execution::sql
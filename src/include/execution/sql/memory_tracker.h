@@ -2,14 +2,31 @@
 
 #include <tbb/enumerable_thread_specific.h>
 
+#include <atomic>
+
+#include "execution/util/execution_common.h"
+
 namespace noisepage::execution::sql {
 
 /**
  * Class for tracking memory on a per-thread granularity.
  * Currently tracks allocation size in bytes during thread's execution.
+ *
+ * In addition to the per-thread statistics (which are reset by the resource trackers whenever a new operating unit
+ * begins), the tracker maintains a running total of the bytes that are live across all threads of the query. This
+ * total is compared against an optional per-query memory budget so that memory-hungry operators can decide to spill.
  */
 class EXPORT MemoryTracker {
  public:
+  /** Denotes that no memory budget is enforced. */
+  static constexpr size_t UNLIMITED_BUDGET = 0;
+
+  /**
+   * Create a tracker with the given budget.
+   * @param memory_budget The maximum number of bytes the query should keep live. Zero means unlimited.
+   */
+  explicit MemoryTracker(size_t memory_budget = UNLIMITED_BUDGET) : memory_budget_(memory_budget) {}
+
   /**
    * Reset tracker
    */
@@ -24,13 +41,40 @@ class EXPORT MemoryTracker {
    * Increments number of allocated bytes
    * @param size number to increment by
    */
-  void Increment(size_t size) { stats_.local().allocated_bytes_ += size; }
+  void Increment(size_t size) {
+    stats_.local().allocated_bytes_ += size;
+    total_allocated_bytes_.fetch_add(size, std::memory_order_relaxed);
+  }
 
   /**
    * Decrements number of allocated bytes
    * @param size number to decrement by
    */
-  void Decrement(size_t size) { stats_.local().allocated_bytes_ -= size; }
+  void Decrement(size_t size) {
+    stats_.local().allocated_bytes_ -= size;
+    total_allocated_bytes_.fetch_sub(size, std::memory_order_relaxed);
+  }
+
+  /**
+   * @return The number of bytes currently live across all threads. Unaffected by Reset().
+   */
+  size_t GetTotalAllocatedSize() const { return total_allocated_bytes_.load(std::memory_order_relaxed); }
+
+  /**
+   * Set the per-query memory budget.
+   * @param memory_budget The maximum number of bytes the query should keep live. Zero means unlimited.
+   */
+  void SetMemoryBudget(size_t memory_budget) { memory_budget_ = memory_budget; }
+
+  /**
+   * @return The per-query memory budget in bytes. Zero means unlimited.
+   */
+  size_t GetMemoryBudget() const { return memory_budget_; }
+
+  /**
+   * @return True if a budget is set and the live memory across all threads exceeds it; false otherwise.
+   */
+  bool IsOverBudget() const { return memory_budget_ != UNLIMITED_BUDGET && GetTotalAllocatedSize() > memory_budget_; }
 
  private:
   /**
@@ -41,6 +85,10 @@ class EXPORT MemoryTracker {
     size_t allocated_bytes_ = 0;
   };
   tbb::enumerable_thread_specific<Stats> stats_;
+  // Number of bytes live across all threads
+  std::atomic<size_t> total_allocated_bytes_{0};
+  // The per-query memory budget
+  size_t memory_budget_;
 };
 
 }  // namespace noisepage::execution::sql
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <string>
 
 #include "execution/sql/runtime_types.h"
 
@@ -8,6 +9,45 @@ namespace noisepage::execution::sql {
 
 static constexpr const char DEFAULT_ESCAPE = '\\';
 
+/**
+ * A LIKE pattern compiled for matching many strings. Patterns whose only wildcards are a leading and/or a trailing '%'
+ * are matched by a specialized kernel: an exact comparison, a prefix or suffix comparison, or a SIMD substring search.
+ * All other patterns fall back to the general matcher, Like::Impl().
+ */
+class LikePattern {
+ public:
+  /** The kernel a pattern is matched with. */
+  enum class Kind : uint8_t { Exact, Prefix, Suffix, Contains, General };
+
+  /**
+   * Compile the given pattern.
+   * @param pattern The LIKE pattern.
+   * @param pattern_len The length of the pattern.
+   * @param escape The escape character of the pattern.
+   */
+  LikePattern(const char *pattern, std::size_t pattern_len, char escape = DEFAULT_ESCAPE);
+
+  /**
+   * Compile the given pattern.
+   * @param pattern The LIKE pattern.
+   * @param escape The escape character of the pattern.
+   */
+  explicit LikePattern(const storage::VarlenEntry &pattern, char escape = DEFAULT_ESCAPE)
+      : LikePattern(reinterpret_cast<const char *>(pattern.Content()), pattern.Size(), escape) {}
+
+  /** @return True if the string is like the pattern. */
+  bool Matches(const char *str, std::size_t str_len) const;
+
+  /** @return The kernel the pattern is matched with. */
+  Kind GetKind() const { return kind_; }
+
+ private:
+  Kind kind_;
+  // For all kinds but General, the pattern without its wildcards and escapes. For General, the pattern itself.
+  std::string literal_;
+  char escape_;
+};
+
 /**
  * Functor implementing the SQL LIKE() operator
  */
@@ -22,6 +62,11 @@ struct Like {
     return Impl(reinterpret_cast<const char *>(str.Content()), str.Size(),
                 reinterpret_cast<const char *>(pattern.Content()), pattern.Size(), escape);
   }
+
+  /** @return True if str is LIKE the compiled pattern. */
+  bool operator()(const storage::VarlenEntry &str, const LikePattern &pattern) const {
+    return pattern.Matches(reinterpret_cast<const char *>(str.Content()), str.Size());
+  }
 };
 
 /**
@@ -33,6 +78,11 @@ struct NotLike {
                   char escape = DEFAULT_ESCAPE) const {
     return !Like{}(str, pattern, escape);  // NOLINT
   }
+
+  /** @return True if str is NOT LIKE the compiled pattern. */
+  bool operator()(const storage::VarlenEntry &str, const LikePattern &pattern) const {
+    return !Like{}(str, pattern);  // NOLINT
+  }
 };
 
 }  // namespace noisepage::execution::sql
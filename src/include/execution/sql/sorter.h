@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/constants.h"
 #include "common/macros.h"
 #include "execution/sql/memory_pool.h"
 #include "execution/util/chunked_vector.h"
@@ -15,6 +16,8 @@ class ExecutionContext;
 
 namespace noisepage::execution::sql {
 
+class SorterRunMerger;
+class SpillFile;
 class ThreadStateContainer;
 class VectorProjection;
 class VectorProjectionIterator;
@@ -67,6 +70,11 @@ class VectorProjectionIterator;
  * thread-local Sorter, but <b>without calling</b> Sorter::Sort(). When all insertions are complete
  * across all threads, the primary thread uses Sorter::SortParallel() or Sorter::SortTopKParallel()
  * for parallel sort and parallel Top-K, respectively.
+ *
+ * If the query exceeds its memory budget while tuples are inserted, the buffered tuples are sorted
+ * and written to a temporary file as a sorted run, and their memory is released. Sorting a sorter
+ * that has spilled runs merges them on the fly: iterators stream the tuples of all runs in order
+ * through a k-way merge. Top-K sorters never spill since they buffer at most K tuples.
  */
 class EXPORT Sorter {
  public:
@@ -91,6 +99,15 @@ class EXPORT Sorter {
   static constexpr uint64_t DEFAULT_MIN_TUPLES_FOR_PARALLEL_SORT = 10000;
 #endif
 
+  /** The minimum number of tuples in a sorted run cut to disk. */
+  static constexpr uint64_t MIN_RUN_SIZE = common::Constants::K_DEFAULT_VECTOR_SIZE;
+
+  /** The maximum number of sorted runs merged at once. More runs are merged into longer runs first. */
+  static constexpr uint32_t MAX_MERGE_FAN_IN = 64;
+
+  /** The size of the buffers used to write out and read back each sorted run. */
+  static constexpr uint32_t RUN_BUFFER_SIZE = 64 * 1024;
+
   /**
    * The comparison function used to sort tuples in a Sorter.
    */
@@ -166,9 +183,9 @@ class EXPORT Sorter {
   void SortTopKParallel(ThreadStateContainer *thread_state_container, uint32_t sorter_offset, uint64_t top_k);
 
   /**
-   * @return The number of tuples currently in this sorter.
+   * @return The number of tuples currently in this sorter, including those spilled to disk.
    */
-  uint64_t GetTupleCount() const noexcept { return tuples_.size(); }
+  uint64_t GetTupleCount() const noexcept { return tuples_.size() + num_spilled_tuples_; }
 
   /**
    * @return True if this sorter contains no tuples; false otherwise.
@@ -180,7 +197,36 @@ class EXPORT Sorter {
    */
   bool IsSorted() const noexcept { return sorted_; }
 
+  /**
+   * @return True if this sorter has written sorted runs to disk; false otherwise.
+   */
+  bool HasSpilled() const noexcept { return !runs_.empty(); }
+
  private:
+  // A sorted run of tuples stored contiguously in a spill file.
+  struct SortedRun {
+    // The file the run lives in.
+    const SpillFile *file_;
+    // The byte offset of the run in the file.
+    std::size_t offset_;
+    // The number of tuples in the run.
+    uint64_t num_tuples_;
+  };
+
+  // Append a tuple without considering to spill.
+  byte *AppendTuple();
+
+  // Sort the buffered tuples, write them out as a new sorted run and release
+  // their memory.
+  void SpillSortedRun();
+
+  // Merge the sorted runs into longer runs until at most MAX_MERGE_FAN_IN
+  // remain, which are then merged while iterating.
+  void ReduceRuns();
+
+  // Take ownership of the sorted runs and spill files of the given sorter.
+  void TakeRuns(Sorter *other);
+
   // Build a max heap from the tuples currently stored in the sorter instance
   void BuildHeap();
 
@@ -190,6 +236,7 @@ class EXPORT Sorter {
 
  private:
   friend class SorterIterator;
+  friend class SorterRunMerger;
   friend class SorterVectorIterator;
 
   exec::ExecutionContext *exec_ctx_;
@@ -210,6 +257,111 @@ class EXPORT Sorter {
 
   // Flag indicating if the contents of the sorter have been sorted
   bool sorted_;
+
+  // The memory tracker whose budget decides when to spill
+  common::ManagedPointer<MemoryTracker> tracker_;
+
+  // The number of buffered tuples needed before a new run is cut
+  uint64_t min_run_size_;
+
+  // The number of tuples in sorted runs on disk
+  uint64_t num_spilled_tuples_;
+
+  // The spill files owned by this sorter. Thread-local sorters create at most
+  // one file. The main sorter takes ownership of all thread-local files.
+  std::vector<std::unique_ptr<SpillFile>> spill_files_;
+
+  // The sorted runs written to disk
+  std::vector<SortedRun> runs_;
+};
+
+/**
+ * Streams the tuples of a set of sorted runs on disk in sorted order. Each run is read back through
+ * a small buffer, and the next smallest tuple is selected using a loser tree, requiring only
+ * log(k) comparisons per tuple for k runs.
+ */
+class SorterRunMerger {
+ public:
+  /**
+   * Create a merger over all sorted runs of the given sorter.
+   * @param sorter The sorter whose runs are merged.
+   */
+  explicit SorterRunMerger(const Sorter &sorter);
+
+  /**
+   * Create a merger over a contiguous range of the given sorter's sorted runs.
+   * @param sorter The sorter whose runs are merged.
+   * @param first_run The index of the first run to merge.
+   * @param num_runs The number of runs to merge.
+   */
+  SorterRunMerger(const Sorter &sorter, std::size_t first_run, std::size_t num_runs);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(SorterRunMerger);
+
+  /**
+   * @return True if the merger has more tuples; false otherwise.
+   */
+  bool HasNext() const noexcept { return num_remaining_ > 0; }
+
+  /**
+   * Advance to the next tuple in sorted order.
+   */
+  void Next();
+
+  /**
+   * @return The number of tuples remaining in the merger.
+   */
+  uint64_t NumRemaining() const noexcept { return num_remaining_; }
+
+  /**
+   * @return A pointer to the current tuple. The pointer is only valid until the next call to
+   *         Next().
+   */
+  const byte *GetRow() const noexcept { return cursors_[tree_[0]].Current(tuple_size_); }
+
+ private:
+  // A read cursor over one sorted run.
+  struct Cursor {
+    // The file being read.
+    const SpillFile *file_;
+    // The file offset of the first tuple not yet read into the buffer.
+    std::size_t next_offset_;
+    // The number of tuples not yet read into the buffer.
+    uint64_t num_unread_;
+    // The buffered tuples.
+    std::vector<byte> buffer_;
+    // The number of tuples in the buffer, and the position of the current one.
+    uint64_t num_buffered_;
+    uint64_t pos_;
+
+    bool IsExhausted() const noexcept { return pos_ == num_buffered_; }
+    const byte *Current(std::size_t tuple_size) const noexcept { return buffer_.data() + pos_ * tuple_size; }
+  };
+
+  // Read the next batch of tuples of the given run into its buffer.
+  void Refill(Cursor *cursor);
+
+  // Does the current tuple of run 'a' come before that of run 'b'?
+  bool Beats(uint32_t a, uint32_t b) const;
+
+  // Build the loser tree over the first tuple of every run.
+  void InitTree();
+
+ private:
+  // The comparison function and size of the merged tuples
+  Sorter::ComparisonFunction cmp_fn_;
+  std::size_t tuple_size_;
+  // The cursors over each run
+  std::vector<Cursor> cursors_;
+  // The loser tree. Node 0 holds the index of the overall winner, i.e., the
+  // run with the current smallest tuple. Nodes [1, k) hold the loser of the
+  // match played at that node.
+  std::vector<uint32_t> tree_;
+  // The number of tuples not yet returned
+  uint64_t num_remaining_;
 };
 
 /**
@@ -228,12 +380,18 @@ class SorterIterator {
   /**
    * @return True if the iterator has more data; false otherwise.
    */
-  bool HasNext() const { return iter_ != end_; }
+  bool HasNext() const { return iter_ != end_ || (merger_ != nullptr && merger_->HasNext()); }
 
   /**
    * Advance the iterator by one tuple.
    */
-  void Next() { ++iter_; }
+  void Next() {
+    if (merger_ == nullptr) {
+      ++iter_;
+    } else {
+      merger_->Next();
+    }
+  }
 
   /**
    * Advance the iterator by @em n rows. If there are fewer than @em n rows remaining in this
@@ -245,14 +403,18 @@ class SorterIterator {
   /**
    * @return The number of tuples remaining in the iterator.
    */
-  uint64_t NumRemaining() const { return std::distance(iter_, end_); }
+  uint64_t NumRemaining() const {
+    return merger_ == nullptr ? static_cast<uint64_t>(std::distance(iter_, end_)) : merger_->NumRemaining();
+  }
 
   /**
    * @return A pointer to the current row. It assumed the called has checked the iterator is valid.
+   *         If the sorter has spilled to disk, the pointer is only valid until the iterator is
+   *         advanced.
    */
   const byte *GetRow() const {
-    NOISEPAGE_ASSERT(iter_ != end_, "Invalid iterator");
-    return *iter_;
+    NOISEPAGE_ASSERT(HasNext(), "Invalid iterator");
+    return merger_ == nullptr ? *iter_ : merger_->GetRow();
   }
 
   /**
@@ -286,6 +448,8 @@ class SorterIterator {
   IteratorType iter_;
   // The ending iterator position
   const IteratorType end_;
+  // The merger over the sorted runs on disk, if the sorter spilled
+  std::unique_ptr<SorterRunMerger> merger_;
 };
 
 /**
@@ -341,6 +505,13 @@ class SorterVectorIterator {
   // Temporary array storing the sorter rows
   const byte **temp_rows_;
 
+  // The size of the sorter's tuples
+  std::size_t tuple_size_;
+
+  // If the sorter spilled, the rows of a vector are copied here since rows
+  // streamed from disk do not remain valid
+  byte *staged_rows_;
+
   // The vector projections produced by this iterator
   std::unique_ptr<VectorProjection> vector_projection_;
 
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+#include "execution/util/file.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * An append-only temporary file used by operators that spill intermediate state to disk once their
+ * query exceeds its memory budget. The file is anonymous: it is unlinked at creation and vanishes
+ * when closed, so a crashed query never leaves junk behind.
+ *
+ * Writers append opaque runs of bytes and receive the file offset the run was written at. Readers
+ * read back arbitrary ranges by offset. Both appends and reads use positional I/O and are therefore
+ * safe to issue concurrently from multiple threads.
+ */
+class SpillFile {
+ public:
+  /**
+   * Create a new, empty, temporary spill file.
+   * @throw ExecutionException If the temporary file could not be created.
+   */
+  SpillFile();
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /**
+   * Append @em len bytes from @em data to the end of the file.
+   * @param data The bytes to write.
+   * @param len The number of bytes to write.
+   * @return The offset in the file the bytes were written at.
+   * @throw ExecutionException On I/O error.
+   */
+  std::size_t Append(const byte *data, std::size_t len);
+
+  /**
+   * Read @em len bytes starting at file offset @em offset into @em data.
+   * @param offset The offset in the file to read from.
+   * @param[out] data The buffer to read into. Must be at least @em len bytes.
+   * @param len The number of bytes to read.
+   * @throw ExecutionException On I/O error or if the range is out of bounds.
+   */
+  void Read(std::size_t offset, byte *data, std::size_t len) const;
+
+  /**
+   * @return The number of bytes written to this file.
+   */
+  std::size_t GetSize() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+ private:
+  // The underlying temporary file.
+  util::File file_;
+  // The number of bytes written (or reserved for writing).
+  std::atomic<std::size_t> size_{0};
+};
+
+}  // namespace noisepage::execution::sql
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
@@ -17,6 +18,10 @@ class Index;
 
 }  // namespace noisepage::storage
 
+namespace noisepage::transaction {
+class TransactionContext;
+}  // namespace noisepage::transaction
+
 namespace noisepage::execution {
 
 namespace exec {
@@ -46,6 +51,13 @@ class EXPORT StorageInterface {
    */
   ~StorageInterface();
 
+  /**
+   * Makes this storage interface write through its own worker context of the transaction, so that several threads of
+   * a parallel pipeline can modify tables and indexes concurrently. The worker is merged back into the transaction
+   * when the storage interface is destroyed.
+   */
+  void BeginWorker();
+
   /**
    * @return The table's projected row.
    */
@@ -162,6 +174,16 @@ class EXPORT StorageInterface {
    * Current index being accessed.
    */
   common::ManagedPointer<storage::index::Index> curr_index_{nullptr};
+
+  /**
+   * The worker context of the transaction that this storage interface writes through, if any.
+   */
+  std::unique_ptr<transaction::TransactionContext> worker_txn_;
+
+  /**
+   * @return The transaction context to write through.
+   */
+  common::ManagedPointer<transaction::TransactionContext> GetTxn();
 };
 }  // namespace sql
 }  // namespace noisepage::execution
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace noisepage::execution::sql {
+
+/**
+ * A merging t-digest: a compact sketch of a distribution of real numbers that answers quantile
+ * queries approximately. The digest summarizes its input as a sorted list of centroids, i.e., a
+ * mean and the number of values it stands for. Centroids at the tails of the distribution stand for
+ * few values and centroids in the middle for many, so extreme quantiles stay accurate while the
+ * size of the digest is bounded by its compression factor, regardless of the number of inputs.
+ *
+ * New values are buffered and merged into the centroids in bulk. Two digests are merged by merging
+ * their centroids, which makes the digest suitable for thread-local partial aggregates.
+ *
+ * @see Dunning and Ertl, "Computing Extremely Accurate Quantiles Using t-Digests"
+ */
+class TDigest {
+ public:
+  /** The default compression factor. Digests hold at most a small multiple of this many centroids. */
+  static constexpr double DEFAULT_COMPRESSION = 100.0;
+
+  /**
+   * Create an empty digest.
+   * @param compression The compression factor. Larger factors are more accurate but larger.
+   */
+  explicit TDigest(double compression = DEFAULT_COMPRESSION);
+
+  /**
+   * Add the given value to the digest.
+   * @param value The value to add.
+   */
+  void Add(double value);
+
+  /**
+   * Merge all values summarized in the given digest into this digest.
+   * @param that The digest to merge.
+   */
+  void Merge(const TDigest &that);
+
+  /**
+   * Remove all values from the digest.
+   */
+  void Clear();
+
+  /**
+   * Estimate the value at the given quantile of all values added to the digest.
+   * @param q The quantile, in the range [0, 1].
+   * @return The estimated value. The digest must not be empty.
+   */
+  double Quantile(double q) const;
+
+  /**
+   * @return The number of values added to the digest.
+   */
+  uint64_t GetCount() const { return count_; }
+
+  /**
+   * @return True if no values have been added to the digest; false otherwise.
+   */
+  bool IsEmpty() const { return count_ == 0; }
+
+ private:
+  // A centroid summarizes a number of values by their mean.
+  struct Centroid {
+    double mean_;
+    double weight_;
+  };
+
+  // Merge the buffered values into the centroids.
+  void Compress();
+
+  // The scale function that limits the weight of centroids by the quantile they are at, and its
+  // inverse.
+  double Scale(double q) const;
+  double InverseScale(double k) const;
+
+ private:
+  // The compression factor.
+  double compression_;
+  // The centroids, sorted by mean.
+  std::vector<Centroid> centroids_;
+  // Values that have not been merged into the centroids yet.
+  std::vector<Centroid> buffer_;
+  // The number of values added to the digest.
+  uint64_t count_;
+  // The smallest and largest value added to the digest.
+  double min_;
+  double max_;
+};
+
+}  // namespace noisepage::execution::sql
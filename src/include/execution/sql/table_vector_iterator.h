@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "execution/sql/vector_projection.h"
@@ -74,6 +75,17 @@ class EXPORT TableVectorIterator {
    */
   bool Init(uint32_t block_start, uint32_t block_end);
 
+  /**
+   * Restrict the iteration to blocks that may contain a value in [low, high] for the column at the given index of the
+   * scanned column OIDs. Blocks whose zone maps prove otherwise are skipped entirely; all other blocks are returned as
+   * usual, so the range must still be applied as a predicate on the produced tuples. Must be called after
+   * initialization but before the first call to Advance(). Only integer-typed columns may be restricted.
+   * @param col_idx The index of the column in the column OIDs the iterator was created with.
+   * @param low The smallest value of the range (inclusive).
+   * @param high The largest value of the range (inclusive).
+   */
+  void AddRangeFilter(uint32_t col_idx, int64_t low, int64_t high);
+
   /**
    * Advance the iterator by a vector of input.
    * @return True if there is more data in the iterator; false otherwise.
@@ -124,6 +136,19 @@ class EXPORT TableVectorIterator {
                            uint32_t min_grain_size = K_MIN_BLOCK_RANGE_SIZE);
 
  private:
+  // A range on a column used to skip blocks through their zone maps.
+  struct RangeFilter {
+    storage::col_id_t col_id_;
+    int64_t low_;
+    int64_t high_;
+  };
+
+  // Position the iterator at the next block in range that passes all range filters.
+  bool AdvanceToNextMatchingBlock();
+
+  // Attach the dictionaries of the given frozen block to the vector projection that was just scanned from it.
+  void AttachDictionaries(storage::RawBlock *block);
+
   exec::ExecutionContext *exec_ctx_;
   const catalog::table_oid_t table_oid_;
   std::vector<catalog::col_oid_t> col_oids_{};
@@ -133,6 +158,17 @@ class EXPORT TableVectorIterator {
 
   std::unique_ptr<storage::DataTable::SlotIterator> iter_ = nullptr;
 
+  // The range of blocks [block_start_, block_end_) to iterate over.
+  uint32_t block_start_{0};
+  uint32_t block_end_{0};
+
+  // When there are range filters, the table is visited one block at a time. This is the next block to consider.
+  uint32_t next_block_{0};
+  std::vector<RangeFilter> range_filters_;
+
+  // The (projection index, storage column) pairs of the string columns that may be dictionary-compressed.
+  std::vector<std::pair<uint32_t, storage::col_id_t>> dictionary_cols_;
+
   VectorProjection vector_projection_;
 
   // An iterator over the currently active projection.
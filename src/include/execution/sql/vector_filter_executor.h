@@ -312,6 +312,25 @@ class VectorFilterExecutor {
    */
   static void SelectNotLike(const exec::ExecutionSettings &exec_settings, VectorProjection *vector_projection,
                             uint32_t left_col_idx, uint32_t right_col_idx, TupleIdList *tid_list);
+
+ private:
+  // The comparisons with a constant that can be answered from the codes of a dictionary-encoded column.
+  enum class DictionaryComparison : uint8_t {
+    SelectEqual,
+    SelectGreaterThan,
+    SelectGreaterThanEqual,
+    SelectLessThan,
+    SelectLessThanEqual,
+    SelectNotEqual,
+    SelectLike,
+    SelectNotLike,
+  };
+
+  // Evaluate the comparison of a dictionary-encoded column with a constant once against the sorted dictionary, and
+  // then select tuples by their integer codes. Returns false if the comparison cannot be evaluated this way, in
+  // which case nothing was selected and the caller must fall back to comparing the values.
+  static bool SelectOnDictionary(DictionaryComparison cmp, VectorProjection *vector_projection, uint32_t col_idx,
+                                 const GenericValue &val, TupleIdList *tid_list);
 };
 
 // ---------------------------------------------------------
@@ -320,21 +339,29 @@ class VectorFilterExecutor {
 //
 // ---------------------------------------------------------
 
-#define GEN_FILTER_VECTOR_GENERIC_VAL(OpName)                                                                \
-  inline void VectorFilterExecutor::OpName##Val(const exec::ExecutionSettings &exec_settings,                \
-                                                VectorProjection *vector_projection, const uint32_t col_idx, \
-                                                const GenericValue &val, TupleIdList *tid_list) {            \
-    const auto *left_vector = vector_projection->GetColumn(col_idx);                                         \
-    VectorOps::OpName(exec_settings, *left_vector, ConstantVector(val), tid_list);                           \
+#define GEN_FILTER_VECTOR_GENERIC_VAL(OpName)                                                                     \
+  inline void VectorFilterExecutor::OpName##Val(const exec::ExecutionSettings &exec_settings,                     \
+                                                VectorProjection *vector_projection, const uint32_t col_idx,      \
+                                                const GenericValue &val, TupleIdList *tid_list) {                 \
+    if (vector_projection->GetColumnDictionary(col_idx) != nullptr &&                                             \
+        SelectOnDictionary(DictionaryComparison::OpName, vector_projection, col_idx, val, tid_list)) {            \
+      return;                                                                                                     \
+    }                                                                                                             \
+    const auto *left_vector = vector_projection->GetColumn(col_idx);                                              \
+    VectorOps::OpName(exec_settings, *left_vector, ConstantVector(val), tid_list);                                \
   }
 
-#define GEN_FILTER_VECTOR_VAL(OpName)                                                                        \
-  inline void VectorFilterExecutor::OpName##Val(const exec::ExecutionSettings &exec_settings,                \
-                                                VectorProjection *vector_projection, const uint32_t col_idx, \
-                                                const Val &val, TupleIdList *tid_list) {                     \
-    const auto *left_vector = vector_projection->GetColumn(col_idx);                                         \
-    const auto constant = GenericValue::CreateFromRuntimeValue(left_vector->GetTypeId(), val);               \
-    VectorOps::OpName(exec_settings, *left_vector, ConstantVector(constant), tid_list);                      \
+#define GEN_FILTER_VECTOR_VAL(OpName)                                                                             \
+  inline void VectorFilterExecutor::OpName##Val(const exec::ExecutionSettings &exec_settings,                     \
+                                                VectorProjection *vector_projection, const uint32_t col_idx,      \
+                                                const Val &val, TupleIdList *tid_list) {                          \
+    const auto *left_vector = vector_projection->GetColumn(col_idx);                                              \
+    const auto constant = GenericValue::CreateFromRuntimeValue(left_vector->GetTypeId(), val);                    \
+    if (vector_projection->GetColumnDictionary(col_idx) != nullptr &&                                             \
+        SelectOnDictionary(DictionaryComparison::OpName, vector_projection, col_idx, constant, tid_list)) {       \
+      return;                                                                                                     \
+    }                                                                                                             \
+    VectorOps::OpName(exec_settings, *left_vector, ConstantVector(constant), tid_list);                           \
   }
 
 #define GEN_FILTER_VECTOR_VECTOR(OpName)                                                                     \
@@ -13,6 +13,7 @@
 #include "storage/storage_defs.h"
 
 namespace noisepage::storage {
+class ArrowVarlenColumn;
 class BlockLayout;
 }
 
@@ -375,7 +376,42 @@ class EXPORT VectorProjection {
   /** @return The tuple slot at the specified row offset. */
   storage::TupleSlot GetTupleSlot(uint32_t row_offset) { return tuple_slots_[row_offset]; }
 
+  /**
+   * Mark the column at the given index as dictionary-encoded for the current contents of the projection. Every
+   * non-NULL value of the column in row i is equal to the dictionary word with code codes[i], where codes is the
+   * returned array that the caller must fill in. The annotation is dropped on the next call to Reset() or Pack().
+   * @param col_idx The index of the column.
+   * @param dictionary The sorted dictionary of the column. Must outlive the current contents of the projection.
+   * @return The array of per-row codes to fill in, sized to the capacity of the projection.
+   */
+  uint32_t *SetColumnDictionary(uint32_t col_idx, const storage::ArrowVarlenColumn *dictionary);
+
+  /**
+   * @return The dictionary of the column at the given index if the column is dictionary-encoded; NULL otherwise.
+   */
+  const storage::ArrowVarlenColumn *GetColumnDictionary(const uint32_t col_idx) const {
+    return col_idx < dictionaries_.size() ? dictionaries_[col_idx].dictionary_ : nullptr;
+  }
+
+  /**
+   * @return The per-row dictionary codes of the column at the given index. Only meaningful if the column has a
+   *         dictionary.
+   */
+  const uint32_t *GetDictionaryCodes(const uint32_t col_idx) const {
+    NOISEPAGE_ASSERT(GetColumnDictionary(col_idx) != nullptr, "Column is not dictionary-encoded");
+    return dictionaries_[col_idx].codes_.get();
+  }
+
  private:
+  // The dictionary of a dictionary-encoded column along with the code of every row.
+  struct ColumnDictionary {
+    const storage::ArrowVarlenColumn *dictionary_{nullptr};
+    std::unique_ptr<uint32_t[]> codes_;
+  };
+
+  // Drop the dictionary annotations of all columns.
+  void ClearDictionaries();
+
   // Propagate the active TID list to child vectors, if necessary.
   void RefreshFilteredTupleIdList();
 
@@ -408,6 +444,9 @@ class EXPORT VectorProjection {
 
   // The tuple slots in this vector projection.
   std::vector<storage::TupleSlot> tuple_slots_;
+
+  // The dictionaries of dictionary-encoded columns, indexed by column. Allocated lazily.
+  std::vector<ColumnDictionary> dictionaries_;
 };
 
 }  // namespace noisepage::execution::sql
@@ -513,6 +513,27 @@ class ChunkedVector {
     num_elements_--;
   }
 
+  /**
+   * Grow the vector to contain @em new_size elements. New elements are uninitialized and must be
+   * written by the caller through operator[]. Since all storage is allocated up front, distinct new
+   * elements may be written concurrently.
+   * @param new_size The new size of the vector. Must not be smaller than the current size.
+   */
+  void resize(std::size_t new_size) {  // NOLINT
+    NOISEPAGE_ASSERT(new_size >= size(), "Shrinking through resize() is not supported");
+    if (new_size == size()) {
+      return;
+    }
+    const std::size_t last_chunk_idx = (new_size - 1) >> K_LOG_NUM_ELEMENTS_PER_CHUNK;
+    while (chunks_.size() <= last_chunk_idx) {
+      AllocateChunk();
+    }
+    active_chunk_idx_ = last_chunk_idx;
+    end_ = chunks_[active_chunk_idx_] + ChunkAllocSize(ElementSize());
+    position_ = chunks_[active_chunk_idx_] + (((new_size - 1) & K_CHUNK_POSITION_MASK) + 1) * ElementSize();
+    num_elements_ = new_size;
+  }
+
   /**
    * Remove all elements from the vector.
    */
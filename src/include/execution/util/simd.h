@@ -43,4 +43,6 @@ struct Lane {
 #include "execution/util/simd/avx2.h"  // NOLINT
 #endif
 
+#include "execution/util/simd/substring.h"  // NOLINT
+
 #undef SIMD_TOP_LEVEL
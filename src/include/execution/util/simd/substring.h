@@ -0,0 +1,79 @@
+#pragma once
+
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifndef SIMD_TOP_LEVEL
+#error "Don't include 'execution/util/simd/substring.h' directly; instead, include 'execution/util/simd.h'"
+#endif
+
+namespace noisepage::execution::util::simd {
+
+// ---------------------------------------------------------
+// Substring Search
+// ---------------------------------------------------------
+
+/**
+ * Find the first occurrence of a needle in a haystack. Candidate positions are found by comparing the first and the
+ * last byte of the needle against a whole register of consecutive positions at once, and only candidates are compared
+ * in full. With AVX-512BW, 64 positions are checked at once, and the AVX2 loop only handles what is left of the
+ * haystack. Bytes past the end of the haystack are never read.
+ * @param haystack The string to search in.
+ * @param hlen The length of the haystack.
+ * @param needle The string to search for.
+ * @param nlen The length of the needle.
+ * @return A pointer to the first occurrence of the needle in the haystack, or NULL if there is none.
+ */
+static inline const char *FindSubstring(const char *haystack, const std::size_t hlen, const char *needle,
+                                        const std::size_t nlen) {
+  if (nlen == 0) {
+    return haystack;
+  }
+  if (nlen > hlen) {
+    return nullptr;
+  }
+
+  std::size_t i = 0;
+#if defined(__AVX512BW__)
+  const __m512i first_64 = _mm512_set1_epi8(needle[0]);
+  const __m512i last_64 = _mm512_set1_epi8(needle[nlen - 1]);
+  for (; i + nlen - 1 + 64 <= hlen; i += 64) {
+    const __mmask64 first_matches = _mm512_cmpeq_epi8_mask(first_64, _mm512_loadu_si512(haystack + i));
+    const __mmask64 last_matches = _mm512_cmpeq_epi8_mask(last_64, _mm512_loadu_si512(haystack + i + nlen - 1));
+    for (uint64_t mask = first_matches & last_matches; mask != 0; mask &= mask - 1) {
+      const char *candidate = haystack + i + __builtin_ctzll(mask);
+      if (std::memcmp(candidate, needle, nlen) == 0) {
+        return candidate;
+      }
+    }
+  }
+#endif
+
+  const __m256i first_32 = _mm256_set1_epi8(needle[0]);
+  const __m256i last_32 = _mm256_set1_epi8(needle[nlen - 1]);
+  for (; i + nlen - 1 + 32 <= hlen; i += 32) {
+    const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i));
+    const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i + nlen - 1));
+    const __m256i matches =
+        _mm256_and_si256(_mm256_cmpeq_epi8(first_32, block_first), _mm256_cmpeq_epi8(last_32, block_last));
+    for (auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches)); mask != 0; mask &= mask - 1) {
+      const char *candidate = haystack + i + __builtin_ctz(mask);
+      if (std::memcmp(candidate, needle, nlen) == 0) {
+        return candidate;
+      }
+    }
+  }
+
+  // Tail
+  for (; i + nlen <= hlen; i++) {
+    if (haystack[i] == needle[0] && std::memcmp(haystack + i, needle, nlen) == 0) {
+      return haystack + i;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace noisepage::execution::util::simd
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <vector>
 
 #include "execution/vm/bytecode_function_info.h"
@@ -126,7 +127,8 @@ class BytecodeEmitter {
   void EmitJump(Bytecode bytecode, BytecodeLabel *label);
 
   /**
-   * Emits a conditional jump code. The jump is performed when the given condition holds.
+   * Emits a conditional jump code. The jump is performed when the given condition holds. A JumpIfFalse is fused with
+   * the previous bytecode into a superinstruction if that bytecode computes the condition and has a superinstruction.
    * @param bytecode jump bytecode to emit
    * @param cond jump condition
    * @param label label to jump to
@@ -425,7 +427,10 @@ class BytecodeEmitter {
   }
 
   /** Emit a bytecode */
-  void EmitImpl(const Bytecode bytecode) { EmitScalarValue(Bytecodes::ToByte(bytecode)); }
+  void EmitImpl(const Bytecode bytecode) {
+    last_bytecode_pos_ = GetPosition();
+    EmitScalarValue(Bytecodes::ToByte(bytecode));
+  }
 
   /** Emit a local variable reference by encoding it into the bytecode stream */
   void EmitImpl(const LocalVar local) { EmitScalarValue(local.Encode()); }
@@ -445,8 +450,15 @@ class BytecodeEmitter {
   /** Emit a jump instruction to the given label */
   void EmitJump(BytecodeLabel *label);
 
+  /** Turn the last bytecode into its superinstruction with a JumpIfFalse on cond, if possible */
+  bool FuseJumpIfFalse(LocalVar cond);
+
  private:
   std::vector<uint8_t> *bytecode_;
+  // Start of the last emitted bytecode
+  std::size_t last_bytecode_pos_{std::numeric_limits<std::size_t>::max()};
+  // Position the last label was bound to
+  std::size_t last_bound_pos_{std::numeric_limits<std::size_t>::max()};
 };
 
 }  // namespace noisepage::execution::vm
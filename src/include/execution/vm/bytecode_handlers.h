@@ -18,6 +18,7 @@
 #include "execution/sql/functions/system_functions.h"
 #include "execution/sql/index_iterator.h"
 #include "execution/sql/join_hash_table.h"
+#include "execution/sql/join_hash_table_batch_probe.h"
 #include "execution/sql/operators/hash_operators.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/sql_def.h"
@@ -319,6 +320,11 @@ VM_OP_HOT void OpTableVectorIteratorGetVPI(noisepage::execution::sql::VectorProj
   *vpi = iter->GetVectorProjectionIterator();
 }
 
+VM_OP void OpTableVectorIteratorAddRangeFilter(noisepage::execution::sql::TableVectorIterator *iter, uint32_t col_idx,
+                                               int64_t low, int64_t high) {
+  iter->AddRangeFilter(col_idx, low, high);
+}
+
 VM_OP_HOT void OpParallelScanTable(uint32_t table_oid, uint32_t *col_oids, uint32_t num_oids, void *const query_state,
                                    noisepage::execution::exec::ExecutionContext *exec_ctx,
                                    const noisepage::execution::sql::TableVectorIterator::ScanFn scanner) {
@@ -1294,6 +1300,77 @@ GEN_BINARY_AGGREGATE(TimestampVal, TimestampHistogramAggregate);
 
 #undef GEN_BINARY_AGGREGATE
 
+// ---------------------------------------------------------
+// Approximate Count Distinct
+// ---------------------------------------------------------
+
+#define GEN_APPROX_COUNT_DISTINCT_AGGREGATE(SQL_TYPE, AGG_TYPE)                                     \
+  VM_OP_HOT void Op##AGG_TYPE##Init(noisepage::execution::sql::AGG_TYPE *agg) {                     \
+    new (agg) noisepage::execution::sql::AGG_TYPE();                                                \
+  }                                                                                                 \
+  VM_OP_HOT void Op##AGG_TYPE##Advance(noisepage::execution::sql::AGG_TYPE *agg,                    \
+                                       const noisepage::execution::sql::SQL_TYPE *val) {            \
+    agg->Advance(*val);                                                                             \
+  }                                                                                                 \
+  VM_OP_HOT void Op##AGG_TYPE##Merge(noisepage::execution::sql::AGG_TYPE *agg_1,                    \
+                                     const noisepage::execution::sql::AGG_TYPE *agg_2) {            \
+    agg_1->Merge(*agg_2);                                                                           \
+  }                                                                                                 \
+  VM_OP_HOT void Op##AGG_TYPE##Reset(noisepage::execution::sql::AGG_TYPE *agg) { agg->Reset(); }    \
+  VM_OP_HOT void Op##AGG_TYPE##GetResult(noisepage::execution::sql::Integer *result,                \
+                                         const noisepage::execution::sql::AGG_TYPE *agg) {          \
+    *result = agg->GetResult();                                                                     \
+  }                                                                                                 \
+  VM_OP_HOT void Op##AGG_TYPE##Free(noisepage::execution::sql::AGG_TYPE *agg) { agg->~AGG_TYPE(); }
+
+GEN_APPROX_COUNT_DISTINCT_AGGREGATE(BoolVal, BooleanApproxCountDistinctAggregate);
+GEN_APPROX_COUNT_DISTINCT_AGGREGATE(Integer, IntegerApproxCountDistinctAggregate);
+GEN_APPROX_COUNT_DISTINCT_AGGREGATE(Real, RealApproxCountDistinctAggregate);
+GEN_APPROX_COUNT_DISTINCT_AGGREGATE(DecimalVal, DecimalApproxCountDistinctAggregate);
+GEN_APPROX_COUNT_DISTINCT_AGGREGATE(StringVal, StringApproxCountDistinctAggregate);
+GEN_APPROX_COUNT_DISTINCT_AGGREGATE(DateVal, DateApproxCountDistinctAggregate);
+GEN_APPROX_COUNT_DISTINCT_AGGREGATE(TimestampVal, TimestampApproxCountDistinctAggregate);
+
+#undef GEN_APPROX_COUNT_DISTINCT_AGGREGATE
+
+// ---------------------------------------------------------
+// Approximate Percentile
+// ---------------------------------------------------------
+
+VM_OP_HOT void OpApproxPercentileAggregateInit(noisepage::execution::sql::ApproxPercentileAggregate *agg) {
+  new (agg) noisepage::execution::sql::ApproxPercentileAggregate();
+}
+
+VM_OP_HOT void OpApproxPercentileAggregateAdvanceInteger(noisepage::execution::sql::ApproxPercentileAggregate *agg,
+                                                         const noisepage::execution::sql::Integer *val,
+                                                         const noisepage::execution::sql::Real *percentile) {
+  agg->Advance(*val, *percentile);
+}
+
+VM_OP_HOT void OpApproxPercentileAggregateAdvanceReal(noisepage::execution::sql::ApproxPercentileAggregate *agg,
+                                                      const noisepage::execution::sql::Real *val,
+                                                      const noisepage::execution::sql::Real *percentile) {
+  agg->Advance(*val, *percentile);
+}
+
+VM_OP_HOT void OpApproxPercentileAggregateMerge(noisepage::execution::sql::ApproxPercentileAggregate *agg_1,
+                                                const noisepage::execution::sql::ApproxPercentileAggregate *agg_2) {
+  agg_1->Merge(*agg_2);
+}
+
+VM_OP_HOT void OpApproxPercentileAggregateReset(noisepage::execution::sql::ApproxPercentileAggregate *agg) {
+  agg->Reset();
+}
+
+VM_OP_HOT void OpApproxPercentileAggregateGetResult(noisepage::execution::sql::Real *result,
+                                                    const noisepage::execution::sql::ApproxPercentileAggregate *agg) {
+  *result = agg->GetResult();
+}
+
+VM_OP_HOT void OpApproxPercentileAggregateFree(noisepage::execution::sql::ApproxPercentileAggregate *agg) {
+  agg->~ApproxPercentileAggregate();
+}
+
 // ---------------------------------------------------------
 // Hash Joins
 // ---------------------------------------------------------
@@ -1318,14 +1395,53 @@ VM_OP void OpJoinHashTableBuildParallel(noisepage::execution::sql::JoinHashTable
                                         noisepage::execution::sql::ThreadStateContainer *thread_state_container,
                                         uint32_t jht_offset);
 
+VM_OP void OpJoinHashTableBuildPartitioned(noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                           noisepage::execution::sql::ThreadStateContainer *thread_state_container,
+                                           uint32_t jht_offset);
+
 VM_OP_HOT void OpJoinHashTableLookup(noisepage::execution::sql::JoinHashTable *join_hash_table,
                                      noisepage::execution::sql::HashTableEntryIterator *ht_entry_iter,
                                      const noisepage::hash_t hash_val) {
   *ht_entry_iter = join_hash_table->Lookup<false>(hash_val);
 }
 
+VM_OP void OpJoinHashTableEnableSpilling(noisepage::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP_HOT void OpJoinHashTableIsResident(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                         const noisepage::hash_t hash_val) {
+  *result = join_hash_table->IsResident(hash_val);
+}
+
+VM_OP void OpJoinHashTableNextPass(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP void OpJoinHashTableEnableBloomFilter(noisepage::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP_HOT void OpJoinHashTableMayContain(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                         const noisepage::hash_t hash_val) {
+  *result = join_hash_table->MayContain(hash_val);
+}
+
 VM_OP void OpJoinHashTableFree(noisepage::execution::sql::JoinHashTable *join_hash_table);
 
+VM_OP void OpJoinHashTableBatchProbeInit(noisepage::execution::sql::JoinHashTableBatchProbe *probe);
+
+VM_OP_HOT void OpJoinHashTableBatchProbeAddHash(noisepage::execution::sql::JoinHashTableBatchProbe *probe,
+                                                noisepage::hash_t hash_val) {
+  probe->AddHash(hash_val);
+}
+
+VM_OP_HOT void OpJoinHashTableBatchProbeLookup(noisepage::execution::sql::JoinHashTableBatchProbe *probe,
+                                               noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  probe->Lookup(*join_hash_table);
+}
+
+VM_OP_HOT void OpJoinHashTableBatchProbeNext(noisepage::execution::sql::JoinHashTableBatchProbe *probe,
+                                             noisepage::execution::sql::HashTableEntryIterator *ht_entry_iter) {
+  *ht_entry_iter = probe->Next();
+}
+
+VM_OP void OpJoinHashTableBatchProbeFree(noisepage::execution::sql::JoinHashTableBatchProbe *probe);
+
 VM_OP_HOT void OpHashTableEntryIteratorHasNext(bool *has_next,
                                                noisepage::execution::sql::HashTableEntryIterator *ht_entry_iter) {
   *has_next = ht_entry_iter->HasNext();
@@ -1876,6 +1992,14 @@ VM_OP_WARM void OpIndexIteratorScanLimitDescending(noisepage::execution::sql::In
   iter->ScanLimitDescending(limit);
 }
 
+VM_OP_WARM void OpIndexIteratorAddBatchKey(noisepage::execution::sql::IndexIterator *iter) { iter->AddBatchKey(); }
+
+VM_OP_WARM void OpIndexIteratorScanKeyBatch(noisepage::execution::sql::IndexIterator *iter, bool sort_keys) {
+  iter->ScanKeyBatch(sort_keys);
+}
+
+VM_OP_WARM void OpIndexIteratorNextBatchKey(noisepage::execution::sql::IndexIterator *iter) { iter->NextBatchKey(); }
+
 VM_OP_WARM void OpIndexIteratorAdvance(bool *has_more, noisepage::execution::sql::IndexIterator *iter) {
   *has_more = iter->Advance();
 }
@@ -2063,6 +2187,8 @@ VM_OP void OpStorageInterfaceInit(noisepage::execution::sql::StorageInterface *s
                                   noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t table_oid,
                                   uint32_t *col_oids, uint32_t num_oids, bool need_indexes);
 
+VM_OP void OpStorageInterfaceBeginWorker(noisepage::execution::sql::StorageInterface *storage_interface);
+
 VM_OP void OpStorageInterfaceGetTablePR(noisepage::storage::ProjectedRow **pr_result,
                                         noisepage::execution::sql::StorageInterface *storage_interface);
 
@@ -2184,6 +2310,69 @@ VM_OP_WARM void OpTestCatalogIndexLookup(uint32_t *oid_var, noisepage::execution
   *oid_var = index_oid.UnderlyingValue();
 }
 
+// ---------------------------------------------------------
+// Superinstructions
+// ---------------------------------------------------------
+
+// A superinstruction fuses a bytecode computing a boolean with a subsequent JumpIfFalse on that boolean. Its handler
+// stores the boolean exactly like the fused bytecode does, and returns whether the jump is taken.
+
+#define FUSED_COMPARISONS(type, ...)                                                           \
+  VM_OP_HOT bool OpGreaterThanEqual##_##type##_JumpIfFalse(bool *result, type lhs, type rhs) { \
+    OpGreaterThanEqual##_##type(result, lhs, rhs);                                             \
+    return !*result;                                                                           \
+  }                                                                                            \
+                                                                                               \
+  VM_OP_HOT bool OpGreaterThan##_##type##_JumpIfFalse(bool *result, type lhs, type rhs) {      \
+    OpGreaterThan##_##type(result, lhs, rhs);                                                  \
+    return !*result;                                                                           \
+  }                                                                                            \
+                                                                                               \
+  VM_OP_HOT bool OpEqual##_##type##_JumpIfFalse(bool *result, type lhs, type rhs) {            \
+    OpEqual##_##type(result, lhs, rhs);                                                        \
+    return !*result;                                                                           \
+  }                                                                                            \
+                                                                                               \
+  VM_OP_HOT bool OpLessThanEqual##_##type##_JumpIfFalse(bool *result, type lhs, type rhs) {    \
+    OpLessThanEqual##_##type(result, lhs, rhs);                                                \
+    return !*result;                                                                           \
+  }                                                                                            \
+                                                                                               \
+  VM_OP_HOT bool OpLessThan##_##type##_JumpIfFalse(bool *result, type lhs, type rhs) {         \
+    OpLessThan##_##type(result, lhs, rhs);                                                     \
+    return !*result;                                                                           \
+  }                                                                                            \
+                                                                                               \
+  VM_OP_HOT bool OpNotEqual##_##type##_JumpIfFalse(bool *result, type lhs, type rhs) {         \
+    OpNotEqual##_##type(result, lhs, rhs);                                                     \
+    return !*result;                                                                           \
+  }
+
+FUSED_COMPARISONS(int32_t)
+FUSED_COMPARISONS(int64_t)
+FUSED_COMPARISONS(uint32_t)
+FUSED_COMPARISONS(uint64_t)
+
+#undef FUSED_COMPARISONS
+
+#define FUSED_CONDITION(op, type)                                  \
+  VM_OP_HOT bool Op##op##_JumpIfFalse(bool *result, type *input) { \
+    Op##op(result, input);                                         \
+    return !*result;                                               \
+  }
+
+FUSED_CONDITION(ForceBoolTruth, noisepage::execution::sql::BoolVal)
+FUSED_CONDITION(TableVectorIteratorNext, noisepage::execution::sql::TableVectorIterator)
+FUSED_CONDITION(VPIHasNext, const noisepage::execution::sql::VectorProjectionIterator)
+FUSED_CONDITION(VPIHasNextFiltered, const noisepage::execution::sql::VectorProjectionIterator)
+FUSED_CONDITION(AggregationHashTableIteratorHasNext, noisepage::execution::sql::AHTIterator)
+FUSED_CONDITION(HashTableEntryIteratorHasNext, noisepage::execution::sql::HashTableEntryIterator)
+FUSED_CONDITION(JoinHashTableIteratorHasNext, noisepage::execution::sql::JoinHashTableIterator)
+FUSED_CONDITION(SorterIteratorHasNext, noisepage::execution::sql::SorterIterator)
+FUSED_CONDITION(IndexIteratorAdvance, noisepage::execution::sql::IndexIterator)
+
+#undef FUSED_CONDITION
+
 // Macro hygiene
 #undef VM_OP_COLD
 #undef VM_OP_WARM
@@ -42,6 +42,39 @@ namespace noisepage::execution::vm {
 #define GET_BASE_FOR_FLOAT_TYPES(op) (op##_float)
 #define GET_BASE_FOR_BOOL_TYPES(op) (op##_bool)
 
+// Creates instances of the fusable comparisons for a given primitive type
+#define CREATE_FUSABLE_COMPARISONS(F, G, type)                                              \
+  F(G, GreaterThan_##type, OperandType::Local, OperandType::Local, OperandType::Local)      \
+  F(G, GreaterThanEqual_##type, OperandType::Local, OperandType::Local, OperandType::Local) \
+  F(G, Equal_##type, OperandType::Local, OperandType::Local, OperandType::Local)            \
+  F(G, LessThan_##type, OperandType::Local, OperandType::Local, OperandType::Local)         \
+  F(G, LessThanEqual_##type, OperandType::Local, OperandType::Local, OperandType::Local)    \
+  F(G, NotEqual_##type, OperandType::Local, OperandType::Local, OperandType::Local)
+
+/**
+ * Bytecodes that write a boolean into their first operand and are hot when immediately followed by a JumpIfFalse on
+ * that boolean, i.e., loop conditions and filters. Each is fused with the jump into a superinstruction named after it
+ * with a "_JumpIfFalse" suffix, that takes the same operands followed by the jump offset. F is invoked with G, the name
+ * of the bytecode, and its operand types.
+ */
+#define FUSABLE_CONDITION_LIST(F, G)                                                \
+  CREATE_FUSABLE_COMPARISONS(F, G, int32_t)                                         \
+  CREATE_FUSABLE_COMPARISONS(F, G, int64_t)                                         \
+  CREATE_FUSABLE_COMPARISONS(F, G, uint32_t)                                        \
+  CREATE_FUSABLE_COMPARISONS(F, G, uint64_t)                                        \
+  F(G, ForceBoolTruth, OperandType::Local, OperandType::Local)                      \
+  F(G, TableVectorIteratorNext, OperandType::Local, OperandType::Local)             \
+  F(G, VPIHasNext, OperandType::Local, OperandType::Local)                          \
+  F(G, VPIHasNextFiltered, OperandType::Local, OperandType::Local)                  \
+  F(G, AggregationHashTableIteratorHasNext, OperandType::Local, OperandType::Local) \
+  F(G, HashTableEntryIteratorHasNext, OperandType::Local, OperandType::Local)       \
+  F(G, JoinHashTableIteratorHasNext, OperandType::Local, OperandType::Local)        \
+  F(G, SorterIteratorHasNext, OperandType::Local, OperandType::Local)               \
+  F(G, IndexIteratorAdvance, OperandType::Local, OperandType::Local)
+
+// Creates the superinstruction fusing the given bytecode with a subsequent JumpIfFalse
+#define CREATE_FUSED_JUMP_IF_FALSE(F, op, ...) F(op##_JumpIfFalse, __VA_ARGS__, OperandType::JumpOffset)
+
 /**
  * The master list of all bytecodes, flags and operands
  */
@@ -135,6 +168,8 @@ namespace noisepage::execution::vm {
   F(TableVectorIteratorFree, OperandType::Local)                                                                      \
   F(TableVectorIteratorGetVPINumTuples, OperandType::Local, OperandType::Local)                                       \
   F(TableVectorIteratorGetVPI, OperandType::Local, OperandType::Local)                                                \
+  F(TableVectorIteratorAddRangeFilter, OperandType::Local, OperandType::Local, OperandType::Local,                    \
+    OperandType::Local)                                                                                               \
   F(ParallelScanTable, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local,                \
     OperandType::Local, OperandType::FunctionId)                                                                      \
                                                                                                                       \
@@ -535,6 +570,57 @@ namespace noisepage::execution::vm {
   F(TimestampHistogramAggregateReset, OperandType::Local)                                                             \
   F(TimestampHistogramAggregateGetResult, OperandType::Local, OperandType::Local, OperandType::Local)                 \
   F(TimestampHistogramAggregateFree, OperandType::Local)                                                              \
+  /* Approximate Count Distinct Aggregates */                                                                         \
+  F(BooleanApproxCountDistinctAggregateInit, OperandType::Local)                                                      \
+  F(BooleanApproxCountDistinctAggregateAdvance, OperandType::Local, OperandType::Local)                               \
+  F(BooleanApproxCountDistinctAggregateMerge, OperandType::Local, OperandType::Local)                                 \
+  F(BooleanApproxCountDistinctAggregateReset, OperandType::Local)                                                     \
+  F(BooleanApproxCountDistinctAggregateGetResult, OperandType::Local, OperandType::Local)                             \
+  F(BooleanApproxCountDistinctAggregateFree, OperandType::Local)                                                      \
+  F(IntegerApproxCountDistinctAggregateInit, OperandType::Local)                                                      \
+  F(IntegerApproxCountDistinctAggregateAdvance, OperandType::Local, OperandType::Local)                               \
+  F(IntegerApproxCountDistinctAggregateMerge, OperandType::Local, OperandType::Local)                                 \
+  F(IntegerApproxCountDistinctAggregateReset, OperandType::Local)                                                     \
+  F(IntegerApproxCountDistinctAggregateGetResult, OperandType::Local, OperandType::Local)                             \
+  F(IntegerApproxCountDistinctAggregateFree, OperandType::Local)                                                      \
+  F(RealApproxCountDistinctAggregateInit, OperandType::Local)                                                         \
+  F(RealApproxCountDistinctAggregateAdvance, OperandType::Local, OperandType::Local)                                  \
+  F(RealApproxCountDistinctAggregateMerge, OperandType::Local, OperandType::Local)                                    \
+  F(RealApproxCountDistinctAggregateReset, OperandType::Local)                                                        \
+  F(RealApproxCountDistinctAggregateGetResult, OperandType::Local, OperandType::Local)                                \
+  F(RealApproxCountDistinctAggregateFree, OperandType::Local)                                                         \
+  F(DecimalApproxCountDistinctAggregateInit, OperandType::Local)                                                      \
+  F(DecimalApproxCountDistinctAggregateAdvance, OperandType::Local, OperandType::Local)                               \
+  F(DecimalApproxCountDistinctAggregateMerge, OperandType::Local, OperandType::Local)                                 \
+  F(DecimalApproxCountDistinctAggregateReset, OperandType::Local)                                                     \
+  F(DecimalApproxCountDistinctAggregateGetResult, OperandType::Local, OperandType::Local)                             \
+  F(DecimalApproxCountDistinctAggregateFree, OperandType::Local)                                                      \
+  F(StringApproxCountDistinctAggregateInit, OperandType::Local)                                                       \
+  F(StringApproxCountDistinctAggregateAdvance, OperandType::Local, OperandType::Local)                                \
+  F(StringApproxCountDistinctAggregateMerge, OperandType::Local, OperandType::Local)                                  \
+  F(StringApproxCountDistinctAggregateReset, OperandType::Local)                                                      \
+  F(StringApproxCountDistinctAggregateGetResult, OperandType::Local, OperandType::Local)                              \
+  F(StringApproxCountDistinctAggregateFree, OperandType::Local)                                                       \
+  F(DateApproxCountDistinctAggregateInit, OperandType::Local)                                                         \
+  F(DateApproxCountDistinctAggregateAdvance, OperandType::Local, OperandType::Local)                                  \
+  F(DateApproxCountDistinctAggregateMerge, OperandType::Local, OperandType::Local)                                    \
+  F(DateApproxCountDistinctAggregateReset, OperandType::Local)                                                        \
+  F(DateApproxCountDistinctAggregateGetResult, OperandType::Local, OperandType::Local)                                \
+  F(DateApproxCountDistinctAggregateFree, OperandType::Local)                                                         \
+  F(TimestampApproxCountDistinctAggregateInit, OperandType::Local)                                                    \
+  F(TimestampApproxCountDistinctAggregateAdvance, OperandType::Local, OperandType::Local)                             \
+  F(TimestampApproxCountDistinctAggregateMerge, OperandType::Local, OperandType::Local)                               \
+  F(TimestampApproxCountDistinctAggregateReset, OperandType::Local)                                                   \
+  F(TimestampApproxCountDistinctAggregateGetResult, OperandType::Local, OperandType::Local)                           \
+  F(TimestampApproxCountDistinctAggregateFree, OperandType::Local)                                                    \
+  /* Approximate Percentile Aggregate */                                                                              \
+  F(ApproxPercentileAggregateInit, OperandType::Local)                                                                \
+  F(ApproxPercentileAggregateAdvanceInteger, OperandType::Local, OperandType::Local, OperandType::Local)              \
+  F(ApproxPercentileAggregateAdvanceReal, OperandType::Local, OperandType::Local, OperandType::Local)                 \
+  F(ApproxPercentileAggregateMerge, OperandType::Local, OperandType::Local)                                           \
+  F(ApproxPercentileAggregateReset, OperandType::Local)                                                               \
+  F(ApproxPercentileAggregateGetResult, OperandType::Local, OperandType::Local)                                       \
+  F(ApproxPercentileAggregateFree, OperandType::Local)                                                                \
                                                                                                                       \
   /* Hash Joins */                                                                                                    \
   F(JoinHashTableInit, OperandType::Local, OperandType::Local, OperandType::Local)                                    \
@@ -542,8 +628,19 @@ namespace noisepage::execution::vm {
   F(JoinHashTableGetTupleCount, OperandType::Local, OperandType::Local)                                               \
   F(JoinHashTableBuild, OperandType::Local)                                                                           \
   F(JoinHashTableBuildParallel, OperandType::Local, OperandType::Local, OperandType::Local)                           \
+  F(JoinHashTableBuildPartitioned, OperandType::Local, OperandType::Local, OperandType::Local)                        \
   F(JoinHashTableLookup, OperandType::Local, OperandType::Local, OperandType::Local)                                  \
+  F(JoinHashTableEnableSpilling, OperandType::Local)                                                                  \
+  F(JoinHashTableIsResident, OperandType::Local, OperandType::Local, OperandType::Local)                              \
+  F(JoinHashTableNextPass, OperandType::Local, OperandType::Local)                                                    \
+  F(JoinHashTableEnableBloomFilter, OperandType::Local)                                                               \
+  F(JoinHashTableMayContain, OperandType::Local, OperandType::Local, OperandType::Local)                              \
   F(JoinHashTableFree, OperandType::Local)                                                                            \
+  F(JoinHashTableBatchProbeInit, OperandType::Local)                                                                  \
+  F(JoinHashTableBatchProbeAddHash, OperandType::Local, OperandType::Local)                                           \
+  F(JoinHashTableBatchProbeLookup, OperandType::Local, OperandType::Local)                                            \
+  F(JoinHashTableBatchProbeNext, OperandType::Local, OperandType::Local)                                              \
+  F(JoinHashTableBatchProbeFree, OperandType::Local)                                                                  \
   F(HashTableEntryIteratorHasNext, OperandType::Local, OperandType::Local)                                            \
   F(HashTableEntryIteratorGetRow, OperandType::Local, OperandType::Local)                                             \
   F(JoinHashTableIteratorInit, OperandType::Local, OperandType::Local)                                                \
@@ -584,6 +681,9 @@ namespace noisepage::execution::vm {
   F(IndexIteratorScanAscending, OperandType::Local, OperandType::Local, OperandType::Local)                           \
   F(IndexIteratorScanDescending, OperandType::Local)                                                                  \
   F(IndexIteratorScanLimitDescending, OperandType::Local, OperandType::Local)                                         \
+  F(IndexIteratorAddBatchKey, OperandType::Local)                                                                     \
+  F(IndexIteratorScanKeyBatch, OperandType::Local, OperandType::Local)                                                \
+  F(IndexIteratorNextBatchKey, OperandType::Local)                                                                    \
   F(IndexIteratorFree, OperandType::Local)                                                                            \
   F(IndexIteratorAdvance, OperandType::Local, OperandType::Local)                                                     \
   F(IndexIteratorGetPR, OperandType::Local, OperandType::Local)                                                       \
@@ -647,6 +747,7 @@ namespace noisepage::execution::vm {
   /* StorageInterface */                                                                                              \
   F(StorageInterfaceInit, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,             \
     OperandType::UImm4, OperandType::Local)                                                                           \
+  F(StorageInterfaceBeginWorker, OperandType::Local)                                                                  \
   F(StorageInterfaceGetTablePR, OperandType::Local, OperandType::Local)                                               \
   F(StorageInterfaceTableUpdate, OperandType::Local, OperandType::Local, OperandType::Local)                          \
   F(StorageInterfaceTableInsert, OperandType::Local, OperandType::Local)                                              \
@@ -766,6 +867,9 @@ namespace noisepage::execution::vm {
   F(GetParamTimestampVal, OperandType::Local, OperandType::Local, OperandType::Local)                                 \
   F(GetParamString, OperandType::Local, OperandType::Local, OperandType::Local)                                       \
                                                                                                                       \
+  /* Superinstructions */                                                                                             \
+  FUSABLE_CONDITION_LIST(CREATE_FUSED_JUMP_IF_FALSE, F)                                                               \
+                                                                                                                      \
   /* FOR TESTING ONLY */                                                                                              \
   F(TestCatalogLookup, OperandType::Local, OperandType::Local, OperandType::StaticLocal, OperandType::UImm4,          \
     OperandType::StaticLocal, OperandType::UImm4)                                                                     \
@@ -881,7 +985,37 @@ class Bytecodes {
    * @return True if the bytecode @em bytecode is a conditional jump; false otherwise.
    */
   static constexpr bool IsConditionalJump(Bytecode bytecode) {
-    return bytecode == Bytecode::JumpIfFalse || bytecode == Bytecode::JumpIfTrue;
+    return bytecode == Bytecode::JumpIfFalse || bytecode == Bytecode::JumpIfTrue || IsFusedConditionalJump(bytecode);
+  }
+
+  /**
+   * @return True if the bytecode @em bytecode is a superinstruction fusing a bytecode that computes a boolean with a
+   *         JumpIfFalse on that boolean; false otherwise.
+   */
+  static constexpr bool IsFusedConditionalJump(Bytecode bytecode) {
+    switch (bytecode) {
+#define FUSED_CASE(G, op, ...) case Bytecode::op##_JumpIfFalse:
+      FUSABLE_CONDITION_LIST(FUSED_CASE, _)
+#undef FUSED_CASE
+      return true;
+      default:
+        return false;
+    }
+  }
+
+  /**
+   * @return The superinstruction fusing the bytecode @em condition with a JumpIfFalse on the boolean it computes, or
+   *         Bytecode::JumpIfFalse if there is no such superinstruction.
+   */
+  static Bytecode GetFusedJumpIfFalse(Bytecode condition);
+
+  /**
+   * @return The index of the jump offset operand of the jump bytecode @em bytecode. The jump offset is always the last
+   *         operand of a jump.
+   */
+  static uint32_t GetJumpOffsetOperandIndex(Bytecode bytecode) {
+    NOISEPAGE_ASSERT(IsJump(bytecode), "Bytecode is not a jump");
+    return NumOperands(bytecode) - 1;
   }
 
   /**
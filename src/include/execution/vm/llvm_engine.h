@@ -6,9 +6,12 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "common/macros.h"
 #include "execution/util/execution_common.h"
+#include "execution/vm/bytecode_function_info.h"
 
 namespace noisepage::execution::ast {
 class Type;
@@ -17,8 +20,6 @@ class Type;
 namespace noisepage::execution::vm {
 
 class BytecodeModule;
-class FunctionInfo;
-class LocalVar;
 
 /**
  * The interface to LLVM to JIT compile TPL bytecode
@@ -53,7 +54,8 @@ class LLVMEngine {
   static void Shutdown();
 
   /**
-   * JIT compile a TPL bytecode module to native code
+   * JIT compile a TPL bytecode module to native code. If the object cache is enabled, the object code of a module
+   * with identical contents, possibly compiled by an earlier process, is loaded from the cache instead.
    * @param module The module to compile
    * @param options The compiler options
    * @return The JIT compiled module
@@ -125,10 +127,42 @@ class LLVMEngine {
      */
     const std::string &GetOutputObjectFileName() const { return output_file_name_; }
 
+    /**
+     * Set the LLVM optimization level
+     * @param level the optimization level, from 0 (no optimization passes) to 3
+     * @return the updated object
+     */
+    CompilerOptions &SetOptimizationLevel(uint32_t level) {
+      opt_level_ = level;
+      return *this;
+    }
+
+    /**
+     * @return the LLVM optimization level
+     */
+    uint32_t GetOptimizationLevel() const { return opt_level_; }
+
+    /**
+     * Restrict compilation to the given functions and all functions they reference, directly or indirectly
+     * @param functions the IDs of the functions to compile, all functions of the module if empty
+     * @return the updated object
+     */
+    CompilerOptions &SetFunctions(std::vector<FunctionId> functions) {
+      functions_ = std::move(functions);
+      return *this;
+    }
+
+    /**
+     * @return the IDs of the functions to compile, all functions of the module if empty
+     */
+    const std::vector<FunctionId> &GetFunctions() const { return functions_; }
+
    private:
     bool debug_{false};
     bool write_obj_file_{false};
     std::string output_file_name_;
+    uint32_t opt_level_{3};
+    std::vector<FunctionId> functions_;
   };
 
   // -------------------------------------------------------
@@ -179,8 +213,10 @@ class LLVMEngine {
     /**
      * Load the given module @em module into memory. If this module has already
      * been loaded, it will not be reloaded.
+     * @param module The bytecode module this module was compiled from.
+     * @param functions The IDs of the functions that were compiled, all if empty.
      */
-    void Load(const BytecodeModule &module);
+    void Load(const BytecodeModule &module, const std::vector<FunctionId> &functions = {});
 
     /**
      * Has this module been loaded into memory and linked?
@@ -206,16 +242,24 @@ class LLVMEngine {
     /**
      * Construct a settings instance from the relevant configuration parameters.
      * @param bytecode_handlers_path The path to the bytecode handlers bitcode file.
+     * @param object_cache_path The directory to cache compiled object code in, empty to disable the cache.
      */
-    explicit Settings(std::string_view bytecode_handlers_path) : bytecode_handlers_path_{bytecode_handlers_path} {}
+    explicit Settings(std::string_view bytecode_handlers_path, std::string_view object_cache_path = "")
+        : bytecode_handlers_path_{bytecode_handlers_path}, object_cache_path_{object_cache_path} {}
 
     /**
      * @return The path to the bytecode handlers bitcode file.
      */
     const std::string &GetBytecodeHandlersBcPath() const noexcept { return bytecode_handlers_path_; }
 
+    /**
+     * @return The directory to cache compiled object code in, empty if the cache is disabled.
+     */
+    const std::string &GetObjectCachePath() const noexcept { return object_cache_path_; }
+
    private:
     const std::string bytecode_handlers_path_;
+    const std::string object_cache_path_;
   };
 
   // -------------------------------------------------------
@@ -246,6 +290,22 @@ class LLVMEngine {
    *   the LLVMEngine because that is the natural ownership relationship
    */
   inline static std::unique_ptr<const Settings> engine_settings;  // NOLINT
+
+  /**
+   * Identifies the bytecode handlers and the machine the engine generates code for. Cached object code is keyed by it
+   * so that it is never loaded by an engine that would have generated different code. Zero if the object cache is
+   * disabled.
+   */
+  inline static uint64_t engine_build_id = 0;  // NOLINT
+
+ private:
+  // The file in the object cache holding the object code of the given module compiled with the given options, or an
+  // empty string if the cache is disabled.
+  static std::string ObjectCacheFile(const BytecodeModule &module, const CompilerOptions &options);
+
+  // The IDs of the functions to compile with the given options, i.e. the requested ones and every function they
+  // reference, or all functions of the module if none are requested.
+  static std::vector<FunctionId> FunctionsToCompile(const BytecodeModule &module, const CompilerOptions &options);
 };
 
 }  // namespace noisepage::execution::vm
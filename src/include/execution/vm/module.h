@@ -2,12 +2,16 @@
 
 #include <llvm/Support/Memory.h>
 
+#include <array>
 #include <atomic>
+#include <condition_variable>  // NOLINT
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "common/constants.h"
 #include "execution/ast/type.h"
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/llvm_engine.h"
@@ -25,6 +29,10 @@ class BytecodeTrampolineTest;
  * They also contain the generated TBC bytecode and their implementations, along with compiled
  * machine-code versions of TPL functions.
  *
+ * In adaptive mode, every function starts out interpreted and is profiled. A function that runs hot enough, measured
+ * by its invocations and the loop iterations it executes, is compiled on its own (along with the functions it
+ * references) in the background, at escalating optimization levels, and its implementation is atomically swapped.
+ *
  * Modules are thread-safe.
  */
 class Module {
@@ -47,6 +55,11 @@ class Module {
    */
   DISALLOW_COPY_AND_MOVE(Module);
 
+  /**
+   * Destructor. Waits for background compilations of this module's functions to finish.
+   */
+  ~Module();
+
   /**
    * Look up a TPL function in this module by its ID
    * @return A pointer to the function's info if it exists; null otherwise
@@ -103,9 +116,30 @@ class Module {
   friend class VM;                            // For the VM to access raw bytecode.
   friend class test::BytecodeTrampolineTest;  // For the tests to check private methods.
 
-  // This class encapsulates the ability to asynchronously JIT compile a module.
+  // This class encapsulates the ability to asynchronously JIT compile a function of a module.
   class AsyncCompileTask;
 
+  // The number of compilation tiers. Tier 0 is the interpreter.
+  static constexpr uint32_t NUM_TIERS = 3;
+  // A function is promoted to a tier once either its invocations or its loop iterations reach the tier's threshold.
+  static constexpr std::array<uint64_t, NUM_TIERS> TIER_INVOCATIONS = {0, 100, 10000};
+  static constexpr std::array<uint64_t, NUM_TIERS> TIER_LOOP_ITERATIONS = {0, 10000, 1000000};
+  // The LLVM optimization level functions of each tier are compiled with.
+  static constexpr std::array<uint32_t, NUM_TIERS> TIER_OPT_LEVELS = {0, 1, 3};
+
+  // The runtime profile of a function, driving its tiered compilation in adaptive mode.
+  struct alignas(common::Constants::CACHELINE_SIZE) FunctionProfile {
+    // Invocations that ran in the interpreter and in compiled code
+    std::atomic<uint64_t> interpreted_invocations_{0};
+    std::atomic<uint64_t> compiled_invocations_{0};
+    // Loop iterations executed by the interpreted invocations
+    std::atomic<uint64_t> loop_iterations_{0};
+    // The highest tier a compilation was requested for
+    std::atomic<uint32_t> requested_tier_{0};
+    // The tier of the installed implementation. Protected by tiering_mutex_.
+    uint32_t installed_tier_{0};
+  };
+
   // A trampoline is a stub function that serves as a landing point for all
   // functions executed in interpreted mode. The purpose of the trampoline is
   // to arrange and adjust call arguments from the C/C++ ABI to the TPL ABI.
@@ -146,9 +180,15 @@ class Module {
   // Compile this module into machine code. This is a blocking call.
   void CompileToMachineCode();
 
-  // Compile this module into machine code. This is a non-blocking call that
-  // triggers a compilation in the background.
-  void CompileToMachineCodeAsync();
+  // Record an invocation of the function with the given ID, with the number of
+  // loop iterations it executed if it was interpreted. Triggers a background
+  // compilation of the function if this makes it hot enough for a higher tier.
+  void RecordInvocation(FunctionId func_id, bool interpreted, uint64_t loop_iterations) const;
+
+  // Compile the function with the given ID for the given tier and install it,
+  // unless a better implementation was installed in the meantime. This is a
+  // blocking call.
+  void CompileFunction(FunctionId func_id, uint32_t tier) const;
 
  private:
   // The module containing all TBC (i.e., bytecode) for the TPL program.
@@ -168,6 +208,20 @@ class Module {
 
   // Flag to indicate if the JIT compilation has occurred.
   std::once_flag compiled_flag_;
+
+  // The runtime profiles of all functions, and whether a function requested in
+  // adaptive mode enabled tiered compilation based on them.
+  std::unique_ptr<FunctionProfile[]> profiles_;
+  mutable std::atomic<bool> tiering_enabled_{false};
+
+  // State of tiered compilation. Compiled modules of individual functions are
+  // kept alive as long as their code may be running.
+  mutable std::mutex tiering_mutex_;
+  mutable std::condition_variable compiles_done_;
+  mutable uint32_t pending_compiles_{0};
+  mutable std::vector<std::unique_ptr<LLVMEngine::CompiledModule>> tiered_modules_;
+  // Whether the whole module has been compiled, which supersedes all tiers.
+  bool fully_compiled_{false};
 };
 
 // ---------------------------------------------------------
@@ -206,36 +260,50 @@ inline bool Module::GetFunction(const std::string &name, const ExecutionMode exe
     return false;
   }
 
+  // Invoke the function in the interpreter
+  const auto interpret = [this, func_info](ArgTypes... args) -> Ret {
+    if constexpr (std::is_void_v<Ret>) {
+      // Create a temporary on-stack buffer and copy all arguments
+      uint8_t arg_buffer[(0ul + ... + sizeof(args))];
+      detail::CopyAll(arg_buffer, args...);
+
+      // Invoke and finish
+      VM::InvokeFunction(this, func_info->GetId(), arg_buffer);
+      return;
+    } else {  // NOLINT
+      // The return value
+      Ret rv{};
+
+      // Create a temporary on-stack buffer and copy all arguments
+      uint8_t arg_buffer[sizeof(Ret *) + (0ul + ... + sizeof(args))];
+      detail::CopyAll(arg_buffer, &rv, args...);
+
+      // Invoke and finish
+      VM::InvokeFunction(this, func_info->GetId(), arg_buffer);
+      return rv;
+    }
+  };
+
   switch (exec_mode) {
     case ExecutionMode::Adaptive: {
-      CompileToMachineCodeAsync();
-      FALLTHROUGH;
-    }
-    case ExecutionMode::Interpret: {
-      *func = [this, func_info](ArgTypes... args) -> Ret {
-        if constexpr (std::is_void_v<Ret>) {
-          // Create a temporary on-stack buffer and copy all arguments
-          uint8_t arg_buffer[(0ul + ... + sizeof(args))];
-          detail::CopyAll(arg_buffer, args...);
-
-          // Invoke and finish
-          VM::InvokeFunction(this, func_info->GetId(), arg_buffer);
-          return;
-        } else {  // NOLINT
-          // The return value
-          Ret rv{};
-
-          // Create a temporary on-stack buffer and copy all arguments
-          uint8_t arg_buffer[sizeof(Ret *) + (0ul + ... + sizeof(args))];
-          detail::CopyAll(arg_buffer, &rv, args...);
-
-          // Invoke and finish
-          VM::InvokeFunction(this, func_info->GetId(), arg_buffer);
-          return rv;
+      tiering_enabled_.store(true, std::memory_order_relaxed);
+      *func = [this, func_info, interpret](ArgTypes... args) -> Ret {
+        const FunctionId func_id = func_info->GetId();
+        void *raw_func = functions_[func_id].load(std::memory_order_relaxed);
+        if (raw_func == GetBytecodeImpl(func_id)) {
+          // Not compiled yet. The VM records the invocation.
+          return interpret(args...);
         }
+        RecordInvocation(func_id, false, 0);
+        auto *jit_f = reinterpret_cast<Ret (*)(ArgTypes...)>(raw_func);
+        return jit_f(args...);
       };
       break;
     }
+    case ExecutionMode::Interpret: {
+      *func = interpret;
+      break;
+    }
     case ExecutionMode::Compiled: {
       CompileToMachineCode();
       *func = [this, func_info](ArgTypes... args) -> Ret {
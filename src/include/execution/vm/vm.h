@@ -1,6 +1,10 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include "execution/vm/bytecode_function_info.h"
+#include "execution/vm/bytecodes.h"
 
 namespace noisepage::execution::vm {
 
@@ -17,6 +21,19 @@ class VM {
    */
   static void InvokeFunction(const Module *module, FunctionId func_id, const uint8_t args[]);
 
+  /**
+   * Pairs of bytecodes interpreted back to back are the candidates for superinstructions. The VM only counts them when
+   * built with NOISEPAGE_PROFILE_BYTECODES, otherwise there are no pairs.
+   * @param n The maximum number of pairs to return.
+   * @return The @em n most frequently interpreted pairs of bytecodes along with their counts, most frequent first.
+   */
+  static std::vector<std::pair<std::pair<Bytecode, Bytecode>, uint64_t>> GetHotBytecodePairs(std::size_t n);
+
+  /**
+   * Reset the counts of the bytecode pairs interpreted so far.
+   */
+  static void ResetBytecodeProfile();
+
  private:
   // Private constructor to force users to use InvokeFunction
   explicit VM(const Module *module);
@@ -36,6 +53,8 @@ class VM {
  private:
   // The module
   const Module *module_;
+  // The number of loop iterations, i.e. backward jumps, executed so far
+  uint64_t loop_iterations_{0};
 };
 
 }  // namespace noisepage::execution::vm
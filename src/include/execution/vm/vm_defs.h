@@ -8,9 +8,10 @@ namespace noisepage::execution::vm {
 enum class ExecutionMode : uint8_t {
   // Always execute in interpreted mode
   Interpret,
-  // Execute in interpreted mode, but trigger a compilation asynchronously. As
-  // compiled code becomes available, seamlessly swap it in and execute mixed
-  // interpreter and compiled code.
+  // Execute in interpreted mode, but profile each function and compile the hot
+  // ones asynchronously, at escalating optimization levels. As compiled code
+  // becomes available, seamlessly swap it in and execute mixed interpreter and
+  // compiled code.
   Adaptive,
   // Compile and generate all machine code before executing the function
   Compiled
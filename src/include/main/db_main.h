@@ -24,6 +24,7 @@
 #include "settings/settings_manager.h"
 #include "settings/settings_param.h"
 #include "storage/garbage_collector_thread.h"
+#include "storage/recovery/checkpoint_manager.h"
 #include "storage/recovery/recovery_manager.h"
 #include "traffic_cop/traffic_cop.h"
 #include "transaction/deferred_action_manager.h"
@@ -135,20 +136,21 @@ class DBMain {
      * @param block_store_size_limit argument to the BlockStore
      * @param block_store_reuse_limit argument to the BlockStore
      * @param use_gc enable GarbageCollector
+     * @param gc_num_threads number of GarbageCollector worker threads
      * @param log_manager needed for safe destruction of StorageLayer
      * @param empty_buffer_queue The common buffer queue that all empty buffers are pulled from and returned to.
      */
     StorageLayer(const common::ManagedPointer<TransactionLayer> txn_layer, const uint64_t block_store_size_limit,
-                 const uint64_t block_store_reuse_limit, const bool use_gc,
+                 const uint64_t block_store_reuse_limit, const bool use_gc, const uint32_t gc_num_threads,
                  const common::ManagedPointer<storage::LogManager> log_manager,
                  std::unique_ptr<common::ConcurrentBlockingQueue<storage::BufferedLogWriter *>> empty_buffer_queue)
         : empty_buffer_queue_(std::move(empty_buffer_queue)),
           deferred_action_manager_(txn_layer->GetDeferredActionManager()),
           log_manager_(log_manager) {
       if (use_gc)
-        garbage_collector_ = std::make_unique<storage::GarbageCollector>(txn_layer->GetTimestampManager(),
-                                                                         txn_layer->GetDeferredActionManager(),
-                                                                         txn_layer->GetTransactionManager(), DISABLED);
+        garbage_collector_ = std::make_unique<storage::GarbageCollector>(
+            txn_layer->GetTimestampManager(), txn_layer->GetDeferredActionManager(),
+            txn_layer->GetTransactionManager(), DISABLED, gc_num_threads);
 
       block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit);
     }
@@ -287,14 +289,17 @@ class DBMain {
      * @param port argument to TerrierServer
      * @param connection_thread_count argument to TerrierServer
      * @param socket_directory argument to TerrierServer
+     * @param shared_plan_cache_size argument to SharedPlanCache
      */
     NetworkLayer(const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
                  const common::ManagedPointer<trafficcop::TrafficCop> traffic_cop, const uint16_t port,
-                 const uint16_t connection_thread_count, const std::string &socket_directory) {
+                 const uint16_t connection_thread_count, const std::string &socket_directory,
+                 const uint64_t shared_plan_cache_size) {
       connection_handle_factory_ = std::make_unique<network::ConnectionHandleFactory>(traffic_cop);
       command_factory_ = std::make_unique<network::PostgresCommandFactory>();
-      provider_ =
-          std::make_unique<network::PostgresProtocolInterpreter::Provider>(common::ManagedPointer(command_factory_));
+      shared_plan_cache_ = std::make_unique<network::SharedPlanCache>(shared_plan_cache_size);
+      provider_ = std::make_unique<network::PostgresProtocolInterpreter::Provider>(
+          common::ManagedPointer(command_factory_), common::ManagedPointer(shared_plan_cache_));
       server_ = std::make_unique<network::TerrierServer>(
           common::ManagedPointer(provider_), common::ManagedPointer(connection_handle_factory_), thread_registry, port,
           connection_thread_count, socket_directory);
@@ -305,10 +310,18 @@ class DBMain {
      */
     common::ManagedPointer<network::TerrierServer> GetServer() const { return common::ManagedPointer(server_); }
 
+    /**
+     * @return ManagedPointer to the component
+     */
+    common::ManagedPointer<network::SharedPlanCache> GetSharedPlanCache() const {
+      return common::ManagedPointer(shared_plan_cache_);
+    }
+
    private:
     // Order matters here for destruction order
     std::unique_ptr<network::ConnectionHandleFactory> connection_handle_factory_;
     std::unique_ptr<network::PostgresCommandFactory> command_factory_;
+    std::unique_ptr<network::SharedPlanCache> shared_plan_cache_;
     std::unique_ptr<network::ProtocolInterpreterProvider> provider_;
     std::unique_ptr<network::TerrierServer> server_;
   };
@@ -321,8 +334,9 @@ class DBMain {
    public:
     /**
      * @param bytecode_handlers_path path to the bytecode handlers bitcode file
+     * @param jit_object_cache_path directory to cache compiled object code in, empty to disable the cache
      */
-    explicit ExecutionLayer(const std::string &bytecode_handlers_path);
+    ExecutionLayer(const std::string &bytecode_handlers_path, const std::string &jit_object_cache_path);
     ~ExecutionLayer();
   };
 
@@ -379,7 +393,7 @@ class DBMain {
       }
 
       std::unique_ptr<common::DedicatedThreadRegistry> thread_registry = DISABLED;
-      if (use_thread_registry_ || use_logging_ || use_network_)
+      if (use_thread_registry_ || use_logging_ || use_network_ || use_checkpoints_)
         thread_registry = std::make_unique<common::DedicatedThreadRegistry>(common::ManagedPointer(metrics_manager));
 
       auto buffer_segment_pool =
@@ -397,6 +411,7 @@ class DBMain {
       if (use_replication_) {
         NOISEPAGE_ASSERT(use_messenger_, "Replication uses the messenger subsystem.");
         NOISEPAGE_ASSERT(use_logging_, "Replication uses logging.");
+        NOISEPAGE_ASSERT(wal_num_streams_ == 1, "Replication ships a single stream of the log.");
         if (network_identity_ == "primary") {
           replication_manager = std::make_unique<replication::PrimaryReplicationManager>(
               messenger_layer->GetMessenger(), network_identity_, replication_port_, replication_hosts_path_,
@@ -418,7 +433,7 @@ class DBMain {
             wal_file_path_, wal_num_buffers_, std::chrono::microseconds{wal_serialization_interval_},
             std::chrono::microseconds{wal_persist_interval_}, wal_persist_threshold_,
             common::ManagedPointer(buffer_segment_pool), common::ManagedPointer(empty_buffer_queue), rep_manager_ptr,
-            common::ManagedPointer(thread_registry));
+            common::ManagedPointer(thread_registry), wal_num_streams_);
         log_manager->Start();
       }
 
@@ -428,7 +443,8 @@ class DBMain {
 
       auto storage_layer =
           std::make_unique<StorageLayer>(common::ManagedPointer(txn_layer), block_store_size_, block_store_reuse_,
-                                         use_gc_, common::ManagedPointer(log_manager), std::move(empty_buffer_queue));
+                                         use_gc_, gc_num_threads_, common::ManagedPointer(log_manager),
+                                         std::move(empty_buffer_queue));
 
       std::unique_ptr<CatalogLayer> catalog_layer = DISABLED;
       if (use_catalog_) {
@@ -449,10 +465,21 @@ class DBMain {
         recovery_manager = std::make_unique<storage::RecoveryManager>(
             log_provider, catalog_layer->GetCatalog(), txn_layer->GetTransactionManager(),
             txn_layer->GetDeferredActionManager(), common::ManagedPointer(replication_manager),
-            common::ManagedPointer(thread_registry), common::ManagedPointer(storage_layer->GetBlockStore()));
+            common::ManagedPointer(thread_registry), common::ManagedPointer(storage_layer->GetBlockStore()),
+            recovery_num_threads_);
         recovery_manager->StartRecovery();
       }
 
+      std::unique_ptr<storage::CheckpointManager> checkpoint_manager = DISABLED;
+      if (use_checkpoints_) {
+        NOISEPAGE_ASSERT(use_catalog_ && catalog_layer->GetCatalog() != DISABLED, "Checkpoints need the CatalogLayer.");
+        checkpoint_manager = std::make_unique<storage::CheckpointManager>(
+            checkpoint_path_, std::chrono::seconds{checkpoint_interval_}, catalog_layer->GetCatalog(),
+            txn_layer->GetTransactionManager(), common::ManagedPointer(log_manager),
+            common::ManagedPointer(thread_registry));
+        checkpoint_manager->Start();
+      }
+
       std::unique_ptr<storage::GarbageCollectorThread> gc_thread = DISABLED;
       if (use_gc_thread_) {
         NOISEPAGE_ASSERT(use_gc_ && storage_layer->GetGarbageCollector() != DISABLED,
@@ -469,7 +496,7 @@ class DBMain {
 
       std::unique_ptr<ExecutionLayer> execution_layer = DISABLED;
       if (use_execution_) {
-        execution_layer = std::make_unique<ExecutionLayer>(bytecode_handlers_path_);
+        execution_layer = std::make_unique<ExecutionLayer>(bytecode_handlers_path_, jit_object_cache_path_);
       }
 
       std::unique_ptr<trafficcop::TrafficCop> traffic_cop = DISABLED;
@@ -490,7 +517,8 @@ class DBMain {
         NOISEPAGE_ASSERT(use_traffic_cop_ && traffic_cop != DISABLED, "NetworkLayer needs TrafficCopLayer.");
         network_layer =
             std::make_unique<NetworkLayer>(common::ManagedPointer(thread_registry), common::ManagedPointer(traffic_cop),
-                                           network_port_, connection_thread_count_, uds_file_directory_);
+                                           network_port_, connection_thread_count_, uds_file_directory_,
+                                           shared_plan_cache_size_);
       }
 
       std::unique_ptr<modelserver::ModelServerManager> model_server_manager = DISABLED;
@@ -544,6 +572,7 @@ class DBMain {
       db_main->catalog_layer_ = std::move(catalog_layer);
       db_main->recovery_manager_ = std::move(recovery_manager);
       db_main->gc_thread_ = std::move(gc_thread);
+      db_main->checkpoint_manager_ = std::move(checkpoint_manager);
       db_main->stats_storage_ = std::move(stats_storage);
       db_main->execution_layer_ = std::move(execution_layer);
       db_main->traffic_cop_ = std::move(traffic_cop);
@@ -665,6 +694,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalNumStreams(const uint32_t value) {
+      wal_num_streams_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -674,6 +712,51 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value number of GC worker threads
+     * @return self reference for chaining
+     */
+    Builder &SetGCNumThreads(const uint32_t value) {
+      gc_num_threads_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value number of RecoveryManager replay threads
+     * @return self reference for chaining
+     */
+    Builder &SetRecoveryNumThreads(const uint32_t value) {
+      recovery_num_threads_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value use component
+     * @return self reference for chaining
+     */
+    Builder &SetUseCheckpoints(const bool value) {
+      use_checkpoints_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value CheckpointManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetCheckpointInterval(const int32_t value) {
+      checkpoint_interval_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value CheckpointManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetCheckpointPath(const std::string &value) {
+      checkpoint_path_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -818,6 +901,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value SharedPlanCache argument
+     * @return self reference for chaining
+     */
+    Builder &SetSharedPlanCacheSize(const uint64_t value) {
+      shared_plan_cache_size_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -872,6 +964,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value the new directory to cache compiled object code in, empty to disable the cache
+     * @return self reference for chaining
+     */
+    Builder &SetJitObjectCachePath(const std::string &value) {
+      jit_object_cache_path_ = value;
+      return *this;
+    }
+
    private:
     std::unordered_map<settings::Param, settings::ParamInfo> param_map_;
 
@@ -897,9 +998,11 @@ class DBMain {
     std::string model_save_path_;
     std::string forecast_model_save_path_;
     std::string bytecode_handlers_path_ = "./bytecode_handlers_ir.bc";
+    std::string jit_object_cache_path_;
     std::string network_identity_ = "primary";
     std::string uds_file_directory_ = "/tmp/";
     std::string replication_hosts_path_ = "./replication.config";
+    std::string checkpoint_path_ = "./checkpoints";
     /**
      * The ModelServer script is located at PROJECT_ROOT/script/model by default, and also assume
      * the build binary at PROJECT_ROOT/build/bin/noisepage. This should be override or set explicitly
@@ -925,8 +1028,13 @@ class DBMain {
     int32_t wal_serialization_interval_ = 100;
     int32_t wal_persist_interval_ = 100;
     int32_t gc_interval_ = 1000;
+    uint32_t gc_num_threads_ = 1;
+    int32_t checkpoint_interval_ = 60;
+    uint32_t recovery_num_threads_ = 1;
+    uint32_t wal_num_streams_ = 1;
 
     uint16_t connection_thread_count_ = 4;
+    uint64_t shared_plan_cache_size_ = 1000;
     uint16_t network_port_ = 15721;
     uint16_t messenger_port_ = 9022;
     uint16_t replication_port_ = 15445;
@@ -939,6 +1047,7 @@ class DBMain {
     bool use_catalog_ = false;
     bool create_default_database_ = true;
     bool use_gc_thread_ = false;
+    bool use_checkpoints_ = false;
     bool use_stats_storage_ = false;
     bool use_execution_ = false;
     bool use_traffic_cop_ = false;
@@ -976,6 +1085,7 @@ class DBMain {
         wal_persist_interval_ = settings_manager->GetInt(settings::Param::wal_persist_interval);
         wal_persist_threshold_ =
             static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_persist_threshold));
+        wal_num_streams_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::wal_num_streams));
       }
 
       use_metrics_ = settings_manager->GetBool(settings::Param::metrics);
@@ -984,6 +1094,11 @@ class DBMain {
       pilot_planning_ = settings_manager->GetBool(settings::Param::pilot_planning);
 
       gc_interval_ = settings_manager->GetInt(settings::Param::gc_interval);
+      gc_num_threads_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::gc_num_threads));
+      recovery_num_threads_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::recovery_num_threads));
+      use_checkpoints_ = settings_manager->GetBool(settings::Param::checkpoint_enable);
+      checkpoint_interval_ = settings_manager->GetInt(settings::Param::checkpoint_interval);
+      checkpoint_path_ = settings_manager->GetString(settings::Param::checkpoint_path);
       pilot_interval_ = settings_manager->GetInt64(settings::Param::pilot_interval);
       forecast_train_interval_ = settings_manager->GetInt64(settings::Param::forecast_train_interval);
       workload_forecast_interval_ = settings_manager->GetInt64(settings::Param::workload_forecast_interval);
@@ -1000,11 +1115,13 @@ class DBMain {
           static_cast<uint16_t>(settings_manager->GetInt(settings::Param::connection_thread_count));
       optimizer_timeout_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
       use_query_cache_ = settings_manager->GetBool(settings::Param::use_query_cache);
+      shared_plan_cache_size_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::shared_plan_cache_size));
 
       execution_mode_ = settings_manager->GetBool(settings::Param::compiled_query_execution)
                             ? execution::vm::ExecutionMode::Compiled
                             : execution::vm::ExecutionMode::Interpret;
       bytecode_handlers_path_ = settings_manager->GetString(settings::Param::bytecode_handlers_path);
+      jit_object_cache_path_ = settings_manager->GetString(settings::Param::jit_object_cache_path);
 
       query_trace_metrics_ = settings_manager->GetBool(settings::Param::query_trace_metrics_enable);
       pipeline_metrics_ = settings_manager->GetBool(settings::Param::pipeline_metrics_enable);
@@ -1111,6 +1228,13 @@ class DBMain {
     return common::ManagedPointer(gc_thread_);
   }
 
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<storage::CheckpointManager> GetCheckpointManager() const {
+    return common::ManagedPointer(checkpoint_manager_);
+  }
+
   /**
    * @return ManagedPointer to the component, can be nullptr if disabled
    */
@@ -1173,6 +1297,7 @@ class DBMain {
   std::unique_ptr<CatalogLayer> catalog_layer_;
   std::unique_ptr<storage::GarbageCollectorThread>
       gc_thread_;  // thread needs to die before manual invocations of GC in CatalogLayer and others
+  std::unique_ptr<storage::CheckpointManager> checkpoint_manager_;  // Stops taking checkpoints before the catalog dies.
   std::unique_ptr<optimizer::StatsStorage> stats_storage_;
   std::unique_ptr<ExecutionLayer> execution_layer_;
   std::unique_ptr<trafficcop::TrafficCop> traffic_cop_;
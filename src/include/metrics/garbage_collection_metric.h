@@ -25,6 +25,9 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
     if (!other_db_metric->gc_data_.empty()) {
       gc_data_.splice(gc_data_.cend(), other_db_metric->gc_data_);
     }
+    if (!other_db_metric->worker_data_.empty()) {
+      worker_data_.splice(worker_data_.cend(), other_db_metric->worker_data_);
+    }
   }
 
   /**
@@ -43,6 +46,7 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
                      "Not all files are open.");
 
     auto &outfile = (*outfiles)[0];
+    auto &worker_outfile = (*outfiles)[1];
 
     for (const auto &data : gc_data_) {
       outfile << data.txns_deallocated_ << ", " << data.txns_unlinked_ << ", " << data.buffer_unlinked_ << ", "
@@ -50,19 +54,26 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
       data.resource_metrics_.ToCSV(outfile);
       outfile << std::endl;
     }
+    for (const auto &data : worker_data_) {
+      worker_outfile << data.worker_id_ << ", " << data.num_workers_ << ", " << data.buffer_unlinked_ << ", ";
+      data.resource_metrics_.ToCSV(worker_outfile);
+      worker_outfile << std::endl;
+    }
     gc_data_.clear();
+    worker_data_.clear();
   }
 
   /**
    * Files to use for writing to CSV.
    */
-  static constexpr std::array<std::string_view, 1> FILES = {"./gc.csv"};
+  static constexpr std::array<std::string_view, 2> FILES = {"./gc.csv", "./gc_worker.csv"};
   /**
    * Columns to use for writing to CSV.
    * Note: This includes the columns for the input feature, but not the output (resource counters)
    */
-  static constexpr std::array<std::string_view, 1> FEATURE_COLUMNS = {
-      "txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval"};
+  static constexpr std::array<std::string_view, 2> FEATURE_COLUMNS = {
+      "txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval",
+      "worker_id, num_workers, buffer_unlinked"};
 
  private:
   friend class GarbageCollectionMetric;
@@ -75,6 +86,11 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
                           resource_metrics);
   }
 
+  void RecordWorkerData(uint32_t worker_id, uint32_t num_workers, uint64_t buffer_unlinked,
+                        const common::ResourceTracker::Metrics &resource_metrics) {
+    worker_data_.emplace_back(worker_id, num_workers, buffer_unlinked, resource_metrics);
+  }
+
   struct GCData {
     GCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked, uint64_t readonly_unlinked,
            const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics)
@@ -92,11 +108,27 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
+  // The share of one worker of a parallel unlink pass
+  struct WorkerData {
+    WorkerData(uint32_t worker_id, uint32_t num_workers, uint64_t buffer_unlinked,
+               const common::ResourceTracker::Metrics &resource_metrics)
+        : worker_id_(worker_id),
+          num_workers_(num_workers),
+          buffer_unlinked_(buffer_unlinked),
+          resource_metrics_(resource_metrics) {}
+    const uint32_t worker_id_;
+    const uint32_t num_workers_;
+    const uint64_t buffer_unlinked_;
+    const common::ResourceTracker::Metrics resource_metrics_;
+  };
+
   std::list<GCData> gc_data_;
+  std::list<WorkerData> worker_data_;
 };
 
 /**
- * Metrics for the garbage collection components of the system: currently deallocation and unlinking
+ * Metrics for the garbage collection components of the system: currently deallocation and unlinking, as well as the
+ * share of every worker of a parallel unlink pass
  */
 class GarbageCollectionMetric : public AbstractMetric<GarbageCollectionMetricRawData> {
  private:
@@ -108,5 +140,10 @@ class GarbageCollectionMetric : public AbstractMetric<GarbageCollectionMetricRaw
     GetRawData()->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval,
                                resource_metrics);
   }
+
+  void RecordWorkerData(uint32_t worker_id, uint32_t num_workers, uint64_t buffer_unlinked,
+                        const common::ResourceTracker::Metrics &resource_metrics) {
+    GetRawData()->RecordWorkerData(worker_id, num_workers, buffer_unlinked, resource_metrics);
+  }
 };
 }  // namespace noisepage::metrics
@@ -94,6 +94,23 @@ class MetricsStore {
                              resource_metrics);
   }
 
+  /**
+   * Record metrics of one worker of a parallel GC unlink pass
+   * @param worker_id first entry of metrics datapoint
+   * @param num_workers second entry of metrics datapoint
+   * @param buffer_unlinked third entry of metrics datapoint
+   * @param resource_metrics fourth entry of metrics datapoint
+   */
+  void RecordGCWorkerData(uint32_t worker_id, uint32_t num_workers, uint64_t buffer_unlinked,
+                          const common::ResourceTracker::Metrics &resource_metrics) {
+    if (!ComponentEnabled(MetricsComponent::GARBAGECOLLECTION))
+      METRICS_LOG_WARN(
+          "RecordGCWorkerData() called without GC metrics enabled. Was it recently disabled and the component is just "
+          "lagging?");
+    NOISEPAGE_ASSERT(gc_metric_ != nullptr, "GarbageCollectionMetric not allocated. Check MetricsStore constructor.");
+    gc_metric_->RecordWorkerData(worker_id, num_workers, buffer_unlinked, resource_metrics);
+  }
+
   /**
    * Record metrics for transaction manager when beginning transaction
    * @param resource_metrics first entry of txn datapoint
@@ -13,6 +13,7 @@
 #include "network/postgres/postgres_network_commands.h"
 #include "network/postgres/postgres_packet_writer.h"
 #include "network/postgres/statement.h"
+#include "network/postgres/shared_plan_cache.h"
 #include "network/postgres/statement_cache.h"
 #include "network/protocol_interpreter.h"
 
@@ -36,27 +37,32 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
     /**
      * Constructs a new provider
      * @param command_factory The command factory to use for the constructed protocol interpreters
+     * @param shared_plan_cache The server-wide plan cache for the constructed protocol interpreters, if any
      */
-    explicit Provider(common::ManagedPointer<PostgresCommandFactory> command_factory)
-        : command_factory_(command_factory) {}
+    explicit Provider(common::ManagedPointer<PostgresCommandFactory> command_factory,
+                      common::ManagedPointer<SharedPlanCache> shared_plan_cache = nullptr)
+        : command_factory_(command_factory), shared_plan_cache_(shared_plan_cache) {}
 
     /**
      * @return an instance of the protocol interpreter
      */
     std::unique_ptr<ProtocolInterpreter> Get() override {
-      return std::make_unique<PostgresProtocolInterpreter>(command_factory_);
+      return std::make_unique<PostgresProtocolInterpreter>(command_factory_, shared_plan_cache_);
     }
 
    private:
     common::ManagedPointer<PostgresCommandFactory> command_factory_;
+    common::ManagedPointer<SharedPlanCache> shared_plan_cache_;
   };
 
   /**
    * Creates the interpreter for Postgres
    * @param command_factory to convert packet into commands
+   * @param shared_plan_cache server-wide plan cache shared with other connections, if any
    */
-  explicit PostgresProtocolInterpreter(common::ManagedPointer<PostgresCommandFactory> command_factory)
-      : command_factory_(command_factory) {}
+  explicit PostgresProtocolInterpreter(common::ManagedPointer<PostgresCommandFactory> command_factory,
+                                       common::ManagedPointer<SharedPlanCache> shared_plan_cache = nullptr)
+      : command_factory_(command_factory), shared_plan_cache_(shared_plan_cache) {}
 
   /**
    * @see ProtocolIntepreter::Process
@@ -171,6 +177,11 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
     return cache_.Lookup(query_text);
   }
 
+  /**
+   * @return the server-wide plan cache, nullptr if there is none
+   */
+  common::ManagedPointer<SharedPlanCache> GetSharedPlanCache() const { return shared_plan_cache_; }
+
   /**
    * @param name key
    * @param statement statement to create a mapping to for this name
@@ -237,6 +248,7 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
   common::ManagedPointer<PostgresCommandFactory> command_factory_;
 
   StatementCache cache_;
+  common::ManagedPointer<SharedPlanCache> shared_plan_cache_;
 
   // name to statement
   std::unordered_map<std::string, common::ManagedPointer<network::Statement>> statements_;
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "common/spin_latch.h"
+#include "network/postgres/statement.h"
+#include "transaction/transaction_defs.h"
+#include "type/type_id.h"
+
+namespace noisepage::transaction {
+class TransactionContext;
+}  // namespace noisepage::transaction
+
+namespace noisepage::network {
+
+/**
+ * Server-wide cache of the physical plans and generated code of Extended Query protocol statements, shared by all
+ * connections. Where StatementCache lets one connection reuse its own Statements, SharedPlanCache lets a connection
+ * reuse the optimize result and ExecutableQuery that another connection already produced for the same query, so a
+ * pool of connections preparing the same statements pays for optimization and code generation once.
+ *
+ * Entries are keyed by the exact query text, the parameter types, and the database. The text is not normalized: the
+ * optimizer bakes literals into the plan, so two queries that only differ in their literals need different plans.
+ * The cache holds at most max_size entries and evicts the least recently used one beyond that.
+ *
+ * DDL invalidates the whole cache. While a DDL transaction is in flight the cache is bypassed, and once it commits only
+ * transactions that started after the commit may read or publish entries, so no transaction ever sees a plan built
+ * against a catalog other than its own snapshot. The cache also carries a version that each DDL bumps, which lets
+ * connections drop the objects their own Statements cached before the DDL.
+ */
+class SharedPlanCache {
+ public:
+  /**
+   * @param max_size maximum number of entries to hold, 0 disables the cache
+   */
+  explicit SharedPlanCache(const uint64_t max_size) : max_size_(max_size) {}
+
+  DISALLOW_COPY_AND_MOVE(SharedPlanCache)
+
+  /**
+   * Prepare a Statement for binding. Drops the objects the Statement cached before the last DDL, and if the Statement
+   * has no cached objects afterwards, shares the ones cached for the same query if there are any.
+   * @param statement statement about to be bound
+   * @param db_oid database the statement is bound in
+   * @param txn transaction the statement is bound in
+   * @return true if the statement now shares cached objects from this cache
+   */
+  bool Lookup(common::ManagedPointer<Statement> statement, catalog::db_oid_t db_oid,
+              common::ManagedPointer<transaction::TransactionContext> txn);
+
+  /**
+   * Publish the cached objects of a Statement that has been optimized and compiled, unless the query is cached already.
+   * @param statement statement that was executed
+   * @param db_oid database the statement was executed in
+   * @param txn transaction the statement was executed in
+   */
+  void Add(common::ManagedPointer<Statement> statement, catalog::db_oid_t db_oid,
+           common::ManagedPointer<transaction::TransactionContext> txn);
+
+  /**
+   * Invalidate the cache for a DDL statement about to run. The cache is bypassed until the transaction finishes.
+   * @param txn transaction that runs the DDL statement
+   */
+  void RegisterDDL(common::ManagedPointer<transaction::TransactionContext> txn);
+
+  /**
+   * @return number of entries in the cache
+   */
+  uint64_t Size() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return entries_.size();
+  }
+
+ private:
+  struct Key {
+    std::string query_text_;
+    std::vector<type::TypeId> param_types_;
+    catalog::db_oid_t db_oid_;
+
+    bool operator==(const Key &other) const {
+      return db_oid_ == other.db_oid_ && param_types_ == other.param_types_ && query_text_ == other.query_text_;
+    }
+  };
+
+  struct KeyHasher {
+    std::size_t operator()(const Key &key) const;
+  };
+
+  struct Entry {
+    Key key_;
+    std::shared_ptr<optimizer::OptimizeResult> optimize_result_;
+    std::shared_ptr<execution::compiler::ExecutableQuery> executable_query_;
+    std::vector<type::TypeId> desired_param_types_;
+  };
+
+  // Whether txn may read or publish entries. Requires latch_ to be held.
+  bool Usable(common::ManagedPointer<transaction::TransactionContext> txn) const;
+
+  const uint64_t max_size_;
+  mutable common::SpinLatch latch_;
+  // most recently used entry first
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHasher> index_;
+  // number of DDL transactions in flight
+  uint32_t pending_ddl_ = 0;
+  transaction::timestamp_t last_ddl_commit_ = transaction::INITIAL_TXN_TIMESTAMP;
+  uint64_t version_ = 0;
+};
+
+}  // namespace noisepage::network
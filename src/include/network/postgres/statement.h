@@ -80,7 +80,7 @@ class Statement {
    * @return the optimize result of the query
    */
   common::ManagedPointer<optimizer::OptimizeResult> OptimizeResult() const {
-    return common::ManagedPointer(optimize_result_);
+    return common::ManagedPointer(optimize_result_.get());
   }
 
   /**
@@ -92,7 +92,7 @@ class Statement {
    * @return the compiled executable query
    */
   common::ManagedPointer<execution::compiler::ExecutableQuery> GetExecutableQuery() const {
-    return common::ManagedPointer(executable_query_);
+    return common::ManagedPointer(executable_query_.get());
   }
 
   /**
@@ -145,6 +145,40 @@ class Statement {
     desired_param_types_ = {};
   }
 
+  /**
+   * @return shared ownership of the optimize result, for the SharedPlanCache
+   */
+  std::shared_ptr<optimizer::OptimizeResult> SharedOptimizeResult() const { return optimize_result_; }
+
+  /**
+   * @return shared ownership of the compiled executable query, for the SharedPlanCache
+   */
+  std::shared_ptr<execution::compiler::ExecutableQuery> SharedExecutableQuery() const { return executable_query_; }
+
+  /**
+   * Replace the cached objects of this Statement with the ones another Statement of the same query generated
+   * @param optimize_result optimize result to share
+   * @param executable_query executable query to share
+   * @param desired_param_types output from the binder for the other Statement
+   */
+  void ShareCachedObjects(std::shared_ptr<optimizer::OptimizeResult> optimize_result,
+                          std::shared_ptr<execution::compiler::ExecutableQuery> executable_query,
+                          std::vector<type::TypeId> desired_param_types) {
+    optimize_result_ = std::move(optimize_result);
+    executable_query_ = std::move(executable_query);
+    desired_param_types_ = std::move(desired_param_types);
+  }
+
+  /**
+   * @return version of the SharedPlanCache that the cached objects of this Statement were generated under
+   */
+  uint64_t PlanCacheVersion() const { return plan_cache_version_; }
+
+  /**
+   * @param version version of the SharedPlanCache that the cached objects of this Statement are generated under
+   */
+  void SetPlanCacheVersion(const uint64_t version) { plan_cache_version_ = version; }
+
  private:
   const std::string query_text_;
   const std::unique_ptr<parser::ParseResult> parse_result_ = nullptr;
@@ -155,9 +189,12 @@ class Statement {
   // The following objects can be "cached" in Statement objects for future statement invocations. Though they don't
   // relate to the Postgres Statement concept, these objects should be compatible with future queries that match the
   // same query text. The exception to this that DDL changes can break these cached objects.
-  std::unique_ptr<optimizer::OptimizeResult> optimize_result_ = nullptr;              // generated in the Bind phase
-  std::unique_ptr<execution::compiler::ExecutableQuery> executable_query_ = nullptr;  // generated in the Execute phase
+  // They are shared_ptrs so that Statements of the same query on other connections can share them through the
+  // SharedPlanCache.
+  std::shared_ptr<optimizer::OptimizeResult> optimize_result_ = nullptr;              // generated in the Bind phase
+  std::shared_ptr<execution::compiler::ExecutableQuery> executable_query_ = nullptr;  // generated in the Execute phase
   std::vector<type::TypeId> desired_param_types_;                                     // generated in the Bind phase
+  uint64_t plan_cache_version_ = 0;  // SharedPlanCache version the cached objects were generated under
 };
 
 }  // namespace noisepage::network
@@ -53,6 +53,23 @@ class HyperLogLog {
    */
   void Update(const void *key, size_t length) { hll_->Update(XXH3_64bits(key, length)); }
 
+  /**
+   * Merge the keys seen by another HLL into this HLL. Both HLLs must have the same precision.
+   * @param other the HLL to merge into this HLL.
+   */
+  void Merge(const HyperLogLog &other) {
+    NOISEPAGE_ASSERT(precision_ == other.precision_, "HLLs of different precision cannot be merged");
+    hll_->Merge(other.hll_);
+  }
+
+  /**
+   * Reset the HLL to the state in which it has not seen any keys.
+   */
+  void Clear() {
+    delete hll_;
+    hll_ = libcount::HLL::Create(precision_).release();
+  }
+
   /**
    * Compute the bias-corrected estimate using the HyperLogLog++ algorithm.
    * @return
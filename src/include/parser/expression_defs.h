@@ -54,6 +54,8 @@ namespace noisepage::parser {
   T(ExpressionType, AGGREGATE_AVG)                    \
   T(ExpressionType, AGGREGATE_TOP_K)                  \
   T(ExpressionType, AGGREGATE_HISTOGRAM)              \
+  T(ExpressionType, AGGREGATE_APPROX_COUNT_DISTINCT)  \
+  T(ExpressionType, AGGREGATE_APPROX_PERCENTILE)      \
                                                       \
   T(ExpressionType, FUNCTION)                         \
                                                       \
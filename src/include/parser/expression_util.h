@@ -89,6 +89,8 @@ class ExpressionUtil {
       case ExpressionType::AGGREGATE_AVG:
       case ExpressionType::AGGREGATE_TOP_K:
       case ExpressionType::AGGREGATE_HISTOGRAM:
+      case ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT:
+      case ExpressionType::AGGREGATE_APPROX_PERCENTILE:
         return true;
       default:
         return false;
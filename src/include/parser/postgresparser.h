@@ -78,7 +78,8 @@ class PostgresParser {
   }
 
   static bool IsAggregateFunction(const std::string &fun_name) {
-    return (fun_name == "min" || fun_name == "max" || fun_name == "count" || fun_name == "avg" || fun_name == "sum");
+    return (fun_name == "min" || fun_name == "max" || fun_name == "count" || fun_name == "avg" || fun_name == "sum" ||
+            fun_name == "approx_count_distinct" || fun_name == "approx_percentile");
   }
 
   /**
@@ -97,6 +97,17 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Number of garbage collector worker threads
+SETTING_int(
+    gc_num_threads,
+    "Number of threads that unlink versions and collect indexes in parallel on each GC run (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Write ahead logging
 SETTING_bool(
     wal_enable,
@@ -157,6 +168,46 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Number of threads that replay committed transactions during recovery and replication
+SETTING_int(
+    recovery_num_threads,
+    "Number of threads that replay committed transactions from the log in parallel (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Whether checkpoints are taken in the background
+SETTING_bool(
+    checkpoint_enable,
+    "Whether periodic checkpoints are enabled (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Checkpoint interval
+SETTING_int(
+    checkpoint_interval,
+    "Interval between checkpoints (s) (default: 60)",
+    60,
+    1,
+    86400,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Path to checkpoint directory
+SETTING_string(
+    checkpoint_path,
+    "The path to the directory checkpoints are written to (default: ./checkpoints)",
+    "./checkpoints",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Optimizer timeout
 SETTING_int(task_execution_timeout,
             "Maximum allowed length of time (in ms) for task execution step of optimizer, "
@@ -172,6 +223,17 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Number of log streams
+SETTING_int(
+    wal_num_streams,
+    "Number of independent streams, each with its own serializer and log file, the log is split into (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Log file persisting threshold
 SETTING_int64(
     wal_persist_threshold,
@@ -347,6 +409,16 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_int(
+    shared_plan_cache_size,
+    "Maximum number of Extended Query protocol plans and generated code shared across connections, 0 disables sharing (default: 1000)",
+    1000,
+    0,
+    1000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     compiled_query_execution,
     "Compile queries to native machine code using LLVM, rather than relying on TPL interpretation (default: false).",
@@ -381,6 +453,54 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_int64(
+    query_memory_budget,
+    "Maximum number of bytes a query may keep in memory before spilling to disk, 0 for unlimited (default: 0)",
+    0,
+    0,
+    1099511627776,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    radix_join_build_enable,
+    "Merge thread-local hash join tables through a radix-partitioned build (default: true)",
+    true,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    index_join_sort_keys_enable,
+    "Sort each batch of index nested-loop join keys before probing the index (default: true)",
+    true,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    index_join_hash_switch_probes_per_block,
+    "Outer tuples per inner table block after which an index nested-loop join switches to a hash join, 0 to disable "
+    "(default: 1000)",
+    1000,
+    0,
+    1000000,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    index_join_hash_table_max_size,
+    "Maximum number of bytes per thread of the hash table an index nested-loop join switches to, 0 for unlimited "
+    "(default: 67108864)",
+    67108864,
+    0,
+    1099511627776,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     counters_enable,
     "Whether to use counters (default: false)",
@@ -474,4 +594,12 @@ SETTING_string(
     false,
     noisepage::settings::Callbacks::NoOp
 )
+
+SETTING_string(
+    jit_object_cache_path,
+    "Directory to cache JIT-compiled query object code in across restarts, empty to disable (default: empty)",
+    "",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
     // clang-format on
@@ -137,7 +137,12 @@ class ArrowColumnInfo {
    * @param other the object to move from
    */
   ArrowColumnInfo(ArrowColumnInfo &&other) noexcept
-      : type_(other.type_), varlen_column_(std::move(other.varlen_column_)), indices_(other.indices_) {
+      : type_(other.type_),
+        varlen_column_(std::move(other.varlen_column_)),
+        indices_(other.indices_),
+        zone_map_min_(other.zone_map_min_),
+        zone_map_max_(other.zone_map_max_),
+        has_zone_map_(other.has_zone_map_) {
     other.indices_ = nullptr;
   }
 
@@ -158,6 +163,9 @@ class ArrowColumnInfo {
       delete[] indices_;
       indices_ = other.indices_;
       other.indices_ = nullptr;
+      zone_map_min_ = other.zone_map_min_;
+      zone_map_max_ = other.zone_map_max_;
+      has_zone_map_ = other.has_zone_map_;
     }
     return *this;
   }
@@ -166,11 +174,22 @@ class ArrowColumnInfo {
    * @return type of the Arrow Column
    */
   ArrowColumnType &Type() { return type_; }
+
+  /**
+   * @return type of the Arrow Column
+   */
+  ArrowColumnType Type() const { return type_; }
+
   /**
    * @return ArrowVarlenColumn object for the column
    */
   ArrowVarlenColumn &VarlenColumn() { return varlen_column_; }
 
+  /**
+   * @return ArrowVarlenColumn object for the column
+   */
+  const ArrowVarlenColumn &VarlenColumn() const { return varlen_column_; }
+
   /**
    * Returns the indices array. This array is only meaningful if the column is dictionary compressed. The
    * size of this array is equal to the number of slots in a block.
@@ -182,6 +201,49 @@ class ArrowColumnInfo {
     return indices_;
   }
 
+  /**
+   * @return the indices array, only meaningful if the column is dictionary compressed
+   */
+  const uint64_t *Indices() const {
+    NOISEPAGE_ASSERT(type_ == ArrowColumnType::DICTIONARY_COMPRESSED,
+                     "this array is only meaningful if the column is dicationary compressed");
+    return indices_;
+  }
+
+  /**
+   * The zone map of a column holds the smallest and largest non-null value of the column in a frozen block. Values
+   * are read as sign-extended integers of the column's attribute size, so a zone map is only meaningful for
+   * integer-typed columns; it is up to the reader to only consult it for those. A column whose values are all null
+   * has a zone map whose minimum is larger than its maximum.
+   * @return reference to the flag that denotes whether the zone map of the column is up-to-date
+   */
+  bool &HasZoneMap() { return has_zone_map_; }
+
+  /**
+   * @return whether the zone map of the column is up-to-date
+   */
+  bool HasZoneMap() const { return has_zone_map_; }
+
+  /**
+   * @return reference to the smallest non-null value of the column
+   */
+  int64_t &ZoneMapMin() { return zone_map_min_; }
+
+  /**
+   * @return the smallest non-null value of the column
+   */
+  int64_t ZoneMapMin() const { return zone_map_min_; }
+
+  /**
+   * @return reference to the largest non-null value of the column
+   */
+  int64_t &ZoneMapMax() { return zone_map_max_; }
+
+  /**
+   * @return the largest non-null value of the column
+   */
+  int64_t ZoneMapMax() const { return zone_map_max_; }
+
   /**
    * Deallocates all associated buffers in the ArrowVarlenColumn
    */
@@ -198,6 +260,9 @@ class ArrowColumnInfo {
   ArrowVarlenColumn varlen_column_;  // For varlen and dictionary
   // TODO(Tianyu): Add null bitmap
   uint64_t *indices_ = nullptr;  // for dictionary
+  // min/max synopsis of fixed-length columns, only valid while the block is frozen
+  int64_t zone_map_min_ = 0, zone_map_max_ = 0;
+  bool has_zone_map_ = false;
 };
 
 /**
@@ -280,6 +345,14 @@ class ArrowBlockMetadata {
     return reinterpret_cast<ArrowColumnInfo *>(null_count_end)[col_id.UnderlyingValue()];
   }
 
+  /**
+   * Marks the zone maps of all columns as outdated. This needs to happen whenever a frozen block is modified.
+   * @param layout layout object of the Block
+   */
+  void InvalidateZoneMaps(const BlockLayout &layout) {
+    for (col_id_t col_id : layout.AllColumns()) GetColumnInfo(layout, col_id).HasZoneMap() = false;
+  }
+
  private:
   uint32_t num_records_;  // number of actual records
   // null_count[num_cols] (32-bit) | padding up to 8 byte-aligned | arrow_varlen_buffers[num_cols] |
@@ -91,8 +91,11 @@ class BlockAccessController {
 
   /**
    * blocks until all in-place readers have left to be able to perform in-place modifications.
+   * @return true if this call flipped the block back to hot from a colder state, in which case any Arrow metadata
+   *         computed for the block (e.g. zone maps) has to be considered outdated.
    */
-  void WaitUntilHot() {
+  bool WaitUntilHot() {
+    bool was_cold = false;
     while (true) {
       BlockState current_state = GetBlockState()->load();
       switch (current_state) {
@@ -104,6 +107,7 @@ class BlockAccessController {
           // intentional fall through
         case BlockState::FROZEN:
           GetBlockState()->store(BlockState::HOT);
+          was_cold = true;
           // intentional fall through
         case BlockState::HOT:
           // Although the block is already hot, we may need to wait for any straggling readers to finish
@@ -114,6 +118,7 @@ class BlockAccessController {
       }
       break;
     }
+    return was_cold;
   }
 
   /**
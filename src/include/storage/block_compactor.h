@@ -82,6 +82,10 @@ class BlockCompactor {
   void BuildDictionary(std::vector<const byte *> *loose_ptrs, ArrowBlockMetadata *metadata, col_id_t col_id,
                        common::RawConcurrentBitmap *column_bitmap, ArrowColumnInfo *col, VarlenEntry *values);
 
+  // Compute the min/max synopsis of a fixed-length column so that scans can skip the block
+  void BuildZoneMap(const ArrowBlockMetadata &metadata, common::RawConcurrentBitmap *column_bitmap,
+                    ArrowColumnInfo *col, const byte *values, uint16_t attr_size);
+
   void ComputeFilled(const BlockLayout &layout, std::vector<uint32_t> *filled, const std::vector<uint32_t> &empty) {
     // Reconstruct the list of filled slots
     // Since the list of empty slots is sorted, we can use a counter j to keep track of the next empty slot that
@@ -169,6 +169,21 @@ class DataTable {
   bool Select(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot,
               ProjectedRow *out_buffer) const;
 
+  /**
+   * Issues software prefetches for the cache lines that a visibility check or a select of the given slot reads
+   * first: the slot's allocation bit, its logical delete bit and its version pointer. This has no effect on
+   * correctness and never blocks, so callers can issue it for slots they are going to read a little later.
+   * @param slot the tuple slot that is going to be read
+   */
+  void PrefetchSlot(const TupleSlot slot) const {
+    RawBlock *const block = slot.GetBlock();
+    const uint32_t offset = slot.GetOffset();
+    __builtin_prefetch(reinterpret_cast<const byte *>(accessor_.AllocationBitmap(block)) + offset / BYTE_SIZE);
+    __builtin_prefetch(reinterpret_cast<const byte *>(accessor_.ColumnNullBitmap(block, VERSION_POINTER_COLUMN_ID)) +
+                       offset / BYTE_SIZE);
+    __builtin_prefetch(accessor_.AccessWithoutNullCheck(slot, VERSION_POINTER_COLUMN_ID));
+  }
+
   // TODO(Tianyu): Should this be updated in place or return a new iterator? Does the caller ever want to
   // save a point of scan and come back to it later?
   // Alternatively, we can provide an easy wrapper that takes in a const SlotIterator & and returns a SlotIterator,
@@ -293,6 +308,28 @@ class DataTable {
   /** @return Maximum number of blocks in the data table. */
   static uint32_t GetMaxBlocks() { return std::numeric_limits<uint32_t>::max(); }
 
+  /**
+   * Consults the zone map of a column in the given block to decide whether any of its values can fall in the range
+   * [low, high]. Only frozen blocks carry zone maps; every other block may contain anything. The zone map reads the
+   * column as integers, so this should only be asked of integer-typed columns.
+   * @param block_idx index of the block to check, must be smaller than GetNumBlocks()
+   * @param col_id the column the range is on
+   * @param low the smallest value of the range (inclusive)
+   * @param high the largest value of the range (inclusive)
+   * @return false if no value of the column in the block is in the range, true if there may be one
+   */
+  bool BlockMayContainRange(uint32_t block_idx, col_id_t col_id, int64_t low, int64_t high) const;
+
+  /**
+   * Looks up the dictionary of a varlen column in the given block. A column only has a dictionary while its block is
+   * frozen and the column was dictionary-compressed when the block was frozen.
+   * @param block the block to look in, must belong to this table
+   * @param col_id the varlen column to look up
+   * @return the Arrow metadata of the column holding the dictionary and the per-slot codes, or nullptr if the column
+   *         is not dictionary-compressed in the block
+   */
+  const ArrowColumnInfo *GetFrozenDictionary(RawBlock *block, col_id_t col_id) const;
+
   /**
    * @return a coarse estimation on the number of tuples in this table
    */
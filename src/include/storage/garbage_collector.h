@@ -1,14 +1,20 @@
 #pragma once
 
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/shared_latch.h"
 #include "storage/storage_defs.h"
 #include "transaction/transaction_defs.h"
 
+namespace noisepage::common {
+class WorkerPool;
+}  // namespace noisepage::common
+
 namespace noisepage::transaction {
 class TimestampManager;
 class TransactionManager;
@@ -31,6 +37,11 @@ class Index;
  * Based on the contents of this queue, it unlinks the UndoRecords from their version chains when no running
  * transactions can view those versions anymore. It then stores those transactions to attempt to deallocate on the next
  * iteration if no running transactions can still hold references to them.
+ *
+ * With more than one worker, the GC unlinks the UndoRecords of the transactions it processes in parallel. Every
+ * worker owns the version chains of a disjoint set of blocks, so a version chain is still only ever pruned by a single
+ * thread. Indexes are garbage collected in parallel as well. Deferred actions are processed by the calling thread, in
+ * the order they were registered.
  */
 class GarbageCollector {
  public:
@@ -44,17 +55,17 @@ class GarbageCollector {
    *                 it is not null. The observer can then gain insight invoke other components to perform actions.
    *                 The observer's function implementation needs to be lightweight because it is called on the GC
    *                 thread.
+   * @param num_workers the number of threads that unlink UndoRecords and garbage collect indexes in parallel. With a
+   *                    single worker, all work is done by the thread invoking the GC.
    */
   // TODO(Tianyu): Eventually the GC will be re-written to be purely on the deferred action manager. which will
   //  eliminate this perceived redundancy of taking in a transaction manager.
   GarbageCollector(common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
                    common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer);
+                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+                   uint32_t num_workers = 1);
 
-  ~GarbageCollector() {
-    NOISEPAGE_ASSERT(txns_to_deallocate_.empty(), "Not all txns have been deallocated");
-    NOISEPAGE_ASSERT(txns_to_unlink_.empty(), "Not all txns have been unlinked");
-  }
+  ~GarbageCollector();
 
   /**
    * Deallocates transactions that can no longer be referenced by running transactions, and unlinks UndoRecords that
@@ -86,7 +97,15 @@ class GarbageCollector {
    */
   void SetGCInterval(uint64_t gc_interval) { gc_interval_ = gc_interval; }
 
+  /**
+   * @return the number of threads that unlink UndoRecords and garbage collect indexes in parallel
+   */
+  uint32_t GetNumWorkers() const { return num_workers_; }
+
  private:
+  // What a worker did during one parallel unlink pass.
+  struct UnlinkPartition;
+
   /**
    * Process the deallocate queue
    * @return number of txns (not UndoRecords) processed for debugging/testing
@@ -99,8 +118,10 @@ class GarbageCollector {
    *   first element - number of txns processed
    *   second element - number UndoRecords processed
    *   first element - number of read-only txns processed
+   * With gc_metrics_enabled, the metrics of every worker of a parallel unlink pass are recorded.
    */
-  std::tuple<uint32_t, uint32_t, uint32_t> ProcessUnlinkQueue(transaction::timestamp_t oldest_txn);
+  std::tuple<uint32_t, uint32_t, uint32_t> ProcessUnlinkQueue(transaction::timestamp_t oldest_txn,
+                                                              bool gc_metrics_enabled);
 
   /**
    * Process deferred actions
@@ -109,7 +130,19 @@ class GarbageCollector {
 
   void ReclaimSlotIfDeleted(UndoRecord *undo_record) const;
 
-  void ReclaimBufferIfVarlen(transaction::TransactionContext *txn, UndoRecord *undo_record) const;
+  void ReclaimBufferIfVarlen(std::vector<const byte *> *loose_ptrs, UndoRecord *undo_record) const;
+
+  // Unlink the UndoRecords of the given txns in parallel. Returns the number of UndoRecords processed.
+  uint32_t UnlinkInParallel(const std::vector<transaction::TransactionContext *> &txns,
+                            transaction::timestamp_t oldest_txn, bool gc_metrics_enabled);
+
+  // Unlink the UndoRecords of the given partition, which all lie in the blocks of one worker.
+  void UnlinkPartitionOf(transaction::timestamp_t oldest_txn, UnlinkPartition *partition) const;
+
+  // The worker that owns the version chains of the given block.
+  uint32_t WorkerOf(const RawBlock *block) const {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(block) / common::Constants::BLOCK_SIZE % num_workers_);
+  }
 
   void TruncateVersionChain(DataTable *table, TupleSlot slot, transaction::timestamp_t oldest) const;
 
@@ -130,6 +163,10 @@ class GarbageCollector {
   common::SharedLatch indexes_latch_;
 
   uint64_t gc_interval_{0};
+
+  const uint32_t num_workers_;
+  // The threads that unlink UndoRecords and garbage collect indexes, null with a single worker.
+  std::unique_ptr<common::WorkerPool> worker_pool_;
 };
 
 }  // namespace noisepage::storage
@@ -88,6 +88,18 @@ class BPlusTreeIndex final : public Index {
   void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                std::vector<TupleSlot> *value_list) final;
 
+  /**
+   * Finds all the values associated with each of the given keys in our index.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param num_keys the number of keys
+   * @param sort_keys whether to look the keys up in key order
+   * @param[out] value_list the values associated with the keys, grouped by key in the given order
+   * @param[out] key_ends for each key, the end offset of its values in value_list
+   */
+  void ScanKeyBatch(const transaction::TransactionContext &txn, const ProjectedRow *const *keys, uint32_t num_keys,
+                    bool sort_keys, std::vector<TupleSlot> *value_list, std::vector<uint32_t> *key_ends) final;
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
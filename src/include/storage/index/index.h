@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -47,6 +50,80 @@ class Index {
     return data_table->IsVisible(txn, slot);
   }
 
+  /**
+   * Shared implementation of ScanKeyBatch() for the ordered indexes. The lookups of all keys happen before any
+   * visibility check, so the tuples that the visibility checks read can be prefetched a fixed distance ahead.
+   * @tparam KeyType the type of keys stored in the index
+   * @tparam Lookup callable as lookup(const KeyType &, std::vector<TupleSlot> *) that appends all values of a key
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param num_keys the number of keys
+   * @param sort_keys whether to look the keys up in key order instead of the given order
+   * @param lookup the lookup of a single key in the underlying data structure
+   * @param[out] value_list the values associated with the keys, grouped by key in the given order
+   * @param[out] key_ends for each key, the end offset of its values in value_list
+   */
+  template <typename KeyType, typename Lookup>
+  void ScanKeyBatchImpl(const transaction::TransactionContext &txn, const ProjectedRow *const *keys,
+                        const uint32_t num_keys, const bool sort_keys, const Lookup &lookup,
+                        std::vector<TupleSlot> *value_list, std::vector<uint32_t> *key_ends) const {
+    // Number of candidates between a slot's prefetch and its visibility check. The block header holding the data
+    // table pointer that the prefetch needs is itself fetched twice as far ahead.
+    constexpr uint32_t prefetch_distance = 16;
+
+    std::vector<KeyType> index_keys(num_keys);
+    for (uint32_t i = 0; i < num_keys; i++) {
+      index_keys[i].SetFromProjectedRow(*keys[i], metadata_, metadata_.GetSchema().GetColumns().size());
+    }
+
+    // Probing in key order makes consecutive lookups traverse mostly the same inner nodes, and brings equal keys
+    // next to each other so that each distinct key is only looked up once.
+    std::vector<uint32_t> order(num_keys);
+    std::iota(order.begin(), order.end(), 0);
+    if (sort_keys) {
+      std::sort(order.begin(), order.end(), [&index_keys](const uint32_t lhs, const uint32_t rhs) {
+        return std::less<KeyType>()(index_keys[lhs], index_keys[rhs]);
+      });
+    }
+
+    // Look up all keys, recording the range of candidate values of each key.
+    std::vector<TupleSlot> candidates;
+    std::vector<std::pair<uint32_t, uint32_t>> ranges(num_keys);
+    for (uint32_t i = 0; i < num_keys; i++) {
+      const uint32_t key = order[i];
+      if (i > 0 && std::equal_to<KeyType>()(index_keys[order[i - 1]], index_keys[key])) {
+        ranges[key] = ranges[order[i - 1]];
+        continue;
+      }
+      const auto begin = static_cast<uint32_t>(candidates.size());
+      lookup(index_keys[key], &candidates);
+      ranges[key] = {begin, static_cast<uint32_t>(candidates.size())};
+    }
+
+    // Check the visibility of all candidates while prefetching the ones to check next.
+    const auto num_candidates = static_cast<uint32_t>(candidates.size());
+    std::vector<bool> visible(num_candidates);
+    for (uint32_t i = 0; i < num_candidates; i++) {
+      if (i + 2 * prefetch_distance < num_candidates) {
+        __builtin_prefetch(candidates[i + 2 * prefetch_distance].GetBlock());
+      }
+      if (i + prefetch_distance < num_candidates) {
+        const TupleSlot slot = candidates[i + prefetch_distance];
+        slot.GetBlock()->data_table_->PrefetchSlot(slot);
+      }
+      visible[i] = IsVisible(txn, candidates[i]);
+    }
+
+    // Emit the visible values key by key in the given order.
+    key_ends->reserve(key_ends->size() + num_keys);
+    for (uint32_t key = 0; key < num_keys; key++) {
+      for (uint32_t i = ranges[key].first; i < ranges[key].second; i++) {
+        if (visible[i]) value_list->emplace_back(candidates[i]);
+      }
+      key_ends->emplace_back(static_cast<uint32_t>(value_list->size()));
+    }
+  }
+
   /**
    * Creates a new index wrapper.
    * @param metadata index description
@@ -115,6 +192,28 @@ class Index {
   virtual void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                        std::vector<TupleSlot> *value_list) = 0;
 
+  /**
+   * Finds all the values associated with each of the given keys in our index. This is equivalent to calling ScanKey()
+   * on every key, but lets the index amortize and overlap the work across the keys.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param num_keys the number of keys
+   * @param sort_keys whether the index may look the keys up in key order, if it supports ordered scans
+   * @param[out] value_list the values associated with the keys, grouped by key in the given order
+   * @param[out] key_ends for each key, the end offset of its values in value_list
+   */
+  virtual void ScanKeyBatch(const transaction::TransactionContext &txn, const ProjectedRow *const *keys,
+                            uint32_t num_keys, bool sort_keys, std::vector<TupleSlot> *value_list,
+                            std::vector<uint32_t> *key_ends) {
+    std::vector<TupleSlot> results;
+    for (uint32_t i = 0; i < num_keys; i++) {
+      results.clear();
+      ScanKey(txn, *keys[i], &results);
+      value_list->insert(value_list->end(), results.begin(), results.end());
+      key_ends->emplace_back(static_cast<uint32_t>(value_list->size()));
+    }
+  }
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -310,6 +310,13 @@ class UndoBuffer {
    */
   byte *LastRecord() const { return last_record_; }
 
+  /**
+   * Moves all segments of the other buffer to the end of this one, leaving the other buffer empty. The last record of
+   * this buffer is unchanged. Both buffers must draw from the same buffer pool.
+   * @param other the buffer to take the segments of
+   */
+  void Append(UndoBuffer *other);
+
  private:
   RecordBufferSegmentPool *buffer_pool_;
   std::vector<RecordBufferSegment *> buffers_;
@@ -350,6 +357,20 @@ class RedoBuffer {
    */
   void Finalize(bool flush_buffer, const transaction::TransactionPolicy &policy);
 
+  /**
+   * Hands the current segment, if any, to the log manager without closing this redo buffer. The next entry starts a
+   * new segment, so everything written so far is guaranteed to be logged before it. Afterwards there is no last record.
+   * @param policy The transaction-wide policies for this log.
+   */
+  void Flush(const transaction::TransactionPolicy &policy);
+
+  /**
+   * Flushes the other redo buffer, whose records are logged after everything this buffer has flushed so far.
+   * @param other the redo buffer to flush, which must not be written to afterwards
+   * @param policy The transaction-wide policies for this log.
+   */
+  void Append(RedoBuffer *other, const transaction::TransactionPolicy &policy);
+
   /**
    * @return a pointer to the beginning of the last record requested, or nullptr if no record exists.
    */
@@ -29,7 +29,7 @@ class AbstractLogProvider {
    * @return next log record along with vector of varlen entry pointers. nullptr log record if no more logs will be
    * provided.
    */
-  std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
+  virtual std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
     return HasMoreRecords() ? ReadNextRecord() : std::make_pair(nullptr, std::vector<byte *>());
   }
 
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <mutex>               // NOLINT
+#include <string>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/dedicated_thread_owner.h"
+#include "common/dedicated_thread_task.h"
+#include "common/managed_pointer.h"
+#include "storage/storage_defs.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::catalog {
+class Catalog;
+}  // namespace noisepage::catalog
+
+namespace noisepage::transaction {
+class TransactionContext;
+class TransactionManager;
+}  // namespace noisepage::transaction
+
+namespace noisepage::storage {
+
+class LogManager;
+class SqlTable;
+
+/**
+ * The CheckpointManager periodically takes fuzzy checkpoints of all databases, so that recovery only has to replay the
+ * log written since the latest checkpoint instead of the whole log.
+ *
+ * A checkpoint is taken without blocking transactions. It first continues the log in a new segment and waits for all
+ * transactions that were running at that point to finish. It then writes out a snapshot of all tables as of a read-only
+ * transaction that begins afterwards, whose start timestamp is the timestamp of the checkpoint. Any transaction that is
+ * not part of the snapshot therefore writes its records to the new segment or later ones, and the older segments can
+ * be removed.
+ *
+ * A checkpoint is a directory named after its timestamp and holds files in the on-disk log format:
+ *    1. The catalog file contains one transaction, committed at the checkpoint timestamp, that recreates all databases
+ * and their catalog tables the same way the log does when they are created
+ *    2. A file for every non-empty user table contains the inserts of all of its tuples
+ *    3. The meta file holds the checkpoint timestamp and the first segment of the log to replay. It is written last, so
+ * checkpoints without it are incomplete and ignored.
+ * Records reference the tuple slots of the checkpointed tuples, so that records later in the log that modify these
+ * tuples can be replayed. See RecoveryManager::RecoverFromCheckpoint.
+ */
+class CheckpointManager : public common::DedicatedThreadOwner {
+  /**
+   * Task that periodically takes checkpoints in a background thread
+   */
+  class CheckpointTask : public common::DedicatedThreadTask {
+   public:
+    /**
+     * @param checkpoint_manager pointer to checkpoint manager who started the task
+     */
+    explicit CheckpointTask(CheckpointManager *checkpoint_manager) : checkpoint_manager_(checkpoint_manager) {}
+
+    /**
+     * Takes a checkpoint every checkpoint interval until terminated
+     */
+    void RunTask() override;
+
+    /**
+     * Stops the task, waking it up if it is waiting for the next checkpoint
+     */
+    void Terminate() override;
+
+   private:
+    CheckpointManager *checkpoint_manager_;
+    bool run_task_ = true;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+  };
+
+ public:
+  /** Name of the file that holds the catalog of a checkpoint */
+  static constexpr const char *CATALOG_FILE_NAME = "catalog.log";
+  /** Name of the file that marks a checkpoint as complete */
+  static constexpr const char *META_FILE_NAME = "checkpoint.meta";
+
+  /** A file of a checkpoint that holds the tuples of a user table */
+  struct TableFile {
+    catalog::db_oid_t db_oid_;        ///< database of the table
+    catalog::table_oid_t table_oid_;  ///< the table
+    std::string path_;                ///< path of the file
+  };
+
+  /**
+   * @param checkpoint_path directory to write checkpoints to
+   * @param checkpoint_interval interval between checkpoints taken in the background
+   * @param catalog catalog to checkpoint
+   * @param txn_manager txn manager to begin the snapshot txn with
+   * @param log_manager log manager whose log is split into segments at checkpoints, DISABLED if logging is disabled
+   * @param thread_registry thread registry to register the background task
+   */
+  CheckpointManager(std::string checkpoint_path, std::chrono::seconds checkpoint_interval,
+                    common::ManagedPointer<catalog::Catalog> catalog,
+                    common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                    common::ManagedPointer<LogManager> log_manager,
+                    common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry);
+
+  /** Stops taking checkpoints in the background if it was started. */
+  ~CheckpointManager() override {
+    if (checkpoint_task_ != nullptr) Stop();
+  }
+
+  /** Starts taking checkpoints in the background. */
+  void Start();
+
+  /** Stops taking checkpoints in the background. A checkpoint in progress is completed first. */
+  void Stop();
+
+  /**
+   * Takes a checkpoint of all databases. Removes older checkpoints and the segments of the log they needed once done.
+   * @return timestamp of the checkpoint
+   */
+  transaction::timestamp_t TakeCheckpoint();
+
+  /**
+   * Find the latest complete checkpoint in the given directory.
+   * @param checkpoint_path directory the checkpoints were written to
+   * @param[out] checkpoint_dir directory of the checkpoint
+   * @param[out] checkpoint_ts timestamp of the checkpoint
+   * @param[out] log_segment first segment of the log that must be replayed after loading the checkpoint
+   * @return false if there is no complete checkpoint
+   */
+  static bool FindLatestCheckpoint(const std::string &checkpoint_path, std::string *checkpoint_dir,
+                                   transaction::timestamp_t *checkpoint_ts, uint64_t *log_segment);
+
+  /**
+   * @param checkpoint_dir directory of a checkpoint
+   * @return the files of the checkpoint that hold the tuples of user tables
+   */
+  static std::vector<TableFile> ListTableFiles(const std::string &checkpoint_dir);
+
+ private:
+  // A user table to write out
+  struct UserTable {
+    catalog::db_oid_t db_oid_;
+    catalog::table_oid_t table_oid_;
+    SqlTable *table_;
+  };
+
+  const std::string checkpoint_path_;
+  const std::chrono::seconds checkpoint_interval_;
+  const common::ManagedPointer<catalog::Catalog> catalog_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  const common::ManagedPointer<LogManager> log_manager_;
+
+  // Serializes checkpoints taken in the background and on request
+  std::mutex checkpoint_latch_;
+  common::ManagedPointer<CheckpointTask> checkpoint_task_ = nullptr;
+
+  // The oids of all columns of the table
+  static std::vector<catalog::col_oid_t> ColumnOids(const SqlTable &table);
+
+  // Write the catalog of all databases to the catalog file, and collect the user tables to write out.
+  void WriteCatalog(transaction::TransactionContext *txn, const std::string &checkpoint_dir,
+                    std::vector<UserTable> *user_tables);
+
+  // Write the tuples of a user table to its file in the checkpoint. No file is written for empty tables.
+  void WriteTable(transaction::TransactionContext *txn, const std::string &checkpoint_dir, const UserTable &table);
+};
+
+}  // namespace noisepage::storage
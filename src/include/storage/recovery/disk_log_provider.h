@@ -1,6 +1,10 @@
 #pragma once
 
+#include <filesystem>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/write_ahead_log/log_io.h"
@@ -9,26 +13,49 @@ namespace noisepage::storage {
 
 /**
  * @brief Log provider for logs stored on disk
- * Provides logs to the recovery manager from logs persisted on disk. The log file is read in using the
- * BufferedLogReader.
+ * Provides logs to the recovery manager from logs persisted on disk. The log files are read in using the
+ * BufferedLogReader. A log that the LogManager split into segments is read segment by segment, see
+ * LogManager::SegmentPaths.
  */
 class DiskLogProvider : public AbstractLogProvider {
  public:
   /**
    * @param log_file_path path to log file to read logs from
    */
-  explicit DiskLogProvider(const std::string &log_file_path) : in_(BufferedLogReader(log_file_path.c_str())) {}
+  explicit DiskLogProvider(const std::string &log_file_path)
+      : DiskLogProvider(std::vector<std::string>{log_file_path}) {}
+
+  /**
+   * @param log_file_paths paths to the log files to read logs from, in the order they were written
+   */
+  explicit DiskLogProvider(std::vector<std::string> log_file_paths) : log_file_paths_(std::move(log_file_paths)) {}
 
   LogProviderType GetType() const override { return LogProviderType::DISK; }
 
  private:
-  // Buffered log file reader
-  storage::BufferedLogReader in_;
+  // The log files to read, in order
+  std::vector<std::string> log_file_paths_;
+  // The index of the next log file to open
+  uint32_t next_file_ = 0;
+  // Buffered reader of the current log file, null before the first file is opened
+  std::unique_ptr<BufferedLogReader> in_;
 
   /**
    * @return true if log file contains more records, false otherwise
    */
-  bool HasMoreRecords() override { return in_.HasMore(); }
+  bool HasMoreRecords() override {
+    // Records never span two log files, so we move on to the next file once the current one is exhausted. An empty log
+    // file, e.g., a segment that was started right before shutdown, is skipped since the reader can't tell it apart
+    // from a file that has more to read.
+    while (in_ == nullptr || !in_->HasMore()) {
+      if (next_file_ == log_file_paths_.size()) return false;
+      const auto &path = log_file_paths_[next_file_++];
+      std::error_code error;
+      if (std::filesystem::file_size(path, error) == 0 && !error) continue;
+      in_ = std::make_unique<BufferedLogReader>(path.c_str());
+    }
+    return true;
+  }
 
   /**
    * Read data from the log file into the destination provided
@@ -36,7 +63,7 @@ class DiskLogProvider : public AbstractLogProvider {
    * @param size number of bytes to read
    * @return true if we read the given number of bytes
    */
-  bool Read(void *dest, uint32_t size) override { return in_.Read(dest, size); }
+  bool Read(void *dest, uint32_t size) override { return in_->Read(dest, size); }
 };
 
 }  // namespace noisepage::storage
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "storage/recovery/disk_log_provider.h"
+
+namespace noisepage::storage {
+
+/**
+ * @brief Log provider for a log that the LogManager split into several streams
+ * The records of a transaction are all in the same stream, but the commits of different streams are not ordered with
+ * respect to each other. The provider first supplies all records other than commit records, one stream after the other,
+ * and then the commit records of all streams in commit timestamp order. The recovery manager buffers the changes of a
+ * transaction until it sees its commit record, so transactions are replayed as if the streams were merged by commit
+ * timestamp.
+ *
+ * A stream may have persisted commits that depend on commits another stream never persisted. The LogManager did not
+ * acknowledge those, and the provider drops them the same way: a commit is only supplied if, for every stream, the
+ * RoundRecords of its run carry a persisted bound at or above the horizon of its round. The changes of a dropped commit
+ * are discarded like those of a transaction that was still running.
+ * @warning All records of the log are buffered until the first commit record is supplied, so a large log should be cut
+ * short with checkpoints, see CheckpointManager.
+ */
+class MergingLogProvider : public AbstractLogProvider {
+ public:
+  /**
+   * @param stream_paths for every stream of the log, the paths to its log files in the order they were written, see
+   * LogManager::StreamSegmentPaths
+   */
+  explicit MergingLogProvider(const std::vector<std::vector<std::string>> &stream_paths) {
+    for (const auto &paths : stream_paths) streams_.emplace_back(std::make_unique<DiskLogProvider>(paths));
+  }
+
+  LogProviderType GetType() const override { return LogProviderType::DISK; }
+
+  std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() override {
+    for (; next_stream_ < streams_.size(); next_stream_++) {
+      for (auto pair = streams_[next_stream_]->GetNextRecord(); pair.first != nullptr;
+           pair = streams_[next_stream_]->GetNextRecord()) {
+        switch (pair.first->RecordType()) {
+          case LogRecordType::COMMIT:
+            round_commits_.push_back(pair.first);
+            break;
+          case LogRecordType::ROUND:
+            CloseRound(*pair.first->GetUnderlyingRecordBodyAs<RoundRecord>());
+            delete[] reinterpret_cast<byte *>(pair.first);
+            break;
+          default:
+            return pair;
+        }
+      }
+      // The last round of the stream was not persisted, so its commits were never acknowledged
+      for (auto *const commit : round_commits_) delete[] reinterpret_cast<byte *>(commit);
+      round_commits_.clear();
+    }
+    if (!commits_sorted_) {
+      DropUnacknowledgedCommits();
+      std::sort(commits_.begin(), commits_.end(), [](const RoundCommit &a, const RoundCommit &b) {
+        return a.record_->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime() <
+               b.record_->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime();
+      });
+      commits_sorted_ = true;
+    }
+    if (next_commit_ == commits_.size()) return {nullptr, std::vector<byte *>()};
+    return {commits_[next_commit_++].record_, std::vector<byte *>()};
+  }
+
+ private:
+  // A commit record along with the round of serialization it was persisted in
+  struct RoundCommit {
+    LogRecord *record_;
+    uint64_t run_;
+    uint64_t horizon_;
+  };
+
+  // Providers for the streams of the log
+  std::vector<std::unique_ptr<DiskLogProvider>> streams_;
+  // The index of the stream that records are read from
+  uint32_t next_stream_ = 0;
+  // Commit records of the current stream that were read since its last RoundRecord
+  std::vector<LogRecord *> round_commits_;
+  // For every run of the LogManager, the highest persisted bound in the RoundRecords of each stream
+  std::unordered_map<uint64_t, std::vector<uint64_t>> persisted_bounds_;
+  // Commit records of all streams, ordered by commit timestamp once all streams are read
+  std::vector<RoundCommit> commits_;
+  // True once all streams are read and commits_ is sorted
+  bool commits_sorted_ = false;
+  // The index of the next commit record to supply
+  uint64_t next_commit_ = 0;
+
+  // Assigns the commit records read since the last RoundRecord of the current stream to the round the given one closes
+  void CloseRound(const RoundRecord &round) {
+    auto &bounds = persisted_bounds_[round.Run()];
+    bounds.resize(streams_.size(), 0);
+    bounds[next_stream_] = std::max(bounds[next_stream_], round.PersistedBound());
+    for (auto *const commit : round_commits_) commits_.push_back({commit, round.Run(), round.Horizon()});
+    round_commits_.clear();
+  }
+
+  // Drops the commit records that the LogManager never acknowledged, as some stream did not persist every commit that
+  // may precede them
+  void DropUnacknowledgedCommits() {
+    std::unordered_map<uint64_t, uint64_t> persisted_commit_sequence;
+    for (const auto &[run, bounds] : persisted_bounds_) {
+      persisted_commit_sequence[run] = *std::min_element(bounds.begin(), bounds.end());
+    }
+    const auto acknowledged_end = std::partition(commits_.begin(), commits_.end(), [&](const RoundCommit &commit) {
+      return commit.horizon_ <= persisted_commit_sequence[commit.run_];
+    });
+    for (auto it = acknowledged_end; it != commits_.end(); ++it) delete[] reinterpret_cast<byte *>(it->record_);
+    commits_.erase(acknowledged_end, commits_.end());
+  }
+
+  /**
+   * @return true if there are more records to provide, false otherwise
+   */
+  bool HasMoreRecords() override { return next_stream_ < streams_.size() || next_commit_ < commits_.size(); }
+
+  /**
+   * Records are read through the providers of the streams, so this is never called
+   * @return false
+   */
+  bool Read(void * /*dest*/, uint32_t /*size*/) override {
+    NOISEPAGE_ASSERT(false, "Records are read through the providers of the streams");
+    return false;
+  }
+};
+
+}  // namespace noisepage::storage
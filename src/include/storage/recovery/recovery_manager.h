@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -18,6 +19,8 @@
 #include "catalog/postgres/pg_namespace.h"
 #include "catalog/postgres/pg_type.h"
 #include "common/dedicated_thread_owner.h"
+#include "common/spin_latch.h"
+#include "common/worker_pool.h"
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/sql_table.h"
 
@@ -83,6 +86,7 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param replication_manager replication manager to acknowledge applied changes
    * @param thread_registry thread registry to register tasks
    * @param store block store used for SQLTable creation during recovery
+   * @param num_replay_threads number of threads that replay committed txns in parallel
    */
   explicit RecoveryManager(const common::ManagedPointer<AbstractLogProvider> log_provider,
                            const common::ManagedPointer<catalog::Catalog> catalog,
@@ -90,14 +94,20 @@ class RecoveryManager : public common::DedicatedThreadOwner {
                            const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
                            const common::ManagedPointer<replication::ReplicationManager> replication_manager,
                            const common::ManagedPointer<noisepage::common::DedicatedThreadRegistry> thread_registry,
-                           const common::ManagedPointer<BlockStore> store)
+                           const common::ManagedPointer<BlockStore> store, const uint32_t num_replay_threads = 1)
       : DedicatedThreadOwner(thread_registry),
         log_provider_(log_provider),
         catalog_(catalog),
         txn_manager_(txn_manager),
         deferred_action_manager_(deferred_action_manager),
         replication_manager_(replication_manager),
-        block_store_(store) {
+        block_store_(store),
+        num_replay_threads_(num_replay_threads) {
+    NOISEPAGE_ASSERT(num_replay_threads_ > 0, "Recovery needs at least one replay thread");
+    if (num_replay_threads_ > 1) {
+      replay_pool_ = std::make_unique<common::WorkerPool>(num_replay_threads_, common::TaskQueue{});
+      replay_pool_->Startup();
+    }
     // Initialize catalog_table_schemas_ map
     catalog_table_schemas_[catalog::postgres::PgClass::CLASS_TABLE_OID] =
         catalog::postgres::Builder::GetClassTableSchema();
@@ -113,6 +123,21 @@ class RecoveryManager : public common::DedicatedThreadOwner {
         catalog::postgres::Builder::GetTypeTableSchema();
   }
 
+  /** Stops the replay threads. */
+  ~RecoveryManager() override {
+    if (replay_pool_ != nullptr) replay_pool_->Shutdown();
+  }
+
+  /**
+   * Loads the latest complete checkpoint in the given directory, if there is one. Must be called before recovery is
+   * started. Recovery then replays the log written since the checkpoint, and skips txns of the log that committed
+   * before it, as their changes are already part of the checkpoint. See CheckpointManager.
+   * @param checkpoint_path directory the checkpoints were written to
+   * @param num_threads number of threads to load the tables of the checkpoint with
+   * @return true if a checkpoint was loaded, false if there is none
+   */
+  bool RecoverFromCheckpoint(const std::string &checkpoint_path, uint32_t num_threads);
+
   /** Starts a background recovery thread, which does not stop until WaitForRecoveryToFinish() is called. */
   void StartRecovery();
 
@@ -127,6 +152,7 @@ class RecoveryManager : public common::DedicatedThreadOwner {
 
  private:
   FRIEND_TEST(RecoveryTests, DoubleRecoveryTest);
+  FRIEND_TEST(RecoveryTests, CheckpointTest);
   friend class RecoveryTests;
   friend class noisepage::RecoveryBenchmark;
 
@@ -154,6 +180,8 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   // TODO(Gus): This map may get huge, benchmark whether this becomes a problem and if we need a more sophisticated data
   // structure
   std::unordered_map<TupleSlot, TupleSlot> tuple_slot_map_;
+  // Protects tuple_slot_map_ while txns are replayed in parallel
+  common::SpinLatch tuple_slot_map_latch_;
 
   // Used during recovery from log. Stores deferred transactions in sorted sorted order to be able to execute them in
   // serial order. Transactions are defered when there is an older active transaction at the time it committed. Even
@@ -166,6 +194,10 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   std::unordered_map<transaction::timestamp_t, std::vector<std::pair<LogRecord *, std::vector<byte *>>>>
       buffered_changes_map_;
 
+  // Replays txns that don't modify the catalog in parallel, nullptr if txns are replayed serially
+  const uint32_t num_replay_threads_;
+  std::unique_ptr<common::WorkerPool> replay_pool_;
+
   // Background recovery task
   common::ManagedPointer<RecoveryTask> recovery_task_ = nullptr;
   /**
@@ -183,6 +215,8 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   std::unordered_map<catalog::table_oid_t, catalog::Schema> catalog_table_schemas_;
 
   transaction::timestamp_t last_applied_txn_id_ = transaction::INITIAL_TXN_TIMESTAMP;  ///< The last applied txn's ID.
+  // Timestamp of the loaded checkpoint. Txns of the log that committed before it are part of the checkpoint.
+  transaction::timestamp_t checkpoint_ts_ = transaction::INITIAL_TXN_TIMESTAMP;
   uint32_t recovered_txns_ = 0;  ///< The number of recovered committed txns.
 
   /**
@@ -194,7 +228,7 @@ class RecoveryManager : public common::DedicatedThreadOwner {
 
   /**
    * Recovers the databases from the logs.
-   * @note this is a separate method so in the future, we can also have a RecoverFromCheckpoint method
+   * @note this is a separate method from Recover so that the catalog of a checkpoint can be replayed with it as well
    */
   void RecoverFromLogs(common::ManagedPointer<AbstractLogProvider> log_provider_);
 
@@ -204,6 +238,42 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    */
   void ProcessCommittedTransaction(transaction::timestamp_t txn_id);
 
+  /**
+   * Replays committed transactions in the given order on the replay threads. Transactions that modify the catalog are
+   * barriers, i.e., they are replayed alone once all transactions before them are replayed. Any other transaction is
+   * replayed once all earlier transactions that modify the same tuples are, or the same tables if these have a unique
+   * index.
+   * @param txn_ids start timestamps of the committed transactions, in the order they must be replayed in serially
+   */
+  void ProcessCommittedTransactionsInParallel(const std::vector<transaction::timestamp_t> &txn_ids);
+
+  /**
+   * Replays transactions between barriers in parallel, see ProcessCommittedTransactionsInParallel.
+   * @param txn_ids start timestamps of the transactions
+   * @param buffered_changes buffered log records of each transaction
+   */
+  void ReplayTransactionsInParallel(
+      const std::vector<transaction::timestamp_t> &txn_ids,
+      std::vector<std::vector<std::pair<LogRecord *, std::vector<byte *>>>> *buffered_changes);
+
+  /**
+   * Replays the buffered changes of a committed transaction in a new transaction, and defers the deletes of its records
+   * @param buffered_changes buffered log records of the transaction
+   */
+  void ReplayTransaction(std::vector<std::pair<LogRecord *, std::vector<byte *>>> *buffered_changes);
+
+  /**
+   * Records that a committed transaction was replayed, and acknowledges it to the primary on replicas
+   * @param txn_id start timestamp of the replayed transaction
+   */
+  void TransactionApplied(transaction::timestamp_t txn_id);
+
+  /**
+   * @param buffered_changes buffered log records of a transaction
+   * @return true if the transaction modifies the catalog, and must not be replayed concurrently with other ones
+   */
+  static bool IsBarrierTransaction(const std::vector<std::pair<LogRecord *, std::vector<byte *>>> &buffered_changes);
+
   /**
    * Defers log records deletes with the transaction manager
    * @param txn_id txn_id for txn who's records to delete
@@ -211,6 +281,14 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    */
   void DeferRecordDeletes(transaction::timestamp_t txn_id, bool delete_varlens);
 
+  /**
+   * Defers log records deletes with the transaction manager
+   * @param buffered_changes buffered log records to delete
+   * @param delete_varlens true if we should delete varlens allocated for the records
+   */
+  void DeferRecordDeletes(std::vector<std::pair<LogRecord *, std::vector<byte *>>> &&buffered_changes,
+                          bool delete_varlens);
+
   /**
    * Replay any transaction who's txn start time is less than upper_bound. If upper_bound == transaction::NO_ACTIVE_TXN,
    * it will replay all deferred transactions
@@ -225,6 +303,7 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @return new tuple slot
    */
   TupleSlot GetTupleSlotMapping(TupleSlot slot) {
+    common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
     NOISEPAGE_ASSERT(tuple_slot_map_.find(slot) != tuple_slot_map_.end(), "No tuple slot mapping exists");
     return tuple_slot_map_[slot];
   }
@@ -244,6 +323,20 @@ class RecoveryManager : public common::DedicatedThreadOwner {
     return db_catalog_ptr;
   }
 
+  /**
+   * Wrapper over GetDatabaseCatalog method that asserts the database exists. Unlike GetDatabaseCatalog, it does not
+   * lock the database catalog, so that transactions that only modify user tables can be replayed concurrently.
+   * @param txn txn for catalog lookup
+   * @param database oid for database we want
+   * @return pointer to database catalog
+   */
+  common::ManagedPointer<catalog::DatabaseCatalog> LookupDatabaseCatalog(transaction::TransactionContext *txn,
+                                                                         catalog::db_oid_t db_oid) {
+    auto db_catalog_ptr = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    NOISEPAGE_ASSERT(db_catalog_ptr != nullptr, "No catalog for given database oid");
+    return db_catalog_ptr;
+  }
+
   /**
    * @param txn transaction to use for catalog lookup
    * @param db_oid database oid for requested table
@@ -269,6 +362,20 @@ class RecoveryManager : public common::DedicatedThreadOwner {
                             catalog::table_oid_t table_oid, common::ManagedPointer<storage::SqlTable> table_ptr,
                             const TupleSlot &tuple_slot, ProjectedRow *table_pr, bool insert);
 
+  /**
+   * Inserts or deletes a tuple slot from the given indexes.
+   * @param txn transaction to delete with
+   * @param index_objects indexes to update, and their schemas
+   * @param pr_map projection map of the table PR
+   * @param tuple tuple slot to delete
+   * @param table_pr pointer to PR with values for every column of the table
+   * @param insert true if we should insert into indexes, false for delete
+   */
+  static void UpdateIndexes(
+      transaction::TransactionContext *txn,
+      const std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> &index_objects,
+      const ProjectionMap &pr_map, const TupleSlot &tuple_slot, ProjectedRow *table_pr, bool insert);
+
   /**
    * NYS = Not yet supported
    * Returns whether a delete or redo record is a special case catalog record. The special cases we consider are:
@@ -314,7 +421,8 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param record record we want to determine redo type of
    * @return true if record is an insert redo, false if it is an update redo
    */
-  bool IsInsertRecord(const RedoRecord *record) const {
+  bool IsInsertRecord(const RedoRecord *record) {
+    common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
     return tuple_slot_map_.find(record->GetTupleSlot()) == tuple_slot_map_.end();
   }
 
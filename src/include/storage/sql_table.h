@@ -236,13 +236,19 @@ class SqlTable {
    */
   uint64_t GetNumTuple() const { return table_.data_table_->GetNumTuple(); }
 
+  /**
+   * @return the number of blocks in this table
+   */
+  uint32_t GetNumBlocks() const { return table_.data_table_->GetNumBlocks(); }
+
   /**
    * @return Approximate heap usage of the table
    */
   size_t EstimateHeapUsage() const { return table_.data_table_->EstimateHeapUsage(); }
 
  private:
-  friend class RecoveryManager;  // Needs access to OID and ID mappings
+  friend class CheckpointManager;  // Needs access to OID and ID mappings
+  friend class RecoveryManager;    // Needs access to OID and ID mappings
   friend class noisepage::RandomSqlTableTransaction;
   friend class noisepage::LargeSqlTableTestObject;
   friend class RecoveryTests;
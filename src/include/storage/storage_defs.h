@@ -226,7 +226,7 @@ enum class DeltaRecordType : uint8_t { UPDATE = 0, INSERT, DELETE };
 /**
  * Types of LogRecords
  */
-enum class LogRecordType : uint8_t { REDO = 1, DELETE, COMMIT, ABORT };
+enum class LogRecordType : uint8_t { REDO = 1, DELETE, COMMIT, ABORT, ROUND };
 
 /**
  * A varlen entry is always a 32-bit size field and the varlen content,
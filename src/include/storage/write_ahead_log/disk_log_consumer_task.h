@@ -1,17 +1,21 @@
 #pragma once
 
 #include <condition_variable>  // NOLINT
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "common/container/concurrent_blocking_queue.h"
 #include "common/container/concurrent_queue.h"
 #include "common/dedicated_thread_task.h"
+#include "common/managed_pointer.h"
 #include "storage/storage_defs.h"
 #include "storage/write_ahead_log/log_io.h"
 
 namespace noisepage::storage {
 
+class LogManager;
+
 /**
  * A DiskLogConsumerTask is responsible for writing serialized log records out to disk by processing buffers in the log
  * manager's filled buffer queue
@@ -25,18 +29,27 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
    * @param buffers pointer to list of all buffers used by log manager, used to persist log file
    * @param empty_buffer_queue pointer to queue to push empty buffers to
    * @param filled_buffer_queue pointer to queue to pop filled buffers from
+   * @param serialized_rounds pointer to queue to pop rounds of serialization from, null if the log is not split into
+   * several streams
+   * @param log_manager the log manager to report persisted rounds of serialization to
+   * @param stream the stream of the log this task persists
    */
   explicit DiskLogConsumerTask(const std::chrono::microseconds persist_interval, uint64_t persist_threshold,
                                std::vector<BufferedLogWriter> *buffers,
                                common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
-                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue)
+                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
+                               common::ConcurrentQueue<storage::SerializedRound> *serialized_rounds = nullptr,
+                               common::ManagedPointer<LogManager> log_manager = nullptr, uint32_t stream = 0)
       : run_task_(false),
         persist_interval_(persist_interval),
         persist_threshold_(persist_threshold),
         current_data_written_(0),
         buffers_(buffers),
         empty_buffer_queue_(empty_buffer_queue),
-        filled_buffer_queue_(filled_buffer_queue) {}
+        filled_buffer_queue_(filled_buffer_queue),
+        serialized_rounds_(serialized_rounds),
+        log_manager_(log_manager),
+        stream_(stream) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -68,9 +81,23 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue_;
   // The queue containing filled buffers. Task should dequeue filled buffers from this queue to flush
   common::ConcurrentQueue<SerializedLogs> *filled_buffer_queue_;
+  // The queue containing rounds of serialization, null if the log is not split into several streams. A round is handed
+  // over after all of its buffers, so it is written out along with the buffers that are in the queue when it is popped
+  common::ConcurrentQueue<SerializedRound> *serialized_rounds_;
+  // Rounds of serialization that were written to the log file but not yet persisted
+  std::vector<SerializedRound> unpersisted_rounds_;
+  // The log manager that persisted rounds of serialization are reported to
+  common::ManagedPointer<LogManager> log_manager_;
+  // The stream of the log this task persists
+  uint32_t stream_;
 
   // Flag used by the serializer thread to signal the disk log consumer task thread to persist the data on disk
   volatile bool force_flush_;
+  // Flag used by the LogManager to signal the disk log consumer task thread to persist the data on disk and continue
+  // the log in the file at next_log_file_path_
+  volatile bool rotate_ = false;
+  // The log file to continue the log in once rotate_ is set. Protected by persist_lock_
+  std::string next_log_file_path_;
 
   // Synchronisation primitives to synchronise persisting buffers to disk
   std::mutex persist_lock_;
@@ -92,9 +119,16 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
 
   /*
    * Persists the log file on disk by calling fsync, as well as calling callbacks for all committed transactions that
-   * were persisted
+   * were persisted and reporting the persisted rounds of serialization to the log manager
    * @return number of buffers persisted, used for metrics
    */
   uint64_t PersistLogFile();
+
+  /**
+   * Flush all buffers in the filled buffers queue, persist them, and have all buffers write to next_log_file_path_ from
+   * now on. Must hold persist_lock_.
+   * @return number of buffers persisted, used for metrics
+   */
+  uint64_t RotateLogFile();
 };
 }  // namespace noisepage::storage
@@ -61,6 +61,16 @@ class BufferedLogWriter {
    */
   void Close() { PosixIoWrappers::Close(out_); }
 
+  /**
+   * Close the current log file and append to the specified log file from now on. Buffered writes that have not been
+   * flushed yet are written to the new file.
+   * @param log_file_path path to the log file to write to, created if it does not exist yet
+   */
+  void Reopen(const char *const log_file_path) {
+    PosixIoWrappers::Close(out_);
+    out_ = PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR);
+  }
+
   /**
    * Write to the log file the given amount of bytes from the given location in memory, but buffer the write so the
    * update is only written out when the BufferedLogWriter is persisted. Note that this function writes to the buffer
@@ -158,7 +168,7 @@ class BufferedLogWriter {
  private:
   friend class replication::RecordsBatchMsg;
 
-  const int out_;  // fd of the output files
+  int out_;  // fd of the output files
   char buffer_[common::Constants::LOG_BUFFER_SIZE];
 
   uint32_t buffer_size_ = 0;
@@ -246,4 +256,16 @@ struct CommitCallback {
  */
 using SerializedLogs = std::pair<BufferedLogWriter *, std::vector<CommitCallback>>;
 
+/**
+ * A round of serialization of one stream of a log that the LogManager split into several streams. Once all logs the
+ * round serialized are persisted, every commit of the stream that was registered with a commit sequence number below
+ * persisted_bound_ is persistent. The commit callbacks of the round may be invoked once this holds for all commit
+ * sequence numbers below horizon_ in every stream.
+ */
+struct SerializedRound {
+  uint64_t persisted_bound_;             ///< Commits of the stream below this are in this round or an earlier one
+  uint64_t horizon_;                     ///< Every commit in this round has a lower commit sequence number
+  std::vector<CommitCallback> commits_;  ///< Commit callbacks for the commit records serialized in this round
+};
+
 }  // namespace noisepage::storage
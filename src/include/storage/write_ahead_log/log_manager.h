@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <map>
 #include <memory>
 #include <queue>
 #include <string>
@@ -16,6 +18,7 @@
 #include "storage/record_buffer.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "storage/write_ahead_log/log_record.h"
+#include "transaction/transaction_defs.h"
 
 namespace noisepage::replication {
 class PrimaryReplicationManager;
@@ -42,6 +45,17 @@ class DiskLogConsumerTask;
  *          c) A sufficient amount of data has been written since the last persist
  *      5. When the persist is done, the `DiskLogConsumerTask` will call the commit callbacks for any CommitRecords that
  * were just persisted.
+ *
+ * The log can be split into several streams, each with its own serializer task, consumer task, buffers and log file,
+ * so that streams serialize and persist in parallel. All records of a transaction go to the same stream, chosen by its
+ * start timestamp. A commit is only acknowledged once every commit that may precede it is persisted, no matter the
+ * stream. For this, transactions register with their stream before they take a commit timestamp (BeginCommit) and get
+ * a commit sequence number, and unregister once their commit record is handed over (EndCommit). Each round of
+ * serialization of a stream yields a bound below which all registered commits of the stream are serialized. Once a
+ * round is persisted, the stream's persisted bound advances, and the minimum over all streams is the persisted commit
+ * sequence number. The callbacks of a round are invoked once that watermark passes the commits in the round. Each
+ * round that moved the bounds ends with a RoundRecord in the log of its stream, so that recovery applies the same rule:
+ * it merges the streams by commit timestamp and drops the commits that were never acknowledged, see MergingLogProvider.
  */
 class LogManager : public common::DedicatedThreadOwner {
  public:
@@ -61,26 +75,19 @@ class LogManager : public common::DedicatedThreadOwner {
    * @param primary_replication_manager     The replication manager that handles shipping logs over the network.
    *                                        Currently only the primary does this.
    * @param thread_registry                 DedicatedThreadRegistry dependency injection
+   * @param num_streams                     Number of streams to split the log into. Stream 0 is written to
+   *                                        log_file_path and uses empty_buffer_queue, see StreamPath for the others.
+   *                                        Replication requires a single stream.
    */
   LogManager(std::string log_file_path, uint64_t num_buffers, std::chrono::microseconds serialization_interval,
              std::chrono::microseconds persist_interval, uint64_t persist_threshold,
              common::ManagedPointer<RecordBufferSegmentPool> buffer_pool,
              common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue,
              common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager,
-             common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry)
-      : DedicatedThreadOwner(thread_registry),
-        run_log_manager_(false),
-        log_file_path_(std::move(log_file_path)),
-        num_buffers_(num_buffers),
-        buffer_pool_(buffer_pool.Get()),
-        empty_buffer_queue_(empty_buffer_queue),
-        serialization_interval_(serialization_interval),
-        persist_interval_(persist_interval),
-        persist_threshold_(persist_threshold),
-        primary_replication_manager_(primary_replication_manager) {}
-
-  /**
-   * Starts log manager. Does the following in order:
+             common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry, uint32_t num_streams = 1);
+
+  /**
+   * Starts log manager. Does the following in order for every stream:
    *    1. Initialize buffers to pass serialized logs to log consumers
    *    2. Starts up DiskLogConsumerTask
    *    3. Starts up LogSerializerTask
@@ -114,6 +121,30 @@ class LogManager : public common::DedicatedThreadOwner {
    */
   void AddBufferToFlushQueue(RecordBufferSegment *buffer_segment, const transaction::TransactionPolicy &policy);
 
+  /**
+   * Register a transaction that is about to take its commit timestamp with the stream of the log its records go to.
+   * This is a no-op if the log is not split into several streams.
+   * @param txn_start start timestamp of the transaction
+   * @return the commit sequence number of the transaction, to be handed back to EndCommit
+   */
+  uint64_t BeginCommit(transaction::timestamp_t txn_start);
+
+  /**
+   * Unregister a transaction once it handed the buffer with its commit record over to the log manager
+   * @param txn_start start timestamp of the transaction
+   * @param commit_sequence the commit sequence number BeginCommit returned for the transaction
+   */
+  void EndCommit(transaction::timestamp_t txn_start, uint64_t commit_sequence);
+
+  /**
+   * @return the persisted commit sequence number, i.e., every commit that BeginCommit handed a lower commit sequence
+   * number is persisted. Only maintained if the log is split into several streams.
+   */
+  uint64_t GetPersistedCommitSequence() const { return persisted_commit_sequence_.load(); }
+
+  /** @return number of streams the log is split into */
+  uint32_t GetNumStreams() const { return static_cast<uint32_t>(streams_.size()); }
+
   /**
    * For testing only
    * @return number of buffers used for logging
@@ -121,8 +152,8 @@ class LogManager : public common::DedicatedThreadOwner {
   uint64_t TestGetNumBuffers() { return num_buffers_; }
 
   /**
-   * Set the number of buffers used for buffering logs. The operation fails if the LogManager has already allocated more
-   * buffers than the new size
+   * Set the number of buffers used for buffering logs. Every stream of the log gets this many buffers. The operation
+   * fails if the LogManager has already allocated more buffers than the new size
    *
    * @param new_num_buffers the new number of buffers the log manager can use
    * @return true if new_num_buffers is successfully set and false the operation fails
@@ -130,9 +161,11 @@ class LogManager : public common::DedicatedThreadOwner {
   bool SetNumBuffers(uint64_t new_num_buffers) {
     if (new_num_buffers >= num_buffers_) {
       // Add in new buffers
-      for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
-        buffers_.emplace_back(log_file_path_.c_str());
-        empty_buffer_queue_->Enqueue(&buffers_[num_buffers_ + i]);
+      for (auto &stream : streams_) {
+        for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
+          stream->buffers_.emplace_back(SegmentPath(stream->log_file_path_, current_segment_).c_str());
+          stream->empty_buffer_queue_->Enqueue(&stream->buffers_[num_buffers_ + i]);
+        }
       }
       num_buffers_ = new_num_buffers;
       return true;
@@ -152,12 +185,94 @@ class LogManager : public common::DedicatedThreadOwner {
   /** Stop performing actions related to replication. Currently works around circular DBMain dependencies. */
   void EndReplication();
 
+  /**
+   * Persist all serialized logs and continue the log in a new segment. The log is made up of consecutively numbered
+   * segments, i.e., log files, and no record spans two segments. This allows the prefix of the log that a checkpoint
+   * covers to be removed.
+   * @warning Blocks serialization until all serialized logs are persisted
+   * @return the number of the new segment, to which all records serialized from now on are written
+   */
+  uint64_t StartNewSegment();
+
+  /**
+   * Delete all segments of the log that are older than the given segment.
+   * @param segment the oldest segment to keep
+   */
+  void RemoveSegmentsBefore(uint64_t segment);
+
+  /**
+   * @param log_file_path path of the log
+   * @param stream number of a stream of the log
+   * @return path of the log file of the given stream. Stream 0 is the log file itself, so that a log that is not split
+   * into streams is written to the same file as before.
+   */
+  static std::string StreamPath(const std::string &log_file_path, uint32_t stream);
+
+  /**
+   * @param log_file_path path of the log
+   * @param num_streams number of streams the log was split into
+   * @return for every stream of the log, the paths of its segments that exist on disk, see SegmentPaths
+   */
+  static std::vector<std::vector<std::string>> StreamSegmentPaths(const std::string &log_file_path,
+                                                                  uint32_t num_streams);
+
+  /**
+   * @param log_file_path path of the log
+   * @param segment number of a segment of the log
+   * @return path of the log file of the given segment. Segment 0 is the log file itself, so that logs that were never
+   * split into segments remain readable.
+   */
+  static std::string SegmentPath(const std::string &log_file_path, uint64_t segment);
+
+  /**
+   * @param log_file_path path of the log
+   * @return the numbers of the segments of the log that exist on disk, in ascending order
+   */
+  static std::vector<uint64_t> ListSegments(const std::string &log_file_path);
+
+  /**
+   * @param log_file_path path of the log
+   * @return the paths of the segments of the log that exist on disk, in the order they should be replayed in
+   */
+  static std::vector<std::string> SegmentPaths(const std::string &log_file_path);
+
  private:
+  friend class DiskLogConsumerTask;
+
+  /**
+   * One stream of the log, with its own buffers, serializer task and consumer task writing to its own log file
+   */
+  struct LogStream {
+    // System path for the log file of this stream
+    std::string log_file_path_;
+    // This stores a reference to all the buffers the serializer or the log consumer threads of this stream use
+    std::vector<BufferedLogWriter> buffers_;
+    // The queue of empty buffers of a stream other than stream 0, which shares its queue with the replication manager
+    std::unique_ptr<common::ConcurrentBlockingQueue<BufferedLogWriter *>> owned_empty_buffer_queue_;
+    // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
+    // serializer thread should block when requesting a new buffer until it receives an empty buffer
+    common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue_;
+    // The queue containing filled buffers pending flush to the disk
+    common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
+    // The queue containing rounds of serialization pending flush to the disk, only used with several streams
+    common::ConcurrentQueue<SerializedRound> serialized_rounds_;
+    // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
+    common::ManagedPointer<LogSerializerTask> log_serializer_task_ = common::ManagedPointer<LogSerializerTask>(nullptr);
+    // The log consumer task which flushes filled buffers to the disk
+    common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_ =
+        common::ManagedPointer<DiskLogConsumerTask>(nullptr);
+    // Every registered commit of this stream below this commit sequence number is persisted. Protected by
+    // persisted_latch_
+    uint64_t persisted_bound_ = 0;
+  };
+
   // Flag to tell us when the log manager is running or during termination
   bool run_log_manager_;
 
   // System path for log file
   std::string log_file_path_;
+  // The segment of the log that is currently written to
+  uint64_t current_segment_ = 0;
 
   // Number of buffers to use for buffering and serializing logs
   uint64_t num_buffers_;
@@ -166,22 +281,20 @@ class LogManager : public common::DedicatedThreadOwner {
   //  (e.g. logs can be streamed out to the network for remote replication)
   RecordBufferSegmentPool *buffer_pool_;
 
-  // This stores a reference to all the buffers the serializer or the log consumer threads use
-  std::vector<BufferedLogWriter> buffers_;
-  // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
-  // serializer thread should block when requesting a new buffer until it receives an empty buffer
-  common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue_;
-  // The queue containing filled buffers pending flush to the disk
-  common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
+  // The streams the log is split into
+  std::vector<std::unique_ptr<LogStream>> streams_;
+
+  // Hands out commit sequence numbers, only used with several streams
+  std::atomic<uint64_t> commit_sequence_ = 0;
+  // Every commit below this commit sequence number is persisted, only maintained with several streams
+  std::atomic<uint64_t> persisted_commit_sequence_ = 0;
+  // Protects the persisted bounds of the streams and waiting_commits_
+  common::SpinLatch persisted_latch_;
+  // Commit callbacks of persisted rounds of serialization, keyed by the horizon of their round
+  std::multimap<uint64_t, std::vector<CommitCallback>> waiting_commits_;
 
-  // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
-  common::ManagedPointer<LogSerializerTask> log_serializer_task_ = common::ManagedPointer<LogSerializerTask>(nullptr);
   // Interval used by log serialization task
   std::chrono::microseconds serialization_interval_;
-
-  // The log consumer task which flushes filled buffers to the disk
-  common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_ =
-      common::ManagedPointer<DiskLogConsumerTask>(nullptr);
   // Interval used by disk consumer task
   const std::chrono::microseconds persist_interval_;
   // Threshold used by disk consumer task
@@ -189,6 +302,20 @@ class LogManager : public common::DedicatedThreadOwner {
 
   common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager_;
 
+  /**
+   * @param txn_start start timestamp of a transaction
+   * @return the stream the records of the transaction go to
+   */
+  LogStream *StreamOf(transaction::timestamp_t txn_start) const;
+
+  /**
+   * Called by the consumer task of a stream once the given rounds of serialization are persisted. Advances the
+   * persisted commit sequence number and invokes the commit callbacks it passed.
+   * @param stream the stream that persisted the rounds
+   * @param rounds the persisted rounds, in the order they were serialized
+   */
+  void RoundsPersisted(uint32_t stream, std::vector<SerializedRound> *rounds);
+
   /**
    * If the central registry wants to removes our thread used for the disk log consumer task, we only allow removal if
    * we are in shut down, else we need to keep the task, so we reject the removal
@@ -409,4 +409,68 @@ class AbortRecord {
   transaction::TimestampManager *timestamp_manager_;
   transaction::TransactionContext *txn_;
 };
+
+/**
+ * Record body that closes a round of serialization of one stream of a log that is split into several streams, see
+ * LogManager. The header is stored in the LogRecord class that would presumably return this object. The commit records
+ * of a stream that precede it and follow the previous RoundRecord belong to its round. Recovery only replays them once
+ * every stream logged a persisted bound at or above the horizon of the round, just like their commits were only
+ * acknowledged then. A round record does not belong to any transaction.
+ */
+class RoundRecord {
+ public:
+  MEM_REINTERPRETATION_ONLY(RoundRecord)
+
+  /**
+   * @return type of record this type of body holds
+   */
+  static constexpr LogRecordType RecordType() { return LogRecordType::ROUND; }
+
+  /**
+   * @return Size of the entire record of this type, in bytes, in memory.
+   */
+  static uint32_t Size() { return static_cast<uint32_t>(sizeof(LogRecord) + sizeof(RoundRecord)); }
+
+  /**
+   * Initialize an entire LogRecord (header included) to have an underlying round record, using the parameters
+   * supplied.
+   *
+   * @param head pointer location to initialize, this is also the returned address (reinterpreted)
+   * @param run identifies the run of the LogManager that serialized the round, as commit sequence numbers of different
+   * runs are not comparable
+   * @param persisted_bound every commit of the stream below this commit sequence number is in this round or an earlier
+   * one
+   * @param horizon every commit in this round has a commit sequence number below the horizon
+   * @return pointer to the initialized log record, always equal in value to the given head
+   */
+  static LogRecord *Initialize(byte *const head, const uint64_t run, const uint64_t persisted_bound,
+                               const uint64_t horizon) {
+    auto *result = LogRecord::InitializeHeader(head, LogRecordType::ROUND, Size(), transaction::INITIAL_TXN_TIMESTAMP);
+    auto *body = result->GetUnderlyingRecordBodyAs<RoundRecord>();
+    body->run_ = run;
+    body->persisted_bound_ = persisted_bound;
+    body->horizon_ = horizon;
+    return result;
+  }
+
+  /**
+   * @return the run of the LogManager that serialized the round
+   */
+  uint64_t Run() const { return run_; }
+
+  /**
+   * @return every commit of the stream below this commit sequence number is in this round or an earlier one
+   */
+  uint64_t PersistedBound() const { return persisted_bound_; }
+
+  /**
+   * @return every commit in this round has a commit sequence number below the horizon
+   */
+  uint64_t Horizon() const { return horizon_; }
+
+ private:
+  uint64_t run_;
+  uint64_t persisted_bound_;
+  uint64_t horizon_;
+};
 }  // namespace noisepage::storage
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>  // NOLINT
+#include <optional>
 #include <queue>
+#include <set>
 #include <thread>  // NOLINT
 #include <tuple>
 #include <unordered_map>
@@ -12,6 +15,7 @@
 #include "common/container/concurrent_queue.h"
 #include "common/dedicated_thread_task.h"
 #include "storage/record_buffer.h"
+#include "storage/storage_util.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "storage/write_ahead_log/log_record.h"
 
@@ -34,13 +38,20 @@ class LogSerializerTask : public common::DedicatedThreadTask {
    * @param filled_buffer_queue         Pointer to queue to push filled buffers to.
    * @param disk_log_writer_thread_cv   Pointer to cvar to notify consumer when a new buffer has handed over.
    * @param primary_replication_manager Pointer to replication manager where to-be-replicated serialized logs are sent.
+   * @param commit_sequence             Pointer to the counter that hands out commit sequence numbers, null if the log
+   *                                    is not split into several streams.
+   * @param serialized_rounds           Pointer to queue to push rounds of serialization to, null if the log is not
+   *                                    split into several streams.
+   * @param run                         Identifies the run of the LogManager in the RoundRecords of this stream.
    */
   explicit LogSerializerTask(
       const std::chrono::microseconds serialization_interval, RecordBufferSegmentPool *buffer_pool,
       common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue,
       common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
       std::condition_variable *disk_log_writer_thread_cv,
-      common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager)
+      common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager,
+      std::atomic<uint64_t> *commit_sequence = nullptr,
+      common::ConcurrentQueue<storage::SerializedRound> *serialized_rounds = nullptr, const uint64_t run = 0)
       : run_task_(false),
         serialization_interval_(serialization_interval),
         buffer_pool_(buffer_pool),
@@ -49,7 +60,10 @@ class LogSerializerTask : public common::DedicatedThreadTask {
         empty_buffer_queue_(empty_buffer_queue),
         filled_buffer_queue_(filled_buffer_queue),
         disk_log_writer_thread_cv_(disk_log_writer_thread_cv),
-        primary_replication_manager_(primary_replication_manager) {}
+        primary_replication_manager_(primary_replication_manager),
+        commit_sequence_(commit_sequence),
+        serialized_rounds_(serialized_rounds),
+        run_(run) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -92,6 +106,140 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   /** Stop performing actions related to replication. Currently works around circular DBMain dependencies. */
   void EndReplication() { notify_oat_ = false; }
 
+  /**
+   * Register a transaction of this stream that is about to take its commit timestamp. Until the transaction has handed
+   * its commit record over to this task and unregistered, the persisted bound of this stream stays below its commit
+   * sequence number.
+   * @return the commit sequence number of the transaction
+   */
+  uint64_t RegisterCommit() {
+    std::unique_lock<std::mutex> guard(flush_queue_latch_);
+    const uint64_t commit_sequence = commit_sequence_->fetch_add(1);
+    registered_commits_.insert(commit_sequence);
+    return commit_sequence;
+  }
+
+  /**
+   * Unregister a transaction once it has handed its commit record over to this task
+   * @param commit_sequence the commit sequence number RegisterCommit returned for the transaction
+   */
+  void UnregisterCommit(const uint64_t commit_sequence) {
+    std::unique_lock<std::mutex> guard(flush_queue_latch_);
+    registered_commits_.erase(registered_commits_.find(commit_sequence));
+  }
+
+  /**
+   * Serialize out the record in the on-disk log format. The serializer writes records to its consumer buffers this
+   * way, and the CheckpointManager writes checkpoints in the same format so that recovery can read both alike.
+   * @tparam WriteFn type of the function that writes out the serialized bytes
+   * @param record the record to serialize
+   * @param write_value function invoked with a pointer to and the number of bytes to write, returning the number of
+   * bytes written
+   * @return bytes serialized, used for metrics
+   */
+  template <class WriteFn>
+  static uint64_t SerializeRecord(const LogRecord &record, const WriteFn &write_value) {
+    const auto write = [&write_value](const auto &val) {
+      return write_value(&val, static_cast<uint32_t>(sizeof(val)));
+    };
+    uint64_t num_bytes = 0;
+    // First, serialize out fields common across all LogRecordType's.
+
+    // Note: This is the in-memory size of the log record itself, i.e. inclusive of padding and not considering the
+    // size of any potential varlen entries. It is logically different from the size of the serialized record, which the
+    // log manager generates in this function. In particular, the later value is very likely to be strictly smaller when
+    // the LogRecordType is REDO. On recovery, the goal is to turn the serialized format back into an in-memory log
+    // record of this size.
+    num_bytes += write(record.Size());
+
+    num_bytes += write(record.RecordType());
+    num_bytes += write(record.TxnBegin());
+
+    switch (record.RecordType()) {
+      case LogRecordType::REDO: {
+        auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
+        num_bytes += write(record_body->GetDatabaseOid());
+        num_bytes += write(record_body->GetTableOid());
+        num_bytes += write(record_body->GetTupleSlot());
+
+        auto *delta = record_body->Delta();
+        // Write out which column ids this redo record is concerned with. On recovery, we can construct the appropriate
+        // ProjectedRowInitializer from these ids and their corresponding block layout.
+        num_bytes += write(delta->NumColumns());
+        num_bytes += write_value(delta->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * delta->NumColumns());
+
+        // Write out the attr sizes boundaries, this way we can deserialize the records without the need of the block
+        // layout
+        const auto &block_layout = record_body->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
+        uint16_t boundaries[NUM_ATTR_BOUNDARIES];
+        memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+        StorageUtil::ComputeAttributeSizeBoundaries(block_layout, delta->ColumnIds(), delta->NumColumns(), boundaries);
+        write_value(boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+
+        // Write out the null bitmap.
+        num_bytes += write_value(&(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
+
+        // Write out attribute values
+        for (uint16_t i = 0; i < delta->NumColumns(); i++) {
+          const auto *column_value_address = delta->AccessWithNullCheck(i);
+          if (column_value_address == nullptr) {
+            // If the column in this REDO record is null, then there's nothing to serialize out. The bitmap contains all
+            // the relevant information.
+            continue;
+          }
+          // Get the column id of the current column in the ProjectedRow.
+          col_id_t col_id = delta->ColumnIds()[i];
+
+          if (block_layout.IsVarlen(col_id)) {
+            // Inline column value is a pointer to a VarlenEntry, so reinterpret as such.
+            const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(column_value_address);
+            // Serialize out length of the varlen entry.
+            num_bytes += write(varlen_entry->Size());
+            if (varlen_entry->IsInlined()) {
+              // Serialize out the prefix of the varlen entry.
+              num_bytes += write_value(varlen_entry->Prefix(), varlen_entry->Size());
+            } else {
+              // Serialize out the content field of the varlen entry.
+              num_bytes += write_value(varlen_entry->Content(), varlen_entry->Size());
+            }
+          } else {
+            // Inline column value is the actual data we want to serialize out.
+            // Note that by writing out AttrSize(col_id) bytes instead of just the difference between successive offsets
+            // of the delta record, we avoid serializing out any potential padding.
+            num_bytes += write_value(column_value_address, block_layout.AttrSize(col_id));
+          }
+        }
+        break;
+      }
+      case LogRecordType::DELETE: {
+        auto *record_body = record.GetUnderlyingRecordBodyAs<DeleteRecord>();
+        num_bytes += write(record_body->GetDatabaseOid());
+        num_bytes += write(record_body->GetTableOid());
+        num_bytes += write(record_body->GetTupleSlot());
+        break;
+      }
+      case LogRecordType::COMMIT: {
+        auto *record_body = record.GetUnderlyingRecordBodyAs<CommitRecord>();
+        num_bytes += write(record_body->CommitTime());
+        num_bytes += write(record_body->OldestActiveTxn());
+        break;
+      }
+      case LogRecordType::ABORT: {
+        // AbortRecord does not hold any additional metadata
+        break;
+      }
+      case LogRecordType::ROUND: {
+        auto *record_body = record.GetUnderlyingRecordBodyAs<RoundRecord>();
+        num_bytes += write(record_body->Run());
+        num_bytes += write(record_body->PersistedBound());
+        num_bytes += write(record_body->Horizon());
+        break;
+      }
+    }
+
+    return num_bytes;
+  }
+
  private:
   friend class LogManager;
   bool run_task_;                                     ///< Flag to signal task to run or stop.
@@ -137,6 +285,19 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   bool oat_replicas_ = false;  ///< True if the replicas may need an update of their OAT.
   bool notify_oat_ = true;     ///< TODO(WAN): A hack to prevent use after free.
 
+  /** Hands out commit sequence numbers to all streams of the log, null if the log is not split into streams. */
+  std::atomic<uint64_t> *commit_sequence_;
+  /** Commit sequence numbers of transactions registered with RegisterCommit. Protected by flush_queue_latch_. */
+  std::multiset<uint64_t> registered_commits_;
+  /** The queue that rounds of serialization are pushed to, null if the log is not split into streams. */
+  common::ConcurrentQueue<SerializedRound> *serialized_rounds_;
+  /** Commit callbacks for commit records serialized in the current round, only used with serialized_rounds_. */
+  std::vector<storage::CommitCallback> commits_in_round_;
+  /** Identifies the run of the LogManager in the RoundRecords of this stream, only used with serialized_rounds_. */
+  uint64_t run_;
+  /** Persisted bound and horizon of the last RoundRecord serialized, if any. */
+  std::optional<std::pair<uint64_t, uint64_t>> logged_round_;
+
   /**
    * Main serialization loop. Calls Process every interval. Processes all the accumulated log records and
    * serializes them to log consumer tasks.
@@ -158,6 +319,20 @@ class LogSerializerTask : public common::DedicatedThreadTask {
    */
   std::tuple<uint64_t, uint64_t, uint64_t> SerializeBuffer(IterableBufferSegment<LogRecord> *buffer_to_serialize);
 
+  /**
+   * Serialize a RoundRecord that closes the current round of serialization to the current serialization buffer
+   * @param persisted_bound every commit of this stream below this commit sequence number is serialized
+   * @param horizon every commit serialized in this round has a commit sequence number below the horizon
+   */
+  void SerializeRoundRecord(uint64_t persisted_bound, uint64_t horizon);
+
+  /**
+   * Serialize the last RoundRecord again and hand it over to the consumer. Used at the start of a new segment of the
+   * log, so that the persisted bound of this stream survives the removal of the older segments.
+   * @warning The caller must hold serialization_latch_
+   */
+  void RepeatRoundRecord();
+
   /**
    * Serialize out the record to the log
    * @param record the redo record to serialise
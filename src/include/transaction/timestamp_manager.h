@@ -1,9 +1,12 @@
 #pragma once
 
 #include <algorithm>
-#include <unordered_set>
+#include <array>
+#include <atomic>
+#include <set>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "transaction/transaction_defs.h"
@@ -15,13 +18,21 @@ class LogSerializerTask;
 
 namespace noisepage::transaction {
 class TransactionManager;
+class TimestampManagerTests_RemoveTransactionsWithBeginningTxn_Test;
 /**
  * Generates timestamps, and keeps track of the lifetime of transactions (whether they have entered or left the system)
  */
 class TimestampManager {
  public:
+  /** The number of shards the set of running transactions is split into. */
+  static constexpr uint32_t NUM_RUNNING_TXN_SHARDS = 64;
+
+  /** The number of slots in which transactions that are beginning announce themselves. */
+  static constexpr uint32_t NUM_BEGIN_SLOTS = 64;
+
   ~TimestampManager() {
-    NOISEPAGE_ASSERT(curr_running_txns_.empty(),
+    NOISEPAGE_ASSERT(std::all_of(running_txns_.begin(), running_txns_.end(),
+                                 [](const RunningTxnShard &shard) { return shard.txns_.empty(); }),
                      "Destroying the TimestampManager while txns are still running. That seems wrong.");
   }
 
@@ -35,53 +46,61 @@ class TimestampManager {
    */
   timestamp_t CurrentTime() const { return time_.load(); }
 
+  /**
+   * Advance the current time to at least the given timestamp. Used on recovery, so that txns begun afterwards are
+   * ordered after everything that was recovered.
+   * @param timestamp the timestamp the current time must not be older than
+   */
+  void AdvanceTime(const timestamp_t timestamp) {
+    timestamp_t current = time_.load();
+    while (current < timestamp && !time_.compare_exchange_weak(current, timestamp)) {
+    }
+  }
+
   /**
    * Get the oldest transaction alive (by start timestamp given out by this timestamp manager at this time)
    * Because of concurrent operations, it is not guaranteed that upon return the txn is still alive. However,
    * it is guaranteed that the return timestamp is older than any transactions live.
-   * @warning If logging is enabled, txns are not removed from the txn set until they are serialized. Thus, the active
-   * txn set can grow greatly in size, making this call expensive. Consider using CachedOldestTransactionStartTime for
-   * better performance at the cost of a more stale timestamp.
+   * This only looks at the oldest txn of every shard of the running txn set and at the txns that are beginning, so
+   * its cost does not depend on the number of running txns, even though txns remain in the set until they are
+   * serialized if logging is enabled.
    * @return timestamp that is older than any transactions alive
    */
   timestamp_t OldestTransactionStartTime();
 
   /**
    * Get the cached timestamp of the oldest active txn. The cached timestamp is only refreshed upon every invocation of
-   * OldestTransactionStartTime, so it may be stale. On the other hand, this function does not require taking a latch or
-   * iterating through the running txns set, making it much cheaper than OldestTransactionStartTime. This has the same
-   * correctness guarantee as OldestTransactionStartTime, but may cause performance degradations for processes that rely
-   * on very fresh oldest txn timestamps
+   * OldestTransactionStartTime, so it may be stale. On the other hand, this function does not require taking any
+   * latches, making it cheaper than OldestTransactionStartTime. This has the same correctness guarantee as
+   * OldestTransactionStartTime, but may cause performance degradations for processes that rely on very fresh oldest
+   * txn timestamps
    * @return timestamp that is older than any transactions alive
    */
   timestamp_t CachedOldestTransactionStartTime();
 
  private:
-  // TransactionManager needs to be able to use the curr_running_txns_latch to guard more than just the
-  // duration of the following method calls --- things such as adding to the GC queue needs to be atomic
-  // along with removing a transaction from the table of active transactions. We need this for correctness
-  // in the deferred action framework when dropping tables.
   friend class TransactionManager;
   friend class storage::LogSerializerTask;
-  timestamp_t BeginTransaction() {
-    timestamp_t start_time;
-    {
-      common::SpinLatch::ScopedSpinLatch running_guard(&curr_running_txns_latch_);
-      // There is a three-way race that needs to be prevented.  Specifically, we
-      // cannot allow both a transaction to commit and the GC to poll for the
-      // oldest running transaction in between this transaction acquiring its
-      // begin timestamp and getting inserted into the current running
-      // transactions list.  Using the current running transactions latch
-      // prevents the GC from polling and stops the race.  This allows us to
-      // replace acquiring a shared instance of the commit latch with a
-      // read-only spin-latch and move the allocation out of a critical section.
-      start_time = time_++;
-
-      const auto ret UNUSED_ATTRIBUTE = curr_running_txns_.emplace(start_time);
-      NOISEPAGE_ASSERT(ret.second, "commit start time should be globally unique");
-    }  // Release latch on current running transactions
-    return start_time;
-  }
+  friend class TimestampManagerTests_RemoveTransactionsWithBeginningTxn_Test;
+
+  // A part of the set of running transactions. Transactions are assigned to shards by their start timestamp, so that
+  // transactions beginning and finishing concurrently rarely contend on the same latch.
+  struct alignas(common::Constants::CACHELINE_SIZE) RunningTxnShard {
+    common::SpinLatch latch_;
+    std::set<timestamp_t> txns_;
+  };
+
+  // A slot in which a transaction that is beginning announces a lower bound of its start timestamp until it has been
+  // inserted into the running transaction set. INVALID_TXN_TIMESTAMP if the slot is free.
+  struct alignas(common::Constants::CACHELINE_SIZE) BeginSlot {
+    std::atomic<timestamp_t> lower_bound_{INVALID_TXN_TIMESTAMP};
+  };
+
+  /**
+   * Check out a start timestamp and add it to the running txn set.
+   * @return the start timestamp of the new txn
+   */
+  timestamp_t BeginTransaction();
 
   /**
    * Remove a timestamp from active txn set
@@ -90,23 +109,25 @@ class TimestampManager {
   void RemoveTransaction(timestamp_t timestamp);
 
   /**
-   * Bulk remove a set of timestamps from the active txn set. Only grabs the curr_running_txns_latch_ once for all the
-   * timestamps.
+   * Bulk remove a set of timestamps from the active txn set. Grabs the latch of every shard at most once.
    * @param timestamps vector of timestamps to remove
-   * @return True if there are no more running transactions after removal. False otherwise.
+   * @return True if there are no more running or beginning transactions after removal. False otherwise.
    */
   bool RemoveTransactions(const std::vector<timestamp_t> &timestamps);
 
+  // The shard of the running txn set the txn with the given start timestamp belongs to.
+  RunningTxnShard &ShardFor(const timestamp_t timestamp) {
+    return running_txns_[timestamp.UnderlyingValue() % NUM_RUNNING_TXN_SHARDS];
+  }
+
   // TODO(Tianyu): Timestamp generation needs to be more efficient (batches)
   // TODO(Tianyu): We don't handle timestamp wrap-arounds. I doubt this would be an issue any time soon.
   std::atomic<timestamp_t> time_{INITIAL_TXN_TIMESTAMP};
   // We cache the oldest txn start time
   std::atomic<timestamp_t> cached_oldest_txn_start_time_{INITIAL_TXN_TIMESTAMP};
-  // TODO(Matt): consider a different data structure if this becomes a measured bottleneck
-  // TODO(Gus): This data structure initially only held items in the order of # of workers. With the logging change, it
-  // can hold many more, since txns are only removed when serialized. We should consider if there is a possible better
-  // data structure
-  std::unordered_set<timestamp_t> curr_running_txns_;
-  mutable common::SpinLatch curr_running_txns_latch_;
+  // The running txns. With logging enabled, txns are only removed once they have been serialized, so this can hold
+  // many more txns than there are workers.
+  std::array<RunningTxnShard, NUM_RUNNING_TXN_SHARDS> running_txns_;
+  std::array<BeginSlot, NUM_BEGIN_SLOTS> begin_slots_;
 };
 }  // namespace noisepage::transaction
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "common/object_pool.h"
+#include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "storage/data_table.h"
 #include "storage/record_buffer.h"
@@ -49,7 +51,9 @@ class TransactionContext {
       : start_time_(start),
         finish_time_(finish),
         undo_buffer_(buffer_pool.Get()),
-        redo_buffer_(log_manager.Get(), buffer_pool.Get()) {}
+        redo_buffer_(log_manager.Get(), buffer_pool.Get()),
+        buffer_pool_(buffer_pool),
+        log_manager_(log_manager) {}
 
   /**
    * @warning In the src/ folder this should only be called by the Garbage Collector to adhere to MVCC semantics. Tests
@@ -229,6 +233,26 @@ class TransactionContext {
   /** @return The transaction-wide policies for this transaction. */
   TransactionPolicy GetTransactionPolicy() const { return {durability_policy_, replication_policy_}; }
 
+  /**
+   * Creates a worker context through which one thread of a parallel operation writes on behalf of this transaction.
+   * The worker has the same timestamps as this transaction, so to the storage layer its writes are this transaction's
+   * writes, but it has its own undo and redo buffers and deferred actions so that workers do not contend with each
+   * other. Everything this transaction has staged so far is logged before anything the worker stages.
+   *
+   * Thread-safe with respect to other calls to BeginWorker() and MergeWorker(), but this transaction must not be
+   * written to directly until all of its workers are merged back.
+   * @return the new worker context
+   */
+  std::unique_ptr<TransactionContext> BeginWorker();
+
+  /**
+   * Merges a worker context created by BeginWorker() back into this transaction, which takes over the worker's undo
+   * records, deferred actions and loose pointers and logs its redo records. If the worker or this transaction
+   * encountered a conflict, this transaction must abort, and the worker's last update is checked for varlens to free.
+   * @param worker the worker context, which must no longer be written to
+   */
+  void MergeWorker(std::unique_ptr<TransactionContext> worker);
+
  private:
   friend class storage::GarbageCollector;
   friend class TransactionManager;
@@ -242,6 +266,11 @@ class TransactionContext {
   std::atomic<timestamp_t> finish_time_;
   storage::UndoBuffer undo_buffer_;
   storage::RedoBuffer redo_buffer_;
+  // Kept around to hand out buffers to workers of parallel operations.
+  const common::ManagedPointer<storage::RecordBufferSegmentPool> buffer_pool_;
+  const common::ManagedPointer<storage::LogManager> log_manager_;
+  // Protects the buffers of this transaction while workers are created and merged.
+  common::SpinLatch workers_latch_;
   // TODO(Tianyu): Maybe not so much of a good idea to do this. Make explicit queue in GC?
   //
   std::vector<const byte *> loose_ptrs_;
@@ -264,6 +293,11 @@ class TransactionContext {
   /** The replication policy controls whether logs must be applied on replicas before commits are invoked. */
   ReplicationPolicy replication_policy_ = ReplicationPolicy::DISABLE;
 
+  /**
+   * Frees any varlen memory of the last update if it was never installed because of a write-write conflict.
+   */
+  void GCLastUpdateOnAbort();
+
   /**
    * @warning This method is ONLY for recovery
    * Copy the log record into the transaction's redo buffer.
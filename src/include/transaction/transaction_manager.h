@@ -104,6 +104,9 @@ class TransactionManager {
   /** @return The default transaction policy. */
   const TransactionPolicy &GetDefaultTransactionPolicy() const { return default_txn_policy_; }
 
+  /** @return The timestamp manager that hands out the timestamps of this transaction manager. */
+  common::ManagedPointer<TimestampManager> GetTimestampManager() const { return timestamp_manager_; }
+
  private:
   const common::ManagedPointer<TimestampManager> timestamp_manager_;
   const common::ManagedPointer<DeferredActionManager> deferred_action_manager_;
@@ -112,6 +115,8 @@ class TransactionManager {
 
   common::Gate txn_gate_;
 
+  // Protects completed_txns_
+  common::SpinLatch completed_txns_latch_;
   TransactionQueue completed_txns_;
   const common::ManagedPointer<storage::LogManager> log_manager_;
 
@@ -133,6 +138,5 @@ class TransactionManager {
 
   void DeallocateInsertedTupleIfVarlen(TransactionContext *txn, storage::UndoRecord *undo,
                                        const storage::TupleAccessStrategy &accessor) const;
-  void GCLastUpdateOnAbort(TransactionContext *txn);
 };
 }  // namespace noisepage::transaction
@@ -47,8 +47,9 @@ void DBMain::ForceShutdown() {
 
 DBMain::~DBMain() { ForceShutdown(); }
 
-DBMain::ExecutionLayer::ExecutionLayer(const std::string &bytecode_handlers_path) {
-  execution::ExecutionUtil::InitTPL(bytecode_handlers_path);
+DBMain::ExecutionLayer::ExecutionLayer(const std::string &bytecode_handlers_path,
+                                       const std::string &jit_object_cache_path) {
+  execution::ExecutionUtil::InitTPL(bytecode_handlers_path, jit_object_cache_path);
 }
 
 DBMain::ExecutionLayer::~ExecutionLayer() { execution::ExecutionUtil::ShutdownTPL(); }
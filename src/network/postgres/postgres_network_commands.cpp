@@ -23,7 +23,8 @@ static Transition FinishSimpleQueryCommand(const common::ManagedPointer<Postgres
 static void ExecutePortal(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
                           const common::ManagedPointer<Portal> portal,
                           const common::ManagedPointer<network::PostgresPacketWriter> out,
-                          const common::ManagedPointer<trafficcop::TrafficCop> t_cop, const bool explicit_txn_block) {
+                          const common::ManagedPointer<trafficcop::TrafficCop> t_cop, const bool explicit_txn_block,
+                          const common::ManagedPointer<SharedPlanCache> shared_plan_cache) {
   trafficcop::TrafficCopResult result;
 
   const auto query_type = portal->GetStatement()->GetQueryType();
@@ -44,6 +45,7 @@ static void ExecutePortal(const common::ManagedPointer<network::ConnectionContex
       connection_ctx->Transaction()->SetMustAbort();
       return;
     }
+    if (shared_plan_cache != nullptr) shared_plan_cache->RegisterDDL(connection_ctx->Transaction());
     if (query_type == network::QueryType::QUERY_CREATE_INDEX) {
       result = t_cop->ExecuteCreateStatement(connection_ctx, physical_plan, query_type);
       result = t_cop->CodegenPhysicalPlan(connection_ctx, out, portal);
@@ -58,6 +60,7 @@ static void ExecutePortal(const common::ManagedPointer<network::ConnectionContex
       connection_ctx->Transaction()->SetMustAbort();
       return;
     }
+    if (shared_plan_cache != nullptr) shared_plan_cache->RegisterDDL(connection_ctx->Transaction());
     result = t_cop->ExecuteDropStatement(connection_ctx, physical_plan, query_type);
   }
 
@@ -190,7 +193,7 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
       }
 
       ExecutePortal(connection, common::ManagedPointer(portal), out, t_cop,
-                    postgres_interpreter->ExplicitTransactionBlock());
+                    postgres_interpreter->ExplicitTransactionBlock(), postgres_interpreter->GetSharedPlanCache());
     } else if (bind_result.type_ == trafficcop::ResultType::NOTICE) {
       NOISEPAGE_ASSERT(std::holds_alternative<common::ErrorData>(bind_result.extra_),
                        "We're expecting a message here.");
@@ -389,6 +392,10 @@ Transition BindCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> i
 
   if (UNLIKELY(NetworkUtil::DDLQueryType(query_type))) {
     statement->ClearCachedObjects();
+  } else if (t_cop->UseQueryCache() && postgres_interpreter->GetSharedPlanCache() != nullptr) {
+    // Drop what DDL invalidated since, and reuse what another connection generated for the same query
+    postgres_interpreter->GetSharedPlanCache()->Lookup(statement, connection->GetDatabaseOid(),
+                                                       connection->Transaction());
   }
 
   // Bind it, plan it
@@ -564,9 +571,13 @@ Transition ExecuteCommand::Exec(const common::ManagedPointer<ProtocolInterpreter
   }
 
   if (portal->OptimizeResult() != nullptr) {
-    ExecutePortal(connection, portal, out, t_cop, postgres_interpreter->ExplicitTransactionBlock());
+    const auto shared_plan_cache = postgres_interpreter->GetSharedPlanCache();
+    ExecutePortal(connection, portal, out, t_cop, postgres_interpreter->ExplicitTransactionBlock(), shared_plan_cache);
     if (connection->TransactionState() == NetworkTransactionStateType::FAIL) {
       postgres_interpreter->SetWaitingForSync();
+    } else if (NetworkUtil::DMLQueryType(query_type) && t_cop->UseQueryCache() && shared_plan_cache != nullptr) {
+      // Let other connections reuse the plan and generated code
+      shared_plan_cache->Add(statement, connection->GetDatabaseOid(), connection->Transaction());
     }
   } else {
     // This happens in the event of a noop generated earlier (like in binding with an IF EXISTS);
@@ -0,0 +1,89 @@
+#include "network/postgres/shared_plan_cache.h"
+
+#include <algorithm>
+
+#include "common/hash_util.h"
+#include "transaction/transaction_context.h"
+
+namespace noisepage::network {
+
+std::size_t SharedPlanCache::KeyHasher::operator()(const Key &key) const {
+  auto hash = common::HashUtil::Hash(key.query_text_);
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(key.db_oid_.UnderlyingValue()));
+  for (const auto type : key.param_types_) {
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(static_cast<uint8_t>(type)));
+  }
+  return hash;
+}
+
+bool SharedPlanCache::Usable(const common::ManagedPointer<transaction::TransactionContext> txn) const {
+  // A transaction that started before the last DDL committed reads an older catalog than the entries are built for.
+  return max_size_ > 0 && pending_ddl_ == 0 && txn->StartTime() > last_ddl_commit_;
+}
+
+bool SharedPlanCache::Lookup(const common::ManagedPointer<Statement> statement, const catalog::db_oid_t db_oid,
+                             const common::ManagedPointer<transaction::TransactionContext> txn) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (statement->OptimizeResult() != nullptr) {
+    if (statement->PlanCacheVersion() == version_) return false;
+    // a DDL statement ran since this Statement was optimized, so its cached objects may no longer be valid
+    statement->ClearCachedObjects();
+  }
+  // Whatever the Statement generates from here on is generated under the current version
+  statement->SetPlanCacheVersion(version_);
+  if (!Usable(txn)) return false;
+
+  const auto it = index_.find({statement->GetQueryText(), statement->ParamTypes(), db_oid});
+  if (it == index_.end()) return false;
+
+  const auto &entry = *(it->second);
+  statement->ShareCachedObjects(entry.optimize_result_, entry.executable_query_, entry.desired_param_types_);
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return true;
+}
+
+void SharedPlanCache::Add(const common::ManagedPointer<Statement> statement, const catalog::db_oid_t db_oid,
+                          const common::ManagedPointer<transaction::TransactionContext> txn) {
+  NOISEPAGE_ASSERT(statement->OptimizeResult() != nullptr && statement->GetExecutableQuery() != nullptr,
+                   "Only Statements that have been optimized and compiled can be shared.");
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (!Usable(txn) || statement->PlanCacheVersion() != version_) return;
+
+  Key key{statement->GetQueryText(), statement->ParamTypes(), db_oid};
+  if (index_.find(key) != index_.end()) return;
+
+  entries_.push_front({key, statement->SharedOptimizeResult(), statement->SharedExecutableQuery(),
+                       statement->GetDesiredParamTypes()});
+  index_.emplace(std::move(key), entries_.begin());
+  while (entries_.size() > max_size_) {
+    index_.erase(entries_.back().key_);
+    entries_.pop_back();
+  }
+}
+
+void SharedPlanCache::RegisterDDL(const common::ManagedPointer<transaction::TransactionContext> txn) {
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    pending_ddl_++;
+    version_++;
+    index_.clear();
+    entries_.clear();
+  }
+
+  // Actions run after the transaction's finish time is set.
+  const auto *const ddl_txn = txn.Get();
+  txn->RegisterCommitAction([this, ddl_txn]() {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    pending_ddl_--;
+    version_++;
+    last_ddl_commit_ = std::max(last_ddl_commit_, ddl_txn->FinishTime());
+  });
+  // Statements optimized within the aborted transaction saw its catalog changes, so they are invalidated as well.
+  txn->RegisterAbortAction([this]() {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    pending_ddl_--;
+    version_++;
+  });
+}
+
+}  // namespace noisepage::network
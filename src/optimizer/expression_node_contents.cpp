@@ -74,15 +74,17 @@ common::ManagedPointer<parser::AbstractExpression> ExpressionNodeContents::CopyW
     case parser::ExpressionType::AGGREGATE_MAX:
     case parser::ExpressionType::AGGREGATE_AVG:
     case parser::ExpressionType::AGGREGATE_TOP_K:
-    case parser::ExpressionType::AGGREGATE_HISTOGRAM: {
+    case parser::ExpressionType::AGGREGATE_HISTOGRAM:
+    case parser::ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT:
+    case parser::ExpressionType::AGGREGATE_APPROX_PERCENTILE: {
       // Unfortunately, the aggregate expression (also applies to function) may
       // already have extra state information created due to the binder.
       // Under noisepage's design, we decide to just copy() the node and then
       // install the child.
       auto expr_copy = expr_->Copy();
-      if (children.size() == 1) {
-        // If we updated the child, install the child
-        expr_copy->SetChild(0, common::ManagedPointer<parser::AbstractExpression>(children[0]));
+      // If we updated the children, install the children
+      for (size_t i = 0; i < children.size(); i++) {
+        expr_copy->SetChild(i, common::ManagedPointer<parser::AbstractExpression>(children[i]));
       }
       result = common::ManagedPointer<parser::AbstractExpression>(expr_copy.release());
       break;
@@ -129,7 +129,9 @@ JSONDeserializeExprIntermediate DeserializeExpression(const nlohmann::json &j) {
     case ExpressionType::AGGREGATE_MAX:
     case ExpressionType::AGGREGATE_AVG:
     case ExpressionType::AGGREGATE_TOP_K:
-    case ExpressionType::AGGREGATE_HISTOGRAM: {
+    case ExpressionType::AGGREGATE_HISTOGRAM:
+    case ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT:
+    case ExpressionType::AGGREGATE_APPROX_PERCENTILE: {
       expr = std::make_unique<AggregateExpression>();
       break;
     }
@@ -26,6 +26,7 @@ void AggregateExpression::DeriveReturnValueType() {
   auto expr_type = this->GetExpressionType();
   switch (expr_type) {
     case ExpressionType::AGGREGATE_COUNT:
+    case ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT:
       this->SetReturnValueType(type::TypeId::INTEGER);
       break;
     // keep the type of the base
@@ -37,6 +38,7 @@ void AggregateExpression::DeriveReturnValueType() {
       this->SetReturnValueType(this->GetChild(0)->GetReturnValueType());
       break;
     case ExpressionType::AGGREGATE_AVG:
+    case ExpressionType::AGGREGATE_APPROX_PERCENTILE:
       this->SetReturnValueType(type::TypeId::REAL);
       break;
     case ExpressionType::AGGREGATE_TOP_K:
@@ -82,6 +84,8 @@ bool AggregateExpression::RequiresCleanup() const {
       return false;
     case ExpressionType::AGGREGATE_TOP_K:
     case ExpressionType::AGGREGATE_HISTOGRAM:
+    case ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT:
+    case ExpressionType::AGGREGATE_APPROX_PERCENTILE:
       return true;
     default:
       throw PARSER_EXCEPTION(fmt::format("Not a valid aggregation expression type: %d", static_cast<int>(expr_type)));
@@ -30,6 +30,8 @@ std::string ExpressionTypeToShortString(ExpressionType type) {
     case ExpressionType::AGGREGATE_AVG:                     return "AVG";
     case ExpressionType::AGGREGATE_TOP_K:                   return "TOP_K";
     case ExpressionType::AGGREGATE_HISTOGRAM:               return "HISTOGRAM";
+    case ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT:   return "APPROX_COUNT_DISTINCT";
+    case ExpressionType::AGGREGATE_APPROX_PERCENTILE:       return "APPROX_PERCENTILE";
     default: return ExpressionTypeToString(type);
       // clang-format on
   }
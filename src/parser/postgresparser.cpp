@@ -365,6 +365,12 @@ ExpressionType PostgresParser::StringToExpressionType(const std::string &parser_
   if (str == "AGGREGATE_HISTOGRAM") {
     return ExpressionType::AGGREGATE_HISTOGRAM;
   }
+  if (str == "AGGREGATE_APPROX_COUNT_DISTINCT") {
+    return ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT;
+  }
+  if (str == "AGGREGATE_APPROX_PERCENTILE") {
+    return ExpressionType::AGGREGATE_APPROX_PERCENTILE;
+  }
   if (str == "FUNCTION") {
     return ExpressionType::FUNCTION;
   }
@@ -623,6 +629,10 @@ std::unique_ptr<AbstractExpression> PostgresParser::FuncCallTransform(ParseResul
   } else {
     // aggregate function
     auto agg_fun_type = StringToExpressionType("AGGREGATE_" + func_name);
+    if (agg_fun_type == ExpressionType::AGGREGATE_APPROX_PERCENTILE &&
+        (root->agg_star_ || root->args_ == nullptr || root->args_->length != 2)) {
+      throw PARSER_EXCEPTION("FuncCallTransform: APPROX_PERCENTILE requires a column and a percentile");
+    }
     std::vector<std::unique_ptr<AbstractExpression>> children;
     if (root->agg_star_) {
       auto child = new StarExpression();
@@ -633,6 +643,39 @@ std::unique_ptr<AbstractExpression> PostgresParser::FuncCallTransform(ParseResul
       auto child = ExprTransform(parse_result, expr_node, nullptr);
       children.emplace_back(std::move(child));
       result = std::make_unique<AggregateExpression>(agg_fun_type, std::move(children), root->agg_distinct_);
+    } else if (agg_fun_type == ExpressionType::AGGREGATE_APPROX_PERCENTILE) {
+      // APPROX_PERCENTILE(col, percentile) takes the percentile to compute as a constant in [0, 1]
+      auto expr_node = reinterpret_cast<Node *>(root->args_->head->data.ptr_value);
+      children.emplace_back(ExprTransform(parse_result, expr_node, nullptr));
+      auto percentile_node = reinterpret_cast<Node *>(root->args_->tail->data.ptr_value);
+      auto percentile = ExprTransform(parse_result, percentile_node, nullptr);
+      if (percentile->GetExpressionType() != ExpressionType::VALUE_CONSTANT) {
+        throw PARSER_EXCEPTION("FuncCallTransform: APPROX_PERCENTILE requires a constant percentile");
+      }
+      const auto &constant = *common::ManagedPointer(percentile).CastManagedPointerTo<ConstantValueExpression>();
+      if (constant.IsNull()) {
+        throw PARSER_EXCEPTION("FuncCallTransform: APPROX_PERCENTILE requires a non-NULL percentile");
+      }
+      double percentile_val;
+      switch (constant.GetReturnValueType()) {
+        case type::TypeId::TINYINT:
+        case type::TypeId::SMALLINT:
+        case type::TypeId::INTEGER:
+        case type::TypeId::BIGINT:
+          percentile_val = static_cast<double>(constant.Peek<int64_t>());
+          break;
+        case type::TypeId::REAL:
+          percentile_val = constant.Peek<double>();
+          break;
+        default:
+          throw PARSER_EXCEPTION("FuncCallTransform: APPROX_PERCENTILE requires a numeric percentile");
+      }
+      if (percentile_val < 0.0 || percentile_val > 1.0) {
+        throw PARSER_EXCEPTION("FuncCallTransform: APPROX_PERCENTILE requires a percentile between 0 and 1");
+      }
+      children.emplace_back(
+          std::make_unique<ConstantValueExpression>(type::TypeId::REAL, execution::sql::Real(percentile_val)));
+      result = std::make_unique<AggregateExpression>(agg_fun_type, std::move(children), root->agg_distinct_);
     } else {
       PARSER_LOG_DEBUG("FuncCallTransform: Aggregation over multiple cols not supported");
       throw PARSER_EXCEPTION("FuncCallTransform: Aggregation over multiple cols not supported");
@@ -1,6 +1,7 @@
 #include "storage/block_compactor.h"
 
 #include <algorithm>
+#include <limits>
 #include <queue>
 #include <unordered_map>
 #include <utility>
@@ -11,6 +12,22 @@
 #include "transaction/transaction_util.h"
 
 namespace noisepage::storage {
+
+namespace {
+
+template <typename T>
+void ComputeMinMax(const byte *values, common::RawConcurrentBitmap *column_bitmap, uint32_t num_records,
+                   int64_t *min, int64_t *max) {
+  const auto *typed_values = reinterpret_cast<const T *>(values);
+  for (uint32_t i = 0; i < num_records; i++) {
+    if (!column_bitmap->Test(i)) continue;
+    *min = std::min<int64_t>(*min, typed_values[i]);
+    *max = std::max<int64_t>(*max, typed_values[i]);
+  }
+}
+
+}  // namespace
+
 void BlockCompactor::ProcessCompactionQueue(transaction::DeferredActionManager *deferred_action_manager,
                                             transaction::TransactionManager *txn_manager) {
   std::queue<RawBlock *> to_process = std::move(compaction_queue_);
@@ -248,6 +265,8 @@ void BlockCompactor::GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlo
       // Only need to count null for non-varlens
       for (uint32_t i = 0; i < metadata.NumRecords(); i++)
         if (!column_bitmap->Test(i)) metadata.NullCount(col_id)++;
+      ArrowColumnInfo &col_info = metadata.GetColumnInfo(layout, col_id);
+      BuildZoneMap(metadata, column_bitmap, &col_info, accessor.ColumnStart(block, col_id), layout.AttrSize(col_id));
       continue;
     }
 
@@ -366,4 +385,32 @@ void BlockCompactor::BuildDictionary(std::vector<const byte *> *loose_ptrs, Arro
   *col = std::move(new_col_info);
 }
 
+void BlockCompactor::BuildZoneMap(const ArrowBlockMetadata &metadata, common::RawConcurrentBitmap *column_bitmap,
+                                  ArrowColumnInfo *col, const byte *values, uint16_t attr_size) {
+  // An all-null column ends up with min > max, which no range can overlap.
+  int64_t min = std::numeric_limits<int64_t>::max(), max = std::numeric_limits<int64_t>::min();
+  switch (attr_size) {
+    case sizeof(int8_t):
+      ComputeMinMax<int8_t>(values, column_bitmap, metadata.NumRecords(), &min, &max);
+      break;
+    case sizeof(int16_t):
+      ComputeMinMax<int16_t>(values, column_bitmap, metadata.NumRecords(), &min, &max);
+      break;
+    case sizeof(int32_t):
+      ComputeMinMax<int32_t>(values, column_bitmap, metadata.NumRecords(), &min, &max);
+      break;
+    case sizeof(int64_t):
+      ComputeMinMax<int64_t>(values, column_bitmap, metadata.NumRecords(), &min, &max);
+      break;
+    default:
+      // Wider attributes (e.g. decimals) do not get a zone map.
+      col->HasZoneMap() = false;
+      return;
+  }
+  col->ZoneMapMin() = min;
+  col->ZoneMapMax() = max;
+  // Readers only trust the zone map once the block is frozen, which happens after this write.
+  col->HasZoneMap() = true;
+}
+
 }  // namespace noisepage::storage
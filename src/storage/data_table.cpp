@@ -75,13 +75,39 @@ void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContex
   out_buffer->Reset(filled);
 }
 
+bool DataTable::BlockMayContainRange(const uint32_t block_idx, const col_id_t col_id, const int64_t low,
+                                     const int64_t high) const {
+  NOISEPAGE_ASSERT(block_idx < blocks_size_, "block index out of range");
+  NOISEPAGE_ASSERT(!accessor_.GetBlockLayout().IsVarlen(col_id), "zone maps only exist for fixed-length columns");
+  RawBlock *block;
+  {
+    common::SharedLatch::ScopedSharedLatch latch(&blocks_latch_);
+    block = blocks_[block_idx];
+  }
+  // Zone maps are only maintained while the block is frozen. A transaction that modifies the block after this check
+  // commits after the calling reader has started, so the reader does not see the new values anyway.
+  if (block->controller_.GetBlockState()->load() != BlockState::FROZEN) return true;
+  const ArrowColumnInfo &col_info = accessor_.GetArrowBlockMetadata(block).GetColumnInfo(GetBlockLayout(), col_id);
+  if (!col_info.HasZoneMap()) return true;
+  return col_info.ZoneMapMin() <= high && low <= col_info.ZoneMapMax();
+}
+
+const ArrowColumnInfo *DataTable::GetFrozenDictionary(RawBlock *const block, const col_id_t col_id) const {
+  NOISEPAGE_ASSERT(accessor_.GetBlockLayout().IsVarlen(col_id), "only varlen columns can be dictionary-compressed");
+  if (block->controller_.GetBlockState()->load() != BlockState::FROZEN) return nullptr;
+  const ArrowColumnInfo &col_info = accessor_.GetArrowBlockMetadata(block).GetColumnInfo(GetBlockLayout(), col_id);
+  if (col_info.Type() != ArrowColumnType::DICTIONARY_COMPRESSED) return nullptr;
+  return &col_info;
+}
+
 bool DataTable::Update(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot,
                        const ProjectedRow &redo) {
   NOISEPAGE_ASSERT(redo.NumColumns() <= accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
                    "The input buffer cannot change the reserved columns, so it should have fewer attributes.");
   NOISEPAGE_ASSERT(redo.NumColumns() > 0, "The input buffer should modify at least one attribute.");
   UndoRecord *const undo = txn->UndoRecordForUpdate(this, slot, redo);
-  slot.GetBlock()->controller_.WaitUntilHot();
+  if (slot.GetBlock()->controller_.WaitUntilHot())
+    accessor_.GetArrowBlockMetadata(slot.GetBlock()).InvalidateZoneMaps(accessor_.GetBlockLayout());
   UndoRecord *version_ptr;
   do {
     version_ptr = AtomicallyReadVersionPtr(slot, accessor_);
@@ -200,7 +226,8 @@ void DataTable::InsertInto(const common::ManagedPointer<transaction::Transaction
 
 bool DataTable::Delete(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot) {
   UndoRecord *const undo = txn->UndoRecordForDelete(this, slot);
-  slot.GetBlock()->controller_.WaitUntilHot();
+  if (slot.GetBlock()->controller_.WaitUntilHot())
+    accessor_.GetArrowBlockMetadata(slot.GetBlock()).InvalidateZoneMaps(accessor_.GetBlockLayout());
   UndoRecord *version_ptr;
   do {
     version_ptr = AtomicallyReadVersionPtr(slot, accessor_);
@@ -2,9 +2,12 @@
 
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/macros.h"
+#include "common/resource_tracker.h"
 #include "common/thread_context.h"
+#include "common/worker_pool.h"
 #include "loggers/storage_logger.h"
 #include "metrics/metrics_store.h"
 #include "storage/access_observer.h"
@@ -18,17 +21,43 @@
 
 namespace noisepage::storage {
 
+struct GarbageCollector::UnlinkPartition {
+  // The UndoRecords in the blocks of the worker, each with whether its txn aborted, in the order of the txns
+  std::vector<std::pair<UndoRecord *, bool>> undo_records_;
+  // Varlen buffers that can be freed once the processed txns are deallocated
+  std::vector<const byte *> loose_ptrs_;
+  // Blocks written by the processed UndoRecords, reported to the access observer afterwards
+  std::vector<RawBlock *> observed_blocks_;
+  // Number of UndoRecords processed
+  uint32_t buffer_processed_ = 0;
+  // Resources used by the worker, only tracked with GC metrics enabled
+  common::ResourceTracker::Metrics resource_metrics_;
+};
+
 GarbageCollector::GarbageCollector(
     const common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
     const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer)
+    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+    const uint32_t num_workers)
     : timestamp_manager_(timestamp_manager),
       deferred_action_manager_(deferred_action_manager),
       txn_manager_(txn_manager),
       observer_(observer),
-      last_unlinked_{0} {
+      last_unlinked_{0},
+      num_workers_(num_workers) {
   NOISEPAGE_ASSERT(txn_manager_->GCEnabled(),
                    "The TransactionManager needs to be instantiated with gc_enabled true for GC to work!");
+  NOISEPAGE_ASSERT(num_workers_ > 0, "The GC needs at least one worker");
+  if (num_workers_ > 1) {
+    worker_pool_ = std::make_unique<common::WorkerPool>(num_workers_, common::TaskQueue{});
+    worker_pool_->Startup();
+  }
+}
+
+GarbageCollector::~GarbageCollector() {
+  NOISEPAGE_ASSERT(txns_to_deallocate_.empty(), "Not all txns have been deallocated");
+  NOISEPAGE_ASSERT(txns_to_unlink_.empty(), "Not all txns have been unlinked");
+  if (worker_pool_ != nullptr) worker_pool_->Shutdown();
 }
 
 std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
@@ -42,7 +71,7 @@ std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
   uint32_t txns_deallocated = ProcessDeallocateQueue(oldest_txn);
   STORAGE_LOG_TRACE("GarbageCollector::PerformGarbageCollection(): txns_deallocated: {}", txns_deallocated);
   uint32_t txns_unlinked, buffer_unlinked, readonly_unlinked;
-  std::tie(txns_unlinked, buffer_unlinked, readonly_unlinked) = ProcessUnlinkQueue(oldest_txn);
+  std::tie(txns_unlinked, buffer_unlinked, readonly_unlinked) = ProcessUnlinkQueue(oldest_txn, gc_metrics_enabled);
   STORAGE_LOG_TRACE("GarbageCollector::PerformGarbageCollection(): txns_unlinked: {}", txns_unlinked);
   if (txns_unlinked > 0) {
     // Only update this field if we actually unlinked anything, otherwise we're being too conservative about when it's
@@ -85,7 +114,8 @@ uint32_t GarbageCollector::ProcessDeallocateQueue(transaction::timestamp_t oldes
   return txns_processed;
 }
 
-std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(transaction::timestamp_t oldest_txn) {
+std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(transaction::timestamp_t oldest_txn,
+                                                                              const bool gc_metrics_enabled) {
   transaction::TransactionContext *txn = nullptr;
 
   // Get the completed transactions from the TransactionManager
@@ -98,6 +128,8 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
   uint32_t txns_processed = 0, buffer_processed = 0, readonly_processed = 0;
   // Certain transactions might not be yet safe to gc. Need to requeue them
   transaction::TransactionQueue requeue;
+  // Transactions that are safe to unlink, only collected when unlinking in parallel
+  std::vector<transaction::TransactionContext *> txns_to_process;
   // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
   // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
   // wasteful traversals of the version chain.
@@ -115,21 +147,25 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
       readonly_processed++;
     } else if (transaction::TransactionUtil::NewerThan(oldest_txn, txn->FinishTime())) {
       // Safe to garbage collect.
-      for (auto &undo_record : txn->undo_buffer_) {
-        // It is possible for the table field to be null, for aborted transaction's last conflicting record
-        DataTable *&table = undo_record.Table();
-        // Each version chain needs to be traversed and truncated at most once every GC period. Check
-        // if we have already visited this tuple slot; if not, proceed to prune the version chain.
-        if (table != nullptr && visited_slots.insert(undo_record.Slot()).second)
-          TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
-        // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
-        // unless the transaction is aborted, and the record holds a version that is still visible.
-        if (!txn->Aborted()) {
-          ReclaimBufferIfVarlen(txn, &undo_record);
-          ReclaimSlotIfDeleted(&undo_record);
+      if (worker_pool_ != nullptr) {
+        txns_to_process.push_back(txn);
+      } else {
+        for (auto &undo_record : txn->undo_buffer_) {
+          // It is possible for the table field to be null, for aborted transaction's last conflicting record
+          DataTable *&table = undo_record.Table();
+          // Each version chain needs to be traversed and truncated at most once every GC period. Check
+          // if we have already visited this tuple slot; if not, proceed to prune the version chain.
+          if (table != nullptr && visited_slots.insert(undo_record.Slot()).second)
+            TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
+          // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to
+          // varlens, unless the transaction is aborted, and the record holds a version that is still visible.
+          if (!txn->Aborted()) {
+            ReclaimBufferIfVarlen(&txn->loose_ptrs_, &undo_record);
+            ReclaimSlotIfDeleted(&undo_record);
+          }
+          if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
+          buffer_processed++;
         }
-        if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
-        buffer_processed++;
       }
       txns_to_deallocate_.push_front(txn);
       txns_processed++;
@@ -139,12 +175,72 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
     }
   }
 
+  if (!txns_to_process.empty()) buffer_processed += UnlinkInParallel(txns_to_process, oldest_txn, gc_metrics_enabled);
+
   // Requeue any txns that we were still visible to running transactions
   txns_to_unlink_ = transaction::TransactionQueue(std::move(requeue));
 
   return std::make_tuple(txns_processed, buffer_processed, readonly_processed);
 }
 
+uint32_t GarbageCollector::UnlinkInParallel(const std::vector<transaction::TransactionContext *> &txns,
+                                            const transaction::timestamp_t oldest_txn, const bool gc_metrics_enabled) {
+  // Hand every worker only the UndoRecords in its own blocks, so that the workers don't all scan every record.
+  std::vector<UnlinkPartition> partitions(num_workers_);
+  for (auto *const txn : txns) {
+    for (auto &undo_record : txn->undo_buffer_)
+      partitions[WorkerOf(undo_record.Slot().GetBlock())].undo_records_.emplace_back(&undo_record, txn->Aborted());
+  }
+  for (uint32_t worker = 0; worker < num_workers_; worker++) {
+    if (partitions[worker].undo_records_.empty()) continue;
+    worker_pool_->SubmitTask([this, worker, oldest_txn, gc_metrics_enabled, &partitions] {
+      if (gc_metrics_enabled) common::thread_context.resource_tracker_.Start();
+      UnlinkPartitionOf(oldest_txn, &partitions[worker]);
+      if (gc_metrics_enabled) {
+        common::thread_context.resource_tracker_.Stop();
+        partitions[worker].resource_metrics_ = common::thread_context.resource_tracker_.GetMetrics();
+      }
+    });
+  }
+  worker_pool_->WaitUntilAllFinished();
+
+  // The txns of this pass are deallocated together, so the varlens they no longer reference can be handed to any one
+  // of them.
+  auto &loose_ptrs = txns.front()->loose_ptrs_;
+  uint32_t buffer_processed = 0;
+  for (uint32_t worker = 0; worker < num_workers_; worker++) {
+    auto &partition = partitions[worker];
+    loose_ptrs.insert(loose_ptrs.end(), partition.loose_ptrs_.begin(), partition.loose_ptrs_.end());
+    if (observer_ != nullptr) {
+      for (auto *const block : partition.observed_blocks_) observer_->ObserveWrite(block);
+    }
+    buffer_processed += partition.buffer_processed_;
+    if (gc_metrics_enabled) {
+      common::thread_context.metrics_store_->RecordGCWorkerData(worker, num_workers_, partition.buffer_processed_,
+                                                                partition.resource_metrics_);
+    }
+  }
+  return buffer_processed;
+}
+
+void GarbageCollector::UnlinkPartitionOf(const transaction::timestamp_t oldest_txn,
+                                         UnlinkPartition *const partition) const {
+  // Every version chain belongs to exactly one worker, so each worker can keep its own set of truncated chains.
+  std::unordered_set<TupleSlot> visited_slots;
+  for (const auto &[undo_record, aborted] : partition->undo_records_) {
+    // It is possible for the table field to be null, for aborted transaction's last conflicting record
+    DataTable *&table = undo_record->Table();
+    if (table != nullptr && visited_slots.insert(undo_record->Slot()).second)
+      TruncateVersionChain(table, undo_record->Slot(), oldest_txn);
+    if (!aborted) {
+      ReclaimBufferIfVarlen(&partition->loose_ptrs_, undo_record);
+      ReclaimSlotIfDeleted(undo_record);
+    }
+    if (observer_ != nullptr) partition->observed_blocks_.push_back(undo_record->Slot().GetBlock());
+    partition->buffer_processed_++;
+  }
+}
+
 void GarbageCollector::ProcessDeferredActions(transaction::timestamp_t oldest_txn) {
   if (deferred_action_manager_ != DISABLED) {
     // TODO(Tianyu): Eventually we will remove the GC and implement version chain pruning with deferred actions
@@ -198,7 +294,7 @@ void GarbageCollector::ReclaimSlotIfDeleted(UndoRecord *const undo_record) const
   if (undo_record->Type() == DeltaRecordType::DELETE) undo_record->Table()->accessor_.Deallocate(undo_record->Slot());
 }
 
-void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *const txn,
+void GarbageCollector::ReclaimBufferIfVarlen(std::vector<const byte *> *const loose_ptrs,
                                              UndoRecord *const undo_record) const {
   const TupleAccessStrategy &accessor = undo_record->Table()->accessor_;
   const BlockLayout &layout = accessor.GetBlockLayout();
@@ -212,7 +308,7 @@ void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *co
         // Okay to include version vector, as it is never varlen
         if (layout.IsVarlen(col_id)) {
           auto *varlen = reinterpret_cast<VarlenEntry *>(accessor.AccessWithNullCheck(undo_record->Slot(), col_id));
-          if (varlen != nullptr && varlen->NeedReclaim()) txn->loose_ptrs_.push_back(varlen->Content());
+          if (varlen != nullptr && varlen->NeedReclaim()) loose_ptrs->push_back(varlen->Content());
         }
       }
       break;
@@ -222,7 +318,7 @@ void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *co
         col_id_t col_id = undo_record->Delta()->ColumnIds()[i];
         if (layout.IsVarlen(col_id)) {
           auto *varlen = reinterpret_cast<VarlenEntry *>(undo_record->Delta()->AccessWithNullCheck(i));
-          if (varlen != nullptr && varlen->NeedReclaim()) txn->loose_ptrs_.push_back(varlen->Content());
+          if (varlen != nullptr && varlen->NeedReclaim()) loose_ptrs->push_back(varlen->Content());
         }
       }
       break;
@@ -247,7 +343,13 @@ void GarbageCollector::UnregisterIndexForGC(const common::ManagedPointer<index::
 
 void GarbageCollector::ProcessIndexes() {
   common::SharedLatch::ScopedSharedLatch guard(&indexes_latch_);
-  for (const auto &index : indexes_) index->PerformGarbageCollection();
+  if (worker_pool_ == nullptr) {
+    for (const auto &index : indexes_) index->PerformGarbageCollection();
+    return;
+  }
+  // Every index is collected by a single worker, so indexes don't need to support concurrent garbage collection.
+  for (const auto &index : indexes_) worker_pool_->SubmitTask([index] { index->PerformGarbageCollection(); });
+  worker_pool_->WaitUntilAllFinished();
 }
 
 }  // namespace noisepage::storage
@@ -121,6 +121,19 @@ void BPlusTreeIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn
                    "Invalid number of results for unique index.");
 }
 
+template <typename KeyType>
+void BPlusTreeIndex<KeyType>::ScanKeyBatch(const transaction::TransactionContext &txn, const ProjectedRow *const *keys,
+                                           const uint32_t num_keys, const bool sort_keys,
+                                           std::vector<TupleSlot> *value_list, std::vector<uint32_t> *key_ends) {
+  const auto lookup = [this](const KeyType &index_key, std::vector<TupleSlot> *results) {
+    bplustree_->FindValueOfKey(index_key, results);
+  };
+  ScanKeyBatchImpl<KeyType>(txn, keys, num_keys, sort_keys, lookup, value_list, key_ends);
+
+  NOISEPAGE_ASSERT(!(metadata_.GetSchema().Unique()) || value_list->size() <= num_keys,
+                   "Invalid number of results for unique index.");
+}
+
 template <typename KeyType>
 void BPlusTreeIndex<KeyType>::ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type,
                                             uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
@@ -153,6 +153,22 @@ void BwTreeIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn, c
                    "Invalid number of results for unique index.");
 }
 
+template <typename KeyType>
+void BwTreeIndex<KeyType>::ScanKeyBatch(const transaction::TransactionContext &txn, const ProjectedRow *const *keys,
+                                        const uint32_t num_keys, const bool sort_keys,
+                                        std::vector<TupleSlot> *value_list, std::vector<uint32_t> *key_ends) {
+  std::vector<TupleSlot> key_results;
+  const auto lookup = [this, &key_results](const KeyType &index_key, std::vector<TupleSlot> *results) {
+    key_results.clear();
+    bwtree_->GetValue(index_key, key_results);
+    results->insert(results->end(), key_results.begin(), key_results.end());
+  };
+  ScanKeyBatchImpl<KeyType>(txn, keys, num_keys, sort_keys, lookup, value_list, key_ends);
+
+  NOISEPAGE_ASSERT(!(metadata_.GetSchema().Unique()) || value_list->size() <= num_keys,
+                   "Invalid number of results for unique index.");
+}
+
 template <typename KeyType>
 void BwTreeIndex<KeyType>::ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type,
                                          uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
@@ -14,6 +14,13 @@ byte *UndoBuffer::NewEntry(const uint32_t size) {
   return last_record_;
 }
 
+void UndoBuffer::Append(UndoBuffer *const other) {
+  NOISEPAGE_ASSERT(buffer_pool_ == other->buffer_pool_, "Undo buffers must draw from the same buffer pool");
+  buffers_.insert(buffers_.end(), other->buffers_.begin(), other->buffers_.end());
+  other->buffers_.clear();
+  other->last_record_ = nullptr;
+}
+
 byte *RedoBuffer::NewEntry(const uint32_t size, const transaction::TransactionPolicy &policy) {
   if (buffer_seg_ == nullptr) {
     // this is the first write
@@ -47,4 +54,15 @@ void RedoBuffer::Finalize(bool flush_buffer, const transaction::TransactionPolic
     buffer_pool_->Release(buffer_seg_);
   }
 }
+
+void RedoBuffer::Flush(const transaction::TransactionPolicy &policy) {
+  Finalize(true, policy);
+  buffer_seg_ = nullptr;
+  last_record_ = nullptr;
+}
+
+void RedoBuffer::Append(RedoBuffer *const other, const transaction::TransactionPolicy &policy) {
+  other->Flush(policy);
+  has_flushed_ = has_flushed_ || other->has_flushed_;
+}
 }  // namespace noisepage::storage
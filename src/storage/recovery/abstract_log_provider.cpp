@@ -35,6 +35,13 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
       return {storage::AbortRecord::Initialize(buf, txn_begin, nullptr, nullptr), varlen_contents};
     }
 
+    case (storage::LogRecordType::ROUND): {
+      auto run = ReadValue<uint64_t>();
+      auto persisted_bound = ReadValue<uint64_t>();
+      auto horizon = ReadValue<uint64_t>();
+      return {storage::RoundRecord::Initialize(buf, run, persisted_bound, horizon), varlen_contents};
+    }
+
     case (storage::LogRecordType::DELETE): {
       auto database_oid = ReadValue<catalog::db_oid_t>();
       auto table_oid = ReadValue<catalog::table_oid_t>();
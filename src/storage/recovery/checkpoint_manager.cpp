@@ -0,0 +1,338 @@
+#include "storage/recovery/checkpoint_manager.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/database_catalog.h"
+#include "catalog/postgres/pg_attribute.h"
+#include "catalog/postgres/pg_class.h"
+#include "catalog/postgres/pg_constraint.h"
+#include "catalog/postgres/pg_database.h"
+#include "catalog/postgres/pg_index.h"
+#include "catalog/postgres/pg_language.h"
+#include "catalog/postgres/pg_namespace.h"
+#include "catalog/postgres/pg_proc.h"
+#include "catalog/postgres/pg_statistic.h"
+#include "catalog/postgres/pg_type.h"
+#include "common/allocator.h"
+#include "common/dedicated_thread_registry.h"
+#include "storage/sql_table.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "storage/write_ahead_log/log_manager.h"
+#include "storage/write_ahead_log/log_record.h"
+#include "storage/write_ahead_log/log_serializer_task.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+// A file of a checkpoint in the on-disk log format. The file is only created once the first record is written to it.
+class CheckpointFile {
+ public:
+  explicit CheckpointFile(std::string path) : path_(std::move(path)) {}
+
+  ~CheckpointFile() { NOISEPAGE_ASSERT(out_ == nullptr, "Checkpoint file must be persisted before destruction"); }
+
+  // Serialize the record to the file
+  void Write(const LogRecord &record) {
+    if (out_ == nullptr) out_ = std::make_unique<BufferedLogWriter>(path_.c_str());
+    LogSerializerTask::SerializeRecord(record, [this](const void *val, const uint32_t size) {
+      uint32_t size_written = 0;
+      while (size_written < size) {
+        size_written += out_->BufferWrite(reinterpret_cast<const byte *>(val) + size_written, size - size_written);
+        if (out_->IsBufferFull()) out_->FlushBuffer();
+      }
+      return size;
+    });
+  }
+
+  // Flush and persist everything written to the file, and close it
+  void Persist() {
+    if (out_ == nullptr) return;
+    out_->FlushBuffer();
+    out_->Persist();
+    out_->Close();
+    out_ = nullptr;
+  }
+
+ private:
+  const std::string path_;
+  std::unique_ptr<BufferedLogWriter> out_;
+};
+
+// Write the given columns of all tuples of the table visible to the txn to the file as inserts into the tuple slots
+// they occupy. The given function is invoked on every tuple before it is written, with its tuple slot, its values and
+// their projection map.
+template <class Prepare>
+void WriteTuples(transaction::TransactionContext *const txn, CheckpointFile *const file, const catalog::db_oid_t db_oid,
+                 const catalog::table_oid_t table_oid, SqlTable *const table,
+                 const std::vector<catalog::col_oid_t> &col_oids, const Prepare &prepare) {
+  const auto initializer = table->InitializerForProjectedRow(col_oids);
+  const auto pr_map = table->ProjectionMapForOids(col_oids);
+
+  auto *const buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer));
+  for (auto it = table->begin(); it != table->end(); ++it) {
+    auto *const record = RedoRecord::Initialize(buffer, txn->StartTime(), db_oid, table_oid, initializer);
+    auto *const redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+    if (!table->Select(common::ManagedPointer(txn), *it, redo->Delta())) continue;
+    redo->SetTupleSlot(*it);
+    prepare(*it, common::ManagedPointer(redo->Delta()), pr_map);
+    file->Write(*record);
+  }
+  delete[] buffer;
+}
+
+// The checkpoints in the directory, by timestamp.
+std::vector<std::pair<uint64_t, std::filesystem::path>> ListCheckpointDirs(const std::string &checkpoint_path) {
+  std::vector<std::pair<uint64_t, std::filesystem::path>> dirs;
+  if (!std::filesystem::is_directory(checkpoint_path)) return dirs;
+  for (const auto &entry : std::filesystem::directory_iterator(checkpoint_path)) {
+    const auto name = entry.path().filename().string();
+    if (!entry.is_directory() || name.empty() ||
+        !std::all_of(name.begin(), name.end(), [](const char c) { return std::isdigit(c); })) {
+      continue;
+    }
+    dirs.emplace_back(std::stoull(name), entry.path());
+  }
+  std::sort(dirs.begin(), dirs.end());
+  return dirs;
+}
+
+}  // namespace
+
+void CheckpointManager::CheckpointTask::RunTask() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait_for(lock, checkpoint_manager_->checkpoint_interval_, [&] { return !run_task_; });
+    if (!run_task_) break;
+    lock.unlock();
+    checkpoint_manager_->TakeCheckpoint();
+    lock.lock();
+  }
+}
+
+void CheckpointManager::CheckpointTask::Terminate() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    run_task_ = false;
+  }
+  cv_.notify_all();
+}
+
+CheckpointManager::CheckpointManager(std::string checkpoint_path, const std::chrono::seconds checkpoint_interval,
+                                     const common::ManagedPointer<catalog::Catalog> catalog,
+                                     const common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                                     const common::ManagedPointer<LogManager> log_manager,
+                                     const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry)
+    : DedicatedThreadOwner(thread_registry),
+      checkpoint_path_(std::move(checkpoint_path)),
+      checkpoint_interval_(checkpoint_interval),
+      catalog_(catalog),
+      txn_manager_(txn_manager),
+      log_manager_(log_manager) {}
+
+void CheckpointManager::Start() {
+  NOISEPAGE_ASSERT(checkpoint_task_ == nullptr, "Checkpointing already started");
+  checkpoint_task_ =
+      thread_registry_->RegisterDedicatedThread<CheckpointTask>(this /* dedicated thread owner */, this /* task arg */);
+}
+
+void CheckpointManager::Stop() {
+  NOISEPAGE_ASSERT(checkpoint_task_ != nullptr, "Checkpointing must already have been started");
+  if (!thread_registry_->StopTask(this, checkpoint_task_.CastManagedPointerTo<common::DedicatedThreadTask>())) {
+    throw std::runtime_error("Checkpoint task termination failed");
+  }
+  checkpoint_task_ = nullptr;
+}
+
+transaction::timestamp_t CheckpointManager::TakeCheckpoint() {
+  std::lock_guard<std::mutex> guard(checkpoint_latch_);
+  const auto timestamp_manager = txn_manager_->GetTimestampManager();
+
+  // Step 1: Continue the log in a new segment, and wait for every txn that may have written to the older segments to
+  // finish. Txns only leave the running txn set once their commit or abort record is serialized, so afterwards every
+  // txn that commits after the snapshot txn begins has all its records in the new segment or later ones.
+  const uint64_t log_segment = log_manager_ != DISABLED ? log_manager_->StartNewSegment() : 0;
+  const auto segment_start_time = timestamp_manager->CurrentTime();
+  while (timestamp_manager->OldestTransactionStartTime() < segment_start_time) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // Step 2: Write out the snapshot of the snapshot txn
+  auto *const txn = txn_manager_->BeginTransaction();
+  const auto checkpoint_ts = txn->StartTime();
+  const auto checkpoint_dir = std::filesystem::path(checkpoint_path_) / std::to_string(checkpoint_ts.UnderlyingValue());
+  std::filesystem::create_directories(checkpoint_dir);
+
+  std::vector<UserTable> user_tables;
+  WriteCatalog(txn, checkpoint_dir.string(), &user_tables);
+  for (const auto &table : user_tables) {
+    WriteTable(txn, checkpoint_dir.string(), table);
+  }
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Step 3: Mark the checkpoint as complete. The meta file is written under a temporary name and renamed once it is
+  // persisted, so that it is never read partially written.
+  const auto meta_path = checkpoint_dir / META_FILE_NAME;
+  const auto meta_tmp_path = meta_path.string() + ".tmp";
+  {
+    BufferedLogWriter meta(meta_tmp_path.c_str());
+    meta.BufferWrite(&checkpoint_ts, sizeof(checkpoint_ts));
+    meta.BufferWrite(&log_segment, sizeof(log_segment));
+    meta.FlushBuffer();
+    meta.Persist();
+    meta.Close();
+  }
+  std::filesystem::rename(meta_tmp_path, meta_path);
+
+  // Step 4: Older checkpoints and the log they needed are no longer needed
+  for (const auto &dir : ListCheckpointDirs(checkpoint_path_)) {
+    if (dir.first >= checkpoint_ts.UnderlyingValue()) break;
+    std::filesystem::remove_all(dir.second);
+  }
+  if (log_manager_ != DISABLED) log_manager_->RemoveSegmentsBefore(log_segment);
+
+  return checkpoint_ts;
+}
+
+void CheckpointManager::WriteCatalog(transaction::TransactionContext *const txn, const std::string &checkpoint_dir,
+                                     std::vector<UserTable> *const user_tables) {
+  using catalog::postgres::PgClass;
+  using catalog::postgres::PgDatabase;
+  CheckpointFile file((std::filesystem::path(checkpoint_dir) / CATALOG_FILE_NAME).string());
+  const auto no_op = [](TupleSlot, common::ManagedPointer<ProjectedRow>, const ProjectionMap &) {};
+
+  // Step 1: Recreate the databases
+  std::vector<catalog::db_oid_t> db_oids;
+  WriteTuples(txn, &file, catalog::INVALID_DATABASE_OID, PgDatabase::DATABASE_TABLE_OID, catalog_->databases_,
+              ColumnOids(*catalog_->databases_),
+              [&](TupleSlot, const common::ManagedPointer<ProjectedRow> row, const ProjectionMap &pr_map) {
+                db_oids.emplace_back(*PgDatabase::DATOID.Get(row, pr_map));
+              });
+
+  for (const auto db_oid : db_oids) {
+    const auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    const auto write_table = [&](const catalog::table_oid_t table_oid, const auto &prepare) {
+      auto *const table = db_catalog->GetTable(common::ManagedPointer(txn), table_oid).Get();
+      WriteTuples(txn, &file, db_oid, table_oid, table, ColumnOids(*table), prepare);
+    };
+
+    // Step 2: Write out the catalog tables that recovery needs to recreate tables and indexes. As when a table or index
+    // is created, pg_class entries don't point to any objects yet.
+    struct ClassEntry {
+      TupleSlot slot_;
+      catalog::table_oid_t oid_;
+      PgClass::RelKind kind_;
+      SqlTable *ptr_;
+    };
+    std::vector<ClassEntry> class_entries;
+    write_table(catalog::postgres::PgNamespace::NAMESPACE_TABLE_OID, no_op);
+    write_table(PgClass::CLASS_TABLE_OID,
+                [&](const TupleSlot slot, const common::ManagedPointer<ProjectedRow> row, const ProjectionMap &pr_map) {
+                  const auto *const ptr = PgClass::REL_PTR.Get(row, pr_map);
+                  if (ptr != nullptr) {
+                    class_entries.push_back({slot, *PgClass::RELOID.Get(row, pr_map),
+                                             static_cast<PgClass::RelKind>(*PgClass::RELKIND.Get(row, pr_map)), *ptr});
+                  }
+                  PgClass::REL_SCHEMA.Set(row, pr_map, nullptr);
+                  PgClass::REL_PTR.SetNull(row, pr_map);
+                });
+    write_table(catalog::postgres::PgAttribute::COLUMN_TABLE_OID, no_op);
+    write_table(catalog::postgres::PgIndex::INDEX_TABLE_OID, no_op);
+    write_table(catalog::postgres::PgType::TYPE_TABLE_OID, no_op);
+    write_table(catalog::postgres::PgConstraint::CONSTRAINT_TABLE_OID, no_op);
+
+    // Step 3: Set the pointers of tables and indexes, which is when recovery recreates them
+    const auto pg_class = db_catalog->GetTable(common::ManagedPointer(txn), PgClass::CLASS_TABLE_OID);
+    const auto ptr_initializer = pg_class->InitializerForProjectedRow({PgClass::REL_PTR.oid_});
+    auto *const buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(ptr_initializer));
+    for (const auto &entry : class_entries) {
+      if (entry.kind_ != PgClass::RelKind::REGULAR_TABLE && entry.kind_ != PgClass::RelKind::INDEX) continue;
+      auto *const record =
+          RedoRecord::Initialize(buffer, txn->StartTime(), db_oid, PgClass::CLASS_TABLE_OID, ptr_initializer);
+      auto *const redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+      redo->SetTupleSlot(entry.slot_);
+      PgClass::REL_PTR.Set(common::ManagedPointer(redo->Delta()), 0, entry.ptr_);
+      file.Write(*record);
+
+      if (entry.kind_ == PgClass::RelKind::REGULAR_TABLE && entry.oid_.UnderlyingValue() >= catalog::START_OID) {
+        user_tables->push_back({db_oid, entry.oid_, entry.ptr_});
+      }
+    }
+    delete[] buffer;
+
+    // Step 4: Write out the catalog tables whose schemas recovery looks up in pg_class
+    write_table(catalog::postgres::PgLanguage::LANGUAGE_TABLE_OID, no_op);
+    write_table(catalog::postgres::PgProc::PRO_TABLE_OID, no_op);
+    write_table(catalog::postgres::PgStatistic::STATISTIC_TABLE_OID, no_op);
+  }
+
+  // Step 5: Commit everything at the checkpoint timestamp
+  auto *const buffer = common::AllocationUtil::AllocateAligned(CommitRecord::Size());
+  const auto *const record = CommitRecord::Initialize(buffer, txn->StartTime(), txn->StartTime(), nullptr, nullptr,
+                                                      txn->StartTime(), false, nullptr, nullptr);
+  file.Write(*record);
+  delete[] buffer;
+  file.Persist();
+}
+
+void CheckpointManager::WriteTable(transaction::TransactionContext *const txn, const std::string &checkpoint_dir,
+                                   const UserTable &table) {
+  CheckpointFile file(
+      (std::filesystem::path(checkpoint_dir) /
+       (std::to_string(table.db_oid_.UnderlyingValue()) + "_" + std::to_string(table.table_oid_.UnderlyingValue())))
+          .string());
+  WriteTuples(txn, &file, table.db_oid_, table.table_oid_, table.table_, ColumnOids(*table.table_),
+              [](TupleSlot, common::ManagedPointer<ProjectedRow>, const ProjectionMap &) {});
+  file.Persist();
+}
+
+std::vector<catalog::col_oid_t> CheckpointManager::ColumnOids(const SqlTable &table) {
+  std::vector<catalog::col_oid_t> col_oids;
+  for (const auto &column : table.GetColumnMap()) col_oids.emplace_back(column.first);
+  return col_oids;
+}
+
+bool CheckpointManager::FindLatestCheckpoint(const std::string &checkpoint_path, std::string *const checkpoint_dir,
+                                             transaction::timestamp_t *const checkpoint_ts,
+                                             uint64_t *const log_segment) {
+  auto dirs = ListCheckpointDirs(checkpoint_path);
+  for (auto dir = dirs.rbegin(); dir != dirs.rend(); ++dir) {
+    const auto meta_path = dir->second / META_FILE_NAME;
+    if (!std::filesystem::exists(meta_path)) continue;
+    BufferedLogReader meta(meta_path.c_str());
+    if (!meta.Read(checkpoint_ts, sizeof(*checkpoint_ts)) || !meta.Read(log_segment, sizeof(*log_segment))) continue;
+    *checkpoint_dir = dir->second.string();
+    return true;
+  }
+  return false;
+}
+
+std::vector<CheckpointManager::TableFile> CheckpointManager::ListTableFiles(const std::string &checkpoint_dir) {
+  // Table files are named <database oid>_<table oid>
+  std::vector<TableFile> files;
+  for (const auto &entry : std::filesystem::directory_iterator(checkpoint_dir)) {
+    const auto name = entry.path().filename().string();
+    const auto separator = name.find('_');
+    if (separator == std::string::npos || separator == 0 || separator + 1 == name.size() ||
+        !std::all_of(name.begin(), name.end(), [](const char c) { return std::isdigit(c) || c == '_'; })) {
+      continue;
+    }
+    files.push_back({catalog::db_oid_t(static_cast<uint32_t>(std::stoul(name.substr(0, separator)))),
+                     catalog::table_oid_t(static_cast<uint32_t>(std::stoul(name.substr(separator + 1)))),
+                     entry.path().string()});
+  }
+  return files;
+}
+
+}  // namespace noisepage::storage
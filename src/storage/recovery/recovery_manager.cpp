@@ -1,6 +1,8 @@
 #include "storage/recovery/recovery_manager.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -18,10 +20,13 @@
 #include "catalog/postgres/pg_type.h"
 #include "common/dedicated_thread_registry.h"
 #include "common/json.h"
+#include "common/worker_pool.h"
 #include "replication/replica_replication_manager.h"
 #include "storage/index/index.h"
 #include "storage/index/index_builder.h"
 #include "storage/index/index_metadata.h"
+#include "storage/recovery/checkpoint_manager.h"
+#include "storage/recovery/disk_log_provider.h"
 #include "storage/recovery/replication_log_provider.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "transaction/deferred_action_manager.h"
@@ -45,6 +50,92 @@ void RecoveryManager::WaitForRecoveryToFinish() {
   recovery_task_ = nullptr;
 }
 
+bool RecoveryManager::RecoverFromCheckpoint(const std::string &checkpoint_path, const uint32_t num_threads) {
+  NOISEPAGE_ASSERT(recovery_task_ == nullptr, "Checkpoints must be loaded before recovery is started");
+  std::string checkpoint_dir;
+  transaction::timestamp_t checkpoint_ts;
+  uint64_t log_segment;
+  if (!CheckpointManager::FindLatestCheckpoint(checkpoint_path, &checkpoint_dir, &checkpoint_ts, &log_segment)) {
+    return false;
+  }
+
+  // Step 1: Recreate the databases and their catalog tables the same way the log does when they are created
+  DiskLogProvider catalog_provider(checkpoint_dir + "/" + CheckpointManager::CATALOG_FILE_NAME);
+  RecoverFromLogs(common::ManagedPointer<AbstractLogProvider>(&catalog_provider));
+
+  // Step 2: Look up the tables of the checkpoint and their indexes. Catalog lookups lock the database catalog for the
+  // looking up txn, so this is done serially before the tables are loaded in parallel.
+  struct TableLoad {
+    std::string path_;
+    common::ManagedPointer<SqlTable> table_;
+    std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> index_objects_;
+    ProjectionMap pr_map_;
+    std::vector<std::pair<TupleSlot, TupleSlot>> slots_;
+  };
+  std::vector<TableLoad> loads;
+  auto *lookup_txn = txn_manager_->BeginTransaction();
+  for (const auto &file : CheckpointManager::ListTableFiles(checkpoint_dir)) {
+    auto db_catalog_ptr = GetDatabaseCatalog(lookup_txn, file.db_oid_);
+    const auto &schema = GetTableSchema(lookup_txn, db_catalog_ptr, file.table_oid_);
+    std::vector<catalog::col_oid_t> all_table_oids;
+    for (const auto &col : schema.GetColumns()) {
+      all_table_oids.push_back(col.Oid());
+    }
+    auto table = GetSqlTable(lookup_txn, file.db_oid_, file.table_oid_);
+    loads.push_back({file.path_, table, db_catalog_ptr->GetIndexes(common::ManagedPointer(lookup_txn), file.table_oid_),
+                     table->ProjectionMapForOids(all_table_oids), {}});
+  }
+  txn_manager_->Commit(lookup_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Step 3: Insert the tuples of every table into it and its indexes. The tables are independent of each other, so they
+  // are loaded in parallel, each in a series of txns to bound the size of their redo buffers.
+  constexpr uint32_t records_per_txn = 10000;
+  common::WorkerPool workers(std::max(num_threads, 1U), common::TaskQueue{});
+  workers.Startup();
+  for (auto &load : loads) {
+    workers.SubmitTask([&] {
+      DiskLogProvider table_provider(load.path_);
+      auto *txn = txn_manager_->BeginTransaction();
+      uint32_t txn_records = 0;
+      for (auto pair = table_provider.GetNextRecord(); pair.first != nullptr; pair = table_provider.GetNextRecord()) {
+        auto *record = pair.first;
+        NOISEPAGE_ASSERT(record->RecordType() == LogRecordType::REDO, "Checkpoint tables only hold inserts");
+        auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+        const auto old_tuple_slot = redo_record->GetTupleSlot();
+        redo_record->SetTupleSlot(TupleSlot(nullptr, 0));
+        auto *staged_record = txn->StageRecoveryWrite(record);
+        auto new_tuple_slot = load.table_->Insert(common::ManagedPointer(txn), staged_record);
+        UpdateIndexes(txn, load.index_objects_, load.pr_map_, new_tuple_slot, staged_record->Delta(),
+                      true /* insert */);
+        load.slots_.emplace_back(old_tuple_slot, new_tuple_slot);
+        // The staged record is a copy, and the varlens are now owned by the table
+        delete[] reinterpret_cast<byte *>(record);
+
+        if (++txn_records == records_per_txn) {
+          txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+          txn = txn_manager_->BeginTransaction();
+          txn_records = 0;
+        }
+      }
+      txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    });
+  }
+  workers.WaitUntilAllFinished();
+  workers.Shutdown();
+
+  // Step 4: Later records of the log reference the tuples by their slots at the time of the checkpoint
+  for (const auto &load : loads) {
+    for (const auto &slots : load.slots_) {
+      tuple_slot_map_[slots.first] = slots.second;
+    }
+  }
+
+  // Txns that start from now on must be newer than the checkpoint, so that later checkpoints are ordered after it
+  checkpoint_ts_ = checkpoint_ts;
+  txn_manager_->GetTimestampManager()->AdvanceTime(checkpoint_ts + 1);
+  return true;
+}
+
 void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogProvider> log_provider) {
   // Replay logs until the log provider no longer gives us logs
   while (true) {
@@ -85,8 +176,14 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
         NOISEPAGE_ASSERT(pair.second.empty(), "Commit records should not have any varlen pointers");
         auto *commit_record = log_record->GetUnderlyingRecordBodyAs<CommitRecord>();
 
-        // We defer all transactions initially
-        deferred_txns_.insert(log_record->TxnBegin());
+        if (commit_record->CommitTime() < checkpoint_ts_) {
+          // The changes of the txn are already part of the loaded checkpoint
+          DeferRecordDeletes(log_record->TxnBegin(), true);
+          buffered_changes_map_.erase(log_record->TxnBegin());
+        } else {
+          // We defer all transactions initially
+          deferred_txns_.insert(log_record->TxnBegin());
+        }
         // Process any deferred transactions that are safe to execute
         recovered_txns_ += ProcessDeferredTransactions(commit_record->OldestActiveTxn());
         // Clean up the log record
@@ -117,18 +214,129 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
 }
 
 void RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timestamp_t txn_id) {
+  auto buffered_changes = std::move(buffered_changes_map_[txn_id]);
+  buffered_changes_map_.erase(txn_id);
+  ReplayTransaction(&buffered_changes);
+  TransactionApplied(txn_id);
+}
+
+void RecoveryManager::ProcessCommittedTransactionsInParallel(const std::vector<transaction::timestamp_t> &txn_ids) {
+  // Take the changes of the txns out of the map, as replay threads must not access it concurrently
+  std::vector<transaction::timestamp_t> segment_txn_ids;
+  std::vector<std::vector<std::pair<LogRecord *, std::vector<byte *>>>> segment_changes;
+  for (const auto txn_id : txn_ids) {
+    auto buffered_changes = std::move(buffered_changes_map_[txn_id]);
+    buffered_changes_map_.erase(txn_id);
+
+    if (!IsBarrierTransaction(buffered_changes)) {
+      segment_txn_ids.push_back(txn_id);
+      segment_changes.emplace_back(std::move(buffered_changes));
+      continue;
+    }
+
+    // Replay all txns before the barrier, and then the barrier by itself
+    ReplayTransactionsInParallel(segment_txn_ids, &segment_changes);
+    segment_txn_ids.clear();
+    segment_changes.clear();
+    ReplayTransaction(&buffered_changes);
+    TransactionApplied(txn_id);
+  }
+  ReplayTransactionsInParallel(segment_txn_ids, &segment_changes);
+}
+
+void RecoveryManager::ReplayTransactionsInParallel(
+    const std::vector<transaction::timestamp_t> &txn_ids,
+    std::vector<std::vector<std::pair<LogRecord *, std::vector<byte *>>>> *const buffered_changes) {
+  const auto num_txns = txn_ids.size();
+  if (num_txns == 0) return;
+
+  // Tables are identified by their database and table oid
+  const auto table_key = [](const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid) {
+    return (static_cast<uint64_t>(db_oid.UnderlyingValue()) << 32) | table_oid.UnderlyingValue();
+  };
+
+  // Step 1: Find the tables with unique indexes. Txns that insert or delete the same key into these modify different
+  // tuples, but must still be replayed in order, so their txns are ordered by table rather than by tuple.
+  std::unordered_map<uint64_t, bool> has_unique_index;
+  auto *lookup_txn = txn_manager_->BeginTransaction();
+  for (const auto &changes : *buffered_changes) {
+    for (const auto &change : changes) {
+      const auto *record = change.first;
+      const auto db_oid = record->RecordType() == LogRecordType::REDO
+                              ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetDatabaseOid()
+                              : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetDatabaseOid();
+      const auto table_oid = record->RecordType() == LogRecordType::REDO
+                                 ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid()
+                                 : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid();
+      const auto key = table_key(db_oid, table_oid);
+      if (has_unique_index.find(key) != has_unique_index.end()) continue;
+      const auto indexes =
+          LookupDatabaseCatalog(lookup_txn, db_oid)->GetIndexes(common::ManagedPointer(lookup_txn), table_oid);
+      has_unique_index[key] = std::any_of(indexes.begin(), indexes.end(),
+                                          [](const auto &index) { return index.second.Unique(); });
+    }
+  }
+  txn_manager_->Commit(lookup_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Step 2: Every txn depends on the last earlier txn that modified any of the same tuples or ordered tables
+  std::vector<std::vector<uint64_t>> successors(num_txns);
+  std::vector<std::atomic<uint32_t>> num_predecessors(num_txns);
+  std::unordered_map<TupleSlot, uint64_t> last_tuple_writer;
+  std::unordered_map<uint64_t, uint64_t> last_table_writer;
+  for (uint64_t idx = 0; idx < num_txns; idx++) {
+    std::unordered_set<uint64_t> predecessors;
+    for (const auto &change : (*buffered_changes)[idx]) {
+      const auto *record = change.first;
+      const bool redo = record->RecordType() == LogRecordType::REDO;
+      const auto key = redo ? table_key(record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetDatabaseOid(),
+                                        record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid())
+                            : table_key(record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetDatabaseOid(),
+                                        record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid());
+      if (has_unique_index[key]) {
+        auto it = last_table_writer.find(key);
+        if (it != last_table_writer.end() && it->second != idx) predecessors.insert(it->second);
+        last_table_writer[key] = idx;
+      } else {
+        const auto slot = redo ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTupleSlot()
+                               : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTupleSlot();
+        auto it = last_tuple_writer.find(slot);
+        if (it != last_tuple_writer.end() && it->second != idx) predecessors.insert(it->second);
+        last_tuple_writer[slot] = idx;
+      }
+    }
+    num_predecessors[idx] = static_cast<uint32_t>(predecessors.size());
+    for (const auto predecessor : predecessors) successors[predecessor].push_back(idx);
+  }
+
+  // Step 3: Replay every txn once its predecessors are replayed. A txn begins only after they committed, so it never
+  // conflicts with them.
+  std::function<void(uint64_t)> replay = [&](const uint64_t idx) {
+    ReplayTransaction(&(*buffered_changes)[idx]);
+    for (const auto successor : successors[idx]) {
+      if (--num_predecessors[successor] == 0) replay_pool_->SubmitTask([&replay, successor] { replay(successor); });
+    }
+  };
+  for (uint64_t idx = 0; idx < num_txns; idx++) {
+    if (num_predecessors[idx] == 0) replay_pool_->SubmitTask([&replay, idx] { replay(idx); });
+  }
+  replay_pool_->WaitUntilAllFinished();
+
+  for (const auto txn_id : txn_ids) TransactionApplied(txn_id);
+}
+
+void RecoveryManager::ReplayTransaction(std::vector<std::pair<LogRecord *, std::vector<byte *>>> *buffered_changes) {
   // Begin a txn to replay changes with.
   auto *txn = txn_manager_->BeginTransaction();
 
   // Apply all buffered changes. They should all succeed. After applying we can safely delete the record
-  for (uint32_t idx = 0; idx < buffered_changes_map_[txn_id].size(); idx++) {
-    auto *buffered_record = buffered_changes_map_[txn_id][idx].first;
+  for (uint32_t idx = 0; idx < buffered_changes->size(); idx++) {
+    auto *buffered_record = (*buffered_changes)[idx].first;
     NOISEPAGE_ASSERT(
         buffered_record->RecordType() == LogRecordType::REDO || buffered_record->RecordType() == LogRecordType::DELETE,
         "Buffered record must be a redo or delete.");
 
     if (IsSpecialCaseCatalogRecord(buffered_record)) {
-      idx += ProcessSpecialCaseCatalogRecord(txn, &buffered_changes_map_[txn_id], idx);
+      idx += ProcessSpecialCaseCatalogRecord(txn, buffered_changes, idx);
     } else if (buffered_record->RecordType() == LogRecordType::REDO) {
       ReplayRedoRecord(txn, buffered_record);
     } else {
@@ -137,12 +345,26 @@ void RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timest
   }
 
   // Defer deletes of the log records
-  DeferRecordDeletes(txn_id, false);
-  buffered_changes_map_.erase(txn_id);
+  DeferRecordDeletes(std::move(*buffered_changes), false);
 
   // Commit the txn
   txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+bool RecoveryManager::IsBarrierTransaction(
+    const std::vector<std::pair<LogRecord *, std::vector<byte *>>> &buffered_changes) {
+  // Catalog changes lock the database catalog and may create or drop the tables other txns modify
+  for (const auto &change : buffered_changes) {
+    const auto *record = change.first;
+    const auto table_oid = record->RecordType() == LogRecordType::REDO
+                               ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid()
+                               : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid();
+    if (table_oid.UnderlyingValue() < catalog::START_OID) return true;
+  }
+  return false;
+}
 
+void RecoveryManager::TransactionApplied(const transaction::timestamp_t txn_id) {
   last_applied_txn_id_ = std::max(last_applied_txn_id_, txn_id);
   if (replication_manager_ != DISABLED) {
     // Replicas have to send back their list of deferred transactions that were processed, periodically.
@@ -156,8 +378,13 @@ void RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timest
 }
 
 void RecoveryManager::DeferRecordDeletes(noisepage::transaction::timestamp_t txn_id, bool delete_varlens) {
+  DeferRecordDeletes(std::move(buffered_changes_map_[txn_id]), delete_varlens);
+}
+
+void RecoveryManager::DeferRecordDeletes(std::vector<std::pair<LogRecord *, std::vector<byte *>>> &&buffered_changes,
+                                         bool delete_varlens) {
   // Capture the changes by value except for changes which we can move
-  deferred_action_manager_->RegisterDeferredAction([=, buffered_changes{std::move(buffered_changes_map_[txn_id])}]() {
+  deferred_action_manager_->RegisterDeferredAction([=, buffered_changes{std::move(buffered_changes)}]() {
     for (auto &buffered_pair : buffered_changes) {
       delete[] reinterpret_cast<byte *>(buffered_pair.first);
       if (delete_varlens) {
@@ -177,9 +404,15 @@ uint32_t RecoveryManager::ProcessDeferredTransactions(noisepage::transaction::ti
       (upper_bound_ts == transaction::INVALID_TXN_TIMESTAMP) ? transaction::timestamp_t(INT64_MAX) : upper_bound_ts;
   auto upper_bound_it = deferred_txns_.upper_bound(upper_bound_ts);
 
-  for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
-    ProcessCommittedTransaction(*it);
-    txns_processed++;
+  if (replay_pool_ != nullptr) {
+    const std::vector<transaction::timestamp_t> txn_ids(deferred_txns_.begin(), upper_bound_it);
+    ProcessCommittedTransactionsInParallel(txn_ids);
+    txns_processed = static_cast<uint32_t>(txn_ids.size());
+  } else {
+    for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
+      ProcessCommittedTransaction(*it);
+      txns_processed++;
+    }
   }
 
   // If we actually processed some txns, remove them from the set
@@ -208,9 +441,10 @@ void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, Log
     NOISEPAGE_ASSERT(staged_record->GetTupleSlot() == new_tuple_slot,
                      "Insert should update redo record with new tuple slot");
     // Create a mapping of the old to new tuple. The new tuple slot should be used for future updates and deletes.
+    common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
     tuple_slot_map_[old_tuple_slot] = new_tuple_slot;
   } else {
-    auto new_tuple_slot = tuple_slot_map_[redo_record->GetTupleSlot()];
+    auto new_tuple_slot = GetTupleSlotMapping(redo_record->GetTupleSlot());
     redo_record->SetTupleSlot(new_tuple_slot);
     // Stage the write. This way the recovery operation is logged if logging is enabled
     auto staged_record = txn->StageRecoveryWrite(record);
@@ -224,7 +458,7 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
   // Get tuple slot
   auto new_tuple_slot = GetTupleSlotMapping(delete_record->GetTupleSlot());
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, delete_record->GetDatabaseOid());
+  auto db_catalog_ptr = LookupDatabaseCatalog(txn, delete_record->GetDatabaseOid());
   auto sql_table_ptr = db_catalog_ptr->GetTable(common::ManagedPointer(txn), delete_record->GetTableOid());
   const auto &schema = GetTableSchema(txn, db_catalog_ptr, delete_record->GetTableOid());
 
@@ -249,7 +483,10 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   UpdateIndexesOnTable(txn, delete_record->GetDatabaseOid(), delete_record->GetTableOid(), sql_table_ptr,
                        new_tuple_slot, pr, false /* delete */);
   // We can delete the TupleSlot from the map
-  tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
+    tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  }
   delete[] buffer;
 }
 
@@ -257,7 +494,7 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
                                            catalog::table_oid_t table_oid,
                                            common::ManagedPointer<storage::SqlTable> table_ptr,
                                            const TupleSlot &tuple_slot, ProjectedRow *table_pr, const bool insert) {
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  auto db_catalog_ptr = LookupDatabaseCatalog(txn, db_oid);
 
   // Stores index objects and schemas
   std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> index_objects;
@@ -352,14 +589,6 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
   // If there's no indexes on the table, we can return
   if (index_objects.empty()) return;
 
-  // Compute largest PR size we need for index PRs.
-  uint32_t max_index_key_pr_size = 0;
-  for (const auto &index_obj : index_objects) {
-    max_index_key_pr_size =
-        std::max(max_index_key_pr_size, index_obj.first->GetProjectedRowInitializer().ProjectedRowSize());
-  }
-  auto *index_buffer = common::AllocationUtil::AllocateAligned(max_index_key_pr_size);
-
   // Build a PR map for all columns in the table, as the table pr should have values for every column
   const auto &table_schema = GetTableSchema(txn, db_catalog_ptr, table_oid);
   std::vector<catalog::col_oid_t> all_table_oids;
@@ -369,6 +598,24 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
   auto pr_map = table_ptr->ProjectionMapForOids(all_table_oids);
   NOISEPAGE_ASSERT(pr_map.size() == table_pr->NumColumns(), "Projected row should contain all attributes");
 
+  UpdateIndexes(txn, index_objects, pr_map, tuple_slot, table_pr, insert);
+}
+
+void RecoveryManager::UpdateIndexes(
+    transaction::TransactionContext *txn,
+    const std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> &index_objects,
+    const ProjectionMap &pr_map, const TupleSlot &tuple_slot, ProjectedRow *table_pr, const bool insert) {
+  // If there's no indexes on the table, we can return
+  if (index_objects.empty()) return;
+
+  // Compute largest PR size we need for index PRs.
+  uint32_t max_index_key_pr_size = 0;
+  for (const auto &index_obj : index_objects) {
+    max_index_key_pr_size =
+        std::max(max_index_key_pr_size, index_obj.first->GetProjectedRowInitializer().ProjectedRowSize());
+  }
+  auto *index_buffer = common::AllocationUtil::AllocateAligned(max_index_key_pr_size);
+
   // TODO(Gus): We are going to assume no indexes on expressions below. Having indexes on expressions would require to
   // evaluate expressions and that's a nightmare
   for (const auto &index_obj : index_objects) {
@@ -387,12 +634,12 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
       const auto &col = schema.GetColumn(col_idx);
       auto index_col_oid = col.Oid();
       const catalog::col_oid_t &table_col_oid = indexed_attributes[col_idx];
-      if (table_pr->IsNull(pr_map[table_col_oid])) {
+      if (table_pr->IsNull(pr_map.at(table_col_oid))) {
         index_pr->SetNull(index->GetKeyOidToOffsetMap().at(index_col_oid));
       } else {
         auto size = AttrSizeBytes(col.AttributeLength());
         std::memcpy(index_pr->AccessForceNotNull(index->GetKeyOidToOffsetMap().at(index_col_oid)),
-                    table_pr->AccessWithNullCheck(pr_map[table_col_oid]), size);
+                    table_pr->AccessWithNullCheck(pr_map.at(table_col_oid)), size);
       }
     }
 
@@ -868,7 +1115,7 @@ common::ManagedPointer<storage::SqlTable> RecoveryManager::GetSqlTable(transacti
     return common::ManagedPointer(catalog_->databases_);
   }
 
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  auto db_catalog_ptr = LookupDatabaseCatalog(txn, db_oid);
 
   common::ManagedPointer<storage::SqlTable> table_ptr = nullptr;
 
@@ -5,6 +5,7 @@
 #include "common/scoped_timer.h"
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
+#include "storage/write_ahead_log/log_manager.h"
 
 namespace noisepage::storage {
 
@@ -23,6 +24,11 @@ void DiskLogConsumerTask::Terminate() {
 }
 
 void DiskLogConsumerTask::WriteBuffersToLogFile() {
+  // Pop the rounds of serialization before the buffers, so that all buffers of the popped rounds are written below
+  if (serialized_rounds_ != nullptr) {
+    SerializedRound round;
+    while (serialized_rounds_->Dequeue(&round)) unpersisted_rounds_.emplace_back(std::move(round));
+  }
   // Persist all the filled buffers to the disk
   SerializedLogs logs;
   while (!filled_buffer_queue_->Empty()) {
@@ -51,6 +57,21 @@ uint64_t DiskLogConsumerTask::PersistLogFile() {
   // Execute the callbacks for the transactions that have been persisted
   for (auto &callback : commit_callbacks_) callback.fn_(callback.arg_);
   commit_callbacks_.clear();
+  if (!unpersisted_rounds_.empty()) {
+    log_manager_->RoundsPersisted(stream_, &unpersisted_rounds_);
+    unpersisted_rounds_.clear();
+  }
+  return num_buffers;
+}
+
+uint64_t DiskLogConsumerTask::RotateLogFile() {
+  // The LogManager holds back the serializer while the log file is rotated, so that no record spans two files. Anything
+  // left in the filled buffer queue therefore belongs to the current file.
+  WriteBuffersToLogFile();
+  const auto num_buffers = PersistLogFile();
+  for (auto &buffer : *buffers_) {
+    buffer.Reopen(next_log_file_path_.c_str());
+  }
   return num_buffers;
 }
 
@@ -84,12 +105,15 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
       std::unique_lock<std::mutex> lock(persist_lock_);
       // Wake up the task thread if:
       // 1) The serializer thread has signalled to persist all non-empty buffers to disk
-      // 2) There is a filled buffer to write to the disk
-      // 3) LogManager has shut down the task
-      // 4) Our persist interval timed out
-
-      bool signaled = disk_log_writer_thread_cv_.wait_for(
-          lock, curr_sleep, [&] { return force_flush_ || !filled_buffer_queue_->Empty() || !run_task_; });
+      // 2) The LogManager has signalled to continue the log in a new file
+      // 3) There is a filled buffer or a round of serialization to write to the disk
+      // 4) LogManager has shut down the task
+      // 5) Our persist interval timed out
+
+      bool signaled = disk_log_writer_thread_cv_.wait_for(lock, curr_sleep, [&] {
+        return force_flush_ || rotate_ || !filled_buffer_queue_->Empty() ||
+               (serialized_rounds_ != nullptr && !serialized_rounds_->Empty()) || !run_task_;
+      });
       next_sleep = signaled ? persist_interval_ : curr_sleep * 2;
       next_sleep = std::min(next_sleep, max_sleep);
     }
@@ -100,19 +124,22 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
     // We persist the log file if the following conditions are met
     // 1) The persist interval amount of time has passed since the last persist
     // 2) We have written more data since the last persist than the threshold
-    // 3) We are signaled to persist
+    // 3) We are signaled to persist or to rotate the log file
     // 4) We are shutting down this task
+    // 5) There are rounds of serialization to report and nothing was written since the last persist
     bool timeout = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
                                                                          last_persist) > curr_sleep;
+    bool report = !unpersisted_rounds_.empty() && current_data_written_ == 0;
 
-    if (timeout || current_data_written_ > persist_threshold_ || force_flush_ || !run_task_) {
+    if (timeout || current_data_written_ > persist_threshold_ || force_flush_ || rotate_ || !run_task_ || report) {
       std::unique_lock<std::mutex> lock(persist_lock_);
-      num_buffers = PersistLogFile();
+      num_buffers = rotate_ ? RotateLogFile() : PersistLogFile();
       num_bytes = current_data_written_;
       // Reset meta data
       last_persist = std::chrono::high_resolution_clock::now();
       current_data_written_ = 0;
       force_flush_ = false;
+      rotate_ = false;
 
       // Signal anyone who forced a persist that the persist has finished
       persist_cv_.notify_all();
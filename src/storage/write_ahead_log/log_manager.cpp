@@ -1,5 +1,13 @@
 #include "storage/write_ahead_log/log_manager.h"
 
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "common/dedicated_thread_registry.h"
 #include "storage/write_ahead_log/disk_log_consumer_task.h"
 #include "storage/write_ahead_log/log_serializer_task.h"
@@ -7,39 +15,95 @@
 
 namespace noisepage::storage {
 
+LogManager::LogManager(std::string log_file_path, uint64_t num_buffers,
+                       std::chrono::microseconds serialization_interval, std::chrono::microseconds persist_interval,
+                       uint64_t persist_threshold, common::ManagedPointer<RecordBufferSegmentPool> buffer_pool,
+                       common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue,
+                       common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager,
+                       common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
+                       const uint32_t num_streams)
+    : DedicatedThreadOwner(thread_registry),
+      run_log_manager_(false),
+      log_file_path_(std::move(log_file_path)),
+      num_buffers_(num_buffers),
+      buffer_pool_(buffer_pool.Get()),
+      serialization_interval_(serialization_interval),
+      persist_interval_(persist_interval),
+      persist_threshold_(persist_threshold),
+      primary_replication_manager_(primary_replication_manager) {
+  NOISEPAGE_ASSERT(num_streams > 0, "The log needs at least one stream");
+  NOISEPAGE_ASSERT(num_streams == 1 || primary_replication_manager == DISABLED,
+                   "Replication ships a single stream of the log");
+  for (uint32_t i = 0; i < num_streams; i++) {
+    auto stream = std::make_unique<LogStream>();
+    stream->log_file_path_ = StreamPath(log_file_path_, i);
+    if (i == 0) {
+      stream->empty_buffer_queue_ = empty_buffer_queue;
+    } else {
+      stream->owned_empty_buffer_queue_ = std::make_unique<common::ConcurrentBlockingQueue<BufferedLogWriter *>>();
+      stream->empty_buffer_queue_ = common::ManagedPointer(stream->owned_empty_buffer_queue_);
+    }
+    streams_.emplace_back(std::move(stream));
+  }
+}
+
 void LogManager::Start() {
   NOISEPAGE_ASSERT(!run_log_manager_, "Can't call Start on already started LogManager");
-  // Initialize buffers for logging
-  for (size_t i = 0; i < num_buffers_; i++) {
-    buffers_.emplace_back(log_file_path_.c_str());
+  // Initialize buffers for logging. If the log was already split into segments, continue appending to the latest one.
+  // All streams start new segments together, but a stream may not have written to its latest segment yet.
+  current_segment_ = 0;
+  for (const auto &stream : streams_) {
+    const auto segments = ListSegments(stream->log_file_path_);
+    if (!segments.empty()) current_segment_ = std::max(current_segment_, segments.back());
   }
-  for (size_t i = 0; i < num_buffers_; i++) {
-    empty_buffer_queue_->Enqueue(&buffers_[i]);
+  for (const auto &stream : streams_) {
+    const auto segment_path = SegmentPath(stream->log_file_path_, current_segment_);
+    for (size_t i = 0; i < num_buffers_; i++) {
+      stream->buffers_.emplace_back(segment_path.c_str());
+    }
+    for (size_t i = 0; i < num_buffers_; i++) {
+      stream->empty_buffer_queue_->Enqueue(&stream->buffers_[i]);
+    }
   }
 
   run_log_manager_ = true;
 
-  // Register DiskLogConsumerTask
-  disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
-      this /* requester */, persist_interval_, persist_threshold_, &buffers_, empty_buffer_queue_.Get(),
-      &filled_buffer_queue_);
+  // Commit callbacks only need to wait for other streams if there are any. Commit sequence numbers start over with
+  // every run, so the RoundRecords of the streams tell recovery which run they belong to.
+  const bool several_streams = streams_.size() > 1;
+  std::random_device random;
+  const uint64_t run = (static_cast<uint64_t>(random()) << 32) | random();
+  for (uint32_t i = 0; i < streams_.size(); i++) {
+    auto &stream = *streams_[i];
+    auto *const serialized_rounds = several_streams ? &stream.serialized_rounds_ : nullptr;
+
+    // Register DiskLogConsumerTask
+    stream.disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
+        this /* requester */, persist_interval_, persist_threshold_, &stream.buffers_, stream.empty_buffer_queue_.Get(),
+        &stream.filled_buffer_queue_, serialized_rounds, common::ManagedPointer(this), i);
 
-  // Register LogSerializerTask
-  log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
-      this /* requester */, serialization_interval_, buffer_pool_, empty_buffer_queue_, &filled_buffer_queue_,
-      &disk_log_writer_task_->disk_log_writer_thread_cv_, primary_replication_manager_);
+    // Register LogSerializerTask
+    stream.log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
+        this /* requester */, serialization_interval_, buffer_pool_, stream.empty_buffer_queue_,
+        &stream.filled_buffer_queue_, &stream.disk_log_writer_task_->disk_log_writer_thread_cv_,
+        i == 0 ? primary_replication_manager_ : common::ManagedPointer<replication::PrimaryReplicationManager>(nullptr),
+        several_streams ? &commit_sequence_ : nullptr, serialized_rounds, run);
+  }
 }
 
 void LogManager::ForceFlush() {
-  // Force the serializer task to serialize buffers
-  log_serializer_task_->Process();
-  // Signal the disk log consumer task thread to persist the buffers to disk
-  std::unique_lock<std::mutex> lock(disk_log_writer_task_->persist_lock_);
-  disk_log_writer_task_->force_flush_ = true;
-  disk_log_writer_task_->disk_log_writer_thread_cv_.notify_one();
+  // Force the serializer tasks to serialize buffers
+  for (const auto &stream : streams_) stream->log_serializer_task_->Process();
+  for (const auto &stream : streams_) {
+    // Signal the disk log consumer task thread to persist the buffers to disk
+    auto &disk_log_writer_task = *stream->disk_log_writer_task_;
+    std::unique_lock<std::mutex> lock(disk_log_writer_task.persist_lock_);
+    disk_log_writer_task.force_flush_ = true;
+    disk_log_writer_task.disk_log_writer_thread_cv_.notify_one();
 
-  // Wait for the disk log consumer task thread to persist the logs
-  disk_log_writer_task_->persist_cv_.wait(lock, [&] { return !disk_log_writer_task_->force_flush_; });
+    // Wait for the disk log consumer task thread to persist the logs
+    disk_log_writer_task.persist_cv_.wait(lock, [&] { return !disk_log_writer_task.force_flush_; });
+  }
 }
 
 void LogManager::PersistAndStop() {
@@ -49,36 +113,202 @@ void LogManager::PersistAndStop() {
   // Signal all tasks to stop. The shutdown of the tasks will trigger any remaining logs to be serialized, writen to the
   // log file, and persisted. The order in which we shut down the tasks is important, we must first serialize, then
   // shutdown the disk consumer task (reverse order of Start())
-  auto result UNUSED_ATTRIBUTE =
-      thread_registry_->StopTask(this, log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  NOISEPAGE_ASSERT(result, "LogSerializerTask should have been stopped");
+  for (const auto &stream : streams_) {
+    auto result UNUSED_ATTRIBUTE = thread_registry_->StopTask(
+        this, stream->log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+    NOISEPAGE_ASSERT(result, "LogSerializerTask should have been stopped");
+  }
+  for (const auto &stream : streams_) {
+    auto result UNUSED_ATTRIBUTE = thread_registry_->StopTask(
+        this, stream->disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+    NOISEPAGE_ASSERT(result, "DiskLogConsumerTask should have been stopped");
+    NOISEPAGE_ASSERT(stream->filled_buffer_queue_.Empty(),
+                     "disk log consumer task should have processed all filled buffers\n");
+  }
 
-  result = thread_registry_->StopTask(this, disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  NOISEPAGE_ASSERT(result, "DiskLogConsumerTask should have been stopped");
-  NOISEPAGE_ASSERT(filled_buffer_queue_.Empty(), "disk log consumer task should have processed all filled buffers\n");
+  // Everything that was handed over is persisted now, so the remaining commit callbacks don't need to wait for commits
+  // that are still registered
+  std::multimap<uint64_t, std::vector<CommitCallback>> waiting_commits;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&persisted_latch_);
+    waiting_commits.swap(waiting_commits_);
+  }
+  for (auto &round : waiting_commits) {
+    for (auto &callback : round.second) callback.fn_(callback.arg_);
+  }
 
-  // Close the buffers corresponding to the log file
-  for (auto &buf : buffers_) {
-    buf.Close();
+  for (const auto &stream : streams_) {
+    // Close the buffers corresponding to the log file
+    for (auto &buf : stream->buffers_) {
+      buf.Close();
+    }
+    // Clear buffer queues
+    stream->empty_buffer_queue_->Clear();
+    stream->filled_buffer_queue_.Clear();
+    stream->buffers_.clear();
   }
-  // Clear buffer queues
-  empty_buffer_queue_->Clear();
-  filled_buffer_queue_.Clear();
-  buffers_.clear();
 }
 
 void LogManager::AddBufferToFlushQueue(RecordBufferSegment *const buffer_segment,
                                        const transaction::TransactionPolicy &policy) {
   NOISEPAGE_ASSERT(run_log_manager_, "Must call Start on log manager before handing it buffers");
-  log_serializer_task_->AddBufferToFlushQueue(buffer_segment, policy);
+  auto *stream = streams_.front().get();
+  if (streams_.size() > 1) {
+    // All records in a buffer belong to the same transaction, which picks the stream. A transaction that writes nothing
+    // may hand over an empty buffer, which can go to any stream.
+    IterableBufferSegment<LogRecord> records(buffer_segment);
+    if (records.begin() != records.end()) stream = StreamOf(records.begin()->TxnBegin());
+  }
+  stream->log_serializer_task_->AddBufferToFlushQueue(buffer_segment, policy);
+}
+
+uint64_t LogManager::BeginCommit(const transaction::timestamp_t txn_start) {
+  if (streams_.size() == 1) return 0;
+  return StreamOf(txn_start)->log_serializer_task_->RegisterCommit();
+}
+
+void LogManager::EndCommit(const transaction::timestamp_t txn_start, const uint64_t commit_sequence) {
+  if (streams_.size() == 1) return;
+  StreamOf(txn_start)->log_serializer_task_->UnregisterCommit(commit_sequence);
+}
+
+LogManager::LogStream *LogManager::StreamOf(const transaction::timestamp_t txn_start) const {
+  // Start and commit timestamps come from the same counter, so the start timestamps of a client that runs one
+  // transaction after the other are spaced evenly. Scramble them (Fibonacci hashing) before picking the stream.
+  const uint64_t hash = txn_start.UnderlyingValue() * UINT64_C(0x9E3779B97F4A7C15);
+  return streams_[(hash >> 32) % streams_.size()].get();
+}
+
+void LogManager::RoundsPersisted(const uint32_t stream, std::vector<SerializedRound> *const rounds) {
+  std::vector<CommitCallback> persisted_commits;
+  std::vector<LogSerializerTask *> lagging_streams;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&persisted_latch_);
+    auto &persisted_bound = streams_[stream]->persisted_bound_;
+    const uint64_t old_persisted_bound = persisted_bound;
+    for (auto &round : *rounds) {
+      persisted_bound = std::max(persisted_bound, round.persisted_bound_);
+      if (!round.commits_.empty()) waiting_commits_.emplace(round.horizon_, std::move(round.commits_));
+    }
+
+    // A round's commits are persistent once every commit below its horizon is, in whichever stream
+    uint64_t persisted_commit_sequence = persisted_bound;
+    for (const auto &other : streams_) {
+      persisted_commit_sequence = std::min(persisted_commit_sequence, other->persisted_bound_);
+    }
+    persisted_commit_sequence_ = persisted_commit_sequence;
+    const auto persisted_end = waiting_commits_.upper_bound(persisted_commit_sequence);
+    for (auto it = waiting_commits_.begin(); it != persisted_end; ++it) {
+      persisted_commits.insert(persisted_commits.end(), it->second.begin(), it->second.end());
+    }
+    waiting_commits_.erase(waiting_commits_.begin(), persisted_end);
+
+    // Idle streams back off between rounds of serialization. Wake up the streams that hold back the remaining commits,
+    // but only when this stream made progress so that a commit that takes long to hand over its buffer does not keep
+    // the streams busy.
+    if (persisted_bound > old_persisted_bound && !waiting_commits_.empty()) {
+      for (const auto &other : streams_) {
+        if (other->persisted_bound_ < waiting_commits_.begin()->first) {
+          lagging_streams.emplace_back(other->log_serializer_task_.Get());
+        }
+      }
+    }
+  }
+
+  for (auto &callback : persisted_commits) callback.fn_(callback.arg_);
+  for (auto *const serializer : lagging_streams) serializer->flush_queue_cv_.notify_one();
 }
 
 void LogManager::SetSerializationInterval(int32_t interval) {
   NOISEPAGE_ASSERT(interval > 0, "Log serialization interval should be greater than 0");
   serialization_interval_ = std::chrono::microseconds(interval);
-  if (log_serializer_task_ != nullptr) log_serializer_task_->SetSerializationInterval(interval);
+  for (const auto &stream : streams_) {
+    if (stream->log_serializer_task_ != nullptr) stream->log_serializer_task_->SetSerializationInterval(interval);
+  }
+}
+
+void LogManager::EndReplication() {
+  for (const auto &stream : streams_) stream->log_serializer_task_->EndReplication();
+}
+
+uint64_t LogManager::StartNewSegment() {
+  NOISEPAGE_ASSERT(run_log_manager_, "Can't start a new segment on an un-started LogManager");
+  // The streams switch over one after the other. A transaction's records all go to the same stream, so each of its
+  // records is either in the old or in the new segment of that stream.
+  for (const auto &stream : streams_) {
+    // Hold back the serializer until the disk log consumer task has switched over to the new segment. Between two
+    // rounds of serialization all serialized records have been handed over to the consumer, so the new segment starts
+    // at a record boundary.
+    auto &disk_log_writer_task = *stream->disk_log_writer_task_;
+    common::SpinLatch::ScopedSpinLatch guard(&stream->log_serializer_task_->serialization_latch_);
+    std::unique_lock<std::mutex> lock(disk_log_writer_task.persist_lock_);
+    disk_log_writer_task.next_log_file_path_ = SegmentPath(stream->log_file_path_, current_segment_ + 1);
+    disk_log_writer_task.rotate_ = true;
+    disk_log_writer_task.disk_log_writer_thread_cv_.notify_one();
+
+    // Wait for the disk log consumer task thread to persist the logs and switch over
+    disk_log_writer_task.persist_cv_.wait(lock, [&] { return !disk_log_writer_task.rotate_; });
+    lock.unlock();
+
+    // Recovery must know the persisted bound of every stream even once the older segments are removed
+    if (streams_.size() > 1) stream->log_serializer_task_->RepeatRoundRecord();
+  }
+  // Persist the repeated RoundRecords
+  if (streams_.size() > 1) ForceFlush();
+  return ++current_segment_;
+}
+
+void LogManager::RemoveSegmentsBefore(const uint64_t segment) {
+  for (const auto &stream : streams_) {
+    for (const auto existing : ListSegments(stream->log_file_path_)) {
+      if (existing >= segment) break;
+      std::filesystem::remove(SegmentPath(stream->log_file_path_, existing));
+    }
+  }
+}
+
+std::string LogManager::StreamPath(const std::string &log_file_path, const uint32_t stream) {
+  return stream == 0 ? log_file_path : log_file_path + "-" + std::to_string(stream);
+}
+
+std::vector<std::vector<std::string>> LogManager::StreamSegmentPaths(const std::string &log_file_path,
+                                                                     const uint32_t num_streams) {
+  std::vector<std::vector<std::string>> paths;
+  for (uint32_t stream = 0; stream < num_streams; stream++) {
+    paths.emplace_back(SegmentPaths(StreamPath(log_file_path, stream)));
+  }
+  return paths;
+}
+
+std::string LogManager::SegmentPath(const std::string &log_file_path, const uint64_t segment) {
+  return segment == 0 ? log_file_path : log_file_path + "." + std::to_string(segment);
 }
 
-void LogManager::EndReplication() { log_serializer_task_->EndReplication(); }
+std::vector<uint64_t> LogManager::ListSegments(const std::string &log_file_path) {
+  std::vector<uint64_t> segments;
+  const std::filesystem::path path(log_file_path);
+  if (std::filesystem::exists(path)) segments.push_back(0);
+
+  const auto directory = path.has_parent_path() ? path.parent_path() : std::filesystem::current_path();
+  if (!std::filesystem::is_directory(directory)) return segments;
+  const auto prefix = path.filename().string() + ".";
+  for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+    const auto name = entry.path().filename().string();
+    if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+    const auto suffix = name.substr(prefix.size());
+    if (!std::all_of(suffix.begin(), suffix.end(), [](const char c) { return std::isdigit(c); })) continue;
+    segments.push_back(std::stoull(suffix));
+  }
+  std::sort(segments.begin(), segments.end());
+  return segments;
+}
+
+std::vector<std::string> LogManager::SegmentPaths(const std::string &log_file_path) {
+  std::vector<std::string> paths;
+  for (const auto segment : ListSegments(log_file_path)) {
+    paths.emplace_back(SegmentPath(log_file_path, segment));
+  }
+  return paths;
+}
 
 }  // namespace noisepage::storage
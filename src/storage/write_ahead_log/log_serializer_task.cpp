@@ -71,6 +71,16 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::Process() {
     common::SpinLatch::ScopedSpinLatch serialization_guard(&serialization_latch_);
     NOISEPAGE_ASSERT(serialized_txns_.empty(),
                      "Aggregated txn timestamps should have been handed off to TimestampManager");
+
+    // If the log is split into several streams, a commit of this stream that is not registered at this point takes a
+    // commit sequence number at or above the bound. Commits below the bound were thus either serialized in an earlier
+    // round or are in the buffers grabbed below.
+    uint64_t persisted_bound = 0;
+    if (serialized_rounds_ != nullptr) {
+      std::unique_lock<std::mutex> guard(flush_queue_latch_);
+      persisted_bound = registered_commits_.empty() ? commit_sequence_->load() : *registered_commits_.begin();
+    }
+
     // We continually grab all the buffers until we find there are no new buffers. This way we serialize buffers that
     // came in during the previous serialization loop
 
@@ -128,8 +138,27 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::Process() {
       buffers_processed = true;
     }
 
+    // Every commit in this round registered before the last grab, i.e., below the horizon. Recovery learns the
+    // persisted bound and the horizon from a RoundRecord that closes the round, which an idle round whose bounds did
+    // not move can do without.
+    uint64_t horizon = 0;
+    bool round_record = false;
+    if (serialized_rounds_ != nullptr) {
+      horizon = commit_sequence_->load();
+      round_record = buffers_processed || logged_round_ != std::make_pair(persisted_bound, horizon);
+      if (round_record) SerializeRoundRecord(persisted_bound, horizon);
+    }
+
     // Mark the last buffer that was written to as full
-    if (buffers_processed) HandFilledBufferToWriter();
+    if (buffers_processed || round_record) HandFilledBufferToWriter();
+
+    // Hand over the round even if there was nothing to serialize, so that the persisted bound of an idle stream keeps
+    // up with the other streams
+    if (serialized_rounds_ != nullptr) {
+      serialized_rounds_->Enqueue({persisted_bound, horizon, std::move(commits_in_round_)});
+      commits_in_round_.clear();
+      disk_log_writer_thread_cv_->notify_one();
+    }
 
     // Bulk remove all the transactions we serialized. This prevents having to take the TimestampManager's latch once
     // for each timestamp we remove.
@@ -189,6 +218,11 @@ void LogSerializerTask::HandFilledBufferToWriter() {
                                                           newest_buffer_txn_);
     oat_replicas_ = true;
   }
+  // If the log is split into several streams, the callbacks are invoked per round of serialization instead
+  if (serialized_rounds_ != nullptr) {
+    commits_in_round_.insert(commits_in_round_.end(), commits_in_buffer_.begin(), commits_in_buffer_.end());
+    commits_in_buffer_.clear();
+  }
   // Hand over the filled buffer
   filled_buffer_queue_->Enqueue(std::make_pair(filled_buffer_, commits_in_buffer_));
   // Signal disk log consumer task thread that a buffer has been handed over
@@ -198,6 +232,25 @@ void LogSerializerTask::HandFilledBufferToWriter() {
   filled_buffer_ = nullptr;
 }
 
+void LogSerializerTask::SerializeRoundRecord(const uint64_t persisted_bound, const uint64_t horizon) {
+  // The record belongs to no transaction and only needs to be persisted, a log with several streams is not replicated
+  const transaction::TransactionPolicy policy{transaction::DurabilityPolicy::SYNC,
+                                              transaction::ReplicationPolicy::DISABLE};
+  if (filled_buffer_policy_.has_value() && !(filled_buffer_policy_.value() == policy)) HandFilledBufferToWriter();
+  filled_buffer_policy_ = policy;
+
+  byte *const buffer = common::AllocationUtil::AllocateAligned(RoundRecord::Size());
+  SerializeRecord(*RoundRecord::Initialize(buffer, run_, persisted_bound, horizon));
+  delete[] buffer;
+  logged_round_ = std::make_pair(persisted_bound, horizon);
+}
+
+void LogSerializerTask::RepeatRoundRecord() {
+  if (!logged_round_.has_value()) return;
+  SerializeRoundRecord(logged_round_->first, logged_round_->second);
+  HandFilledBufferToWriter();
+}
+
 std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::SerializeBuffer(
     IterableBufferSegment<LogRecord> *buffer_to_serialize) {
   uint64_t num_bytes = 0, num_records = 0, num_txns = 0;
@@ -242,95 +295,7 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::SerializeBuffer(
 }
 
 uint64_t LogSerializerTask::SerializeRecord(const noisepage::storage::LogRecord &record) {
-  uint64_t num_bytes = 0;
-  // First, serialize out fields common across all LogRecordType's.
-
-  // Note: This is the in-memory size of the log record itself, i.e. inclusive of padding and not considering the size
-  // of any potential varlen entries. It is logically different from the size of the serialized record, which the log
-  // manager generates in this function. In particular, the later value is very likely to be strictly smaller when the
-  // LogRecordType is REDO. On recovery, the goal is to turn the serialized format back into an in-memory log record of
-  // this size.
-  num_bytes += WriteValue(record.Size());
-
-  num_bytes += WriteValue(record.RecordType());
-  num_bytes += WriteValue(record.TxnBegin());
-
-  switch (record.RecordType()) {
-    case LogRecordType::REDO: {
-      auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
-      num_bytes += WriteValue(record_body->GetDatabaseOid());
-      num_bytes += WriteValue(record_body->GetTableOid());
-      num_bytes += WriteValue(record_body->GetTupleSlot());
-
-      auto *delta = record_body->Delta();
-      // Write out which column ids this redo record is concerned with. On recovery, we can construct the appropriate
-      // ProjectedRowInitializer from these ids and their corresponding block layout.
-      num_bytes += WriteValue(delta->NumColumns());
-      num_bytes += WriteValue(delta->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * delta->NumColumns());
-
-      // Write out the attr sizes boundaries, this way we can deserialize the records without the need of the block
-      // layout
-      const auto &block_layout = record_body->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
-      uint16_t boundaries[NUM_ATTR_BOUNDARIES];
-      memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
-      StorageUtil::ComputeAttributeSizeBoundaries(block_layout, delta->ColumnIds(), delta->NumColumns(), boundaries);
-      WriteValue(boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
-
-      // Write out the null bitmap.
-      num_bytes += WriteValue(&(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
-
-      // Write out attribute values
-      for (uint16_t i = 0; i < delta->NumColumns(); i++) {
-        const auto *column_value_address = delta->AccessWithNullCheck(i);
-        if (column_value_address == nullptr) {
-          // If the column in this REDO record is null, then there's nothing to serialize out. The bitmap contains all
-          // the relevant information.
-          continue;
-        }
-        // Get the column id of the current column in the ProjectedRow.
-        col_id_t col_id = delta->ColumnIds()[i];
-
-        if (block_layout.IsVarlen(col_id)) {
-          // Inline column value is a pointer to a VarlenEntry, so reinterpret as such.
-          const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(column_value_address);
-          // Serialize out length of the varlen entry.
-          num_bytes += WriteValue(varlen_entry->Size());
-          if (varlen_entry->IsInlined()) {
-            // Serialize out the prefix of the varlen entry.
-            num_bytes += WriteValue(varlen_entry->Prefix(), varlen_entry->Size());
-          } else {
-            // Serialize out the content field of the varlen entry.
-            num_bytes += WriteValue(varlen_entry->Content(), varlen_entry->Size());
-          }
-        } else {
-          // Inline column value is the actual data we want to serialize out.
-          // Note that by writing out AttrSize(col_id) bytes instead of just the difference between successive offsets
-          // of the delta record, we avoid serializing out any potential padding.
-          num_bytes += WriteValue(column_value_address, block_layout.AttrSize(col_id));
-        }
-      }
-      break;
-    }
-    case LogRecordType::DELETE: {
-      auto *record_body = record.GetUnderlyingRecordBodyAs<DeleteRecord>();
-      num_bytes += WriteValue(record_body->GetDatabaseOid());
-      num_bytes += WriteValue(record_body->GetTableOid());
-      num_bytes += WriteValue(record_body->GetTupleSlot());
-      break;
-    }
-    case LogRecordType::COMMIT: {
-      auto *record_body = record.GetUnderlyingRecordBodyAs<CommitRecord>();
-      num_bytes += WriteValue(record_body->CommitTime());
-      num_bytes += WriteValue(record_body->OldestActiveTxn());
-      break;
-    }
-    case LogRecordType::ABORT: {
-      // AbortRecord does not hold any additional metadata
-      break;
-    }
-  }
-
-  return num_bytes;
+  return SerializeRecord(record, [this](const void *val, const uint32_t size) { return WriteValue(val, size); });
 }
 
 uint32_t LogSerializerTask::WriteValue(const void *val, const uint32_t size) {
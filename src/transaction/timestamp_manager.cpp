@@ -5,10 +5,56 @@
 
 namespace noisepage::transaction {
 
+namespace {
+// The number of threads that have begun a txn so far, used to spread threads over the begin slots.
+std::atomic<uint32_t> num_beginning_threads{0};
+}  // namespace
+
+timestamp_t TimestampManager::BeginTransaction() {
+  // There is a three-way race that needs to be prevented. Specifically, we cannot allow both a transaction to commit
+  // and the GC to poll for the oldest running transaction in between this transaction acquiring its begin timestamp
+  // and getting inserted into the running transactions set. Before acquiring its begin timestamp, the transaction
+  // therefore announces a lower bound of it in a begin slot, which OldestTransactionStartTime() takes into account
+  // until the transaction has been inserted.
+  // Threads stick to the slot they last used, so that concurrent begins rarely contend on the same slot.
+  static thread_local uint32_t begin_slot_hint = num_beginning_threads++ % NUM_BEGIN_SLOTS;
+  BeginSlot *slot;
+  for (uint32_t idx = begin_slot_hint;; idx = (idx + 1) % NUM_BEGIN_SLOTS) {
+    slot = &begin_slots_[idx];
+    timestamp_t expected = INVALID_TXN_TIMESTAMP;
+    if (slot->lower_bound_.compare_exchange_strong(expected, time_.load())) {
+      begin_slot_hint = idx;
+      break;
+    }
+  }
+
+  const timestamp_t start_time = time_++;
+  {
+    RunningTxnShard &shard = ShardFor(start_time);
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    const auto ret UNUSED_ATTRIBUTE = shard.txns_.emplace(start_time);
+    NOISEPAGE_ASSERT(ret.second, "commit start time should be globally unique");
+  }
+  slot->lower_bound_.store(INVALID_TXN_TIMESTAMP);
+  return start_time;
+}
+
 timestamp_t TimestampManager::OldestTransactionStartTime() {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const auto &oldest_txn = std::min_element(curr_running_txns_.cbegin(), curr_running_txns_.cend());
-  timestamp_t result = (oldest_txn != curr_running_txns_.end()) ? *oldest_txn : time_.load();
+  // Any transaction that began before the current time is either still announced in its begin slot, or already in
+  // the running transaction set by the time its shard is visited. The begin slots must hence be visited first.
+  timestamp_t result = time_.load();
+  for (const auto &slot : begin_slots_) {
+    const timestamp_t lower_bound = slot.lower_bound_.load();
+    if (lower_bound != INVALID_TXN_TIMESTAMP) {
+      result = std::min(result, lower_bound);
+    }
+  }
+  for (auto &shard : running_txns_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    if (!shard.txns_.empty()) {
+      result = std::min(result, *shard.txns_.begin());
+    }
+  }
   cached_oldest_txn_start_time_.store(result);  // Cache the timestamp
   return result;
 }
@@ -16,18 +62,36 @@ timestamp_t TimestampManager::OldestTransactionStartTime() {
 timestamp_t TimestampManager::CachedOldestTransactionStartTime() { return cached_oldest_txn_start_time_.load(); }
 
 void TimestampManager::RemoveTransaction(timestamp_t timestamp) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
+  RunningTxnShard &shard = ShardFor(timestamp);
+  common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+  const size_t ret UNUSED_ATTRIBUTE = shard.txns_.erase(timestamp);
   NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
 }
 
 bool TimestampManager::RemoveTransactions(const std::vector<noisepage::transaction::timestamp_t> &timestamps) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  for (const auto &timestamp : timestamps) {
-    const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-    NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+  // Group the timestamps by shard so that every shard's latch is only taken once.
+  std::vector<timestamp_t> sorted(timestamps);
+  std::sort(sorted.begin(), sorted.end(), [](const timestamp_t a, const timestamp_t b) {
+    return a.UnderlyingValue() % NUM_RUNNING_TXN_SHARDS < b.UnderlyingValue() % NUM_RUNNING_TXN_SHARDS;
+  });
+  for (auto begin = sorted.cbegin(); begin != sorted.cend();) {
+    RunningTxnShard &shard = ShardFor(*begin);
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    for (; begin != sorted.cend() && &ShardFor(*begin) == &shard; ++begin) {
+      const size_t ret UNUSED_ATTRIBUTE = shard.txns_.erase(*begin);
+      NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+    }
+  }
+  // A txn that has announced itself in a begin slot but has not been inserted into its shard yet is still running. As
+  // in OldestTransactionStartTime(), the begin slots must be visited before the shards.
+  if (std::any_of(begin_slots_.cbegin(), begin_slots_.cend(),
+                  [](const BeginSlot &slot) { return slot.lower_bound_.load() != INVALID_TXN_TIMESTAMP; })) {
+    return false;
   }
-  return curr_running_txns_.empty();
+  return std::all_of(running_txns_.begin(), running_txns_.end(), [](RunningTxnShard &shard) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    return shard.txns_.empty();
+  });
 }
 
 }  // namespace noisepage::transaction
@@ -0,0 +1,66 @@
+#include "transaction/transaction_context.h"
+
+namespace noisepage::transaction {
+std::unique_ptr<TransactionContext> TransactionContext::BeginWorker() {
+  common::SpinLatch::ScopedSpinLatch guard(&workers_latch_);
+  // Records staged before the parallel operation must reach the log before any of the worker's records.
+  redo_buffer_.Flush(GetTransactionPolicy());
+  auto worker = std::make_unique<TransactionContext>(start_time_, finish_time_.load(), buffer_pool_, log_manager_);
+  worker->SetDurabilityPolicy(durability_policy_);
+  worker->SetReplicationPolicy(replication_policy_);
+  return worker;
+}
+
+void TransactionContext::MergeWorker(std::unique_ptr<TransactionContext> worker) {
+  NOISEPAGE_ASSERT(worker->start_time_ == start_time_, "Worker must have been created by this transaction");
+  common::SpinLatch::ScopedSpinLatch guard(&workers_latch_);
+  if (worker->must_abort_ || must_abort_) {
+    // Operators abort through this txn rather than the worker, so either may have been marked. The worker stopped at
+    // its conflicting write, which is therefore its last record. Our own check on abort would not see it.
+    worker->GCLastUpdateOnAbort();
+    must_abort_ = true;
+  }
+  undo_buffer_.Append(&worker->undo_buffer_);
+  redo_buffer_.Append(&worker->redo_buffer_, GetTransactionPolicy());
+  loose_ptrs_.insert(loose_ptrs_.end(), worker->loose_ptrs_.begin(), worker->loose_ptrs_.end());
+  worker->loose_ptrs_.clear();
+  // The worker's actions happened after ours, so they run first.
+  abort_actions_.splice_after(abort_actions_.before_begin(), worker->abort_actions_);
+  commit_actions_.splice_after(commit_actions_.before_begin(), worker->commit_actions_);
+}
+
+void TransactionContext::GCLastUpdateOnAbort() {
+  auto *last_log_record = reinterpret_cast<storage::LogRecord *>(redo_buffer_.LastRecord());
+  auto *last_undo_record = reinterpret_cast<storage::UndoRecord *>(undo_buffer_.LastRecord());
+  // It is possible that there is nothing to do here, because we aborted for reasons other than a
+  // write-write conflict (client calling abort, validation phase failure, etc.). We can
+  // tell whether a write-write conflict happened by checking the last entry of the undo to see
+  // if the update was indeed installed.
+  // TODO(Tianyu): This way of gcing varlen implies that we abort right away on a conflict
+  // and not perform any further updates. Shouldn't be a stretch.
+  if (last_log_record == nullptr) return;                                     // there are no updates
+  if (last_log_record->RecordType() != storage::LogRecordType::REDO) return;  // Only redos need to be gc-ed.
+
+  // Last update can potentially contain a varlen that needs to be gc-ed. We now need to check if it
+  // was installed or not.
+  auto *redo = last_log_record->GetUnderlyingRecordBodyAs<storage::RedoRecord>();
+  NOISEPAGE_ASSERT(redo->GetTupleSlot() == last_undo_record->Slot(),
+                   "Last undo record and redo record must correspond to each other");
+  if (last_undo_record->Table() != nullptr) return;  // the update was installed and will be handled by the GC
+
+  // We need to free any varlen memory in the last update if the code reaches here
+  const storage::BlockLayout &layout = redo->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
+  for (uint16_t i = 0; i < redo->Delta()->NumColumns(); i++) {
+    // Need to deallocate any possible varlen, as updates may have already been logged out and lost.
+    storage::col_id_t col_id = redo->Delta()->ColumnIds()[i];
+    if (layout.IsVarlen(col_id)) {
+      auto *varlen = reinterpret_cast<storage::VarlenEntry *>(redo->Delta()->AccessWithNullCheck(i));
+      if (varlen != nullptr) {
+        NOISEPAGE_ASSERT(varlen->NeedReclaim() || varlen->IsInlined(),
+                         "Fresh updates cannot be compacted or compressed");
+        if (varlen->NeedReclaim()) loose_ptrs_.push_back(varlen->Content());
+      }
+    }
+  }
+}
+}  // namespace noisepage::transaction
@@ -6,6 +6,7 @@
 #include "common/scoped_timer.h"
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
+#include "storage/write_ahead_log/log_manager.h"
 
 namespace noisepage::transaction {
 TransactionContext *TransactionManager::BeginTransaction() {
@@ -119,6 +120,10 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
       !txn->must_abort_,
       "This txn was marked that it must abort. Set a breakpoint at TransactionContext::MustAbort() to see a "
       "stack trace for when this flag is getting tripped.");
+  // If the log is split into several streams, the LogManager must know about this commit before it takes its commit
+  // timestamp and until it hands over its commit record, so that it is acknowledged only after every commit that may
+  // precede it in another stream is persisted.
+  const uint64_t commit_sequence = log_manager_ != DISABLED ? log_manager_->BeginCommit(txn->StartTime()) : 0;
   result = txn->IsReadOnly() ? timestamp_manager_->CheckOutTimestamp() : UpdatingCommitCriticalSection(txn);
 
   txn->finish_time_.store(result);
@@ -158,10 +163,11 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
     oldest_active_txn = timestamp_manager_->CachedOldestTransactionStartTime();
   }
   LogCommit(txn, result, callback, callback_arg, oldest_active_txn);
+  if (log_manager_ != DISABLED) log_manager_->EndCommit(txn->StartTime(), commit_sequence);
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
-    common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+    common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
     // It is not necessary to have to GC process read-only transactions, but it's probably faster to call free off
     // the critical path there anyway
     // Also note here that GC will figure out what varlen entries to GC, as opposed to in the abort case.
@@ -232,13 +238,13 @@ timestamp_t TransactionManager::Abort(TransactionContext *const txn) {
 
   // The last update might not have been installed, and thus Rollback would miss it if it contains a
   // varlen entry whose memory content needs to be freed. We have to check for this case manually.
-  GCLastUpdateOnAbort(txn);
+  txn->GCLastUpdateOnAbort();
 
   LogAbort(txn);
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
-    common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+    common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
     // It is not necessary to have to GC process read-only transactions, but it's probably faster to call free off
     // the critical path there anyway
     // Also note here that GC will figure out what varlen entries to GC, as opposed to in the abort case.
@@ -248,43 +254,8 @@ timestamp_t TransactionManager::Abort(TransactionContext *const txn) {
   return abort_time;
 }
 
-void TransactionManager::GCLastUpdateOnAbort(TransactionContext *const txn) {
-  auto *last_log_record = reinterpret_cast<storage::LogRecord *>(txn->redo_buffer_.LastRecord());
-  auto *last_undo_record = reinterpret_cast<storage::UndoRecord *>(txn->undo_buffer_.LastRecord());
-  // It is possible that there is nothing to do here, because we aborted for reasons other than a
-  // write-write conflict (client calling abort, validation phase failure, etc.). We can
-  // tell whether a write-write conflict happened by checking the last entry of the undo to see
-  // if the update was indeed installed.
-  // TODO(Tianyu): This way of gcing varlen implies that we abort right away on a conflict
-  // and not perform any further updates. Shouldn't be a stretch.
-  if (last_log_record == nullptr) return;                                     // there are no updates
-  if (last_log_record->RecordType() != storage::LogRecordType::REDO) return;  // Only redos need to be gc-ed.
-
-  // Last update can potentially contain a varlen that needs to be gc-ed. We now need to check if it
-  // was installed or not.
-  auto *redo = last_log_record->GetUnderlyingRecordBodyAs<storage::RedoRecord>();
-  NOISEPAGE_ASSERT(redo->GetTupleSlot() == last_undo_record->Slot(),
-                   "Last undo record and redo record must correspond to each other");
-  if (last_undo_record->Table() != nullptr) return;  // the update was installed and will be handled by the GC
-
-  // We need to free any varlen memory in the last update if the code reaches here
-  const storage::BlockLayout &layout = redo->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
-  for (uint16_t i = 0; i < redo->Delta()->NumColumns(); i++) {
-    // Need to deallocate any possible varlen, as updates may have already been logged out and lost.
-    storage::col_id_t col_id = redo->Delta()->ColumnIds()[i];
-    if (layout.IsVarlen(col_id)) {
-      auto *varlen = reinterpret_cast<storage::VarlenEntry *>(redo->Delta()->AccessWithNullCheck(i));
-      if (varlen != nullptr) {
-        NOISEPAGE_ASSERT(varlen->NeedReclaim() || varlen->IsInlined(),
-                         "Fresh updates cannot be compacted or compressed");
-        if (varlen->NeedReclaim()) txn->loose_ptrs_.push_back(varlen->Content());
-      }
-    }
-  }
-}
-
 TransactionQueue TransactionManager::CompletedTransactionsForGC() {
-  common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+  common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
   return std::move(completed_txns_);
 }
 
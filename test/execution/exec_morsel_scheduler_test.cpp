@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <numeric>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "execution/exec/morsel_scheduler.h"
+#include "execution/tpl_test.h"
+
+namespace noisepage::execution::exec::test {
+
+using namespace std::chrono_literals;  // NOLINT
+
+class MorselSchedulerTest : public TplTest {};
+
+// NOLINTNEXTLINE
+TEST_F(MorselSchedulerTest, ParallelForCoversRange) {
+  MorselScheduler scheduler(4);
+
+  // Every element of the range must be processed exactly once, in morsels of at most the grain size.
+  for (const std::size_t grain_size : {1, 7, 100, 20000}) {
+    std::vector<std::atomic<uint32_t>> counts(10000);
+    std::atomic<bool> oversized{false};
+    scheduler.ParallelFor({}, 0, counts.size(), grain_size, [&](const std::size_t begin, const std::size_t end) {
+      oversized = oversized || end - begin > grain_size;
+      for (std::size_t i = begin; i < end; i++) {
+        counts[i]++;
+      }
+    });
+    EXPECT_FALSE(oversized);
+    EXPECT_TRUE(std::all_of(counts.begin(), counts.end(), [](const auto &count) { return count == 1; }));
+  }
+
+  // Empty ranges don't execute anything.
+  scheduler.ParallelFor({}, 10, 10, 1, [](std::size_t, std::size_t) { FAIL(); });
+}
+
+// NOLINTNEXTLINE
+TEST_F(MorselSchedulerTest, ParallelForEach) {
+  MorselScheduler scheduler(4);
+
+  std::vector<uint64_t> values(1000);
+  std::iota(values.begin(), values.end(), 0);
+  scheduler.ParallelForEach({}, values, [](uint64_t &value) { value *= 2; });
+  for (uint64_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(i * 2, values[i]);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(MorselSchedulerTest, MaxParallelism) {
+  MorselScheduler scheduler(8);
+
+  // No more threads than the query allows, the submitting thread included, work on the job at once.
+  std::atomic<uint32_t> running{0}, max_running{0};
+  scheduler.ParallelFor({MorselScheduler::DEFAULT_PRIORITY, 2}, 0, 64, 1, [&](std::size_t, std::size_t) {
+    const uint32_t now = ++running;
+    uint32_t prev = max_running;
+    while (prev < now && !max_running.compare_exchange_weak(prev, now)) {
+    }
+    std::this_thread::sleep_for(1ms);
+    running--;
+  });
+  EXPECT_LE(max_running, 2u);
+}
+
+// NOLINTNEXTLINE
+TEST_F(MorselSchedulerTest, ExceptionIsRethrown) {
+  MorselScheduler scheduler(4);
+
+  std::atomic<uint32_t> executed{0};
+  EXPECT_THROW(scheduler.ParallelFor({}, 0, 1000, 1,
+                                     [&](const std::size_t begin, std::size_t) {
+                                       executed++;
+                                       if (begin == 10) {
+                                         throw std::runtime_error("morsel failed");
+                                       }
+                                     }),
+               std::runtime_error);
+  EXPECT_GT(executed, 0u);
+
+  // The scheduler is still usable afterwards.
+  std::atomic<uint32_t> count{0};
+  scheduler.ParallelFor({}, 0, 100, 1, [&](std::size_t, std::size_t) { count++; });
+  EXPECT_EQ(100u, count);
+}
+
+// NOLINTNEXTLINE
+TEST_F(MorselSchedulerTest, NestedJobs) {
+  MorselScheduler scheduler(2);
+
+  // Morsels submitting jobs themselves must not deadlock, even with more jobs than workers.
+  std::atomic<uint32_t> count{0};
+  scheduler.ParallelFor({}, 0, 8, 1, [&](std::size_t, std::size_t) {
+    scheduler.ParallelFor({}, 0, 8, 1, [&](std::size_t, std::size_t) { count++; });
+  });
+  EXPECT_EQ(64u, count);
+}
+
+// NOLINTNEXTLINE
+TEST_F(MorselSchedulerTest, ConcurrentQueries) {
+  MorselScheduler scheduler(4);
+
+  // Queries of different priorities submitting jobs concurrently all complete.
+  constexpr uint32_t num_queries = 8;
+  std::vector<std::atomic<uint64_t>> sums(num_queries);
+  std::vector<std::thread> queries;
+  for (uint32_t query = 0; query < num_queries; query++) {
+    queries.emplace_back([&, query] {
+      for (uint32_t round = 0; round < 10; round++) {
+        scheduler.ParallelFor({query + 1, 0}, 0, 1000, 10, [&](const std::size_t begin, const std::size_t end) {
+          for (std::size_t i = begin; i < end; i++) {
+            sums[query] += i;
+          }
+        });
+      }
+    });
+  }
+  for (auto &query : queries) {
+    query.join();
+  }
+  for (const auto &sum : sums) {
+    EXPECT_EQ(10u * 999u * 1000u / 2, sum);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(MorselSchedulerTest, PriorityShare) {
+  MorselScheduler scheduler(1);
+
+  // While two queries compete for the worker, it splits its morsels by the queries' priorities. The
+  // submitting threads park on their first morsel, so that the worker runs all the others and its
+  // picks only depend on the charges of the jobs, not on timing.
+  constexpr uint32_t low_priority = 1, high_priority = 3, num_counted = 400;
+  std::atomic<uint32_t> parked_submitters{0}, worker_picks{0};
+  std::atomic<bool> release{false};
+  std::vector<std::atomic<uint32_t>> worker_morsels(2);
+  std::vector<std::thread> competing_queries;
+  for (const uint32_t priority : {low_priority, high_priority}) {
+    competing_queries.emplace_back([&, priority] {
+      const auto submitter = std::this_thread::get_id();
+      const bool is_high = priority == high_priority;
+      scheduler.ParallelFor({priority, 0}, 0, 10 * num_counted, 1, [&](std::size_t, std::size_t) {
+        if (std::this_thread::get_id() == submitter) {
+          parked_submitters++;
+          while (!release) {
+            std::this_thread::yield();
+          }
+          return;
+        }
+        // Both jobs are listed once their submitters run a morsel. The first pick of the worker may
+        // precede that, so it is not counted.
+        while (parked_submitters < 2) {
+          std::this_thread::yield();
+        }
+        const uint32_t pick = worker_picks++;
+        if (pick > 0 && pick <= num_counted) {
+          worker_morsels[is_high]++;
+        }
+        if (pick == num_counted) {
+          release = true;
+        }
+      });
+    });
+  }
+  for (auto &query : competing_queries) {
+    query.join();
+  }
+  EXPECT_EQ(num_counted, worker_morsels[0] + worker_morsels[1]);
+  EXPECT_NEAR(num_counted * high_priority / (low_priority + high_priority), worker_morsels[1], 3);
+}
+
+}  // namespace noisepage::execution::exec::test
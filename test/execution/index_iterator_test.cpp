@@ -1,7 +1,9 @@
 #include "execution/sql/index_iterator.h"
 
+#include <algorithm>
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "catalog/catalog_defs.h"
 #include "execution/sql/table_vector_iterator.h"
@@ -75,6 +77,99 @@ TEST_F(IndexIteratorTest, SimpleIndexIteratorTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(IndexIteratorTest, BatchScanKeyTest) {
+  //
+  // Probe the index with batches of keys, one batch per vector projection
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  auto index_oid = exec_ctx_->GetAccessor()->GetIndexOid(NSOid(), "index_1");
+  std::array<uint32_t, 1> col_oids{1};
+  TableVectorIterator table_iter(exec_ctx_.get(), table_oid.UnderlyingValue(), col_oids.data(),
+                                 static_cast<uint32_t>(col_oids.size()));
+  IndexIterator index_iter{exec_ctx_.get(),
+                           1,
+                           table_oid.UnderlyingValue(),
+                           index_oid.UnderlyingValue(),
+                           col_oids.data(),
+                           static_cast<uint32_t>(col_oids.size())};
+  table_iter.Init();
+  index_iter.Init();
+  VectorProjectionIterator *vpi = table_iter.GetVectorProjectionIterator();
+
+  while (table_iter.Advance()) {
+    std::vector<int32_t> keys;
+    for (; vpi->HasNext(); vpi->Advance()) {
+      keys.push_back(*vpi->GetValue<int32_t, false>(0, nullptr));
+    }
+    vpi->Reset();
+    std::reverse(keys.begin(), keys.end());
+
+    for (const bool sort_keys : {false, true}) {
+      // Add the keys in reverse order, each one twice, followed by a key that does not exist.
+      for (const auto key : keys) {
+        for (uint32_t i = 0; i < 2; i++) {
+          index_iter.PR()->Set<int32_t, false>(0, key, false);
+          index_iter.AddBatchKey();
+        }
+      }
+      index_iter.PR()->Set<int32_t, false>(0, -1, false);
+      index_iter.AddBatchKey();
+      index_iter.ScanKeyBatch(sort_keys);
+
+      // The results come back in the order the keys were added.
+      for (const auto key : keys) {
+        for (uint32_t i = 0; i < 2; i++) {
+          index_iter.NextBatchKey();
+          ASSERT_TRUE(index_iter.Advance());
+          auto *val = index_iter.TablePR()->Get<int32_t, false>(0, nullptr);
+          ASSERT_EQ(key, *val);
+          ASSERT_FALSE(index_iter.Advance());
+        }
+      }
+      index_iter.NextBatchKey();
+      ASSERT_FALSE(index_iter.Advance());
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexIteratorTest, AdaptiveHashTableTest) {
+  //
+  // Switch exact-key lookups from the index to a hash table after one probe per block, unless the hash table would
+  // outgrow its size limit
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  auto sql_table = exec_ctx_->GetAccessor()->GetTable(table_oid);
+  auto index_oid = exec_ctx_->GetAccessor()->GetIndexOid(NSOid(), "index_1");
+  std::array<uint32_t, 1> col_oids{1};
+  const uint32_t threshold = sql_table->GetNumBlocks();
+  for (const uint64_t max_size : {uint64_t{0}, uint64_t{1024}}) {
+    SetIndexJoinHashSwitch(1, max_size);
+    auto exec_ctx = MakeExecCtx();
+    IndexIterator index_iter{exec_ctx.get(),
+                             1,
+                             table_oid.UnderlyingValue(),
+                             index_oid.UnderlyingValue(),
+                             col_oids.data(),
+                             static_cast<uint32_t>(col_oids.size())};
+    index_iter.Init();
+
+    // The lookups return the same results before and after the switch.
+    for (uint32_t key = 0; key < TEST1_SIZE; key++) {
+      index_iter.PR()->Set<int32_t, false>(0, static_cast<int32_t>(key), false);
+      index_iter.ScanKey();
+      ASSERT_EQ(index_iter.IsUsingHashTable(), max_size == 0 && key >= threshold);
+      ASSERT_TRUE(index_iter.Advance());
+      auto *val = index_iter.TablePR()->Get<int32_t, false>(0, nullptr);
+      ASSERT_EQ(static_cast<int32_t>(key), *val);
+      ASSERT_FALSE(index_iter.Advance());
+    }
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(IndexIteratorTest, SimpleAscendingScanTest) {
   //
@@ -191,6 +191,36 @@ TEST_F(AggregationHashTableTest, SimplePartitionedInsertionTest) {
   EXPECT_GT(AggTable()->GetStatistics()->num_flushes_, 0);
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, PreAggregationBypassTest) {
+  const auto insert = [](AggregationHashTable *agg_table, uint32_t num_tuples, uint32_t num_aggs) {
+    for (uint32_t idx = 0; idx < num_tuples; idx++) {
+      InputTuple input(idx % num_aggs, 1);
+      auto *existing = reinterpret_cast<AggTuple *>(
+          agg_table->Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+      if (existing != nullptr) {
+        existing->Advance(input);
+      } else {
+        auto *new_agg = agg_table->AllocInputTuplePartitioned(input.Hash());
+        new (new_agg) AggTuple(input);
+      }
+    }
+  };
+
+  // Few groups are aggregated in the main table
+  insert(AggTable(), 100000, 100);
+  EXPECT_EQ(0, AggTable()->GetStatistics()->num_bypassed_);
+
+  // Unique groups are not, once the first flush has shown that nothing is gained
+  auto exec_ctx = MakeExecCtx();
+  AggregationHashTable unique_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+  insert(&unique_table, 100000, 100000);
+  const auto *stats = unique_table.GetStatistics();
+  EXPECT_GT(stats->num_flushes_, 0);
+  EXPECT_GT(stats->num_bypassed_, 0);
+  EXPECT_EQ(100000, stats->num_inserts_);
+}
+
 // NOLINTNEXTLINE
 TEST_F(AggregationHashTableTest, BatchProcessTest) {
   constexpr uint32_t num_groups = 512;
@@ -438,4 +468,87 @@ TEST_F(AggregationHashTableTest, ParallelAggregationTest) {
   EXPECT_EQ(num_aggs, query_state.row_count_.load(std::memory_order_seq_cst));
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, ParallelAggregationSpillTest) {
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  // A one-byte budget forces every flush of a thread-local table to spill.
+  exec_ctx->GetMemoryPool()->GetTracker()->SetMemoryBudget(1);
+
+  struct QueryState {
+    std::atomic<uint32_t> row_count_;
+    std::atomic<uint64_t> sum_;
+  };
+
+  QueryState query_state{0, 0};
+  MemoryPool memory(nullptr);
+  ThreadStateContainer container(&memory);
+
+  container.Reset(
+      sizeof(AggregationHashTable),
+      [](void *ctx, void *aht) {
+        auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+        new (aht) AggregationHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(AggTuple));
+      },
+      [](void *ctx, void *aht) { std::destroy_at(reinterpret_cast<AggregationHashTable *>(aht)); }, exec_ctx.get());
+
+  // Enough distinct groups to flush the thread-local tables several times.
+  constexpr uint32_t num_aggs = 50000;
+  constexpr uint32_t num_inserts_per_thread = 100000;
+  LaunchParallel(4, [&](auto tid) {
+    auto agg_table = container.AccessCurrentThreadStateAs<AggregationHashTable>();
+
+    for (uint32_t idx = 0; idx < num_inserts_per_thread; idx++) {
+      InputTuple input(idx % num_aggs, 1);
+      auto *existing = reinterpret_cast<AggTuple *>(
+          agg_table->Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+      if (existing != nullptr) {
+        existing->Advance(input);
+      } else {
+        auto *new_agg = agg_table->AllocInputTuplePartitioned(input.Hash());
+        new (new_agg) AggTuple(input);
+      }
+    }
+  });
+
+  // At least one thread-local table must have spilled.
+  std::vector<AggregationHashTable *> tl_tables;
+  container.CollectThreadLocalStateElementsAs(&tl_tables, 0);
+  uint64_t num_spills = 0;
+  for (auto *table : tl_tables) {
+    num_spills += table->GetStatistics()->num_spills_;
+  }
+  EXPECT_GT(num_spills, 0);
+
+  AggregationHashTable main_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+  main_table.TransferMemoryAndPartitions(
+      &container, 0, [](void *ctx, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
+        for (; iter->HasNext(); iter->Next()) {
+          auto *partial_agg = iter->GetRowAs<AggTuple>();
+          auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetRowHash(), AggAggKeyEq, partial_agg));
+          if (existing != nullptr) {
+            existing->Merge(*partial_agg);
+          } else {
+            table->Insert(iter->GetEntryForRow());
+          }
+        }
+      });
+
+  container.Clear();
+
+  // Each group must be produced exactly once, and no input may be lost.
+  main_table.ExecutePartitionedScan(&query_state, [](void *query_state, void *thread_state,
+                                                     const AggregationHashTable *agg_table) {
+    auto *qs = reinterpret_cast<QueryState *>(query_state);
+    qs->row_count_ += agg_table->GetTupleCount();
+    for (AHTIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+      qs->sum_ += reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow())->count1_;
+    }
+  });
+
+  EXPECT_EQ(num_aggs, query_state.row_count_.load(std::memory_order_seq_cst));
+  EXPECT_EQ(4 * num_inserts_per_thread, query_state.sum_.load(std::memory_order_seq_cst));
+}
+
 }  // namespace noisepage::execution::sql
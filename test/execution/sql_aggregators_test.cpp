@@ -1,3 +1,6 @@
+#include <string>
+#include <vector>
+
 #include "execution/sql/aggregators.h"
 #include "execution/sql/value.h"
 #include "execution/sql_test.h"
@@ -1641,4 +1644,100 @@ TEST_F(AggregatorsTest, HistogramTimestamp) {
   }
 }
 
+// ---------------------------------------------------------
+// Approximate Aggregate Tests
+// ---------------------------------------------------------
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorsTest, ApproxCountDistinctInt) {
+  // An empty aggregate counts nothing, and neither do NULL inputs
+  {
+    IntegerApproxCountDistinctAggregate count;
+    EXPECT_EQ(0, count.GetResult().val_);
+    count.Advance(Integer::Null());
+    EXPECT_EQ(0, count.GetResult().val_);
+  }
+
+  // Two partial aggregates over overlapping ranges with repeated values
+  IntegerApproxCountDistinctAggregate count1, count2;
+  for (int64_t i = 0; i < 60000; i++) {
+    count1.Advance(Integer(i % 30000));
+    count2.Advance(Integer(20000 + i % 30000));
+  }
+  EXPECT_NEAR(30000, count1.GetResult().val_, 30000 * 0.05);
+  EXPECT_NEAR(30000, count2.GetResult().val_, 30000 * 0.05);
+
+  // The merged aggregate counts the union of both ranges
+  count1.Merge(count2);
+  EXPECT_NEAR(50000, count1.GetResult().val_, 50000 * 0.05);
+
+  // Merging an empty aggregate changes nothing
+  const auto estimate = count1.GetResult().val_;
+  IntegerApproxCountDistinctAggregate empty_count;
+  count1.Merge(empty_count);
+  EXPECT_EQ(estimate, count1.GetResult().val_);
+
+  // Reset forgets all values
+  count1.Reset();
+  EXPECT_EQ(0, count1.GetResult().val_);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorsTest, ApproxCountDistinctString) {
+  StringApproxCountDistinctAggregate count;
+
+  // Strings are counted by their contents, not by where they are stored
+  std::vector<std::string> strings;
+  for (uint32_t i = 0; i < 1000; i++) {
+    strings.emplace_back("a string that is too long to be inlined " + std::to_string(i % 100));
+  }
+  for (const auto &str : strings) {
+    count.Advance(StringVal(str.c_str(), str.size()));
+  }
+  EXPECT_NEAR(100, count.GetResult().val_, 100 * 0.05);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorsTest, ApproxPercentile) {
+  // NULL check and merging NULL check
+  {
+    ApproxPercentileAggregate percentile;
+    EXPECT_TRUE(percentile.GetResult().is_null_);
+    percentile.Advance(Integer::Null(), Real(0.5));
+    EXPECT_TRUE(percentile.GetResult().is_null_);
+
+    ApproxPercentileAggregate null_percentile;
+    percentile.Merge(null_percentile);
+    EXPECT_TRUE(percentile.GetResult().is_null_);
+  }
+
+  // Few values are summarized exactly
+  {
+    ApproxPercentileAggregate median;
+    for (int64_t i = 1; i <= 100; i++) {
+      median.Advance(Integer(i), Real(0.5));
+    }
+    EXPECT_NEAR(50.5, median.GetResult().val_, 1e-9);
+  }
+
+  // Partial aggregates over interleaved values, merged as the parallel aggregation does
+  const std::vector<double> percentiles = {0.01, 0.25, 0.5, 0.9, 0.99};
+  for (const auto p : percentiles) {
+    ApproxPercentileAggregate partials[4];
+    for (uint32_t i = 0; i < 100000; i++) {
+      partials[i % 4].Advance(Real(static_cast<double>(i)), Real(p));
+    }
+    for (uint32_t i = 1; i < 4; i++) {
+      partials[0].Merge(partials[i]);
+    }
+    EXPECT_NEAR(p * 100000, partials[0].GetResult().val_, 100000 * 0.01);
+
+    // Merging an empty aggregate changes nothing
+    ApproxPercentileAggregate null_percentile;
+    const auto estimate = partials[0].GetResult().val_;
+    partials[0].Merge(null_percentile);
+    EXPECT_DOUBLE_EQ(estimate, partials[0].GetResult().val_);
+  }
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -1,4 +1,6 @@
 #include <chrono>  // NOLINT
+#include <cstring>
+#include <string>
 #include <vector>
 
 #include "common/settings.h"
@@ -9,6 +11,7 @@
 #include "execution/sql/vector_filter_executor.h"
 #include "execution/sql_test.h"
 #include "gmock/gmock.h"
+#include "storage/arrow_block_metadata.h"
 
 namespace noisepage::execution::sql::test {
 
@@ -189,4 +192,53 @@ TEST_F(FilterManagerTest, AdaptiveCheckTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(FilterManagerTest, DictionaryFilterTest) {
+  auto exec_ctx = MakeExecCtx();
+  const auto &exec_settings = exec_ctx->GetExecutionSettings();
+
+  // A sorted dictionary, as produced when freezing a block.
+  const std::vector<std::string> words = {"apple", "banana", "blueberry", "cherry"};
+  uint32_t values_length = 0;
+  for (const auto &word : words) values_length += word.size();
+  storage::ArrowVarlenColumn dictionary(values_length, words.size() + 1);
+  dictionary.Offsets()[0] = 0;
+  for (uint32_t i = 0; i < words.size(); i++) {
+    std::memcpy(dictionary.Values() + dictionary.Offsets()[i], words[i].data(), words[i].size());
+    dictionary.Offsets()[i + 1] = dictionary.Offsets()[i] + words[i].size();
+  }
+
+  // Checks that exactly the non-NULL tuples whose word satisfies the predicate are selected.
+  using SelectFn = void (*)(const exec::ExecutionSettings &, VectorProjection *, uint32_t, const GenericValue &,
+                            TupleIdList *);
+  const auto check = [&](SelectFn select, const char *constant, auto pred) {
+    VectorProjection vp;
+    vp.Initialize({TypeId::Varchar});
+    vp.Reset(common::Constants::K_DEFAULT_VECTOR_SIZE);
+    uint32_t *codes = vp.SetColumnDictionary(0, &dictionary);
+    for (uint32_t i = 0; i < vp.GetTotalTupleCount(); i++) {
+      codes[i] = i % words.size();
+      vp.GetColumn(0)->SetValue(i, GenericValue::CreateVarchar(words[codes[i]]));
+    }
+    vp.GetColumn(0)->SetNull(0, true);
+
+    TupleIdList tids(vp.GetTotalTupleCount());
+    tids.AddAll();
+    select(exec_settings, &vp, 0, GenericValue::CreateVarchar(constant), &tids);
+    for (uint32_t i = 0; i < vp.GetTotalTupleCount(); i++) {
+      EXPECT_EQ(i != 0 && pred(words[i % words.size()]), tids.Contains(i));
+    }
+  };
+
+  check(VectorFilterExecutor::SelectEqualVal, "apple", [](const std::string &w) { return w == "apple"; });
+  check(VectorFilterExecutor::SelectNotEqualVal, "banana", [](const std::string &w) { return w != "banana"; });
+  check(VectorFilterExecutor::SelectLessThanVal, "blue", [](const std::string &w) { return w < "blue"; });
+  check(VectorFilterExecutor::SelectGreaterThanEqualVal, "banana", [](const std::string &w) { return w >= "banana"; });
+  check(VectorFilterExecutor::SelectLikeVal, "b%", [](const std::string &w) { return w[0] == 'b'; });
+  check(VectorFilterExecutor::SelectNotLikeVal, "b%", [](const std::string &w) { return w[0] != 'b'; });
+  // Not a prefix pattern, so the values are compared instead.
+  check(VectorFilterExecutor::SelectLikeVal, "%rr%",
+        [](const std::string &w) { return w.find("rr") != std::string::npos; });
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -1,11 +1,15 @@
 #include <tbb/tbb.h>
 
+#include <algorithm>
 #include <random>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/hash_util.h"
 #include "execution/exec/execution_settings.h"
 #include "execution/sql/join_hash_table.h"
+#include "execution/sql/join_hash_table_batch_probe.h"
+#include "execution/sql/memory_tracker.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql_test.h"
 
@@ -147,6 +151,41 @@ TEST_F(JoinHashTableTest, DuplicateKeyLookupTest) {
   BuildAndProbeTest<false>(exec_ctx.get(), 400, 5);
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, BatchProbeTest) {
+  auto exec_ctx = MakeExecCtx();
+  exec::ExecutionSettings exec_settings{};
+  const uint32_t num_tuples = 4000, dup_scale_factor = 3;
+
+  JoinHashTable join_hash_table(exec_settings, exec_ctx.get(), sizeof(Tuple));
+  PopulateJoinHashTable(&join_hash_table, num_tuples, dup_scale_factor);
+  join_hash_table.Build();
+
+  // Probe in batches of different sizes, half of the probes without a partner
+  JoinHashTableBatchProbe probe;
+  for (const uint32_t batch_size : {1u, 7u, common::Constants::K_DEFAULT_VECTOR_SIZE}) {
+    for (uint32_t start = 0; start < 2 * num_tuples; start += batch_size) {
+      const uint32_t end = std::min(start + batch_size, 2 * num_tuples);
+      for (uint32_t i = start; i < end; i++) {
+        probe.AddHash(Tuple{i, 0, 0, 0}.Hash());
+      }
+      probe.Lookup(join_hash_table);
+
+      // The matches are retrieved in the order the hashes were added
+      for (uint32_t i = start; i < end; i++) {
+        uint32_t count = 0;
+        for (auto iter = probe.Next(); iter.HasNext();) {
+          auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+          if (matched->a_ == i) {
+            count++;
+          }
+        }
+        EXPECT_EQ(i < num_tuples ? dup_scale_factor : 0, count) << "Key [" << i << "]";
+      }
+    }
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, UniqueKeyConciseTableTest) {
   auto exec_ctx = MakeExecCtx();
@@ -160,13 +199,93 @@ TEST_F(JoinHashTableTest, DuplicateKeyLookupConciseTableTest) {
 }
 
 // NOLINTNEXTLINE
-TEST_F(JoinHashTableTest, ParallelBuildTest) {
+TEST_F(JoinHashTableTest, BloomFilterTest) {
+  auto exec_ctx = MakeExecCtx();
+  exec::ExecutionSettings exec_settings{};
+  const uint32_t num_tuples = 10000;
+
+  JoinHashTable join_hash_table(exec_settings, exec_ctx.get(), sizeof(Tuple), false);
+  join_hash_table.EnableBloomFilter();
+  PopulateJoinHashTable(&join_hash_table, num_tuples, 1);
+  join_hash_table.Build();
+  EXPECT_TRUE(join_hash_table.HasBloomFilter());
+
+  // Keys in the table must never be filtered out
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    EXPECT_TRUE(join_hash_table.MayContain(Tuple{i, 0, 0, 0}.Hash())) << "Key [" << i << "] was filtered out";
+  }
+
+  // Most keys not in the table must be filtered out
+  uint32_t num_false_positives = 0;
+  for (uint32_t i = num_tuples; i < 2 * num_tuples; i++) {
+    num_false_positives += static_cast<uint32_t>(join_hash_table.MayContain(Tuple{i, 0, 0, 0}.Hash()));
+  }
+  EXPECT_LT(num_false_positives, num_tuples / 10);
+}
+
+template <bool UseCHT>
+void SpillAndProbeTest(exec::ExecutionContext *exec_ctx, uint32_t num_tuples, uint32_t dup_scale_factor) {
+  exec::ExecutionSettings exec_settings{};
+
+  // A one-byte budget forces the table to spill while it is populated.
+  exec_ctx->GetMemoryPool()->GetTracker()->SetMemoryBudget(1);
+
+  JoinHashTable join_hash_table(exec_settings, exec_ctx, sizeof(Tuple), UseCHT);
+  join_hash_table.EnableSpilling();
+  PopulateJoinHashTable(&join_hash_table, num_tuples, dup_scale_factor);
+  join_hash_table.Build();
+
+  EXPECT_TRUE(join_hash_table.HasSpilled());
+
+  // Every probe key must be resident in exactly one pass, and find all of its
+  // matches in that pass.
+  std::vector<uint32_t> num_probes(num_tuples, 0);
+  uint32_t num_passes = 0;
+  do {
+    num_passes++;
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      Tuple probe_tuple = {i, 0, 0, 0};
+      if (!join_hash_table.IsResident(probe_tuple.Hash())) {
+        continue;
+      }
+      num_probes[i]++;
+      uint32_t count = 0;
+      for (auto iter = join_hash_table.Lookup<UseCHT>(probe_tuple.Hash()); iter.HasNext();) {
+        auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+        if (matched->a_ == probe_tuple.a_) {
+          count++;
+        }
+      }
+      EXPECT_EQ(dup_scale_factor, count) << "Expected to find " << dup_scale_factor << " matches, but key [" << i
+                                         << "] found " << count << " matches";
+    }
+  } while (join_hash_table.NextPass());
+
+  EXPECT_GT(num_passes, 1);
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    EXPECT_EQ(1u, num_probes[i]) << "Key [" << i << "] was probed in " << num_probes[i] << " passes";
+  }
+
+  exec_ctx->GetMemoryPool()->GetTracker()->SetMemoryBudget(MemoryTracker::UNLIMITED_BUDGET);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillTest) {
   auto exec_ctx = MakeExecCtx();
+  SpillAndProbeTest<false>(exec_ctx.get(), 10000, 5);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillConciseTableTest) {
+  auto exec_ctx = MakeExecCtx();
+  SpillAndProbeTest<true>(exec_ctx.get(), 10000, 5);
+}
+
+void ParallelBuildAndProbeTest(exec::ExecutionContext *exec_ctx, bool partitioned, uint32_t num_tuples) {
   exec::ExecutionSettings exec_settings{};
   tbb::task_scheduler_init sched;
 
   constexpr bool use_concise_ht = false;
-  const uint32_t num_tuples = 10000;
   const uint32_t num_thread_local_tables = 4;
 
   ThreadStateContainer container(exec_ctx->GetMemoryPool());
@@ -176,7 +295,7 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
     exec::ExecutionSettings *settings_;
   };
 
-  Context ctx{exec_ctx.get(), &exec_settings};
+  Context ctx{exec_ctx, &exec_settings};
 
   container.Reset(
       sizeof(JoinHashTable),
@@ -192,8 +311,14 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
     PopulateJoinHashTable(jht, num_tuples, 1);
   });
 
-  JoinHashTable main_jht(exec_settings, exec_ctx.get(), sizeof(Tuple), false);
-  main_jht.MergeParallel(&container, 0);
+  JoinHashTable main_jht(exec_settings, exec_ctx, sizeof(Tuple), false);
+  main_jht.EnableBloomFilter();
+  if (partitioned) {
+    main_jht.MergeParallelPartitioned(&container, 0);
+  } else {
+    main_jht.MergeParallel(&container, 0);
+  }
+  EXPECT_TRUE(main_jht.IsBuilt());
 
   // Each of the thread-local tables inserted the same data, i.e., tuples whose
   // keys are in the range [0, num_tuples). Thus, in the final table there
@@ -206,6 +331,7 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
 
   for (uint32_t i = 0; i < num_tuples; i++) {
     auto probe = Tuple{i, 1, 2, 3};
+    EXPECT_TRUE(main_jht.MayContain(probe.Hash()));
     uint32_t count = 0;
     for (auto iter = main_jht.Lookup<use_concise_ht>(probe.Hash()); iter.HasNext();) {
       auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
@@ -215,6 +341,28 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
     }
     EXPECT_EQ(num_thread_local_tables, count);
   }
+
+  // Iteration must visit every tuple exactly once
+  uint32_t num_iterated = 0;
+  for (JoinHashTableIterator iter(main_jht); iter.HasNext(); iter.Next()) {
+    num_iterated++;
+  }
+  EXPECT_EQ(num_tuples * num_thread_local_tables, num_iterated);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, ParallelBuildTest) {
+  auto exec_ctx = MakeExecCtx();
+  ParallelBuildAndProbeTest(exec_ctx.get(), false, 10000);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, ParallelPartitionedBuildTest) {
+  auto exec_ctx = MakeExecCtx();
+  // Small enough to be merged serially
+  ParallelBuildAndProbeTest(exec_ctx.get(), true, 100);
+  // Large enough to be scattered into many partitions
+  ParallelBuildAndProbeTest(exec_ctx.get(), true, 200000);
 }
 
 #if 0
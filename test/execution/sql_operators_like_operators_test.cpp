@@ -78,6 +78,46 @@ TEST_F(LikeOperatorsTests, MultiCharacter_Wildcard) {
   s = "Money In The Bank\\";
   p = "_%%%%%%%%k\\\\";
   EXPECT_TRUE(Like{}(storage::VarlenEntry::Create(s), storage::VarlenEntry::Create(p)));  // NOLINT
+
+  // Escaped character right after a wildcard
+  s = "100% Money";
+  p = "%\\% M%";
+  EXPECT_TRUE(Like{}(storage::VarlenEntry::Create(s), storage::VarlenEntry::Create(p)));  // NOLINT
+  p = "%\\%";
+  EXPECT_FALSE(Like{}(storage::VarlenEntry::Create(s), storage::VarlenEntry::Create(p)));  // NOLINT
+}
+
+// NOLINTNEXTLINE
+TEST_F(LikeOperatorsTests, CompiledPattern) {
+  const auto check = [](const std::string &p, LikePattern::Kind kind) {
+    const LikePattern pattern(p.data(), p.size());
+    EXPECT_EQ(kind, pattern.GetKind()) << p;
+    // The compiled pattern must agree with the general matcher on all suffixes of a long string, so that the SIMD
+    // substring search also sees matches at, and right before, the end of its registers.
+    std::string s;
+    for (uint32_t i = 0; i < 200; i++) {
+      s += "Money In The Bank 100% "[i % 23];
+    }
+    for (std::size_t start = 0; start <= s.size(); start++) {
+      EXPECT_EQ(Like::Impl(s.data() + start, s.size() - start, p.data(), p.size()),
+                pattern.Matches(s.data() + start, s.size() - start))
+          << p << " " << start;
+    }
+  };
+
+  check("", LikePattern::Kind::Exact);
+  check("Money In The Bank", LikePattern::Kind::Exact);
+  check("Bank 100\\% ", LikePattern::Kind::Exact);
+  check("Bank%", LikePattern::Kind::Prefix);
+  check("ey In The%%", LikePattern::Kind::Prefix);
+  check("%Bank 100% ", LikePattern::Kind::General);
+  check("%100\\% ", LikePattern::Kind::Suffix);
+  check("%", LikePattern::Kind::Suffix);
+  check("%Bank%", LikePattern::Kind::Contains);
+  check("%%The Bank%%", LikePattern::Kind::Contains);
+  check("%\\%%", LikePattern::Kind::Contains);
+  check("%Bank_1%", LikePattern::Kind::General);
+  check("M%y", LikePattern::Kind::General);
 }
 
 }  // namespace noisepage::execution::sql::test
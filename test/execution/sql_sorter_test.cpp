@@ -7,6 +7,7 @@
 #include <random>
 #include <vector>
 
+#include "execution/sql/memory_tracker.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql_test.h"
@@ -262,4 +263,62 @@ TEST_F(SorterTest, UnbalancedParallelSortTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillSortTest) {
+  auto exec_ctx = MakeExecCtx();
+
+  // A one-byte budget forces the sorter to cut a run for every MIN_RUN_SIZE
+  // tuples. Insert enough tuples to require a multi-level merge.
+  exec_ctx->GetMemoryPool()->GetTracker()->SetMemoryBudget(1);
+
+  const auto cmp_fn = [](const void *left, const void *right) {
+    return reinterpret_cast<const TestTuple<2> *>(left)->Compare(*reinterpret_cast<const TestTuple<2> *>(right));
+  };
+
+  const uint64_t num_tuples = Sorter::MIN_RUN_SIZE * (Sorter::MAX_MERGE_FAN_IN + 10);
+  std::uniform_int_distribution<uint32_t> rng(0, 100000);
+  std::vector<uint32_t> reference;
+  reference.reserve(num_tuples);
+
+  Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(TestTuple<2>));
+  for (uint64_t i = 0; i < num_tuples; i++) {
+    auto *elem = reinterpret_cast<TestTuple<2> *>(sorter.AllocInputTuple());
+    elem->key_ = rng(generator_);
+    elem->data_[0] = elem->data_[1] = elem->key_;
+    reference.push_back(elem->key_);
+  }
+
+  EXPECT_TRUE(sorter.HasSpilled());
+  EXPECT_EQ(num_tuples, sorter.GetTupleCount());
+
+  sorter.Sort();
+  std::sort(reference.begin(), reference.end());
+
+  // Every tuple must come back in order and intact.
+  uint64_t idx = 0;
+  for (SorterIterator iter(sorter); iter.HasNext(); iter.Next(), idx++) {
+    const auto *row = iter.GetRowAs<TestTuple<2>>();
+    ASSERT_LT(idx, num_tuples);
+    EXPECT_EQ(reference[idx], row->key_);
+    EXPECT_EQ(row->key_, row->data_[1]);
+  }
+  EXPECT_EQ(num_tuples, idx);
+
+  // Skipping rows must land at the correct position.
+  SorterIterator iter(sorter);
+  iter.AdvanceBy(num_tuples / 2);
+  EXPECT_EQ(num_tuples - num_tuples / 2, iter.NumRemaining());
+  EXPECT_EQ(reference[num_tuples / 2], iter.GetRowAs<TestTuple<2>>()->key_);
+
+  exec_ctx->GetMemoryPool()->GetTracker()->SetMemoryBudget(MemoryTracker::UNLIMITED_BUDGET);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillParallelSortTest) {
+  auto exec_ctx = MakeExecCtx();
+  exec_ctx->GetMemoryPool()->GetTracker()->SetMemoryBudget(1);
+  TestParallelSort<2>(exec_ctx.get(), {10000, 10000, 100, 0});
+  exec_ctx->GetMemoryPool()->GetTracker()->SetMemoryBudget(MemoryTracker::UNLIMITED_BUDGET);
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -363,6 +363,33 @@ TEST_F(ChunkedVectorTest, RandomIteratorPreDecrementTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunkedVectorTest, ResizeTest) {
+  ChunkedVector<> vec(sizeof(uint32_t));
+
+  for (uint32_t i = 0; i < 10; i++) {
+    *reinterpret_cast<uint32_t *>(vec.Append()) = i;
+  }
+
+  // Grow past a chunk boundary and fill the new elements through random access
+  const uint32_t num_elems = 3 * ChunkedVector<>::K_NUM_ELEMENTS_PER_CHUNK;
+  vec.resize(num_elems);
+  EXPECT_EQ(num_elems, vec.size());
+  for (uint32_t i = 10; i < num_elems; i++) {
+    *reinterpret_cast<uint32_t *>(vec[i]) = i;
+  }
+
+  // Appends after a resize land at the end
+  *reinterpret_cast<uint32_t *>(vec.Append()) = num_elems;
+  EXPECT_EQ(num_elems + 1, vec.size());
+
+  uint32_t i = 0;
+  for (auto *elem : vec) {
+    EXPECT_EQ(i++, *reinterpret_cast<const uint32_t *>(elem));
+  }
+  EXPECT_EQ(num_elems + 1, i);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunkedVectorTest, SortTest) {
   const uint32_t num_elems = 1000;
@@ -1,3 +1,4 @@
+#include <functional>
 #include <string>
 
 #include "execution/tpl_test.h"
@@ -318,4 +319,38 @@ TEST_F(BytecodeGeneratorTest, FunctionTest) {
   EXPECT_EQ(20, s.b_);
 }
 
+// NOLINTNEXTLINE
+TEST_F(BytecodeGeneratorTest, SuperinstructionTest) {
+  auto src = R"(
+    fun test(n: int32) -> int32 {
+      var x: int32 = 0
+      for (var i: int32 = 0; i < n; i = i + 1) {
+        if (i != 3) {
+          x = x + i
+        }
+      }
+      return x
+    })";
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(src);
+  ASSERT_TRUE(module != nullptr);
+
+  // The comparisons are fused with the jumps on their results
+  const auto *func_info = module->GetFuncInfoByName("test");
+  ASSERT_NE(func_info, nullptr);
+  uint32_t num_fused = 0;
+  for (auto iter = module->GetBytecodeModule()->GetBytecodeForFunction(*func_info); !iter.Done(); iter.Advance()) {
+    EXPECT_NE(Bytecode::JumpIfFalse, iter.CurrentBytecode());
+    num_fused += static_cast<uint32_t>(Bytecodes::IsFusedConditionalJump(iter.CurrentBytecode()));
+  }
+  EXPECT_EQ(2, num_fused);
+
+  // And both take the right branches
+  std::function<int32_t(int32_t)> f;
+  EXPECT_TRUE(module->GetFunction("test", ExecutionMode::Interpret, &f));
+  EXPECT_EQ(0, f(0));
+  EXPECT_EQ(3, f(3));
+  EXPECT_EQ(42, f(10));
+}
+
 }  // namespace noisepage::execution::vm::test
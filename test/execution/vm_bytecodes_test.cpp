@@ -101,4 +101,27 @@ TEST_F(BytecodesTest, OperandTypesTest) {
   EXPECT_EQ(OperandType::Local, Bytecodes::GetNthOperandType(Bytecode::Add_int32_t, 2));
 }
 
+// NOLINTNEXTLINE
+TEST_F(BytecodesTest, SuperinstructionTest) {
+  // A fused conditional jump takes the operands of its condition followed by the jump offset
+  EXPECT_EQ(4u, Bytecodes::NumOperands(Bytecode::LessThan_int32_t_JumpIfFalse));
+  EXPECT_EQ(OperandType::Local, Bytecodes::GetNthOperandType(Bytecode::LessThan_int32_t_JumpIfFalse, 0));
+  EXPECT_EQ(OperandType::JumpOffset, Bytecodes::GetNthOperandType(Bytecode::LessThan_int32_t_JumpIfFalse, 3));
+  EXPECT_EQ(3u, Bytecodes::GetJumpOffsetOperandIndex(Bytecode::LessThan_int32_t_JumpIfFalse));
+  EXPECT_EQ(1u, Bytecodes::GetJumpOffsetOperandIndex(Bytecode::JumpIfFalse));
+
+  // Fused conditional jumps are conditional jumps, and jumps
+  EXPECT_TRUE(Bytecodes::IsFusedConditionalJump(Bytecode::TableVectorIteratorNext_JumpIfFalse));
+  EXPECT_TRUE(Bytecodes::IsConditionalJump(Bytecode::TableVectorIteratorNext_JumpIfFalse));
+  EXPECT_TRUE(Bytecodes::IsJump(Bytecode::TableVectorIteratorNext_JumpIfFalse));
+  EXPECT_FALSE(Bytecodes::IsFusedConditionalJump(Bytecode::JumpIfFalse));
+  EXPECT_FALSE(Bytecodes::IsFusedConditionalJump(Bytecode::TableVectorIteratorNext));
+
+  // Only fusable conditions have a fused conditional jump
+  EXPECT_EQ(Bytecode::NotEqual_uint64_t_JumpIfFalse, Bytecodes::GetFusedJumpIfFalse(Bytecode::NotEqual_uint64_t));
+  EXPECT_EQ(Bytecode::VPIHasNext_JumpIfFalse, Bytecodes::GetFusedJumpIfFalse(Bytecode::VPIHasNext));
+  EXPECT_EQ(Bytecode::JumpIfFalse, Bytecodes::GetFusedJumpIfFalse(Bytecode::Add_int32_t));
+  EXPECT_EQ(Bytecode::JumpIfFalse, Bytecodes::GetFusedJumpIfFalse(Bytecode::LessThan_float));
+}
+
 }  // namespace noisepage::execution::vm::test
@@ -0,0 +1,115 @@
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/ast/context.h"
+#include "execution/compiler/compiler.h"
+#include "execution/sema/error_reporter.h"
+#include "execution/tpl_test.h"
+#include "execution/util/region.h"
+#include "execution/vm/llvm_engine.h"
+#include "execution/vm/module.h"
+#include "test_util/fs_util.h"
+
+namespace noisepage::execution::vm::test {
+
+class LLVMEngineObjectCacheTest : public TplTest {
+ public:
+  LLVMEngineObjectCacheTest() : region_("object_cache_test") {}
+
+  static void SetUpTestSuite() {
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("noisepage-object-cache", cache_path));
+    const auto bytecode_handlers_path = common::GetBinaryArtifactPath("bytecode_handlers_ir.bc");
+    auto settings = std::make_unique<const LLVMEngine::Settings>(bytecode_handlers_path, cache_path.str());
+    LLVMEngine::Initialize(std::move(settings));
+  }
+
+  static void TearDownTestSuite() {
+    LLVMEngine::Shutdown();
+    llvm::sys::fs::remove_directories(cache_path);
+  }
+
+  // Compile the source into a fresh module and run its main function in compiled mode
+  int32_t CompileAndRun(const std::string &name, const std::string &src) {
+    sema::ErrorReporter error_reporter(&region_);
+    ast::Context context(&region_, &error_reporter);
+    auto input = compiler::Compiler::Input(name, &context, &src);
+    auto module = compiler::Compiler::RunCompilationSimple(input);
+    EXPECT_NE(module, nullptr);
+
+    std::function<int32_t()> main;
+    EXPECT_TRUE(module->GetFunction("main", ExecutionMode::Compiled, &main));
+    return main();
+  }
+
+  // The object files currently in the cache
+  static std::vector<std::string> CachedFiles() {
+    std::vector<std::string> files;
+    std::error_code error;
+    for (llvm::sys::fs::directory_iterator it(cache_path, error), end; !error && it != end; it.increment(error)) {
+      files.push_back(it->path());
+    }
+    return files;
+  }
+
+  util::Region region_;
+  inline static llvm::SmallString<128> cache_path;  // NOLINT
+};
+
+// NOLINTNEXTLINE
+TEST_F(LLVMEngineObjectCacheTest, ReuseObjectCode) {
+  const std::string src = R"(
+    fun main() -> int32 {
+      var x: int32 = 0
+      for (var i: int32 = 0; i < 10; i = i + 1) {
+        x = x + i
+      }
+      return x
+    })";
+
+  // The first compilation populates the cache
+  EXPECT_EQ(CompileAndRun("first", src), 45);
+  const auto files = CachedFiles();
+  ASSERT_EQ(files.size(), 1);
+
+  // An identical module loads the cached object code, regardless of its name
+  EXPECT_EQ(CompileAndRun("second", src), 45);
+  EXPECT_EQ(CachedFiles(), files);
+
+  // A different module gets its own object code
+  const std::string other_src = R"(
+    fun main() -> int32 {
+      return 7
+    })";
+  EXPECT_EQ(CompileAndRun("other", other_src), 7);
+  EXPECT_EQ(CachedFiles().size(), 2);
+}
+
+// NOLINTNEXTLINE
+TEST_F(LLVMEngineObjectCacheTest, RecompileCorruptObjectCode) {
+  const std::string src = R"(
+    fun main() -> int32 {
+      return 42
+    })";
+
+  EXPECT_EQ(CompileAndRun("first", src), 42);
+  for (const auto &cached_file : CachedFiles()) {
+    // Corrupt every cached file, the one of this module included
+    std::error_code error;
+    llvm::raw_fd_ostream out(cached_file, error);
+    ASSERT_FALSE(error);
+    out << "garbage";
+  }
+
+  // The unusable object code is compiled again and replaced
+  EXPECT_EQ(CompileAndRun("second", src), 42);
+  EXPECT_EQ(CompileAndRun("third", src), 42);
+}
+
+}  // namespace noisepage::execution::vm::test
@@ -0,0 +1,82 @@
+#include <chrono>  // NOLINT
+#include <functional>
+#include <string>
+#include <thread>  // NOLINT
+
+#include "execution/compiled_tpl_test.h"
+#include "execution/vm/module.h"
+#include "execution/vm/module_compiler.h"
+
+namespace noisepage::execution::vm::test {
+
+class ModuleTieringTest : public CompiledTplTest {
+ protected:
+  // Invoke the function until its implementation changes from the given one, or give up after a while
+  static bool InvokeUntilSwapped(const Module &module, const FunctionId func_id, const void *impl,
+                                 const std::function<void()> &invoke) {
+    for (uint32_t i = 0; i < 100000; i++) {
+      invoke();
+      if (module.GetRawFunctionImpl(func_id) != impl) {
+        return true;
+      }
+      if (i > 1000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    return false;
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(ModuleTieringTest, HotLoopIsCompiled) {
+  auto src = R"(
+    fun sum(n: int64) -> int64 {
+      var x: int64 = 0
+      for (var i: int64 = 0; i < n; i = i + 1) {
+        x = x + i
+      }
+      return x
+    })";
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(src);
+  ASSERT_FALSE(compiler.HasErrors());
+
+  std::function<int64_t(int64_t)> sum;
+  ASSERT_TRUE(module->GetFunction("sum", ExecutionMode::Adaptive, &sum));
+  const FunctionId func_id = module->GetFuncInfoByName("sum")->GetId();
+
+  // A single invocation running enough loop iterations makes the function hot
+  const void *interpreted = module->GetRawFunctionImpl(func_id);
+  EXPECT_EQ(sum(100000), 4999950000);
+  EXPECT_TRUE(InvokeUntilSwapped(*module, func_id, interpreted, [&] { EXPECT_EQ(sum(100), 4950); }));
+
+  // Compiled code keeps on being promoted, based on the profile of the interpreted invocations
+  const void *tier1 = module->GetRawFunctionImpl(func_id);
+  EXPECT_TRUE(InvokeUntilSwapped(*module, func_id, tier1, [&] { EXPECT_EQ(sum(100000), 4999950000); }));
+  EXPECT_EQ(sum(10), 45);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ModuleTieringTest, ColdFunctionIsInterpreted) {
+  auto src = R"(
+    fun add(a: int32, b: int32) -> int32 {
+      return a + b
+    })";
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(src);
+  ASSERT_FALSE(compiler.HasErrors());
+
+  std::function<int32_t(int32_t, int32_t)> add;
+  ASSERT_TRUE(module->GetFunction("add", ExecutionMode::Adaptive, &add));
+  const FunctionId func_id = module->GetFuncInfoByName("add")->GetId();
+
+  // A few short invocations stay in the interpreter
+  const void *interpreted = module->GetRawFunctionImpl(func_id);
+  for (int32_t i = 0; i < 10; i++) {
+    EXPECT_EQ(add(i, i), 2 * i);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(module->GetRawFunctionImpl(func_id), interpreted);
+}
+
+}  // namespace noisepage::execution::vm::test
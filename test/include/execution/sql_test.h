@@ -66,6 +66,11 @@ class SqlBasedTest : public TplTest {
                                                     metrics_manager_, DISABLED, DISABLED);
   }
 
+  void SetIndexJoinHashSwitch(uint32_t probes_per_block, uint64_t max_size) {
+    exec_settings_->index_join_hash_switch_probes_per_block_ = probes_per_block;
+    exec_settings_->index_join_hash_table_max_size_ = max_size;
+  }
+
   void GenerateTestTables(exec::ExecutionContext *exec_ctx) {
     sql::TableGenerator table_generator{exec_ctx, block_store_, test_ns_oid_};
     table_generator.GenerateTestTables();
@@ -424,6 +424,91 @@ TEST_F(IdxJoinTest, MultiPredicateJoinWithExtra) {
   txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+// NOLINTNEXTLINE
+TEST_F(IdxJoinTest, AdaptiveHashJoin) {
+  // Same as MultiPredicateJoinWithExtra, but the join switches from the index to a hash table over bar right away.
+  auto sql =
+      "SELECT foo.col1, foo.col2, foo.col3, bar.col1, bar.col2, bar.col3 "
+      "FROM foo, bar WHERE foo.col1 = bar.col1 and foo.col2 = bar.col2 and bar.col3 = 301 "
+      "ORDER BY foo.col1, bar.col1, foo.col2, bar.col2, foo.col3, bar.col3";
+
+  auto txn = txn_manager_->BeginTransaction();
+  auto stmt_list = parser::PostgresParser::BuildParseTree(sql);
+
+  auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_oid_, DISABLED);
+  auto binder = binder::BindNodeVisitor(common::ManagedPointer(accessor), db_oid_);
+  binder.BindNameToNode(common::ManagedPointer(stmt_list), nullptr, nullptr);
+
+  auto cost_model = std::make_unique<optimizer::TrivialCostModel>();
+  auto out_plan = trafficcop::TrafficCopUtil::Optimize(
+                      common::ManagedPointer(txn), common::ManagedPointer(accessor), common::ManagedPointer(stmt_list),
+                      db_oid_, db_main_->GetStatsStorage(), std::move(cost_model), optimizer_timeout_, nullptr)
+                      ->TakePlanNodeOwnership();
+
+  EXPECT_EQ(out_plan->GetPlanNodeType(), planner::PlanNodeType::PROJECTION);
+  EXPECT_EQ(out_plan->GetChild(0)->GetPlanNodeType(), planner::PlanNodeType::ORDERBY);
+  EXPECT_EQ(out_plan->GetChild(0)->GetChild(0)->GetPlanNodeType(), planner::PlanNodeType::INDEXNLJOIN);
+  auto idx_join = reinterpret_cast<const planner::IndexJoinPlanNode *>(out_plan->GetChild(0)->GetChild(0));
+  EXPECT_EQ(idx_join->GetHiIndexColumns().size(), 3);
+
+  EXPECT_EQ(out_plan->GetChild(0)->GetChild(0)->GetChild(0)->GetPlanNodeType(), planner::PlanNodeType::SEQSCAN);
+
+  uint32_t num_output_rows{0};
+  uint32_t num_expected_rows = 27;
+  execution::compiler::test::RowChecker row_checker =
+      [&num_output_rows](const std::vector<execution::sql::Val *> &vals) {
+        num_output_rows++;
+
+        // Read cols
+        auto foo_col1 = static_cast<execution::sql::Integer *>(vals[0]);
+        auto foo_col2 = static_cast<execution::sql::Integer *>(vals[1]);
+        auto foo_col3 = static_cast<execution::sql::Integer *>(vals[2]);
+        auto bar_col1 = static_cast<execution::sql::Integer *>(vals[3]);
+        auto bar_col2 = static_cast<execution::sql::Integer *>(vals[4]);
+        auto bar_col3 = static_cast<execution::sql::Integer *>(vals[5]);
+        ASSERT_FALSE(foo_col1->is_null_ || foo_col2->is_null_ || foo_col3->is_null_ || bar_col1->is_null_ ||
+                     bar_col2->is_null_ || bar_col3->is_null_);
+
+        ASSERT_EQ(foo_col1->val_, 1 + ((num_output_rows - 1) / 9));
+        ASSERT_EQ(foo_col1->val_, bar_col1->val_);
+
+        ASSERT_EQ(foo_col2->val_, bar_col2->val_);
+        ASSERT_GE(foo_col2->val_, 11);
+        ASSERT_GE(bar_col2->val_, 11);
+        ASSERT_LE(foo_col2->val_, 13);
+        ASSERT_LE(bar_col2->val_, 13);
+
+        ASSERT_GE(foo_col3->val_, 31);
+        ASSERT_LE(foo_col3->val_, 33);
+        ASSERT_EQ(bar_col3->val_, 301);
+      };
+
+  execution::compiler::test::CorrectnessFn correctness_fn = [&num_output_rows, num_expected_rows]() {
+    ASSERT_EQ(num_output_rows, num_expected_rows);
+  };
+  execution::compiler::test::GenericChecker checker(row_checker, correctness_fn);
+
+  // Make Exec Ctx
+  execution::compiler::test::OutputStore store{&checker, out_plan->GetOutputSchema().Get()};
+  execution::exec::OutputPrinter printer(out_plan->GetOutputSchema().Get());
+  execution::compiler::test::MultiOutputCallback callback{std::vector<execution::exec::OutputCallback>{store, printer}};
+  execution::exec::ExecutionSettings exec_settings{};
+  exec_settings.is_parallel_execution_enabled_ = false;
+  exec_settings.index_join_hash_switch_probes_per_block_ = 1;
+  execution::exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+  auto exec_ctx = std::make_unique<execution::exec::ExecutionContext>(
+      db_oid_, common::ManagedPointer(txn), callback_fn, out_plan->GetOutputSchema().Get(),
+      common::ManagedPointer(accessor), exec_settings, db_main_->GetMetricsManager(), DISABLED, DISABLED);
+
+  // Run & Check
+  auto executable = execution::compiler::CompilationContext::Compile(*out_plan, exec_ctx->GetExecutionSettings(),
+                                                                     exec_ctx->GetAccessor());
+  executable->Run(common::ManagedPointer(exec_ctx), execution::vm::ExecutionMode::Interpret);
+  checker.CheckCorrectness();
+
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 // NOLINTNEXTLINE
 TEST_F(IdxJoinTest, FooOnlyScan) {
   auto sql =
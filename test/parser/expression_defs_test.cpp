@@ -90,6 +90,10 @@ TEST(ExpressionDefsTests, ExpressionTypeToStringTest) {
   EXPECT_EQ(ExpressionTypeToString(ExpressionType::AGGREGATE_TOP_K), "AGGREGATE_TOP_K");
   EXPECT_EQ(ExpressionTypeToShortString(ExpressionType::AGGREGATE_HISTOGRAM), "HISTOGRAM");
   EXPECT_EQ(ExpressionTypeToString(ExpressionType::AGGREGATE_HISTOGRAM), "AGGREGATE_HISTOGRAM");
+  EXPECT_EQ(ExpressionTypeToShortString(ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT), "APPROX_COUNT_DISTINCT");
+  EXPECT_EQ(ExpressionTypeToString(ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT), "AGGREGATE_APPROX_COUNT_DISTINCT");
+  EXPECT_EQ(ExpressionTypeToShortString(ExpressionType::AGGREGATE_APPROX_PERCENTILE), "APPROX_PERCENTILE");
+  EXPECT_EQ(ExpressionTypeToString(ExpressionType::AGGREGATE_APPROX_PERCENTILE), "AGGREGATE_APPROX_PERCENTILE");
   EXPECT_EQ(ExpressionTypeToShortString(ExpressionType::FUNCTION), "FUNCTION");
   EXPECT_EQ(ExpressionTypeToString(ExpressionType::FUNCTION), "FUNCTION");
   EXPECT_EQ(ExpressionTypeToShortString(ExpressionType::HASH_RANGE), "HASH_RANGE");
@@ -728,6 +728,39 @@ TEST_F(ParserTestBase, OldAggTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, ApproxAggTest) {
+  auto result =
+      parser::PostgresParser::BuildParseTree("SELECT APPROX_COUNT_DISTINCT(id), APPROX_PERCENTILE(id, 0.9) FROM foo;");
+  auto statement = result->GetStatement(0).CastManagedPointerTo<SelectStatement>();
+  auto columns = statement->GetSelectColumns();
+  EXPECT_EQ(2, columns.size());
+
+  EXPECT_EQ(ExpressionType::AGGREGATE_APPROX_COUNT_DISTINCT, columns[0]->GetExpressionType());
+  EXPECT_EQ(1, columns[0]->GetChildrenSize());
+
+  // The percentile is the second child of the aggregate
+  EXPECT_EQ(ExpressionType::AGGREGATE_APPROX_PERCENTILE, columns[1]->GetExpressionType());
+  EXPECT_EQ(2, columns[1]->GetChildrenSize());
+  auto percentile = columns[1]->GetChild(1).CastManagedPointerTo<ConstantValueExpression>();
+  EXPECT_EQ(type::TypeId::REAL, percentile->GetReturnValueType());
+  EXPECT_DOUBLE_EQ(0.9, percentile->Peek<double>());
+
+  // Integral percentiles are accepted as well
+  result = parser::PostgresParser::BuildParseTree("SELECT APPROX_PERCENTILE(id, 1) FROM foo;");
+  statement = result->GetStatement(0).CastManagedPointerTo<SelectStatement>();
+  percentile = statement->GetSelectColumns()[0]->GetChild(1).CastManagedPointerTo<ConstantValueExpression>();
+  EXPECT_EQ(type::TypeId::REAL, percentile->GetReturnValueType());
+  EXPECT_DOUBLE_EQ(1.0, percentile->Peek<double>());
+
+  // The percentile must be a constant between 0 and 1
+  EXPECT_THROW(parser::PostgresParser::BuildParseTree("SELECT APPROX_PERCENTILE(id, 1.5) FROM foo;"), ParserException);
+  EXPECT_THROW(parser::PostgresParser::BuildParseTree("SELECT APPROX_PERCENTILE(id, id) FROM foo;"), ParserException);
+  EXPECT_THROW(parser::PostgresParser::BuildParseTree("SELECT APPROX_PERCENTILE(id) FROM foo;"), ParserException);
+  EXPECT_THROW(parser::PostgresParser::BuildParseTree("SELECT APPROX_COUNT_DISTINCT(id, 0.5) FROM foo;"),
+               ParserException);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ParserTestBase, OldGroupByTest) {
   // Select with group by clause
@@ -1,5 +1,7 @@
 #include "storage/block_compactor.h"
 
+#include <algorithm>
+#include <limits>
 #include <unordered_map>
 #include <vector>
 
@@ -394,4 +396,110 @@ TEST_F(BlockCompactorTest, DictionaryCompressionTest) {
   }
 }
 
+// This tests generates random single blocks and freezes them. It then verifies that the zone maps of the fixed-length
+// columns bound their contents, and that they are invalidated once a transaction modifies the frozen block.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, ZoneMapTest) {
+  uint32_t repeat = 10;
+  for (uint32_t iteration = 0; iteration < repeat; iteration++) {
+    storage::BlockLayout layout = StorageTestUtil::RandomLayoutWithVarlens(100, &generator_);
+    storage::TupleAccessStrategy accessor(layout);
+    // Technically, the block above is not "in" the table, but since we don't sequential scan that does not matter
+    storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                             storage::layout_version_t(0));
+    storage::RawBlock *block = block_store_.Get();
+    accessor.InitializeRawBlock(&table, block, storage::layout_version_t(0));
+
+    // Enable GC to cleanup transactions started by the block compactor
+    transaction::TimestampManager timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool_),
+                                                true,
+                                                false,
+                                                DISABLED};
+    storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                                 DISABLED};
+
+    auto tuples = StorageTestUtil::PopulateBlockRandomly(&table, block, percent_empty_, &generator_);
+    auto num_tuples = tuples.size();
+
+    // Manually populate the block header's arrow metadata for test initialization
+    auto &arrow_metadata = accessor.GetArrowBlockMetadata(block);
+    for (storage::col_id_t col_id : layout.AllColumns()) {
+      if (layout.IsVarlen(col_id)) {
+        arrow_metadata.GetColumnInfo(layout, col_id).Type() = storage::ArrowColumnType::GATHERED_VARLEN;
+      } else {
+        arrow_metadata.GetColumnInfo(layout, col_id).Type() = storage::ArrowColumnType::FIXED_LENGTH;
+      }
+    }
+
+    storage::BlockCompactor compactor;
+    compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+
+    // Need to prune the version chain in order to make sure that the second pass succeeds
+    gc.PerformGarbageCollection();
+    compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // gathering pass
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+
+    // Every fixed-length column up to 8 bytes wide should carry the exact min/max of its non-null values
+    for (storage::col_id_t col_id : layout.AllColumns()) {
+      if (layout.IsVarlen(col_id)) continue;
+      const storage::ArrowColumnInfo &col_info = arrow_metadata.GetColumnInfo(layout, col_id);
+      const uint16_t attr_size = layout.AttrSize(col_id);
+      if (attr_size != 1 && attr_size != 2 && attr_size != 4 && attr_size != 8) {
+        EXPECT_FALSE(col_info.HasZoneMap());
+        continue;
+      }
+      EXPECT_TRUE(col_info.HasZoneMap());
+      int64_t min = std::numeric_limits<int64_t>::max(), max = std::numeric_limits<int64_t>::min();
+      for (uint32_t i = 0; i < num_tuples; i++) {
+        const byte *value = accessor.AccessWithNullCheck(storage::TupleSlot(block, i), col_id);
+        if (value == nullptr) continue;
+        int64_t int_value;
+        switch (attr_size) {
+          case 1:
+            int_value = *reinterpret_cast<const int8_t *>(value);
+            break;
+          case 2:
+            int_value = *reinterpret_cast<const int16_t *>(value);
+            break;
+          case 4:
+            int_value = *reinterpret_cast<const int32_t *>(value);
+            break;
+          default:
+            int_value = *reinterpret_cast<const int64_t *>(value);
+            break;
+        }
+        min = std::min(min, int_value);
+        max = std::max(max, int_value);
+      }
+      EXPECT_EQ(col_info.ZoneMapMin(), min);
+      EXPECT_EQ(col_info.ZoneMapMax(), max);
+    }
+
+    // Modifying the frozen block flips it back to hot and invalidates all zone maps
+    transaction::TransactionContext *txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(table.Delete(common::ManagedPointer(txn), storage::TupleSlot(block, 0)));
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::HOT);
+    for (storage::col_id_t col_id : layout.AllColumns())
+      EXPECT_FALSE(arrow_metadata.GetColumnInfo(layout, col_id).HasZoneMap());
+    txn_manager.Abort(txn);
+
+    for (auto &entry : tuples) delete[] reinterpret_cast<byte *>(entry.second);  // reclaim memory used for bookkeeping
+
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();  // Second call to deallocate.
+    // Deallocate all the leftover gathered varlens
+    // No need to gather the ones still in the block because they are presumably all gathered
+    for (storage::col_id_t col_id : layout.AllColumns())
+      if (layout.IsVarlen(col_id)) arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
+    block_store_.Release(block);
+  }
+}
+
 }  // namespace noisepage
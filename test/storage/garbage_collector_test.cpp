@@ -1,14 +1,20 @@
 #include "storage/garbage_collector.h"
 
 #include <cstring>
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "common/object_pool.h"
+#include "catalog/index_schema.h"
 #include "main/db_main.h"
+#include "parser/expression/column_value_expression.h"
 #include "storage/data_table.h"
+#include "storage/index/index.h"
+#include "storage/index/index_builder.h"
 #include "storage/storage_util.h"
+#include "test_util/catalog_test_util.h"
 #include "test_util/data_table_test_util.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
@@ -699,4 +705,127 @@ TEST_F(GarbageCollectorTests, InsertUpdate1) {
     EXPECT_EQ(std::make_pair(2U, 0U), gc->PerformGarbageCollection());
   }
 }
+
+// Update tuples spread over many blocks and GC them with several workers. Confirm that all txns get unlinked and
+// deallocated, and the latest versions remain visible.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, ParallelUnlink) {
+  const uint32_t num_tuples = 10000;
+  const uint32_t num_updates = 5;
+  for (uint32_t iteration = 0; iteration < 5; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).SetGCNumThreads(4).Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+    EXPECT_EQ(4U, gc->GetNumWorkers());
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+
+    std::vector<storage::TupleSlot> slots;
+    std::vector<storage::ProjectedRow *> versions;
+    auto *txn0 = txn_manager->BeginTransaction();
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+      slots.push_back(tested.table_.Insert(common::ManagedPointer(txn0), *insert_tuple));
+      versions.push_back(insert_tuple);
+    }
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Every txn updates every tuple, so each version chain holds an UndoRecord of every txn.
+    for (uint32_t update = 0; update < num_updates; update++) {
+      auto *txn = txn_manager->BeginTransaction();
+      for (uint32_t i = 0; i < num_tuples; i++) {
+        storage::ProjectedRow *delta = tested.GenerateRandomUpdate(&generator_);
+        EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slots[i], *delta));
+        versions[i] = tested.GenerateVersionFromUpdate(*delta, *versions[i]);
+      }
+      txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+
+    // Unlink all txns, then deallocate them on the next run
+    EXPECT_EQ(std::make_pair(0U, num_updates + 1), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(num_updates + 1, 0U), gc->PerformGarbageCollection());
+
+    auto *txn1 = txn_manager->BeginTransaction();
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn1, slots[i]);
+      EXPECT_TRUE(tested.select_result_);
+      EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, versions[i]));
+    }
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+}
+
+// Delete every other tuple and remove it from several indexes. Confirm that the GC workers deallocate the deleted slots
+// and leave only the remaining tuples in the indexes, which the GC workers collect in parallel.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, ParallelDelete) {
+  const uint32_t num_tuples = 10000;
+  const uint32_t num_indexes = 8;
+  auto db_main = DBMain::Builder().SetUseGC(true).SetGCNumThreads(4).Build();
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+  GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                             &generator_);
+
+  std::vector<catalog::IndexSchema::Column> keycols;
+  keycols.emplace_back("", type::TypeId::INTEGER, false,
+                       parser::ColumnValueExpression(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID,
+                                                     catalog::col_oid_t(1)));
+  StorageTestUtil::ForceOid(&(keycols[0]), catalog::indexkeycol_oid_t(1));
+  const catalog::IndexSchema key_schema(keycols, storage::index::IndexType::BWTREE, false, false, false, true);
+  std::vector<std::unique_ptr<storage::index::Index>> indexes;
+  for (uint32_t i = 0; i < num_indexes; i++) {
+    indexes.emplace_back(storage::index::IndexBuilder().SetKeySchema(key_schema).Build());
+    gc->RegisterIndexForGC(common::ManagedPointer(indexes.back().get()));
+  }
+  const auto &key_initializer = indexes.front()->GetProjectedRowInitializer();
+  auto *const key_buffer = common::AllocationUtil::AllocateAligned(key_initializer.ProjectedRowSize());
+  auto *const key = key_initializer.InitializeRow(key_buffer);
+
+  std::vector<storage::TupleSlot> slots;
+  auto *txn0 = txn_manager->BeginTransaction();
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    slots.push_back(tested.table_.Insert(common::ManagedPointer(txn0), *tested.GenerateRandomTuple(&generator_)));
+    *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = i;
+    for (const auto &index : indexes) EXPECT_TRUE(index->Insert(common::ManagedPointer(txn0), *key, slots[i]));
+  }
+  txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // The deleted tuples are spread over all blocks, and so over the UndoRecords of every worker.
+  auto *txn1 = txn_manager->BeginTransaction();
+  for (uint32_t i = 0; i < num_tuples; i += 2) {
+    EXPECT_TRUE(tested.table_.Delete(common::ManagedPointer(txn1), slots[i]));
+    *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = i;
+    for (const auto &index : indexes) index->Delete(common::ManagedPointer(txn1), *key, slots[i]);
+  }
+  txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Unlink both txns, which deallocates the deleted slots and removes them from the indexes, then deallocate the txns
+  EXPECT_EQ(std::make_pair(0U, 2U), gc->PerformGarbageCollection());
+  EXPECT_EQ(std::make_pair(2U, 0U), gc->PerformGarbageCollection());
+
+  const storage::TupleAccessStrategy accessor(tested.Layout());
+  for (uint32_t i = 0; i < num_tuples; i++) EXPECT_EQ(i % 2 == 1, accessor.Allocated(slots[i]));
+
+  auto *txn2 = txn_manager->BeginTransaction();
+  for (const auto &index : indexes) {
+    EXPECT_EQ(num_tuples / 2, index->GetSize());
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      std::vector<storage::TupleSlot> results;
+      *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = i;
+      index->ScanKey(*txn2, *key, &results);
+      if (i % 2 == 1) {
+        EXPECT_EQ(std::vector<storage::TupleSlot>{slots[i]}, results);
+      } else {
+        EXPECT_TRUE(results.empty());
+      }
+    }
+  }
+  txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  for (const auto &index : indexes) gc->UnregisterIndexForGC(common::ManagedPointer(index.get()));
+  delete[] key_buffer;
+}
 }  // namespace noisepage
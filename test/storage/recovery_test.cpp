@@ -1,3 +1,4 @@
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -9,7 +10,9 @@
 #include "main/db_main.h"
 #include "storage/garbage_collector_thread.h"
 #include "storage/index/index_builder.h"
+#include "storage/recovery/checkpoint_manager.h"
 #include "storage/recovery/disk_log_provider.h"
+#include "storage/recovery/merging_log_provider.h"
 #include "storage/recovery/recovery_manager.h"
 #include "storage/sql_table.h"
 #include "storage/write_ahead_log/log_manager.h"
@@ -24,6 +27,7 @@
 // executions will read old test's data, and the cause of the errors will be hard to identify. Trust me it will drive
 // you nuts...
 #define RECOVERY_TEST_LOG_FILE_NAME "./test_recovery_test.log"
+#define RECOVERY_TEST_CHECKPOINT_PATH "./test_recovery_test_checkpoints"
 
 namespace noisepage::storage {
 class RecoveryTests : public TerrierTest {
@@ -49,17 +53,7 @@ class RecoveryTests : public TerrierTest {
     // Unlink log file incase one exists from previous test iteration
     unlink(RECOVERY_TEST_LOG_FILE_NAME);
 
-    db_main_ = noisepage::DBMain::Builder()
-                   .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
-                   .SetUseLogging(true)
-                   .SetUseGC(true)
-                   .SetUseGCThread(true)
-                   .SetUseCatalog(true)
-                   .Build();
-    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
-    log_manager_ = db_main_->GetLogManager();
-    block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
-    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+    StartOriginalSystem(1);
 
     recovery_db_main_ = noisepage::DBMain::Builder()
                             .SetUseThreadRegistry(true)
@@ -80,6 +74,22 @@ class RecoveryTests : public TerrierTest {
     unlink(RECOVERY_TEST_LOG_FILE_NAME);
   }
 
+  // Builds the original DBMain, logging into the given number of streams
+  void StartOriginalSystem(const uint32_t num_log_streams) {
+    db_main_ = noisepage::DBMain::Builder()
+                   .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
+                   .SetWalNumStreams(num_log_streams)
+                   .SetUseLogging(true)
+                   .SetUseGC(true)
+                   .SetUseGCThread(true)
+                   .SetUseCatalog(true)
+                   .Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    log_manager_ = db_main_->GetLogManager();
+    block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+  }
+
   catalog::IndexSchema DummyIndexSchema() {
     std::vector<catalog::IndexSchema::Column> keycols;
     keycols.emplace_back(
@@ -184,7 +194,7 @@ class RecoveryTests : public TerrierTest {
     recovery_manager.WaitForRecoveryToFinish();
   }
 
-  void RunTest(const LargeSqlTableTestConfiguration &config) {
+  void RunTest(const LargeSqlTableTestConfiguration &config, const uint32_t num_replay_threads = 1) {
     // Run workload
     auto *tested =
         new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
@@ -192,15 +202,22 @@ class RecoveryTests : public TerrierTest {
 
     ShutdownAndRestartSystem();
 
-    // Instantiate recovery manager, and recover the tables.
-    DiskLogProvider log_provider{RECOVERY_TEST_LOG_FILE_NAME};
-    RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+    // Instantiate recovery manager, and recover the tables. A log split into several streams is merged.
+    std::unique_ptr<AbstractLogProvider> log_provider;
+    if (log_manager_->GetNumStreams() == 1) {
+      log_provider = std::make_unique<DiskLogProvider>(RECOVERY_TEST_LOG_FILE_NAME);
+    } else {
+      log_provider = std::make_unique<MergingLogProvider>(
+          LogManager::StreamSegmentPaths(RECOVERY_TEST_LOG_FILE_NAME, log_manager_->GetNumStreams()));
+    }
+    RecoveryManager recovery_manager{common::ManagedPointer(log_provider),
                                      recovery_catalog_,
                                      recovery_txn_manager_,
                                      recovery_deferred_action_manager_,
                                      DISABLED,
                                      recovery_thread_registry_,
-                                     recovery_block_store_};
+                                     recovery_block_store_,
+                                     num_replay_threads};
     recovery_manager.StartRecovery();
     recovery_manager.WaitForRecoveryToFinish();
 
@@ -284,6 +301,196 @@ TEST_F(RecoveryTests, MultiDatabaseTest) {
   RecoveryTests::RunTest(config);
 }
 
+// This test recovers multiple tables across multiple databases like MultiDatabaseTest, but replays the committed
+// transactions on multiple threads.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ParallelReplayTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(3)
+                                              .SetNumTables(5)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, 4);
+}
+
+// This test logs into several streams, each with its own serializer and log file. It checks that commits are only
+// acknowledged once all streams persisted far enough, and then recovers multiple tables across multiple databases from
+// the streams merged by commit timestamp.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, MultiStreamTest) {
+  const uint32_t num_log_streams = 4;
+  db_main_.reset();
+  for (uint32_t i = 0; i < num_log_streams; i++) {
+    unlink(LogManager::StreamPath(RECOVERY_TEST_LOG_FILE_NAME, i).c_str());
+  }
+  StartOriginalSystem(num_log_streams);
+  EXPECT_EQ(num_log_streams, log_manager_->GetNumStreams());
+
+  // A persisted commit is acknowledged no matter the stream it went to
+  const auto persisted_commit_sequence = log_manager_->GetPersistedCommitSequence();
+  bool persisted = false;
+  auto *txn = txn_manager_->BeginTransaction();
+  CreateDatabase(txn, catalog_, "multistream");
+  txn_manager_->Commit(txn, [](void *arg) { *reinterpret_cast<bool *>(arg) = true; }, &persisted);
+  log_manager_->ForceFlush();
+  EXPECT_TRUE(persisted);
+  EXPECT_LT(persisted_commit_sequence, log_manager_->GetPersistedCommitSequence());
+
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(3)
+                                              .SetNumTables(5)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config);
+
+  for (uint32_t i = 1; i < num_log_streams; i++) unlink(LogManager::StreamPath(RECOVERY_TEST_LOG_FILE_NAME, i).c_str());
+}
+
+// This test logs into several streams and then cuts off the tail of one stream, as if the system crashed before that
+// stream persisted it. The other streams persisted later commits, which may depend on the lost ones and were never
+// acknowledged, so recovery must not replay them either.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, MultiStreamTruncatedTest) {
+  const uint32_t num_log_streams = 2;
+  db_main_.reset();
+  for (uint32_t i = 0; i < num_log_streams; i++) {
+    unlink(LogManager::StreamPath(RECOVERY_TEST_LOG_FILE_NAME, i).c_str());
+  }
+  StartOriginalSystem(num_log_streams);
+  const auto truncated_path = LogManager::StreamPath(RECOVERY_TEST_LOG_FILE_NAME, 0);
+
+  // Every stream persists this commit
+  auto *txn = txn_manager_->BeginTransaction();
+  const auto db_oid = CreateDatabase(txn, catalog_, "persisted");
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  log_manager_->ForceFlush();
+  const auto truncated_size = std::filesystem::file_size(truncated_path);
+
+  // These commits go to both streams
+  const uint32_t num_lost_databases = 20;
+  for (uint32_t i = 0; i < num_lost_databases; i++) {
+    txn = txn_manager_->BeginTransaction();
+    CreateDatabase(txn, catalog_, "lost" + std::to_string(i));
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+
+  // Simulate the system shutting down, and lose the tail of the first stream
+  db_main_->GetGarbageCollectorThread()->StopGC();
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->FullyPerformGC(
+      db_main_->GetStorageLayer()->GetGarbageCollector(), log_manager_);
+  log_manager_->PersistAndStop();
+  EXPECT_LT(truncated_size, std::filesystem::file_size(truncated_path));
+  std::filesystem::resize_file(truncated_path, truncated_size);
+
+  MergingLogProvider log_provider(LogManager::StreamSegmentPaths(RECOVERY_TEST_LOG_FILE_NAME, num_log_streams));
+  RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_};
+  recovery_manager.StartRecovery();
+  recovery_manager.WaitForRecoveryToFinish();
+
+  // Only the commit that every stream persisted is recovered
+  txn = recovery_txn_manager_->BeginTransaction();
+  EXPECT_EQ(db_oid, recovery_catalog_->GetDatabaseOid(common::ManagedPointer(txn), "persisted"));
+  for (uint32_t i = 0; i < num_lost_databases; i++) {
+    EXPECT_EQ(catalog::INVALID_DATABASE_OID,
+              recovery_catalog_->GetDatabaseOid(common::ManagedPointer(txn), "lost" + std::to_string(i)));
+  }
+  recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  log_manager_->Start();
+  db_main_->GetGarbageCollectorThread()->StartGC();
+  for (uint32_t i = 1; i < num_log_streams; i++) unlink(LogManager::StreamPath(RECOVERY_TEST_LOG_FILE_NAME, i).c_str());
+}
+
+// This test takes a checkpoint in the middle of a workload on multiple tables across multiple databases. It then
+// recovers the tables from the checkpoint and the log written since, and verifies that the recovered tables are equal
+// to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CheckpointTest) {
+  std::filesystem::remove_all(RECOVERY_TEST_CHECKPOINT_PATH);
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  auto *tested =
+      new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+  tested->SimulateOltp(100, 4);
+
+  // Checkpoint while txns are still running, and continue the workload afterwards
+  CheckpointManager checkpoint_manager(RECOVERY_TEST_CHECKPOINT_PATH, std::chrono::seconds{60}, catalog_, txn_manager_,
+                                       log_manager_, db_main_->GetThreadRegistry());
+  std::thread workload([&] { tested->SimulateOltp(100, 4); });
+  const auto checkpoint_ts = checkpoint_manager.TakeCheckpoint();
+  workload.join();
+  tested->SimulateOltp(100, 4);
+
+  ShutdownAndRestartSystem();
+
+  // The log written before the checkpoint has been removed
+  EXPECT_EQ(1U, LogManager::SegmentPaths(RECOVERY_TEST_LOG_FILE_NAME).size());
+
+  // Load the checkpoint, and recover the rest from the log
+  DiskLogProvider log_provider{LogManager::SegmentPaths(RECOVERY_TEST_LOG_FILE_NAME)};
+  RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_};
+  EXPECT_TRUE(recovery_manager.RecoverFromCheckpoint(RECOVERY_TEST_CHECKPOINT_PATH, 4));
+  EXPECT_EQ(checkpoint_ts, recovery_manager.checkpoint_ts_);
+  recovery_manager.StartRecovery();
+  recovery_manager.WaitForRecoveryToFinish();
+
+  // Check we recovered all the original tables
+  for (auto &database : tested->GetTables()) {
+    auto database_oid = database.first;
+    for (auto &table_oid : database.second) {
+      auto original_txn = txn_manager_->BeginTransaction();
+      auto original_sql_table = catalog_->GetDatabaseCatalog(common::ManagedPointer(original_txn), database_oid)
+                                    ->GetTable(common::ManagedPointer(original_txn), table_oid);
+
+      auto *recovery_txn = recovery_txn_manager_->BeginTransaction();
+      auto db_catalog = recovery_catalog_->GetDatabaseCatalog(common::ManagedPointer(recovery_txn), database_oid);
+      EXPECT_TRUE(db_catalog != nullptr);
+      auto recovered_sql_table = db_catalog->GetTable(common::ManagedPointer(recovery_txn), table_oid);
+      EXPECT_TRUE(recovered_sql_table != nullptr);
+
+      EXPECT_TRUE(StorageTestUtil::SqlTableEqualDeep(
+          GetBlockLayout(original_sql_table), original_sql_table, recovered_sql_table,
+          tested->GetTupleSlotsForTable(database_oid, table_oid), recovery_manager.tuple_slot_map_, txn_manager_.Get(),
+          recovery_txn_manager_.Get()));
+      txn_manager_->Commit(original_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      recovery_txn_manager_->Commit(recovery_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+  }
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+
+  for (const auto &segment : LogManager::SegmentPaths(RECOVERY_TEST_LOG_FILE_NAME)) {
+    unlink(segment.c_str());
+  }
+  std::filesystem::remove_all(RECOVERY_TEST_CHECKPOINT_PATH);
+}
+
 // Tests that we correctly process records corresponding to a drop database command.
 // NOLINTNEXTLINE
 TEST_F(RecoveryTests, DropDatabaseTest) {
@@ -10,6 +10,7 @@
 #include "common/settings.h"
 #include "gtest/gtest.h"
 #include "main/db_main.h"
+#include "network/postgres/shared_plan_cache.h"
 #include "test_util/test_harness.h"
 
 namespace noisepage::trafficcop {
@@ -210,4 +211,63 @@ TEST_F(TrafficCopTests, AsyncCommitTest) {
   }
 }
 
+/**
+ * Test that connections share the plans of their prepared statements, and that DDL invalidates them
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, SharedPlanCacheTest) {
+  StartServer(false);
+  const auto shared_plan_cache = db_main_->GetNetworkLayer()->GetSharedPlanCache();
+  try {
+    pqxx::connection connection1(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+    pqxx::connection connection2(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+
+    {
+      pqxx::work txn1(connection1);
+      txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data TEXT);");
+      txn1.exec("INSERT INTO TableA VALUES (1, 'abc');");
+      txn1.commit();
+    }
+    EXPECT_EQ(shared_plan_cache->Size(), 0);
+
+    connection1.prepare("select", "SELECT * FROM TableA WHERE id = $1");
+    connection2.prepare("select", "SELECT * FROM TableA WHERE id = $1");
+    {
+      pqxx::work txn1(connection1);
+      EXPECT_EQ(txn1.exec_prepared("select", 1).size(), 1);
+      txn1.commit();
+    }
+    EXPECT_EQ(shared_plan_cache->Size(), 1);
+    {
+      // The second connection reuses the plan of the first one
+      pqxx::work txn2(connection2);
+      EXPECT_EQ(txn2.exec_prepared("select", 1).size(), 1);
+      txn2.commit();
+    }
+    EXPECT_EQ(shared_plan_cache->Size(), 1);
+
+    {
+      pqxx::work txn1(connection1);
+      txn1.exec("DROP TABLE TableA;");
+      txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY);");
+      txn1.exec("INSERT INTO TableA VALUES (1);");
+      txn1.commit();
+    }
+    EXPECT_EQ(shared_plan_cache->Size(), 0);
+    {
+      // The second connection has to replan against the new schema
+      pqxx::work txn2(connection2);
+      pqxx::result r = txn2.exec_prepared("select", 1);
+      EXPECT_EQ(r.size(), 1);
+      EXPECT_EQ(r.columns(), 1);
+      txn2.commit();
+    }
+    EXPECT_EQ(shared_plan_cache->Size(), 1);
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
 }  // namespace noisepage::trafficcop
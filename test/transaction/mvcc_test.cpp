@@ -1,4 +1,6 @@
 #include <cstring>
+#include <memory>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -1369,4 +1371,170 @@ TEST_F(MVCCTests, SimpleDelete2) {
     txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
   }
 }
+
+// Two workers of Txn #0 each insert tuples concurrently and are merged back into Txn #0, which then commits. The
+// workers' inserts should be Txn #0's inserts: visible to Txn #0 itself, and to Txn #1 once Txn #0 commits.
+// NOLINTNEXTLINE
+TEST_F(MVCCTests, WorkerCommitInsert) {
+  const uint32_t num_workers = 2;
+  const uint32_t num_inserts = 100;
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    MVCCDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_, &generator_);
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn0);
+
+    std::vector<std::unique_ptr<transaction::TransactionContext>> workers;
+    std::vector<std::vector<storage::TupleSlot>> slots(num_workers);
+    for (uint32_t i = 0; i < num_workers; i++) workers.emplace_back(txn0->BeginWorker());
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < num_workers; i++) {
+      threads.emplace_back([&, i] {
+        for (uint32_t j = 0; j < num_inserts; j++) {
+          slots[i].push_back(tested.table_.Insert(common::ManagedPointer(workers[i]), *insert_tuple));
+        }
+      });
+    }
+    for (auto &thread : threads) thread.join();
+    for (auto &worker : workers) txn0->MergeWorker(std::move(worker));
+    EXPECT_FALSE(txn0->IsReadOnly());
+
+    auto *txn1 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn1);
+    for (const auto &worker_slots : slots) {
+      for (const auto slot : worker_slots) {
+        storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn0, slot);
+        EXPECT_TRUE(tested.select_result_);
+        EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+        tested.SelectIntoBuffer(txn1, slot);
+        EXPECT_FALSE(tested.select_result_);
+      }
+    }
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto *txn2 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn2);
+    for (const auto &worker_slots : slots) {
+      for (const auto slot : worker_slots) {
+        tested.SelectIntoBuffer(txn2, slot);
+        EXPECT_TRUE(tested.select_result_);
+      }
+    }
+    txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+}
+
+// Two workers of Txn #0 each insert tuples concurrently and are merged back into Txn #0, which then aborts. Aborting
+// Txn #0 should roll back the workers' inserts as well.
+// NOLINTNEXTLINE
+TEST_F(MVCCTests, WorkerAbortInsert) {
+  const uint32_t num_workers = 2;
+  const uint32_t num_inserts = 100;
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    MVCCDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_, &generator_);
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn0);
+
+    std::vector<std::unique_ptr<transaction::TransactionContext>> workers;
+    std::vector<std::vector<storage::TupleSlot>> slots(num_workers);
+    for (uint32_t i = 0; i < num_workers; i++) workers.emplace_back(txn0->BeginWorker());
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < num_workers; i++) {
+      threads.emplace_back([&, i] {
+        for (uint32_t j = 0; j < num_inserts; j++) {
+          slots[i].push_back(tested.table_.Insert(common::ManagedPointer(workers[i]), *insert_tuple));
+        }
+      });
+    }
+    for (auto &thread : threads) thread.join();
+    for (auto &worker : workers) txn0->MergeWorker(std::move(worker));
+    txn_manager->Abort(txn0);
+
+    auto *txn1 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn1);
+    for (const auto &worker_slots : slots) {
+      for (const auto slot : worker_slots) {
+        tested.SelectIntoBuffer(txn1, slot);
+        EXPECT_FALSE(tested.select_result_);
+      }
+    }
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+}
+
+// Two workers of Txn #0 each update their own tuples concurrently, while Txn #1 holds an uncommitted update of one of
+// the second worker's tuples. The second worker stops at that conflict and, like an aborting operator, marks Txn #0
+// rather than itself. After merging, Txn #0 must abort, and aborting it should roll back every update the workers did
+// install, while Txn #1's version survives.
+// NOLINTNEXTLINE
+TEST_F(MVCCTests, WorkerAbortUpdate) {
+  const uint32_t num_workers = 2;
+  const uint32_t num_updates = 100;
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    MVCCDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_, &generator_);
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+
+    auto *txn = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn);
+    std::vector<std::vector<storage::TupleSlot>> slots(num_workers);
+    for (auto &worker_slots : slots) {
+      for (uint32_t j = 0; j < num_updates; j++) {
+        worker_slots.push_back(tested.table_.Insert(common::ManagedPointer(txn), *insert_tuple));
+      }
+    }
+    txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto *txn1 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn1);
+    const storage::TupleSlot conflict_slot = slots[1][num_updates / 2];
+    storage::ProjectedRow *update1 = tested.GenerateRandomUpdate(&generator_);
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn1), conflict_slot, *update1));
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn0);
+    storage::ProjectedRow *update0 = tested.GenerateRandomUpdate(&generator_);
+    std::vector<std::unique_ptr<transaction::TransactionContext>> workers;
+    for (uint32_t i = 0; i < num_workers; i++) workers.emplace_back(txn0->BeginWorker());
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < num_workers; i++) {
+      threads.emplace_back([&, i] {
+        for (const auto slot : slots[i]) {
+          if (!tested.table_.Update(common::ManagedPointer(workers[i]), slot, *update0)) {
+            EXPECT_EQ(conflict_slot, slot);
+            txn0->SetMustAbort();
+            return;
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) thread.join();
+    for (auto &worker : workers) txn0->MergeWorker(std::move(worker));
+    EXPECT_TRUE(txn0->MustAbort());
+    txn_manager->Abort(txn0);
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto *txn2 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn2);
+    storage::ProjectedRow *version1 = tested.GenerateVersionFromUpdate(*update1, *insert_tuple);
+    for (const auto &worker_slots : slots) {
+      for (const auto slot : worker_slots) {
+        storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn2, slot);
+        EXPECT_TRUE(tested.select_result_);
+        EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple,
+                                                                slot == conflict_slot ? version1 : insert_tuple));
+      }
+    }
+    txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+}
 }  // namespace noisepage
@@ -0,0 +1,123 @@
+#include "transaction/timestamp_manager.h"
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "storage/record_buffer.h"
+#include "test_util/test_harness.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage::transaction {
+
+class TimestampManagerTests : public TerrierTest {};
+
+// Test that the oldest running txn is tracked as txns begin and finish out of order
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, OldestTransaction) {
+  TimestampManager timestamp_manager;
+  DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  storage::RecordBufferSegmentPool buffer_pool{1000, 100};
+  TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&buffer_pool),
+                                 false, false, DISABLED};
+
+  // Without running txns, the oldest txn is the current time.
+  EXPECT_EQ(timestamp_manager.CurrentTime(), timestamp_manager.OldestTransactionStartTime());
+
+  // Begin more txns than there are shards, so that some shards hold several of them.
+  std::vector<TransactionContext *> txns;
+  for (uint32_t i = 0; i < 3 * TimestampManager::NUM_RUNNING_TXN_SHARDS; i++) {
+    txns.push_back(txn_manager.BeginTransaction());
+  }
+  EXPECT_EQ(txns.front()->StartTime(), timestamp_manager.OldestTransactionStartTime());
+  EXPECT_EQ(txns.front()->StartTime(), timestamp_manager.CachedOldestTransactionStartTime());
+
+  // Finishing every other txn, starting with the oldest, moves the oldest txn to the next one still running.
+  for (uint32_t i = 0; i < txns.size(); i += 2) {
+    txn_manager.Commit(txns[i], TransactionUtil::EmptyCallback, nullptr);
+    EXPECT_EQ(txns[i + 1]->StartTime(), timestamp_manager.OldestTransactionStartTime());
+  }
+  for (uint32_t i = 1; i < txns.size(); i += 2) {
+    txn_manager.Commit(txns[i], TransactionUtil::EmptyCallback, nullptr);
+  }
+  EXPECT_EQ(timestamp_manager.CurrentTime(), timestamp_manager.OldestTransactionStartTime());
+
+  for (auto *txn : txns) {
+    delete txn;
+  }
+}
+
+// Test that the oldest running txn is never newer than a txn that is running throughout, while other threads begin
+// and finish txns concurrently
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, ConcurrentOldestTransaction) {
+  TimestampManager timestamp_manager;
+  DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  storage::RecordBufferSegmentPool buffer_pool{10000, 1000};
+  TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&buffer_pool),
+                                 false, false, DISABLED};
+
+  const uint32_t num_threads = 8;
+  std::vector<std::atomic<uint64_t>> running(num_threads);
+  for (auto &start_time : running) {
+    start_time = INVALID_TXN_TIMESTAMP.UnderlyingValue();
+  }
+  std::atomic<bool> done{false};
+
+  std::vector<std::thread> threads;
+  for (uint32_t thread = 0; thread < num_threads; thread++) {
+    threads.emplace_back([&, thread] {
+      for (uint32_t i = 0; i < 10000; i++) {
+        auto *txn = txn_manager.BeginTransaction();
+        running[thread] = txn->StartTime().UnderlyingValue();
+        running[thread] = INVALID_TXN_TIMESTAMP.UnderlyingValue();
+        txn_manager.Commit(txn, TransactionUtil::EmptyCallback, nullptr);
+        delete txn;
+      }
+    });
+  }
+  std::thread poller([&] {
+    while (!done) {
+      std::vector<uint64_t> before(num_threads);
+      for (uint32_t thread = 0; thread < num_threads; thread++) {
+        before[thread] = running[thread];
+      }
+      const timestamp_t oldest = timestamp_manager.OldestTransactionStartTime();
+      for (uint32_t thread = 0; thread < num_threads; thread++) {
+        if (before[thread] != INVALID_TXN_TIMESTAMP.UnderlyingValue() && running[thread] == before[thread]) {
+          EXPECT_LE(oldest.UnderlyingValue(), before[thread]);
+        }
+      }
+    }
+  });
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  done = true;
+  poller.join();
+  EXPECT_EQ(timestamp_manager.CurrentTime(), timestamp_manager.OldestTransactionStartTime());
+}
+
+// Test that a txn that has announced itself in a begin slot, but is not in the running txn set yet, keeps the bulk
+// removal from reporting that no txns are running
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, RemoveTransactionsWithBeginningTxn) {
+  TimestampManager timestamp_manager;
+  const timestamp_t start_time = timestamp_manager.BeginTransaction();
+
+  // Occupy a begin slot the way BeginTransaction() does before the txn is inserted into its shard.
+  timestamp_manager.begin_slots_[0].lower_bound_.store(timestamp_manager.CurrentTime());
+  EXPECT_FALSE(timestamp_manager.RemoveTransactions({start_time}));
+  EXPECT_EQ(timestamp_manager.CurrentTime(), timestamp_manager.OldestTransactionStartTime());
+
+  // Once the slot is released, nothing is running anymore.
+  timestamp_manager.begin_slots_[0].lower_bound_.store(INVALID_TXN_TIMESTAMP);
+  EXPECT_TRUE(timestamp_manager.RemoveTransactions({}));
+}
+
+}  // namespace noisepage::transaction
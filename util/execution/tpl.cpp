@@ -51,6 +51,7 @@ llvm::cl::OptionCategory TPL_OPTIONS_CATEGORY("TPL Compiler Options", "Options f
 llvm::cl::opt<bool> PRINT_AST("print-ast", llvm::cl::desc("Print the programs AST"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 llvm::cl::opt<bool> PRINT_TBC("print-tbc", llvm::cl::desc("Print the generated TPL Bytecode"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 llvm::cl::opt<bool> PRETTY_PRINT("pretty-print", llvm::cl::desc("Pretty-print the source from the parsed AST"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
+llvm::cl::opt<uint32_t> PRINT_BYTECODE_PAIRS("print-bytecode-pairs", llvm::cl::desc("Print the N most frequently interpreted pairs of bytecodes, requires a build with NOISEPAGE_PROFILE_BYTECODES"), llvm::cl::init(0), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 llvm::cl::opt<bool> IS_SQL("sql", llvm::cl::desc("Is the input a SQL query?"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 llvm::cl::opt<bool> TPCH("tpch", llvm::cl::desc("Should the TPCH database be loaded? Requires '-schema' and '-data' directories."), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 llvm::cl::opt<std::string> DATA_DIR("data", llvm::cl::desc("Where to find data files of tables to load"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
@@ -390,6 +391,12 @@ int main(int argc, char **argv) {
     noisepage::execution::RunRepl();
   }
 
+  // Report the candidates for superinstructions
+  for (const auto &[pair, count] : noisepage::execution::vm::VM::GetHotBytecodePairs(PRINT_BYTECODE_PAIRS)) {
+    EXECUTION_LOG_INFO("{} -> {}: {}", noisepage::execution::vm::Bytecodes::ToString(pair.first),
+                       noisepage::execution::vm::Bytecodes::ToString(pair.second), count);
+  }
+
   // Cleanup
   noisepage::execution::ShutdownTPL();
   noisepage::LoggersUtil::ShutDown();